@@ -0,0 +1,65 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Aggregated Telemetry Packet Sub-Header
+//
+// Housekeeping and magnetometer DAQ telemetry packets carry several samples
+// packed back to back in the user data field. Each sample (or part of a
+// sample that did not fit in the previous packet) is preceded by a sub-header
+// giving its creation time relative to the packet T-field and the number of
+// sample octets that follow.
+//
+// User data field layout:
+//
+//     Sub-Header | Sample | Sub-Header | Sample | ...
+//
+// Sub-header layout (big-endian):
+//
+//     0  |  Time Offset (16) (milliseconds after packet T-field)
+//     2  |  Encoded Flag (1) | Sample Size (15) (octets following sub-header)
+//
+// Samples are only split on record boundaries (e.g. one magnetometer DAQ scan
+// of channels 0, 1, and 2), so every sub-sample can be processed on its own.
+// Encoded samples (magnetometer DAQ codec, mdq_cdc.h) are split on codec
+// block boundaries.
+//
+// -------------------------------------------------------------------------- /
+//
+// agent
+// Project HEPCATS
+// Subsystem: C&DH
+// Created: October 17, 2026
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Standard libraries:
+#include <stdint.h> // Integer types
+
+// Macro definitions:
+#define AGG_SUB_HDR_SIZE     4 // Sub-header size in octets
+#define AGG_SUB_HDR_ENC 0x8000 // Sample size field: encoded flag
+
+// Encode sub-header
+static inline void enc_agg_sub_hdr(char* buf, uint16_t t_ofst,
+    uint16_t smpl_size, uint8_t enc_flg) {
+    // Set encoded flag:
+    if (enc_flg) {
+        smpl_size |= AGG_SUB_HDR_ENC;
+    }
+
+    buf[0] = (char) (t_ofst >> 8);
+    buf[1] = (char) (t_ofst);
+    buf[2] = (char) (smpl_size >> 8);
+    buf[3] = (char) (smpl_size);
+}
+
+// Decode sub-header
+static inline void dec_agg_sub_hdr(const char* buf, uint16_t* t_ofst,
+    uint16_t* smpl_size, uint8_t* enc_flg) {
+    // Definitions and initializations:
+    const uint8_t* p = (const uint8_t*) buf;
+
+    *t_ofst    = (uint16_t) ((p[0] << 8) | p[1]);
+    *smpl_size = (uint16_t) ((p[2] << 8) | p[3]);
+    *enc_flg   = (*smpl_size & AGG_SUB_HDR_ENC) != 0;
+    *smpl_size &= ~AGG_SUB_HDR_ENC;
+}
@@ -0,0 +1,142 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// CCSDS Packet Error Control Benchmark
+//
+// Measures the time to compute the CRC-16-CCITT packet error control of one
+// telemetry packet (1078 octets) with the slicing-by-8 implementation and
+// with a reference bit-by-bit implementation (also used to check the result).
+// The cost is reported as a fraction of the time needed to send one
+// telemetry packet (1080 octets, 10 bits per octet on the serial line) at the
+// full 1 Mbaud downlink rate.
+//
+// -------------------------------------------------------------------------- /
+//
+// Input Arguments:
+// - argv[1] (number of packets, optional, default 1000000)
+//
+// Output Arguments:
+// - N/A
+//
+// -------------------------------------------------------------------------- /
+//
+// agent
+// Project HEPCATS
+// Subsystem: C&DH
+// Created: October 17, 2026
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Standard libraries:
+#include <stdio.h>   // Standard input/output definitions
+#include <stdlib.h>  // Standard library
+#include <stdint.h>  // Standard integer types
+#include <time.h>    // Standard time function definitions
+
+// Header files:
+#include "ccsds_crc.h" // CCSDS packet error control (CRC)
+
+// Macro definitions:
+#define NPKT_DFLT 1000000 // Default number of packets per benchmark
+#define NBUF           16 // Number of packet buffers cycled through
+#define PKT_CRC_SIZE 1078 // Octets covered by telemetry packet CRC
+#define PKT_SIZE     1080 // Telemetry packet size in octets
+#define BAUD      1000000 // Downlink rate (baud)
+#define BITS_PER_OCTET 10 // Serial bits per octet (start, 8 data, stop)
+
+// Packet buffers:
+static char pkt_buf[NBUF][PKT_SIZE];
+
+// Get monotonic time in seconds
+static double get_tm() {
+    // Definitions and initializations:
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC,&ts);
+
+    return ts.tv_sec + ts.tv_nsec/1e9;
+}
+
+// Calculate CRC-16-CCITT bit by bit (reference)
+static uint16_t calc_ref_crc(const char* buf, size_t len) {
+    // Definitions and initializations:
+    uint16_t crc = CCSDS_CRC_INIT; // CRC
+    size_t i;                      // Octet counter
+    int j;                         // Bit counter
+
+    for (i = 0; i < len; ++i) {
+        crc ^= (uint16_t) ((uint8_t) buf[i] << 8);
+        for (j = 0; j < 8; ++j) {
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : (crc << 1);
+        }
+    }
+
+    return crc;
+}
+
+int main(int argc, char const *argv[]) {
+    // Definitions and initializations:
+    uint32_t npkt = NPKT_DFLT; // Number of packets
+    uint32_t i;                // Counter
+    uint32_t j;                // Counter
+    uint32_t chk = 0;          // Sum of CRCs (keeps CRC from being optimized
+                               // away)
+    double tm_strt;            // Start time
+    double tm_crc;             // Time per packet (slicing-by-8)
+    double tm_ref;             // Time per packet (bit by bit)
+    double tm_pkt;             // Time to send one packet at downlink rate
+
+    // Get number of packets:
+    if (argc > 1) {
+        npkt = strtoul(argv[1],NULL,0);
+    }
+
+    // Populate packet buffers with pseudo-random data:
+    srand(1);
+    for (i = 0; i < NBUF; ++i) {
+        for (j = 0; j < PKT_SIZE; ++j) {
+            pkt_buf[i][j] = (char) rand();
+        }
+    }
+
+    // Check check value ("123456789") and packet buffers against reference:
+    if (calc_ccsds_crc("123456789",9) != 0x29B1) {
+        printf("<ERROR> Check value mismatch\n");
+        return 1;
+    }
+    for (i = 0; i < NBUF; ++i) {
+        for (j = 0; j <= PKT_CRC_SIZE; ++j) {
+            if (calc_ccsds_crc(pkt_buf[i],j) != calc_ref_crc(pkt_buf[i],j)) {
+                printf("<ERROR> CRC mismatch (length %u)\n",j);
+                return 1;
+            }
+        }
+    }
+
+    // Slicing-by-8:
+    tm_strt = get_tm();
+    for (i = 0; i < npkt; ++i) {
+        chk += calc_ccsds_crc(pkt_buf[i % NBUF],PKT_CRC_SIZE);
+    }
+    tm_crc = (get_tm() - tm_strt)/npkt;
+
+    // Bit by bit reference (fewer packets):
+    tm_strt = get_tm();
+    for (i = 0; i < npkt/10; ++i) {
+        chk += calc_ref_crc(pkt_buf[i % NBUF],PKT_CRC_SIZE);
+    }
+    tm_ref = (get_tm() - tm_strt)/(npkt/10);
+
+    // Time to send one packet at downlink rate:
+    tm_pkt = (double) PKT_SIZE*BITS_PER_OCTET/BAUD;
+
+    // Print:
+    printf("Slicing-by-8 : %8.1f ns/packet (%7.1f MB/s)\n",tm_crc*1e9,\
+        PKT_CRC_SIZE/tm_crc/1e6);
+    printf("Bit by bit   : %8.1f ns/packet (%7.1f MB/s)\n",tm_ref*1e9,\
+        PKT_CRC_SIZE/tm_ref/1e6);
+    printf("Packet time at %d baud : %.1f us\n",BAUD,tm_pkt*1e6);
+    printf("CRC cost per packet     : %.4f %%\n",100*tm_crc/tm_pkt);
+    printf("Checksum: %u\n",chk);
+
+    return 0;
+}
@@ -0,0 +1,129 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// CCSDS Packet Codec Benchmark
+//
+// Measures encode and decode throughput (packets/sec) of the CCSDS packet
+// codec for telemetry (primary and secondary header) and telecommand (primary
+// and secondary header plus application data) packets.
+//
+// -------------------------------------------------------------------------- /
+//
+// Input Arguments:
+// - argv[1] (number of packets, optional, default 10000000)
+//
+// Output Arguments:
+// - N/A
+//
+// -------------------------------------------------------------------------- /
+//
+// agent
+// Project HEPCATS
+// Subsystem: C&DH
+// Created: October 17, 2026
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Standard libraries:
+#include <stdio.h>   // Standard input/output definitions
+#include <stdlib.h>  // Standard library
+#include <stdint.h>  // Standard integer types
+#include <time.h>    // Standard time function definitions
+
+// Header files:
+#include "ccsds_pkt.h" // CCSDS packet codec
+
+// Macro definitions:
+#define NPKT_DFLT 10000000 // Default number of packets per benchmark
+#define NBUF            64 // Number of packet buffers cycled through
+
+// Packet buffers:
+static char pkt_buf[NBUF][1080];
+
+// Get monotonic time in seconds
+static double get_tm() {
+    // Definitions and initializations:
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC,&ts);
+
+    return ts.tv_sec + ts.tv_nsec/1e9;
+}
+
+// Print benchmark result
+static void print_res(const char* name, uint32_t npkt, double tm) {
+    printf("%-20s : %12.0f packets/sec (%6.2f ns/packet)\n",name,npkt/tm,\
+        tm*1e9/npkt);
+}
+
+int main(int argc, char const *argv[]) {
+    // Definitions and initializations:
+    uint32_t npkt = NPKT_DFLT; // Number of packets
+    uint32_t i;                // Counter
+    uint32_t chk = 0;          // Checksum of decoded fields (keeps decode
+                               // from being optimized away)
+    double tm_strt;            // Start time
+
+    struct ccsds_pri_hdr pri_hdr; // Packet primary header
+    struct ccsds_sec_hdr sec_hdr; // Packet secondary header
+    uint8_t  atc_flg;             // ATC flag
+    uint32_t cmd_arg;             // Command argument
+
+    // Get number of packets:
+    if (argc > 1) {
+        npkt = strtoul(argv[1],NULL,0);
+    }
+
+    // Populate constant primary header fields:
+    pri_hdr.vrs         = CCSDS_VRS;
+    pri_hdr.typ         = CCSDS_TYP_TLM;
+    pri_hdr.sec_hdr_flg = 1;
+    pri_hdr.grp_flg     = 3;
+    pri_hdr.pkt_len     = 1073;
+
+    // Telemetry encode:
+    tm_strt = get_tm();
+    for (i = 0; i < npkt; ++i) {
+        pri_hdr.apid    = i & CCSDS_APID_MASK;
+        pri_hdr.seq_cnt = i & CCSDS_SEQ_MASK;
+        enc_ccsds_pri_hdr(pkt_buf[i % NBUF],&pri_hdr);
+        enc_ccsds_sec_hdr(pkt_buf[i % NBUF],i,i % 1000);
+    }
+    print_res("TLM encode",npkt,get_tm() - tm_strt);
+
+    // Telemetry decode:
+    tm_strt = get_tm();
+    for (i = 0; i < npkt; ++i) {
+        dec_ccsds_pri_hdr(pkt_buf[i % NBUF],&pri_hdr);
+        dec_ccsds_sec_hdr(pkt_buf[i % NBUF],&sec_hdr);
+        chk += pri_hdr.apid + pri_hdr.seq_cnt + sec_hdr.t_sec + sec_hdr.p_id;
+    }
+    print_res("TLM decode",npkt,get_tm() - tm_strt);
+
+    // Telecommand encode:
+    pri_hdr.typ     = CCSDS_TYP_TELECMD;
+    pri_hdr.pkt_len = 13;
+    tm_strt = get_tm();
+    for (i = 0; i < npkt; ++i) {
+        pri_hdr.apid    = i & CCSDS_APID_MASK;
+        pri_hdr.seq_cnt = i & CCSDS_SEQ_MASK;
+        enc_ccsds_pri_hdr(pkt_buf[i % NBUF],&pri_hdr);
+        enc_ccsds_sec_hdr(pkt_buf[i % NBUF],i,i % 1000);
+        enc_ccsds_app_dat(pkt_buf[i % NBUF],i & 1,i);
+    }
+    print_res("TELECMD encode",npkt,get_tm() - tm_strt);
+
+    // Telecommand decode:
+    tm_strt = get_tm();
+    for (i = 0; i < npkt; ++i) {
+        dec_ccsds_pri_hdr(pkt_buf[i % NBUF],&pri_hdr);
+        dec_ccsds_sec_hdr(pkt_buf[i % NBUF],&sec_hdr);
+        dec_ccsds_app_dat(pkt_buf[i % NBUF],&atc_flg,&cmd_arg);
+        chk += pri_hdr.apid + sec_hdr.t_frc + atc_flg + cmd_arg;
+    }
+    print_res("TELECMD decode",npkt,get_tm() - tm_strt);
+
+    // Print checksum:
+    printf("Checksum: %u\n",chk);
+
+    return 0;
+}
@@ -0,0 +1,174 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Magnetometer DAQ Codec Benchmark
+//
+// Encodes synthetic magnetometer DAQ reads (128 scans of channels 0, 1, and
+// 2: a slowly varying field plus a few counts of noise) and measures the
+// compression ratio, the encode and decode time per read, and the scans that
+// fit in one aggregated telemetry packet with and without the codec. Every
+// read is decoded and checked against the original (lossless). Reads of
+// random counts are checked to fall back to raw (not smaller).
+//
+// -------------------------------------------------------------------------- /
+//
+// Input Arguments:
+// - argv[1] (number of reads, optional, default 100000)
+// - argv[2] (noise amplitude in counts, optional, default 4)
+//
+// Output Arguments:
+// - N/A
+//
+// -------------------------------------------------------------------------- /
+//
+// agent
+// Project HEPCATS
+// Subsystem: C&DH
+// Created: October 17, 2026
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Standard libraries:
+#include <stdio.h>   // Standard input/output definitions
+#include <stdlib.h>  // Standard library
+#include <string.h>  // String function definitions
+#include <stdint.h>  // Standard integer types
+#include <math.h>    // Math function definitions
+#include <time.h>    // Standard time function definitions
+
+// Header files:
+#include "mdq_cdc.h" // Magnetometer DAQ codec
+
+// Macro definitions:
+#define NREAD_DFLT 100000 // Default number of reads per benchmark
+#define NBUF           64 // Number of read buffers cycled through
+#define READ_NSCAN    128 // Scans per read (768 octets)
+#define READ_SIZE     768 // Read size in octets
+#define USR_DAT_SIZE 1064 // Aggregated packet user data size in octets
+#define SUB_HDR_SIZE    4 // Aggregated telemetry sub-header size in octets
+
+// Read buffers:
+static char read_buf[NBUF][READ_SIZE];
+static char enc_buf[NBUF][READ_SIZE];
+static size_t enc_size[NBUF];
+
+// Get monotonic time in seconds
+static double get_tm() {
+    // Definitions and initializations:
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC,&ts);
+
+    return ts.tv_sec + ts.tv_nsec/1e9;
+}
+
+int main(int argc, char const *argv[]) {
+    // Definitions and initializations:
+    uint32_t nread = NREAD_DFLT; // Number of reads
+    double   nois = 4;           // Noise amplitude in counts
+    uint32_t i;                  // Counter
+    uint32_t j;                  // Counter
+    int16_t  cnt;                // Count
+    size_t   chk = 0;            // Sum of sizes (keeps codec from being
+                                 // optimized away)
+    size_t   enc_tot = 0;        // Encoded octets
+    double   tm_strt;            // Start time
+    double   tm_enc;             // Encode time per read
+    double   tm_dec;             // Decode time per read
+    uint32_t nscan_raw;          // Scans per packet (raw)
+    uint32_t nscan_enc;          // Scans per packet (encoded)
+
+    char dec_buf[READ_SIZE]; // Decoded read
+
+    // Get number of reads and noise amplitude:
+    if (argc > 1) {
+        nread = strtoul(argv[1],NULL,0);
+    }
+    if (argc > 2) {
+        nois = strtod(argv[2],NULL);
+    }
+
+    // Populate read buffers (field of about 20000 nT on every channel,
+    // slowly turning, plus noise):
+    srand(1);
+    for (i = 0; i < NBUF; ++i) {
+        for (j = 0; j < READ_NSCAN*MDQ_CDC_NCHNL; ++j) {
+            cnt = (int16_t) (6554*sin(0.001*(i*READ_NSCAN+j/3)+j%3) + \
+                nois*(2.0*rand()/RAND_MAX-1));
+            read_buf[i][2*j]   = (char) cnt;
+            read_buf[i][2*j+1] = (char) ((uint16_t) cnt >> 8);
+        }
+    }
+
+    // Check round trip:
+    for (i = 0; i < NBUF; ++i) {
+        enc_size[i] = enc_mdq_cdc(read_buf[i],READ_NSCAN,enc_buf[i],\
+            READ_SIZE);
+        if ((enc_size[i] == 0) || (dec_mdq_cdc(enc_buf[i],enc_size[i],\
+            dec_buf,READ_SIZE) != READ_SIZE) || \
+            (memcmp(dec_buf,read_buf[i],READ_SIZE) != 0)) {
+            printf("<ERROR> Round trip mismatch (read %u)\n",i);
+            return 1;
+        }
+        enc_tot += enc_size[i];
+    }
+
+    // Check short reads and fallback on random counts:
+    for (j = 1; j < READ_NSCAN; ++j) {
+        i = enc_mdq_cdc(read_buf[0],j,enc_buf[0],READ_SIZE);
+        if ((i != 0) && ((dec_mdq_cdc(enc_buf[0],i,dec_buf,READ_SIZE) != \
+            (int32_t) j*MDQ_CDC_SCAN_SIZE) || \
+            (memcmp(dec_buf,read_buf[0],j*MDQ_CDC_SCAN_SIZE) != 0))) {
+            printf("<ERROR> Round trip mismatch (%u scans)\n",j);
+            return 1;
+        }
+    }
+    for (j = 0; j < READ_SIZE; ++j) {
+        dec_buf[j] = (char) rand();
+    }
+    if (enc_mdq_cdc(dec_buf,READ_NSCAN,enc_buf[0],READ_SIZE) != 0) {
+        printf("<ERROR> Random read was not left raw\n");
+        return 1;
+    }
+    enc_mdq_cdc(read_buf[0],READ_NSCAN,enc_buf[0],READ_SIZE);
+
+    // Encode:
+    tm_strt = get_tm();
+    for (i = 0; i < nread; ++i) {
+        chk += enc_mdq_cdc(read_buf[i % NBUF],READ_NSCAN,\
+            enc_buf[i % NBUF],READ_SIZE);
+    }
+    tm_enc = (get_tm() - tm_strt)/nread;
+
+    // Decode:
+    tm_strt = get_tm();
+    for (i = 0; i < nread; ++i) {
+        chk += dec_mdq_cdc(enc_buf[i % NBUF],enc_size[i % NBUF],dec_buf,\
+            READ_SIZE);
+    }
+    tm_dec = (get_tm() - tm_strt)/nread;
+
+    // Get scans per packet (raw reads are split on scans, encoded reads on
+    // blocks; a packet holds about two sub-headers):
+    nscan_raw = (USR_DAT_SIZE-SUB_HDR_SIZE)/MDQ_CDC_SCAN_SIZE;
+    nscan_enc = (USR_DAT_SIZE-2*SUB_HDR_SIZE)/\
+        (enc_tot/NBUF/(READ_NSCAN/MDQ_CDC_BLK_NSCAN))*MDQ_CDC_BLK_NSCAN;
+
+    // Print:
+    printf("SIMD         : %s\n",
+#ifdef __SSE2__
+        "SSE2");
+#else
+        "none (scalar)");
+#endif
+    printf("Read size    : %d octets raw, %.1f octets encoded (%.2fx)\n",\
+        READ_SIZE,(double) enc_tot/NBUF,(double) READ_SIZE*NBUF/enc_tot);
+    printf("Encode       : %8.1f ns/read (%7.1f MB/s)\n",tm_enc*1e9,\
+        READ_SIZE/tm_enc/1e6);
+    printf("Decode       : %8.1f ns/read (%7.1f MB/s)\n",tm_dec*1e9,\
+        READ_SIZE/tm_dec/1e6);
+    printf("Scans/packet : %u raw, %u encoded (%.2fx)\n",nscan_raw,\
+        nscan_enc,(double) nscan_enc/nscan_raw);
+    printf("Checksum: %zu\n",chk);
+
+    return 0;
+}
@@ -0,0 +1,94 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// CCSDS Attached Sync Marker
+//
+// Header-only attached sync marker (ASM) shared by flight software (downlink
+// transmitter), ground control backend (downlink receiver), and the
+// SGS/simulated IEU test. Every downlinked telemetry packet is preceded by
+// the 4 octet marker 0x1ACFFC1D so the receiver can find packet boundaries
+// in the byte stream and relock after lost or corrupted bytes:
+//
+//     | ASM (0x1ACFFC1D) | Telemetry Packet | ASM (0x1ACFFC1D) | ...
+//
+// The marker search compares 16 stream positions at a time against the first
+// two marker octets with SSE2 and only checks the full marker at candidate
+// positions. Hosts without SSE2 use the scalar search.
+//
+// -------------------------------------------------------------------------- /
+//
+// agent
+// Project HEPCATS
+// Subsystem: C&DH
+// Created: October 17, 2026
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Standard libraries:
+#include <stdint.h> // Integer types
+#include <stddef.h> // Standard definitions (size_t)
+#include <string.h> // String function definitions
+
+#ifdef __SSE2__
+#include <emmintrin.h> // SSE2 intrinsics
+#endif
+
+// Macro definitions:
+#define CCSDS_ASM      0x1ACFFC1D // Attached sync marker
+#define CCSDS_ASM_SIZE 4          // Attached sync marker size in octets
+
+// Attached sync marker octets (transmission order):
+static const uint8_t ccsds_asm[CCSDS_ASM_SIZE] = {0x1A,0xCF,0xFC,0x1D};
+
+// Find attached sync marker (scalar; returns offset of the first marker, or
+// len if there is no complete marker in buf)
+static inline size_t find_ccsds_asm_sclr(const char* buf, size_t len) {
+    // Definitions and initializations:
+    size_t i;
+
+    // Loop over stream positions:
+    for (i = 0; i+CCSDS_ASM_SIZE <= len; ++i) {
+        if (((uint8_t) buf[i] == ccsds_asm[0]) && \
+            (memcmp(buf+i,ccsds_asm,CCSDS_ASM_SIZE) == 0)) {
+            return i;
+        }
+    }
+
+    return len;
+}
+
+// Find attached sync marker (returns offset of the first marker, or len if
+// there is no complete marker in buf)
+static inline size_t find_ccsds_asm(const char* buf, size_t len) {
+    // Definitions and initializations:
+    size_t i = 0;
+
+#ifdef __SSE2__
+    uint32_t m; // Candidate positions (bitmask)
+    uint32_t j; // Candidate position in block
+
+    const __m128i asm0 = _mm_set1_epi8((char) ccsds_asm[0]);
+    const __m128i asm1 = _mm_set1_epi8((char) ccsds_asm[1]);
+
+    // Loop over blocks of 16 positions (full marker fits at every position):
+    for (; i+16+CCSDS_ASM_SIZE-1 <= len; i += 16) {
+        // Get positions matching the first two marker octets:
+        m = _mm_movemask_epi8(_mm_cmpeq_epi8(asm0,\
+                _mm_loadu_si128((const __m128i*) (buf+i)))) & \
+            _mm_movemask_epi8(_mm_cmpeq_epi8(asm1,\
+                _mm_loadu_si128((const __m128i*) (buf+i+1))));
+
+        // Check full marker at candidate positions:
+        while (m != 0) {
+            j = __builtin_ctz(m);
+            m &= m-1;
+
+            if (memcmp(buf+i+j,ccsds_asm,CCSDS_ASM_SIZE) == 0) {
+                return i+j;
+            }
+        }
+    }
+#endif
+
+    // Search remaining positions:
+    return i+find_ccsds_asm_sclr(buf+i,len-i);
+}
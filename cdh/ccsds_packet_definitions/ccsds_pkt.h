@@ -0,0 +1,259 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// CCSDS Packet Codec
+//
+// Header-only encode and decode of CCSDS space packet headers shared by
+// flight software, ground control backend, and the SGS/simulated IEU test.
+// Fields are packed explicitly in big-endian (network) octet order with
+// shifts and masks so the wire layout does not depend on compiler bitfield
+// allocation or host endianness. Every function is branch-free.
+//
+// Packet layout (octet offsets from start of packet):
+//
+//     0  |  Primary Header (6 octets)
+//        |    Version (3) | Type (1) | Sec Hdr Flag (1) | APID (11)
+//        |    Grouping Flags (2) | Sequence Count / Packet Name (14)
+//        |    Packet Length (16) ("C" = octets in packet data field - 1)
+//     6  |  Secondary Header (8 octets)
+//        |    T-Field Seconds (32) | T-Field Fraction (16) | Void (8)
+//        |    P-Field: Ext (1) | I.D. (3) | Basic Octets - 1 (2) |
+//        |             Fraction Octets (2)
+//    14  |  User / Application Data (variable length)
+//        |    (telecommand: ATC Flag (1) | Command Argument (31))
+//   ...  |  Packet Error Control (16) (immediately after user data)
+//
+// Field positions are given by the shift and mask table below; encoders and
+// decoders are built from that table only.
+//
+// The T-field is a CCSDS unsegmented time code (CUC) as declared by the
+// P-field: 4 octets of seconds since the Unix epoch (agency-defined epoch)
+// and 2 octets of binary fraction of a second (1/65536 sec, ~15.3 usec).
+// Helpers convert the fraction to and from milliseconds and nanoseconds.
+//
+// -------------------------------------------------------------------------- /
+//
+// agent
+// Project HEPCATS
+// Subsystem: C&DH
+// Created: October 17, 2026
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Standard libraries:
+#include <stdint.h> // Integer types
+
+// Macro definitions (sizes in octets):
+#define CCSDS_PRI_HDR_SIZE  6 // Primary header
+#define CCSDS_SEC_HDR_SIZE  8 // Secondary header
+#define CCSDS_HDR_SIZE     14 // Primary and secondary header
+#define CCSDS_APP_DAT_SIZE  4 // Telecommand application data
+#define CCSDS_ERR_CNT_SIZE  2 // Packet error control
+#define CCSDS_TLM_DAT_MAX 1064 // Telemetry user data (maximum)
+#define CCSDS_TLM_PKT_MAX 1080 // Telemetry packet (maximum)
+
+// Macro definitions (packet length field, "C" = octets in packet data field
+// - 1, for a packet with dat_size octets of user/application data):
+#define CCSDS_PKT_LEN(dat_size) \
+    (CCSDS_SEC_HDR_SIZE+(dat_size)+CCSDS_ERR_CNT_SIZE-1)
+
+// Macro definitions (field values):
+#define CCSDS_VRS           0 // "000" (version 1)
+#define CCSDS_TYP_TLM       0 // "0"   (telemetry packet)
+#define CCSDS_TYP_TELECMD   1 // "1"   (telecommand packet)
+#define CCSDS_T_FLD_VOID 0xFF // "11111111"
+#define CCSDS_P_FLD      0x2E // "0 010 11 10" (no extension, time code I.D.,
+                              // 4 basic octets, 2 fractional octets)
+#define CCSDS_CUC_FRC_SHFT  16 // CUC fraction bits (2 fractional octets)
+
+// Macro definitions (field shift and mask table):
+// Primary header word 0 (packet I.D.):
+#define CCSDS_VRS_SHFT        13
+#define CCSDS_VRS_MASK    0x0007
+#define CCSDS_TYP_SHFT        12
+#define CCSDS_TYP_MASK    0x0001
+#define CCSDS_SHF_SHFT        11
+#define CCSDS_SHF_MASK    0x0001
+#define CCSDS_APID_SHFT        0
+#define CCSDS_APID_MASK   0x07FF
+// Primary header word 1 (packet sequence control):
+#define CCSDS_GRP_SHFT        14
+#define CCSDS_GRP_MASK    0x0003
+#define CCSDS_SEQ_SHFT         0
+#define CCSDS_SEQ_MASK    0x3FFF
+// Secondary header P-field octet:
+#define CCSDS_P_EXT_SHFT       7
+#define CCSDS_P_EXT_MASK    0x01
+#define CCSDS_P_ID_SHFT        4
+#define CCSDS_P_ID_MASK     0x07
+#define CCSDS_P_BAS_SHFT       2
+#define CCSDS_P_BAS_MASK    0x03
+#define CCSDS_P_FRC_SHFT       0
+#define CCSDS_P_FRC_MASK    0x03
+// Telecommand application data word:
+#define CCSDS_ATC_SHFT        31
+#define CCSDS_ATC_MASK  0x00000001
+#define CCSDS_ARG_SHFT         0
+#define CCSDS_ARG_MASK  0x7FFFFFFF
+
+// Primary header structure (decoded values):
+struct ccsds_pri_hdr {
+    uint8_t  vrs;         // Version
+    uint8_t  typ;         // Type
+    uint8_t  sec_hdr_flg; // Secondary header flag
+    uint16_t apid;        // Application I.D.
+    uint8_t  grp_flg;     // Grouping flag
+    uint16_t seq_cnt;     // Sequence count (telecommand: packet name)
+    uint16_t pkt_len;     // Packet length (octets in packet data field - 1)
+};
+
+// Secondary header structure (decoded values):
+struct ccsds_sec_hdr {
+    uint32_t t_sec;  // T-field seconds (Unix timestamp)
+    uint16_t t_frc;  // T-field fraction (1/65536 sec)
+    uint8_t  p_ext;  // P-field extension
+    uint8_t  p_id;   // P-field I.D.
+    uint8_t  p_bas;  // P-field basic time size (in octets - 1)
+    uint8_t  p_frc;  // P-field fractional time size (in octets)
+};
+
+// Write 16 bit value big-endian
+static inline void put_be16(char* buf, uint16_t val) {
+    buf[0] = (char) (val >> 8);
+    buf[1] = (char) (val);
+}
+
+// Write 32 bit value big-endian
+static inline void put_be32(char* buf, uint32_t val) {
+    buf[0] = (char) (val >> 24);
+    buf[1] = (char) (val >> 16);
+    buf[2] = (char) (val >> 8);
+    buf[3] = (char) (val);
+}
+
+// Read 16 bit big-endian value
+static inline uint16_t get_be16(const char* buf) {
+    const uint8_t* p = (const uint8_t*) buf;
+
+    return (uint16_t) ((p[0] << 8) | p[1]);
+}
+
+// Read 32 bit big-endian value
+static inline uint32_t get_be32(const char* buf) {
+    const uint8_t* p = (const uint8_t*) buf;
+
+    return ((uint32_t) p[0] << 24) | ((uint32_t) p[1] << 16) | \
+        ((uint32_t) p[2] << 8) | (uint32_t) p[3];
+}
+
+// Encode primary header into first 6 octets of packet
+static inline void enc_ccsds_pri_hdr(char* pkt_buf,
+    const struct ccsds_pri_hdr* pri_hdr) {
+    // Packet I.D.:
+    put_be16(pkt_buf+0,\
+        ((pri_hdr->vrs & CCSDS_VRS_MASK) << CCSDS_VRS_SHFT) | \
+        ((pri_hdr->typ & CCSDS_TYP_MASK) << CCSDS_TYP_SHFT) | \
+        ((pri_hdr->sec_hdr_flg & CCSDS_SHF_MASK) << CCSDS_SHF_SHFT) | \
+        ((pri_hdr->apid & CCSDS_APID_MASK) << CCSDS_APID_SHFT));
+
+    // Packet Sequence Control:
+    put_be16(pkt_buf+2,\
+        ((pri_hdr->grp_flg & CCSDS_GRP_MASK) << CCSDS_GRP_SHFT) | \
+        ((pri_hdr->seq_cnt & CCSDS_SEQ_MASK) << CCSDS_SEQ_SHFT));
+
+    // Packet Length:
+    put_be16(pkt_buf+4,pri_hdr->pkt_len);
+}
+
+// Decode primary header from first 6 octets of packet
+static inline void dec_ccsds_pri_hdr(const char* pkt_buf,
+    struct ccsds_pri_hdr* pri_hdr) {
+    // Definitions and initializations:
+    uint16_t pkt_id      = get_be16(pkt_buf+0); // Packet I.D.
+    uint16_t pkt_seq_cnt = get_be16(pkt_buf+2); // Packet sequence control
+
+    // Packet I.D.:
+    pri_hdr->vrs         = (pkt_id >> CCSDS_VRS_SHFT) & CCSDS_VRS_MASK;
+    pri_hdr->typ         = (pkt_id >> CCSDS_TYP_SHFT) & CCSDS_TYP_MASK;
+    pri_hdr->sec_hdr_flg = (pkt_id >> CCSDS_SHF_SHFT) & CCSDS_SHF_MASK;
+    pri_hdr->apid        = (pkt_id >> CCSDS_APID_SHFT) & CCSDS_APID_MASK;
+
+    // Packet Sequence Control:
+    pri_hdr->grp_flg = (pkt_seq_cnt >> CCSDS_GRP_SHFT) & CCSDS_GRP_MASK;
+    pri_hdr->seq_cnt = (pkt_seq_cnt >> CCSDS_SEQ_SHFT) & CCSDS_SEQ_MASK;
+
+    // Packet Length:
+    pri_hdr->pkt_len = get_be16(pkt_buf+4);
+}
+
+// Get total packet size in octets from packet length field
+static inline uint16_t get_ccsds_pkt_size(const char* pkt_buf) {
+    return CCSDS_PRI_HDR_SIZE + get_be16(pkt_buf+4) + 1;
+}
+
+// Convert milliseconds to CUC fraction (rounded)
+static inline uint16_t ccsds_msec_to_frc(uint16_t msec) {
+    return (uint16_t) ((((uint32_t) msec << CCSDS_CUC_FRC_SHFT)+500)/1000);
+}
+
+// Convert CUC fraction to milliseconds (rounded)
+static inline uint16_t ccsds_frc_to_msec(uint16_t frc) {
+    return (uint16_t) (((uint32_t) frc*1000+(1 << (CCSDS_CUC_FRC_SHFT-1))) \
+        >> CCSDS_CUC_FRC_SHFT);
+}
+
+// Convert nanoseconds (less than one second) to CUC fraction (truncated)
+static inline uint16_t ccsds_nsec_to_frc(uint32_t nsec) {
+    return (uint16_t) (((uint64_t) nsec << CCSDS_CUC_FRC_SHFT)/1000000000);
+}
+
+// Encode CUC time code (seconds and fraction) into 6 octets
+static inline void enc_ccsds_cuc(char* buf, uint32_t t_sec, uint16_t t_frc) {
+    put_be32(buf+0,t_sec);
+    put_be16(buf+4,t_frc);
+}
+
+// Encode secondary header (T-field and fixed P-field) into octets 6-13
+static inline void enc_ccsds_sec_hdr(char* pkt_buf, uint32_t t_sec,
+    uint16_t t_frc) {
+    // T-field:
+    enc_ccsds_cuc(pkt_buf+6,t_sec,t_frc);
+    pkt_buf[12] = (char) CCSDS_T_FLD_VOID;
+
+    // P-field:
+    pkt_buf[13] = (char) CCSDS_P_FLD;
+}
+
+// Decode secondary header from octets 6-13
+static inline void dec_ccsds_sec_hdr(const char* pkt_buf,
+    struct ccsds_sec_hdr* sec_hdr) {
+    // Definitions and initializations:
+    uint8_t p_fld = (uint8_t) pkt_buf[13]; // P-field
+
+    // T-field:
+    sec_hdr->t_sec  = get_be32(pkt_buf+6);
+    sec_hdr->t_frc  = get_be16(pkt_buf+10);
+
+    // P-field:
+    sec_hdr->p_ext = (p_fld >> CCSDS_P_EXT_SHFT) & CCSDS_P_EXT_MASK;
+    sec_hdr->p_id  = (p_fld >> CCSDS_P_ID_SHFT) & CCSDS_P_ID_MASK;
+    sec_hdr->p_bas = (p_fld >> CCSDS_P_BAS_SHFT) & CCSDS_P_BAS_MASK;
+    sec_hdr->p_frc = (p_fld >> CCSDS_P_FRC_SHFT) & CCSDS_P_FRC_MASK;
+}
+
+// Encode telecommand application data into octets 14-17
+static inline void enc_ccsds_app_dat(char* pkt_buf, uint8_t atc_flg,
+    uint32_t cmd_arg) {
+    put_be32(pkt_buf+CCSDS_HDR_SIZE,\
+        (((uint32_t) atc_flg & CCSDS_ATC_MASK) << CCSDS_ATC_SHFT) | \
+        ((cmd_arg & CCSDS_ARG_MASK) << CCSDS_ARG_SHFT));
+}
+
+// Decode telecommand application data from octets 14-17
+static inline void dec_ccsds_app_dat(const char* pkt_buf, uint8_t* atc_flg,
+    uint32_t* cmd_arg) {
+    // Definitions and initializations:
+    uint32_t app_dat = get_be32(pkt_buf+CCSDS_HDR_SIZE); // Application data
+
+    *atc_flg = (app_dat >> CCSDS_ATC_SHFT) & CCSDS_ATC_MASK;
+    *cmd_arg = (app_dat >> CCSDS_ARG_SHFT) & CCSDS_ARG_MASK;
+}
@@ -0,0 +1,272 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Magnetometer DAQ Codec
+//
+// Header-only lossless codec for magnetometer DAQ reads shared by flight
+// software (encoder, read_mdq) and ground control backend (decoder,
+// proc_tlm_pkt). A read is a run of scans of channels 0, 1, and 2, each
+// channel a little-endian 16 bit count. Consecutive counts of a channel are
+// close, so the codec sends the difference to the previous count of the same
+// channel, zigzag mapped to an unsigned value (0, -1, 1, -2, ... -> 0, 1, 2,
+// 3, ...) and packed with the fewest bits that hold every value of the
+// channel in a block of scans. Differences are taken modulo 2^16, so no count
+// needs more than 16 bits.
+//
+// An encoded read is a run of blocks of up to MDQ_CDC_BLK_NSCAN scans. Every
+// block carries its own scan count and first counts, so any run of whole
+// blocks decodes on its own (encoded reads are split on block boundaries
+// when aggregated).
+//
+// Block layout (big-endian, bits packed most significant first):
+//
+//     0  |  Scan Count (8)
+//     1  |  First Count Channel 0 (16) | Channel 1 (16) | Channel 2 (16)
+//     7  |  Bit Width Channel 0 (8) | Channel 1 (8) | Channel 2 (8)
+//    10  |  Zigzag Differences Channel 0 (scans-1 values) | Channel 1 |
+//           Channel 2 | (zero padding to octet)
+//
+// Differences and the zigzag mapping are computed 8 counts at a time with
+// SSE2 straight from the read (SSE2 hosts are little-endian); other hosts use
+// the scalar loop. Encoded reads are flagged in the aggregated telemetry
+// sub-header (agg_tlm_pkt.h).
+//
+// -------------------------------------------------------------------------- /
+//
+// agent
+// Project HEPCATS
+// Subsystem: C&DH
+// Created: October 17, 2026
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Standard libraries:
+#include <stdint.h> // Integer types
+#include <stddef.h> // Standard definitions (size_t)
+
+#ifdef __SSE2__
+#include <emmintrin.h> // SSE2 intrinsics
+#endif
+
+// Macro definitions:
+#define MDQ_CDC_NCHNL         3 // Channels per scan
+#define MDQ_CDC_SCAN_SIZE     6 // Scan size in octets
+#define MDQ_CDC_BLK_NSCAN    32 // Scans per block (maximum)
+#define MDQ_CDC_BLK_HDR_SIZE 10 // Block header size in octets
+#define MDQ_CDC_WDTH_MAX     16 // Largest bit width
+
+// Get count n of read (little-endian)
+static inline uint16_t get_mdq_cdc_cnt(const uint8_t* p, size_t n) {
+    return (uint16_t) (p[2*n] | (p[2*n+1] << 8));
+}
+
+// Get zigzag mapped differences of n interleaved counts of a read (counts of
+// the first scan are not differenced and left out)
+static inline void calc_mdq_cdc_zz(const char* raw, uint16_t* zz,
+    size_t n) {
+    // Definitions and initializations:
+    const uint8_t* p = (const uint8_t*) raw;
+
+    size_t   i = MDQ_CDC_NCHNL;
+    uint16_t d; // Difference
+
+#ifdef __SSE2__
+    __m128i v; // Differences of 8 counts
+
+    // Loop over 8 counts at a time:
+    for (; i+8 <= n; i += 8) {
+        v = _mm_sub_epi16(_mm_loadu_si128((const __m128i*) (p+2*i)),\
+            _mm_loadu_si128((const __m128i*) (p+2*(i-MDQ_CDC_NCHNL))));
+        v = _mm_xor_si128(_mm_slli_epi16(v,1),_mm_srai_epi16(v,15));
+        _mm_storeu_si128((__m128i*) (zz+i-MDQ_CDC_NCHNL),v);
+    }
+#endif
+
+    // Remaining counts:
+    for (; i < n; ++i) {
+        d = (uint16_t) (get_mdq_cdc_cnt(p,i)-\
+            get_mdq_cdc_cnt(p,i-MDQ_CDC_NCHNL));
+        zz[i-MDQ_CDC_NCHNL] = (uint16_t) ((d << 1) ^ (0-(d >> 15)));
+    }
+}
+
+// Encode magnetometer DAQ read (returns encoded size in octets, or 0 if the
+// encoded read would not be smaller than the raw read or enc_max)
+static inline size_t enc_mdq_cdc(const char* raw, uint16_t nscan, char* enc,
+    size_t enc_max) {
+    // Definitions and initializations:
+    const uint8_t* p = (const uint8_t*) raw;
+
+    size_t   enc_lim = (size_t) nscan*MDQ_CDC_SCAN_SIZE; // Size limit
+    size_t   n = 0;        // Octets encoded
+    size_t   blk_size;     // Block size in octets
+    uint16_t scan;         // First scan of block
+    uint16_t nb;           // Scans in block
+    uint16_t i;
+    uint8_t  c;            // Channel
+    uint8_t  wdth[MDQ_CDC_NCHNL]; // Bit widths
+    uint16_t msk;          // OR of channel values
+    uint32_t acc;          // Bit accumulator
+    uint8_t  nacc;         // Bits in accumulator
+
+    uint16_t zz[(MDQ_CDC_BLK_NSCAN-1)*MDQ_CDC_NCHNL]; // Zigzag differences
+
+    // Check limit:
+    if (enc_max < enc_lim) {
+        enc_lim = enc_max;
+    }
+
+    // Loop over blocks:
+    for (scan = 0; scan < nscan; scan += nb) {
+        nb = nscan-scan;
+        if (nb > MDQ_CDC_BLK_NSCAN) {
+            nb = MDQ_CDC_BLK_NSCAN;
+        }
+
+        // Get zigzag differences:
+        calc_mdq_cdc_zz(raw+scan*MDQ_CDC_SCAN_SIZE,zz,\
+            (size_t) nb*MDQ_CDC_NCHNL);
+
+        // Get bit width of every channel:
+        for (c = 0; c < MDQ_CDC_NCHNL; ++c) {
+            msk = 0;
+            for (i = c; i < (nb-1)*MDQ_CDC_NCHNL; i += MDQ_CDC_NCHNL) {
+                msk |= zz[i];
+            }
+            for (wdth[c] = 0; (msk >> wdth[c]) != 0; ++wdth[c]);
+        }
+
+        // Check block fits:
+        blk_size = MDQ_CDC_BLK_HDR_SIZE+((size_t) (nb-1)*\
+            (wdth[0]+wdth[1]+wdth[2])+7)/8;
+        if (n+blk_size >= enc_lim) {
+            return 0;
+        }
+
+        // Encode block header:
+        enc[n] = (char) nb;
+        for (c = 0; c < MDQ_CDC_NCHNL; ++c) {
+            i = get_mdq_cdc_cnt(p,(size_t) scan*MDQ_CDC_NCHNL+c);
+            enc[n+1+2*c] = (char) (i >> 8);
+            enc[n+2+2*c] = (char) (i);
+            enc[n+7+c]   = (char) wdth[c];
+        }
+        n += MDQ_CDC_BLK_HDR_SIZE;
+
+        // Pack zigzag differences:
+        acc = 0;
+        nacc = 0;
+        for (c = 0; c < MDQ_CDC_NCHNL; ++c) {
+            for (i = c; i < (nb-1)*MDQ_CDC_NCHNL; i += MDQ_CDC_NCHNL) {
+                acc = (acc << wdth[c]) | zz[i];
+                nacc += wdth[c];
+                while (nacc >= 8) {
+                    nacc -= 8;
+                    enc[n++] = (char) (acc >> nacc);
+                }
+            }
+        }
+        if (nacc > 0) {
+            enc[n++] = (char) (acc << (8-nacc));
+        }
+    }
+
+    return n;
+}
+
+// Get size of encoded block (returns size in octets, or 0 if the block is
+// malformed or longer than size)
+static inline size_t get_mdq_cdc_blk_size(const char* blk, size_t size) {
+    // Definitions and initializations:
+    const uint8_t* p = (const uint8_t*) blk;
+
+    size_t  nbit = 0; // Packed bits
+    uint8_t c;        // Channel
+
+    // Check header:
+    if ((size < MDQ_CDC_BLK_HDR_SIZE) || (p[0] == 0) || \
+        (p[0] > MDQ_CDC_BLK_NSCAN)) {
+        return 0;
+    }
+
+    // Get packed bits:
+    for (c = 0; c < MDQ_CDC_NCHNL; ++c) {
+        if (p[7+c] > MDQ_CDC_WDTH_MAX) {
+            return 0;
+        }
+        nbit += (size_t) (p[0]-1)*p[7+c];
+    }
+
+    // Check size:
+    if (MDQ_CDC_BLK_HDR_SIZE+(nbit+7)/8 > size) {
+        return 0;
+    }
+
+    return MDQ_CDC_BLK_HDR_SIZE+(nbit+7)/8;
+}
+
+// Decode magnetometer DAQ read (returns raw size in octets, or -1 if the
+// encoded read is malformed or does not fit in raw_max)
+static inline int32_t dec_mdq_cdc(const char* enc, size_t enc_size, char* raw,
+    size_t raw_max) {
+    // Definitions and initializations:
+    const uint8_t* p = (const uint8_t*) enc;
+
+    size_t   n = 0;    // Octets decoded
+    size_t   m = 0;    // Raw octets written
+    size_t   blk_size; // Block size in octets
+    size_t   q;        // Packed octet index
+    uint8_t  nb;       // Scans in block
+    uint8_t  i;
+    uint8_t  c;        // Channel
+    uint8_t  wdth;     // Bit width
+    uint16_t cnt;      // Count
+    uint16_t zz;       // Zigzag difference
+    uint32_t acc;      // Bit accumulator
+    uint8_t  nacc;     // Bits in accumulator
+    char*    dst;      // Count destination
+
+    // Loop over blocks:
+    while (n < enc_size) {
+        // Get and check block size:
+        blk_size = get_mdq_cdc_blk_size(enc+n,enc_size-n);
+        if (blk_size == 0) {
+            return -1;
+        }
+        nb = p[n];
+        if (m+(size_t) nb*MDQ_CDC_SCAN_SIZE > raw_max) {
+            return -1;
+        }
+
+        // Unpack channels:
+        q = n+MDQ_CDC_BLK_HDR_SIZE;
+        acc = 0;
+        nacc = 0;
+        for (c = 0; c < MDQ_CDC_NCHNL; ++c) {
+            cnt = (uint16_t) ((p[n+1+2*c] << 8) | p[n+2+2*c]);
+            wdth = p[n+7+c];
+
+            for (i = 0; i < nb; ++i) {
+                // Read zigzag difference and undo mapping and difference:
+                if (i > 0) {
+                    while (nacc < wdth) {
+                        acc = (acc << 8) | p[q++];
+                        nacc += 8;
+                    }
+                    nacc -= wdth;
+                    zz = (uint16_t) ((acc >> nacc) & ((1u << wdth)-1));
+                    cnt = (uint16_t) (cnt+((zz >> 1) ^ (0-(zz & 1))));
+                }
+
+                // Write count (little-endian):
+                dst = raw+m+(size_t) i*MDQ_CDC_SCAN_SIZE+2*c;
+                dst[0] = (char) cnt;
+                dst[1] = (char) (cnt >> 8);
+            }
+        }
+
+        n += blk_size;
+        m += (size_t) nb*MDQ_CDC_SCAN_SIZE;
+    }
+
+    return (int32_t) m;
+}
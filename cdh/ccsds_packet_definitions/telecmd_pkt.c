@@ -23,79 +23,45 @@
 // Standard libraries:
 #include <stdint.h>  // Standard integer types
 
-// Packet header structure:
-struct pkt_hdr {
-    // Packet I.D.:
-    unsigned int pkt_id_vrs:          3;  //  3 bits
-    unsigned int pkt_id_typ:          1;  //  1 bit
-    unsigned int pkt_id_sec_hdr_flg:  1;  //  1 bit
-    unsigned int pkt_id_apid:        11;  // 11 bits
-
-    // Packet Sequence Control:
-    unsigned int pkt_seq_cnt_grp_flg:   2;  //  2 bits
-    unsigned int pkt_seq_cnt_pkt_name: 14;  // 14 bits
-
-    // Packet Length:
-    uint16_t pkt_len; 
-};
-
-// Packet data field structure:
-struct pkt_dat_fld {
-    // Packet Secondary Header:
-    uint32_t pkt_sec_hdr_t_sec;          //  32 bits
-    uint16_t pkt_sec_hdr_t_msec;         //  16 bits
-    uint8_t  pkt_sec_hdr_t_void;         //  8 bits
-    unsigned int pkt_sec_hdr_p_ext:   1; //  1 bit
-    unsigned int pkt_sec_hdr_p_id:    3; //  3 bits
-    unsigned int pkt_sec_hdr_p_bas:   2; //  2 bit
-    unsigned int pkt_sec_hdr_p_frc:   2; //  2 bits
-
-    // Packet User (Application) Data Field:
-    unsigned int pkt_app_dat_atc_flg:  1;  // 1 bit
-    unsigned int pkt_app_dat_cmd_args: 31; // 31 bits
-
-    // Packet Error Control:
-    uint16_t pkt_err_cnt;
-};
+// Header files:
+#include "ccsds_pkt.h" // CCSDS packet codec
+#include "ccsds_crc.h" // CCSDS packet error control (CRC)
 
 void main(int argc, char const *argv[]) {
-    // Define packet structure:
-    struct pkt_hdr pkt_hdr;
-    struct pkt_dat_fld pkt_dat_fld;
+    // Define packet buffer and header:
+    char pkt_buf[20];
+    struct ccsds_pri_hdr pri_hdr;
 
     // Populate packet I.D. fields:
-    pkt_hdr.pkt_id_vrs = 0;         // "000"         (always)
-    pkt_hdr.pkt_id_typ = 1;         // "0"           (telecommand packet)
-    pkt_hdr.pkt_id_sec_hdr_flg = 0; // "0"           (idle packet)
-    pkt_hdr.pkt_id_apid = 0xFF;     // "11111111111" (idle packet APID)
+    pri_hdr.vrs         = CCSDS_VRS;         // "000"         (always)
+    pri_hdr.typ         = CCSDS_TYP_TELECMD; // "1"           (telecommand packet)
+    pri_hdr.sec_hdr_flg = 0;                 // "0"           (idle packet)
+    pri_hdr.apid        = 0x7FF;             // "11111111111" (idle packet APID)
 
-    // Populate packet sequence control fields: 
-    pkt_hdr.pkt_seq_cnt_grp_flg =       3; // "11" (unsegmented data)  
-    pkt_hdr.pkt_seq_cnt_pkt_name = 0x3FFF; // "11111111111111" 
-                                           // (idle packet name)
+    // Populate packet sequence control fields:
+    pri_hdr.grp_flg = 3;      // "11" (unsegmented data)
+    pri_hdr.seq_cnt = 0x3FFF; // "11111111111111"
+                              // (idle packet name)
 
     // Populate packet length field:
-    pkt_hdr.pkt_len = 13; // "C" (Octets in packet data field - 1)
+    pri_hdr.pkt_len = 13; // "C" (Octets in packet data field - 1)
 
-    // Populate packet secondary header T fields:
-    pkt_dat_fld.pkt_sec_hdr_t_sec  = 1547261938; // "1011100001110010101011111110010"
-    pkt_dat_fld.pkt_sec_hdr_t_msec = 824;        // "1100111000"  
-    pkt_dat_fld.pkt_sec_hdr_t_void = 0xFF;       // "11111111"
+    // Encode packet primary header:
+    enc_ccsds_pri_hdr(pkt_buf,&pri_hdr);
 
-    // Populate packet secondary header P fields:
-    pkt_dat_fld.pkt_sec_hdr_p_ext = 0; // "0"   (no extension)
-    pkt_dat_fld.pkt_sec_hdr_p_id =  2; // "010" (time code I.D.)
-    pkt_dat_fld.pkt_sec_hdr_p_bas = 3; // "11"  (Number of octets of the basic
-                                       //        time unit minus one)
-    pkt_dat_fld.pkt_sec_hdr_p_frc = 2; // "10"  (Number of octets of the 
-                                       //        fractional time unit)
+    // Encode packet secondary header (T-field "1011100001110010101011111110010"
+    // sec, 824 msec as CUC fraction, "11111111" void; P-field "0 010 11 10"
+    // for no extension, time code I.D., 4 basic octets, and 2 fractional
+    // octets):
+    enc_ccsds_sec_hdr(pkt_buf,1547261938,ccsds_msec_to_frc(824));
 
-    // Populate user data field:
-    pkt_dat_fld.pkt_app_dat_atc_flg  = 0;          // "0" (execute now)
-    pkt_dat_fld.pkt_app_dat_cmd_args = 0x7FFFFFFF; // "1"s (idle command argument)
+    // Populate application data field ("0" execute now, "1"s idle command
+    // argument):
+    enc_ccsds_app_dat(pkt_buf,0,0x7FFFFFFF);
 
-    // Populate packer error control field:
-    pkt_dat_fld.pkt_err_cnt = 0xFFFF; // "1"s (no error detection)
+    // Populate packet error control field with CRC of packet:
+    put_be16(pkt_buf+CCSDS_HDR_SIZE+CCSDS_APP_DAT_SIZE,\
+        calc_ccsds_crc(pkt_buf,CCSDS_HDR_SIZE+CCSDS_APP_DAT_SIZE));
 
     return;
 }
@@ -21,80 +21,47 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 // Standard libraries:
-#include <stdint.h>  // Standard time function definitions
+#include <stdint.h>  // Standard integer types
+#include <string.h>  // String function definitions
 
-// Packet header structure:
-struct pkt_hdr {
-    // Packet I.D.:
-    unsigned int pkt_id_vrs:          3;  //  3 bits
-    unsigned int pkt_id_typ:          1;  //  1 bit
-    unsigned int pkt_id_sec_hdr_flg:  1;  //  1 bit
-    unsigned int pkt_id_apid:        11;  // 11 bits
-
-    // Packet Sequence Control:
-    unsigned int pkt_seq_cnt_grp_flg:  2;  //  2 bits
-    unsigned int pkt_seq_cnt_seq_cnt: 14;  // 14 bits
-
-    // Packet Length:
-    uint16_t pkt_len; // 16 bits
-};
-
-// Packet data field structure:
-struct pkt_dat_fld {
-    // Packet Secondary Header:
-    uint32_t pkt_sec_hdr_t_sec;          //  32 bits
-    uint16_t pkt_sec_hdr_t_msec;         //  16 bits
-    uint8_t  pkt_sec_hdr_t_void;         //  8 bits
-    unsigned int pkt_sec_hdr_p_ext:   1; //  1 bit
-    unsigned int pkt_sec_hdr_p_id:    3; //  3 bits
-    unsigned int pkt_sec_hdr_p_bas:   2; //  2 bit
-    unsigned int pkt_sec_hdr_p_frc:   2; //  2 bits
-
-    // Packet User Data Field:
-    uint8_t pkt_usr_dat[1064]; // 1064 bytes
-
-    // Packet Error Control:
-    uint16_t pkt_err_cnt: 16; // 16 bits
-};
+// Header files:
+#include "ccsds_pkt.h" // CCSDS packet codec
+#include "ccsds_crc.h" // CCSDS packet error control (CRC)
 
 void main(int argc, char const *argv[]) {
-    // Define packet structure:
-    struct pkt_hdr pkt_hdr;
-    struct pkt_dat_fld pkt_dat_fld;
+    // Define packet buffer and header:
+    char pkt_buf[1080];
+    struct ccsds_pri_hdr pri_hdr;
 
     // Populate packet I.D. fields:
-    pkt_hdr.pkt_id_vrs =         0;  // "000"          (version 1)
-    pkt_hdr.pkt_id_typ =         0;  // "0"            (telemetry packet)
-    pkt_hdr.pkt_id_sec_hdr_flg = 0;  // "0"            (idle packet)
-    pkt_hdr.pkt_id_apid =     0x7FF; // "11111111111"  (idle packet APID)
+    pri_hdr.vrs         = CCSDS_VRS;     // "000"          (version 1)
+    pri_hdr.typ         = CCSDS_TYP_TLM; // "0"            (telemetry packet)
+    pri_hdr.sec_hdr_flg = 0;             // "0"            (idle packet)
+    pri_hdr.apid        = 0x7FF;         // "11111111111"  (idle packet APID)
 
-    // Populate packet sequence control fields: 
-    pkt_hdr.pkt_seq_cnt_grp_flg = 3; // "11" (unsegmented data)  
-    pkt_hdr.pkt_seq_cnt_seq_cnt = 0; // "00000000000000" 
-                                     // (first packet in count)
+    // Populate packet sequence control fields:
+    pri_hdr.grp_flg = 3; // "11" (unsegmented data)
+    pri_hdr.seq_cnt = 0; // "00000000000000"
+                         // (first packet in count)
 
     // Populate packet length field:
-    pkt_hdr.pkt_len = 1073; // "C" (Octets in packet data field - 1)
+    pri_hdr.pkt_len = 1073; // "C" (Octets in packet data field - 1)
 
-    // Populate packet secondary header T fields:
-    pkt_dat_fld.pkt_sec_hdr_t_sec  = 1547261938; // "1011100001110010101011111110010"
-    pkt_dat_fld.pkt_sec_hdr_t_msec =        824; // "1100111000"  
-    pkt_dat_fld.pkt_sec_hdr_t_void =       0xFF; // "11111111"
+    // Encode packet primary header:
+    enc_ccsds_pri_hdr(pkt_buf,&pri_hdr);
 
-    // Populate packet secondary header P fields:
-    pkt_dat_fld.pkt_sec_hdr_p_ext = 0; // "0"   (no extension)
-    pkt_dat_fld.pkt_sec_hdr_p_id =  2; // "010" (time code I.D.)
-    pkt_dat_fld.pkt_sec_hdr_p_bas = 3; // "11"  (Number of octets of the basic
-                                       //        time unit minus one)
-    pkt_dat_fld.pkt_sec_hdr_p_frc = 2; // "10"  (Number of octets of the 
-                                       //        fractional time unit)
+    // Encode packet secondary header (T-field "1011100001110010101011111110010"
+    // sec, 824 msec as CUC fraction, "11111111" void; P-field "0 010 11 10"
+    // for no extension, time code I.D., 4 basic octets, and 2 fractional
+    // octets):
+    enc_ccsds_sec_hdr(pkt_buf,1547261938,ccsds_msec_to_frc(824));
 
     // Populate user data field:
-    for (int i = 0; i < 1063; ++i)
-        pkt_dat_fld.pkt_usr_dat[i] = 0xFF; // "1"s (idle packet user data)
+    memset(pkt_buf+CCSDS_HDR_SIZE,0xFF,1064); // "1"s (idle packet user data)
 
-    // Populate packer error control field:
-    pkt_dat_fld.pkt_err_cnt = 0xFFFF; // "1"s (no error detection)
+    // Populate packet error control field with CRC of packet:
+    put_be16(pkt_buf+CCSDS_HDR_SIZE+1064,\
+        calc_ccsds_crc(pkt_buf,CCSDS_HDR_SIZE+1064));
 
     // Return:
     return;
@@ -0,0 +1,47 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Aggregate Telemetry Header
+//
+// Telemetry aggregation macro and function declarations
+//
+// Samples are sent to the aggregate telemetry task as messages made of a
+// sample header (APID, creation time seconds, creation time fraction of
+// 1/65536 sec; host order, and encoded flag) followed by the sample. Encoded
+// samples (magnetometer DAQ codec, mdq_cdc.h) are split on codec blocks.
+//
+// Flush deadlines are the longest time the first sample in a packet waits
+// before the packet is sent even if it is not full (latency vs. link
+// efficiency; edit to configure).
+//
+// -------------------------------------------------------------------------- /
+//
+// agent
+// Project HEPCATS
+// Subsystem: C&DH
+// Created: October 17, 2026
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Macro definitions:
+#define AGG_TLM_USR_DAT_SIZE  1064 // Aggregated packet user data size in bytes
+#define AGG_TLM_MSG_HDR_SIZE     9 // Sample message header size in bytes
+#define AGG_TLM_SMPL_MAX \
+    (AGG_TLM_USR_DAT_SIZE-AGG_SUB_HDR_SIZE) // Maximum sample size in bytes
+#define AGG_TLM_MSG_MAX \
+    (AGG_TLM_MSG_HDR_SIZE+AGG_TLM_SMPL_MAX) // Maximum message size in bytes
+#define AGG_TLM_QUEUE_NMSG      16 // Message queue limit
+#define AGG_TLM_QUEUE_POOL_SIZE \
+    (AGG_TLM_QUEUE_NMSG*(AGG_TLM_MSG_MAX+64)) // Message queue pool size in
+                                              // bytes (with allocator
+                                              // overhead)
+
+#define AGG_TLM_HK_REC_SIZE     80 // Housekeeping record size in bytes
+#define AGG_TLM_MDQ_REC_SIZE     6 // Magnetometer DAQ record size in bytes
+                                   // (one scan of channels 0, 1, and 2)
+#define AGG_TLM_HK_DL   5000000000 // Housekeeping flush deadline in ns (5 sec)
+#define AGG_TLM_MDQ_DL  1000000000 // Magnetometer DAQ flush deadline in ns
+                                   // (1 sec)
+
+// Function declarations:
+int32_t send_agg_tlm(char* smpl, size_t smpl_size, uint16_t apid,
+    uint8_t enc_flg); // Send sample to aggregate telemetry task
@@ -0,0 +1,67 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Absolutely Timed Command Schedule Header
+//
+// Onboard schedule of absolutely timed commands (ATC) macro, structure, and
+// function declarations
+//
+// Command transfer frames with ATC flag ATC_SCHED_FLG_ADD are added to the
+// schedule by command scheduler task and sent back to command executor task
+// (ATC flag cleared) at their execution time. A frame with ATC flag
+// ATC_SCHED_FLG_DEL cancels every scheduled command with its APID, packet
+// name, and execution time. Commands with the same execution time are
+// executed in the order they were scheduled.
+//
+// The schedule is a binary min-heap (execution time, then order scheduled)
+// of slots of a fixed slot table, so adding, cancelling, and removing the
+// next command take O(log n) with no allocation. Slots are hashed by
+// execution time (sec) to find commands to cancel. Every slot change is
+// written to its entry of the schedule file (ATC_SCHED_FILE) and synced, so
+// a restart loses no scheduled command and writing one command costs one
+// entry regardless of the schedule size. Commands whose execution time
+// passed more than ATC_SCHED_LATE_SEC before the schedule is loaded are
+// dropped.
+//
+// -------------------------------------------------------------------------- /
+//
+// agent
+// Project HEPCATS
+// Subsystem: C&DH
+// Created: October 17, 2026
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Macro definitions:
+#define ATC_SCHED_FRM_SIZE   15 // Command transfer frame size in bytes
+#define ATC_SCHED_NCMD     4096 // Scheduled commands (maximum)
+#define ATC_SCHED_NBKT     1024 // Execution time hash buckets (power of 2)
+#define ATC_SCHED_LATE_SEC   10 // Lateness of a loaded command before it is
+                                // dropped (sec)
+
+#define ATC_SCHED_FLG_NOW 0 // ATC flag: execute now
+#define ATC_SCHED_FLG_ADD 1 // ATC flag: add to schedule
+#define ATC_SCHED_FLG_DEL 2 // ATC flag: cancel scheduled command
+
+#define ATC_SCHED_FILE "../atc_sched.bin" // Schedule file
+
+// Schedule file entry structure (24 bytes):
+struct atc_sched_ent {
+    uint32_t seq;                     // Order scheduled
+    char     frm[ATC_SCHED_FRM_SIZE]; // Command transfer frame
+    uint8_t  flg;                     // Entry in use flag
+    uint16_t crc;                     // CRC-16 of entry
+    uint16_t rsvd;                    // Reserved (0)
+};
+
+// Function declarations:
+void     init_atc_sched();                 // Load persisted schedule
+int8_t   add_atc_sched(const char* frm);   // Add command (returns 1 or -1
+                                           // if full or late)
+int8_t   del_atc_sched(const char* frm);   // Cancel commands (returns 1 or
+                                           // -1 if none scheduled)
+uint64_t get_atc_sched_tm();               // Get next execution time (ns
+                                           // since epoch; 0: none)
+int8_t   get_atc_sched(char* frm);         // Get next command (returns 1
+                                           // or -1 if none)
+void     pop_atc_sched();                  // Remove next command
+uint16_t get_atc_sched_cnt();              // Get scheduled commands
@@ -2,7 +2,7 @@
 //
 // Create Telemetry Packet Transfer Frame header
 //
-// Create telemetry packet transfer function declaration
+// Create telemetry packet transfer function declarations
 //
 // -------------------------------------------------------------------------- /
 //
@@ -14,7 +14,10 @@
 //
 ///////////////////////////////////////////////////////////////////////////////
 
-// Function declaration:
+// Function declarations:
+uint16_t get_tlm_seq_cnt(uint16_t apid);
 void crt_tlm_pkt_xfr_frm(char* src_dat, size_t src_dat_size,
+    char* tlm_pkt_xfr_frm_buf, uint16_t apid, uint8_t grp_flg);
+void bld_tlm_pkt_xfr_frm(char* src_dat, size_t src_dat_size,
     char* tlm_pkt_xfr_frm_buf, uint16_t apid, uint8_t grp_flg,
-    uint16_t seq_cnt);
\ No newline at end of file
+    uint32_t sec, uint16_t frc);
\ No newline at end of file
@@ -22,9 +22,31 @@
 // itself) to find the column indicies to read to get range and frequency
 // values. This would be flt_tbl_mode*2+1 and flt_tbl_mode*2+2.
 //
-// Update the tables if a mode is changed, removed, or added. Also, check
-// filter table task as this task makes assumptions about how the filter
-// tables are set up.
+// Each table is one destination of the filter table task (TO: transmit
+// telemetry packet task, DS: create file task). Rows may use any APID; frames
+// with an APID found in no table are sent to the default destinations.
+//
+// The tables below are the defaults. A complete definition (up to
+// FLT_TBL_ROW_MAX rows) can be uploaded in flight and persisted
+// (ld_flt_tbl.h); the persisted definition replaces the defaults at startup.
+// Update the tables if a mode is changed, removed, or added. The filter table
+// task compiles the published definition into per-APID routing descriptors
+// (rte_tlm.h) whenever the mode or the definition changes.
+//
+// Frames directed to downlink are also subject to the downlink scheduler.
+// Each downlink class (row of the downlink class table) has a token bucket in
+// bytes. Buckets are refilled from the downlink serial port byte rate in
+// strict priority order (row order: HK, then MDQ, then IMG), each class taking
+// at most its share of the link rate and at most its depth. The decision is
+// made once per payload: on the first (or only) segment, if the class bucket
+// cannot pay for the packet the whole payload is diverted to recording
+// instead; otherwise every segment of the payload is downlinked and charged,
+// going into debt if needed, so a payload never reaches the ground with
+// segments missing. APIDs in no row belong to the last (lowest priority)
+// class. While recorded telemetry is played back, its share of the link rate
+// is taken out of the refill first.
+//
+//     | APID | Share (% of link rate) | Depth (maximum size packets) |
 //
 // -------------------------------------------------------------------------- /
 //
@@ -40,16 +62,40 @@
 #define FLT_TBL_ROW 3  // Filter table TO & DS row size
 #define FLT_TBL_COL 11 // Filter table TO & DS column size
 
-// Telemetry output (TO) table declaration:
-extern uint16_t flt_tbl_to[3][11] = {
+#define FLT_TBL_DST_TO 0 // Telemetry output destination
+#define FLT_TBL_DST_DS 1 // Data storage destination
+#define FLT_TBL_NDST   2 // Number of destinations
+
+#define FLT_TBL_DFLT_MSK \
+    (1 << FLT_TBL_DST_TO) // Default destinations of APIDs in no table
+                          // (downlink only)
+
+// Default telemetry output (TO) table declaration:
+static const uint16_t flt_tbl_to[FLT_TBL_ROW][FLT_TBL_COL] = {
     {0x00,1,1,1,1,1,1,1,1,1,1} ,
     {0x64,1,1,1,1,0,0,1,1,0,0} ,
     {0xC8,1,1,1,1,0,0,0,0,1,1}
 };
 
-// Data storage (DS) table declaration:
-extern uint16_t flt_tbl_ds[3][11] = {
+// Default data storage (DS) table declaration:
+static const uint16_t flt_tbl_ds[FLT_TBL_ROW][FLT_TBL_COL] = {
     {0x00,1,1,0,0,1,1,1,1,1,1} ,
     {0x64,1,1,0,0,1,1,1,1,0,0} ,
     {0xC8,1,1,0,0,1,1,0,0,1,1}
-};
\ No newline at end of file
+};
+
+// Downlink scheduler macro definitions:
+#define FLT_TBL_DL_BAUD 1000000 // Downlink baud rate (tx_tlm_pkt)
+#define FLT_TBL_DL_BYTE_RATE \
+    (FLT_TBL_DL_BAUD/10)        // Downlink byte rate in bytes/sec (8N1; 10
+                                // bits per byte)
+#define FLT_TBL_DL_NCLS 3       // Downlink class table row size
+#define FLT_TBL_DL_COL  3       // Downlink class table column size
+
+// Downlink class table declaration:
+static const uint16_t flt_tbl_dl_cls[FLT_TBL_DL_NCLS][FLT_TBL_DL_COL] = {
+    {0x00,20,2} ,
+    {0xC8,60,4} ,
+    {0x64,100,32} // Depth of at least one segmenter block
+                  // (TLM_FRM_SEG_NFRM)
+};
@@ -0,0 +1,77 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Flow Control Header
+//
+// Credit-based flow control macro, structure, and function declarations
+//
+// Drop policies (what to drop when no credit frees up within the timeout):
+//     - NEWEST: drop the message being sent
+//     - OLDEST: drop the oldest message in the queue and send
+//     - APID:   OLDEST for FLW_CTL_APID_KEEP (housekeeping), NEWEST otherwise
+//
+// Edit the flow control table (flw_ctl.c) to configure queue limits, drop
+// policies, and timeouts. The drop policy of a queue can also be set in
+// flight (SETFLWPOL; argument is queue << 8 | policy); it is not persisted,
+// so the table policy applies again after a restart.
+//
+// Drop counters count frames for queues of frame handles (every handle of a
+// dropped block) and messages otherwise.
+//
+// -------------------------------------------------------------------------- /
+//
+// agent
+// Project HEPCATS
+// Subsystem: C&DH
+// Created: October 17, 2026
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Macro definitions:
+#define FLW_CTL_AGG_TLM    0 // Aggregate telemetry message queue
+#define FLW_CTL_FLT_TBL    1 // Filter table message queue
+#define FLW_CTL_TX_TLM_PKT 2 // Transmit telemetry packet message queue
+#define FLW_CTL_CRT_FILE   3 // Create file message queue
+#define FLW_CTL_NQUEUE     4 // Number of flow controlled message queues
+
+#define FLW_CTL_DROP_NEWEST 0 // Drop message being sent
+#define FLW_CTL_DROP_OLDEST 1 // Drop oldest message in queue
+#define FLW_CTL_DROP_APID   2 // Drop by APID
+
+#define FLW_CTL_APID_KEEP 0x00 // APID that evicts oldest message (APID
+                               // drop policy)
+
+// Flow controlled message queue structure:
+struct flw_ctl {
+    RT_QUEUE*   queue;    // Message queue
+    const char* name;     // Credit semaphore name
+    uint16_t    nmsg;     // Message queue limit (credits)
+    uint8_t     drop_pol; // Drop policy
+    uint8_t     hdl_flg;  // Messages are frame handles (release dropped)
+    RTIME       timeout;  // Credit timeout in ns
+
+    RT_SEM   cred;     // Credits (free message slots)
+    uint16_t nmsg_use; // Messages in queue or being sent
+    uint16_t hwm;      // High-water mark (messages)
+    uint16_t drop_cnt; // Dropped frames (frame handles) or messages
+};
+
+// Variable declaration:
+extern struct flw_ctl flw_ctl_tbl[FLW_CTL_NQUEUE]; // Flow control table
+
+// Function declarations:
+void    crt_flw_ctl();                          // Create credit semaphores
+int32_t rsv_flw_ctl(struct flw_ctl* fc,\
+    uint16_t apid);                             // Reserve credit (new
+                                                // message to drop is
+                                                // counted by caller)
+void    drop_flw_ctl(struct flw_ctl* fc,\
+    uint16_t ndrop);                            // Count dropped frames or
+                                                // messages
+void    cncl_flw_ctl(struct flw_ctl* fc);       // Cancel reserved credit
+int32_t send_flw_ctl(struct flw_ctl* fc, void* msg,\
+    size_t msg_size);                           // Send with reserved credit
+int32_t put_flw_ctl(struct flw_ctl* fc, void* msg,\
+    size_t msg_size, uint16_t apid);            // Reserve credit and send
+void    rtn_flw_ctl(struct flw_ctl* fc);        // Return credit (consumer)
+int8_t  set_flw_ctl_pol(uint32_t arg);          // Set drop policy of queue
+                                                // (queue << 8 | policy)
@@ -22,7 +22,8 @@ extern uint8_t  val_cmd_cnt;             // Valid command counter
 extern uint8_t  inv_cmd_cnt;             // Invalid command counter
 extern uint8_t  cmd_exec_suc_cnt;        // Commands executed successfully counter
 extern uint8_t  cmd_exec_err_cnt;        // Commands not executed (error) counter
-extern uint16_t tlm_pkt_xfr_frm_seq_cnt; // Packet sequence count
+extern uint16_t tlm_pkt_xfr_frm_seq_cnt; // Packet sequence count (telemetry
+                                         // packets built, all APIDs)
 extern uint16_t acq_img_cnt;             // Acquired images count
 extern uint8_t  img_acq_prog_flag;       // Image acquisition in progress flag
 extern uint8_t  mdq_scan_state;          // Magnetometer DAQ scanning state
@@ -32,6 +33,26 @@ extern uint16_t img_accpt_cnt;           // Accepted images (from IPS) count
 extern uint16_t img_rej_cnt;             // Rejected images (from IPS) count
 extern uint32_t next_img_acq_tm;         // Next image acquisition time
 extern uint32_t next_atc_tm;             // Next absolutely timed command time
-extern uint8_t  pbk_prog_flg;            // Playback in progress flag
+extern uint8_t  pbk_prog_flg;            // Playback progress (0: idle;
+                                         // 1-100: percent)
 extern uint32_t sys_tm;                  // System time
-extern uint8_t  ips_mdl_ld_state;        // IPS model load state
\ No newline at end of file
+extern uint8_t  ips_mdl_ld_state;        // IPS model load state
+extern uint16_t dl_dvrt_cnt[3];          // Frames diverted from downlink to
+                                         // recording (HK, MDQ, IMG class)
+extern uint16_t flt_tbl_def_crc;         // Filter table definition CRC-16
+extern uint8_t  dl_util_pct;             // Downlink line utilization (%)
+extern uint8_t  mdq_cdc_flg;             // Magnetometer DAQ codec flag
+extern uint16_t stor_free_mb;            // Free recording storage (MB)
+extern uint16_t stor_evct_cnt[3];        // Recorded segments evicted (HK,
+                                         // MDQ, IMG class)
+extern uint16_t atc_cnt;                 // Scheduled absolutely timed
+                                         // commands
+extern uint8_t  seq_run_id;              // Running sequence ID (0xFF: idle)
+extern uint16_t seq_suc_cnt;             // Sequence steps executed
+                                         // successfully counter
+extern uint16_t seq_err_cnt;             // Sequence steps not executed
+                                         // (error) counter
+extern uint16_t telecmd_sync_loss_cnt;   // Uplink sync loss counter
+extern uint16_t telecmd_resync_cnt;      // Uplink resynchronization counter
+extern uint16_t telecmd_crc_err_cnt;     // Uplink packet CRC failure
+                                         // counter
\ No newline at end of file
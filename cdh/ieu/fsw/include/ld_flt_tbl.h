@@ -0,0 +1,58 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Load Filter Table Header
+//
+// In-flight filter table (TO & DS) upload macro, structure, and function
+// declarations (flt_tbl.h must be included first)
+//
+// A filter table definition is uploaded with three software commands:
+//     - BGNFLTTBLLD: argument is the number of rows (1 to FLT_TBL_ROW_MAX)
+//     - FLTTBLLD:    argument is (word index << 16) | word; words are the TO
+//                    table rows followed by the DS table rows (row-major,
+//                    FLT_TBL_COL words per row)
+//     - ENDFLTTBLLD: argument is the CRC-16 (ccsds_crc.h) of the number of
+//                    rows followed by every word, each big-endian
+//
+// Definitions are double-buffered. Words are loaded into the inactive buffer;
+// a validated definition is persisted (FLT_TBL_DEF_FILE) and published with
+// a single pointer store followed by a generation count. The filter table
+// task checks the generation and reads the published pointer without a lock
+// (see ld_flt_tbl.c).
+//
+// -------------------------------------------------------------------------- /
+//
+// agent
+// Project HEPCATS
+// Subsystem: C&DH
+// Created: October 17, 2026
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Macro definitions:
+#define FLT_TBL_ROW_MAX 8 // Maximum filter table TO & DS row size
+#define FLT_TBL_DEF_NWRD \
+    (FLT_TBL_ROW_MAX*FLT_TBL_COL*2) // Maximum definition size in words
+
+#define FLT_TBL_DEF_FILE "../flt_tbl.bin"     // Persisted definition file
+#define FLT_TBL_DEF_TMP  "../flt_tbl.bin.tmp" // Definition file being written
+
+// Filter table definition structure:
+struct flt_tbl_def {
+    uint16_t nrow;                             // Row size
+    uint16_t to[FLT_TBL_ROW_MAX][FLT_TBL_COL]; // Telemetry output (TO) table
+    uint16_t ds[FLT_TBL_ROW_MAX][FLT_TBL_COL]; // Data storage (DS) table
+    uint16_t crc;                              // CRC-16 of definition
+};
+
+// Function declarations:
+void   init_flt_tbl_def();             // Load persisted or default definition
+uint32_t \
+       get_flt_tbl_def_gen();          // Get published definition
+                                       // generation (change check)
+const struct flt_tbl_def* \
+       bgn_rd_flt_tbl_def(uint32_t* gen); // Begin reading published
+                                          // definition (and its generation)
+void   end_rd_flt_tbl_def();           // End reading published definition
+int8_t bgn_ld_flt_tbl(uint32_t nrow);  // Begin upload
+int8_t ld_flt_tbl_wrd(uint32_t arg);   // Load word of upload
+int8_t end_ld_flt_tbl(uint16_t crc);   // Validate, persist, and publish
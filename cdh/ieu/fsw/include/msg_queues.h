@@ -21,11 +21,16 @@ extern RT_QUEUE telecmd_pkt_msg_queue; // For telecommand packets
 extern RT_QUEUE cmd_xfr_frm_msg_queue; // For command transfer frames
                                        // (proc_telecmd_pkt_task/cmd_sched_task
                                        //  --> exec_cmd_task)
-extern RT_QUEUE flt_tbl_msg_queue;     // For telemetry packet transfer frames
-                                       // (read_mdq/img/get_hk_tlm
+extern RT_QUEUE agg_tlm_msg_queue;     // For telemetry samples
+                                       // (read_mdq/get_hk_tlm
+                                       //  --> agg_tlm_task)
+extern RT_QUEUE flt_tbl_msg_queue;     // For telemetry frame handles
+                                       // (agg_tlm/read_img
                                        //  --> flt_tbl_task)
-extern RT_QUEUE tx_tlm_pkt_msg_queue;  // For telemetry packets transfer frames
+extern RT_QUEUE tx_tlm_pkt_msg_queue;  // For telemetry frame handles
                                        // (flt_tbl_task/rtrv_file_task
                                        // --> tx_tlm_pkt_task)
-extern RT_QUEUE crt_file_msg_queue;    // For telemetry packet transfer frames
-                                       // (flt_tbl_task --> crt_file_task)
\ No newline at end of file
+extern RT_QUEUE crt_file_msg_queue;    // For telemetry frame handles
+                                       // (flt_tbl_task --> crt_file_task)
+extern RT_QUEUE tlm_frm_free_msg_queue; // For free telemetry frame handles
+                                        // (frame pool free list)
\ No newline at end of file
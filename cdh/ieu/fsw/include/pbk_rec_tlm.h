@@ -0,0 +1,103 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Play Back Recorded Telemetry Header
+//
+// Indexed playback of recorded telemetry macro, structure, and function
+// declarations
+//
+// A playback is selected with the staged time window and byte budget and
+// the BGNPBK argument (classes to play back):
+//     - SETPBKBGN:  argument is the window start in seconds (0: oldest)
+//     - SETPBKEND:  argument is the window end in seconds, exclusive (0:
+//                   playback start time)
+//     - SETPBKLIM:  argument is the byte budget on the line (sync markers and
+//                   telemetry packets; 0: no budget)
+//     - SETPBKRATE: argument is the playback share of the link rate in
+//                   percent (1 to 100)
+//     - BGNPBK:     argument is a class (0x00: HK, 0x01: MDQ, 0x02: IMG) or
+//                   PBK_REC_TLM_ARG_MSK | class mask (bit 0: HK, bit 1: MDQ,
+//                   bit 2: IMG)
+//     - ACKPBK:     argument is a class or class mask (as BGNPBK); frames of
+//                   the classes in the staged window that were played back
+//                   are marked downlinked (rejected if none were)
+//
+// Staged values are kept for every following playback until changed. Only
+// frames whose index entry (rec_tlm.h) is in the window are read from the
+// segments; segments outside the window are not opened. Frames marked
+// downlinked are not played back, and segments with only such frames are
+// deleted.
+//
+// Every class has a cursor after its last frame played back. A playback
+// starts at the cursors, so a playback stopped by the byte budget (or a
+// restart) is resumed by the next BGNPBK; staging a new window start or end
+// resets the cursors. A cursor only moves past a frame queued for downlink;
+// a frame that could not be queued stops the playback and is played back
+// first by the next BGNPBK. Every class also keeps the time up to which the
+// window was played back, and ACKPBK marks the window downlinked only up to
+// that time, so frames after a byte budget stop are never marked. Staged
+// values, cursors, played back times, and downlinked ranges are persisted
+// (PBK_REC_TLM_FILE).
+//
+// -------------------------------------------------------------------------- /
+//
+// agent
+// Project HEPCATS
+// Subsystem: C&DH
+// Created: October 17, 2026
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Macro definitions:
+#define PBK_REC_TLM_ARG_MSK   0x100 // BGNPBK argument: class mask follows
+#define PBK_REC_TLM_RDAHD_NREC   32 // Frames read ahead of playback
+#define PBK_REC_TLM_PCT_DFLT     25 // Default share of link rate in percent
+#define PBK_REC_TLM_NACK         16 // Downlinked ranges per class (maximum)
+#define PBK_REC_TLM_SAVE_NFRM    64 // Frames played back between cursor
+                                    // saves
+
+#define PBK_REC_TLM_FILE "../pbk_rec_tlm.bin"     // Persisted state file
+#define PBK_REC_TLM_TMP  "../pbk_rec_tlm.bin.tmp" // State file being written
+
+// Playback selection structure:
+struct pbk_rec_tlm_sel {
+    uint32_t bgn_sec;  // Window start (sec)
+    uint32_t end_sec;  // Window end (sec, exclusive)
+    uint32_t byte_lim; // Byte budget (0: none)
+    uint8_t  cls_msk;  // Classes (bit n: class n)
+};
+
+// Playback cursor structure (next frame to play back):
+struct pbk_rec_tlm_cur {
+    uint32_t sec;  // Segment time window start (sec)
+    uint32_t part; // Segment part of time window
+    uint32_t nrec; // Frame of segment
+};
+
+// Time range structure:
+struct pbk_rec_tlm_rng {
+    uint32_t bgn_sec; // Range start (sec)
+    uint32_t end_sec; // Range end (sec, exclusive)
+};
+
+// Function declarations:
+void     init_pbk_rec_tlm();                // Load persisted state
+int8_t   set_pbk_rec_tlm_bgn(uint32_t sec); // Stage window start
+int8_t   set_pbk_rec_tlm_end(uint32_t sec); // Stage window end
+int8_t   set_pbk_rec_tlm_lim(uint32_t lim); // Stage byte budget
+int8_t   set_pbk_rec_tlm_pct(uint32_t pct); // Stage share of link rate
+int8_t   get_pbk_rec_tlm_sel(uint32_t arg,\
+    struct pbk_rec_tlm_sel* sel);           // Get selection of BGNPBK
+                                            // argument (-1: invalid)
+uint32_t pbk_rec_tlm(const struct pbk_rec_tlm_sel* sel,\
+    uint32_t* byte_cnt);                    // Play back selection (returns
+                                            // frames played back)
+int8_t   ack_pbk_rec_tlm(uint32_t arg);     // Mark staged window of classes
+                                            // downlinked and delete
+                                            // downlinked segments
+uint8_t  chk_pbk_rec_tlm_dl(const char* seg,\
+    uint8_t cls);                           // Check if every frame of
+                                            // segment is downlinked (any
+                                            // task)
+uint8_t  get_pbk_rec_tlm_act_pct();         // Get share of link rate of
+                                            // playback in progress (0:
+                                            // idle; any task)
@@ -0,0 +1,150 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Record Telemetry Header
+//
+// Segmented telemetry recorder macro, structure, and function declarations
+// (tlm_frm_pool.h must be included first)
+//
+// Recorded transfer frames are appended to one open segment per class (HK,
+// MDQ, IMG) with a sidecar index of one entry per frame:
+//
+//  |--raw_record_tlm
+//     |-- hk
+//         |-- <window start sec>_<part>.seg (segment header and records,
+//                                            fixed size)
+//         |-- <window start sec>_<part>.idx (index entries, fixed size)
+//         |-- ...
+//     |-- mdq
+//         |-- ...
+//     |-- img
+//         |-- ...
+//
+// A new segment is started for every time window (REC_TLM_SEG_PRD) and when
+// a segment is full (REC_TLM_SEG_NREC); names sort oldest -> newest. A
+// segment starts with a header (REC_TLM_SEG_HDR_SIZE); record n follows at
+// REC_TLM_SEG_HDR_SIZE+n*REC_TLM_REC_SIZE and its index entry is at
+// n*REC_TLM_IDX_SIZE. A record is a record header (length of the transfer
+// frame up to the end of its packet and CRC-16 of those bytes) and the
+// transfer frame. Frames are written in batches by write file task
+// (rec_tlm_ring.h) and synced in batches (REC_TLM_SYNC_NREC frames or
+// REC_TLM_SYNC_PRD, whichever is first).
+//
+// The segment header carries the records known to be on storage at the last
+// sync, and the record count when the segment was closed (sealed). At
+// startup every segment is recovered before any task runs: a sealed segment
+// whose sizes match its header is accepted from its header alone; otherwise
+// only records after the last sync are checked (length and CRC), the
+// segment is truncated before the first torn record, and missing index
+// entries are rebuilt from the records. So recovery reads a few bytes per
+// segment and at most the records of the last syncs, no matter how many
+// records are stored.
+//
+// Storage is bounded by a quota per class (APID; row of the class table) and
+// by a high-water mark of the file system. Before a segment is opened, a
+// class over its quota evicts its own segments, and file system use over the
+// high-water mark evicts segments of every class until use is at the
+// low-water mark. Segments with every frame downlinked (pbk_rec_tlm.h) are
+// evicted first, then the oldest segments in class eviction rank order
+// (imaging first). Segments of the time window being recorded are never
+// evicted. Free storage and segments evicted per class are reported in
+// housekeeping telemetry.
+//
+//     | APID | Eviction rank (0: evicted first) | Quota (MB) |
+//
+// -------------------------------------------------------------------------- /
+//
+// agent
+// Project HEPCATS
+// Subsystem: C&DH
+// Created: October 17, 2026
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Macro definitions:
+#define REC_TLM_DIR "../raw_record_tlm/" // Recorded telemetry directory
+
+#define REC_TLM_CLS_HK  0 // Housekeeping class
+#define REC_TLM_CLS_MDQ 1 // Magnetometer DAQ class
+#define REC_TLM_CLS_IMG 2 // Imaging class
+#define REC_TLM_NCLS    3 // Number of classes
+
+#define REC_TLM_SEG_PRD     600 // Segment time window in seconds
+#define REC_TLM_SEG_NREC   4096 // Maximum frames per segment (4.5 MB)
+#define REC_TLM_SEG_NPART  1000 // Maximum parts per time window (3 digit
+                                // part in names)
+#define REC_TLM_SYNC_NREC    32 // Frames written between syncs (maximum)
+#define REC_TLM_SYNC_PRD \
+    1000000000                  // Time between syncs in ns (maximum; 1 sec)
+#define REC_TLM_NAME_MAX     64 // Segment path size in bytes (maximum)
+#define REC_TLM_IDX_SIZE      8 // Index entry size in bytes
+#define REC_TLM_BAT_NFRM     64 // Frames per class written at once (maximum)
+
+#define REC_TLM_SEG_MAGIC 0x48534547 // Segment header magic number
+#define REC_TLM_SEG_VER            1 // Segment layout version
+#define REC_TLM_SEG_OPEN  0xFFFFFFFF // Segment header record count: open
+#define REC_TLM_SEG_HDR_SIZE      32 // Segment header size in bytes
+#define REC_TLM_REC_HDR_SIZE       4 // Record header size in bytes
+#define REC_TLM_REC_SIZE \
+    (REC_TLM_REC_HDR_SIZE+TLM_PKT_XFR_FRM_SIZE) // Record size in bytes
+#define REC_TLM_SEG_SIZE \
+    (REC_TLM_SEG_HDR_SIZE+REC_TLM_SEG_NREC*\
+    (REC_TLM_REC_SIZE+REC_TLM_IDX_SIZE))        // Segment and index size in
+                                                // bytes (maximum)
+
+// Storage manager macro definitions:
+#define REC_TLM_HWM_PCT      90 // File system use that starts eviction (%)
+#define REC_TLM_LWM_PCT      80 // File system use that stops eviction (%)
+#define REC_TLM_MB      1048576 // Bytes per MB
+#define REC_TLM_COL           3 // Class table column size
+
+// Class table declaration (row n: class n):
+static const uint32_t rec_tlm_cls_tbl[REC_TLM_NCLS][REC_TLM_COL] = {
+    {0x00,2,256} ,
+    {0xC8,1,2048} ,
+    {0x64,0,4096}
+};
+
+// Segment header structure (host order; internal to flight software):
+struct rec_tlm_seg_hdr {
+    uint32_t magic;     // Magic number (REC_TLM_SEG_MAGIC)
+    uint16_t ver;       // Layout version
+    uint16_t cls;       // Class
+    uint32_t sec;       // Time window start (sec)
+    uint32_t part;      // Part of time window
+    uint32_t sync_nrec; // Records on storage at last sync
+    uint32_t seal_nrec; // Records when closed (REC_TLM_SEG_OPEN: open)
+    uint16_t rsvd[3];   // Reserved
+    uint16_t crc;       // CRC-16 of header
+};
+
+// Record header structure (host order; internal to flight software):
+struct rec_tlm_rec_hdr {
+    uint16_t len; // Transfer frame length in bytes (up to end of packet)
+    uint16_t crc; // CRC-16 of transfer frame length
+};
+
+// Index entry structure (host order; internal to flight software):
+struct rec_tlm_idx {
+    uint32_t sec;     // Creation time (sec)
+    uint16_t msec;    // Creation time (millisecond)
+    uint8_t  grp_flg; // Grouping flag (packet sequence)
+    uint8_t  rsvd;    // Reserved
+};
+
+// Function declarations:
+int8_t      get_rec_tlm_cls(uint16_t apid);   // Get class of APID (-1: not
+                                              // recorded)
+const char* get_rec_tlm_dir(uint8_t cls);     // Get class directory
+uint8_t     get_rec_tlm_stor();               // Get file system use (%) and
+                                              // publish free storage
+void        init_rec_tlm();                   // Create class directories
+                                              // and recover segments
+uint8_t     chk_rec_tlm_rec(const char* rec); // Check record length and CRC
+uint32_t    app_rec_tlm(const char* frm,\
+    uint32_t nfrm);                           // Append transfer frames
+                                              // (contiguous; returns frames
+                                              // recorded)
+void        sync_rec_tlm();                   // Sync written frames
+int32_t     list_rec_tlm_seg(uint8_t cls,\
+    char (**seg)[REC_TLM_NAME_MAX]);          // List segment paths of class
+                                              // (oldest first; caller frees)
@@ -0,0 +1,39 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Record Telemetry Ring Header
+//
+// Single-producer, single-consumer ring of transfer frames handed from
+// create file task (real-time producer) to write file task (non-real-time
+// consumer) macro and function declarations (tlm_frm_pool.h must be included
+// first)
+//
+// The producer copies a frame into the slot at the head and publishes it by
+// advancing the head; the consumer writes frames from the tail and frees them
+// by advancing the tail. Each index is only written by its own side (atomic
+// loads and stores), so neither side takes a lock or makes a system call and
+// create file task never leaves primary mode. Frames waiting to be written
+// are contiguous in the ring except where it wraps, so the consumer writes
+// them in place.
+//
+// -------------------------------------------------------------------------- /
+//
+// agent
+// Project HEPCATS
+// Subsystem: C&DH
+// Created: October 17, 2026
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Macro definitions:
+#define REC_TLM_RING_NFRM 256 // Ring size in frames (power of 2; 272 KB)
+
+// Function declarations:
+int8_t   put_rec_tlm_ring(const char* frm);  // Copy frame into ring
+                                             // (producer; returns 1 if the
+                                             // consumer must be woken, 0, or
+                                             // -1 if full)
+uint32_t get_rec_tlm_ring(const char** frm); // Get frames to write
+                                             // (consumer; contiguous,
+                                             // returns number of frames)
+void     rls_rec_tlm_ring(uint32_t nfrm);    // Free frames written
+                                             // (consumer)
@@ -0,0 +1,127 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Route Telemetry Header
+//
+// Compiled per-APID telemetry routing descriptors
+//
+// The filter tables (flt_tbl.h) are compiled for one filter table mode into a
+// dense descriptor table indexed by APID (CCSDS_APID_MASK+1 entries, so
+// ccsds_pkt.h must be included first). Routing a transfer frame is then a
+// single table lookup that returns a destination bitmask (bit d set means
+// send to destination d).
+//
+// Each destination of a descriptor is either taking every frame (all_msk,
+// frequency >= range), decimated (dcm_msk, 0 < frequency < range), or not
+// taking any frame (frequency = 0). Decimated destinations take the first
+// frequency frames out of every range frames. Counters are reset whenever the
+// tables are compiled, so the first frame after a mode change is always sent
+// if the frequency is non-zero.
+//
+// APIDs not found in any table get the default destination mask.
+//
+// -------------------------------------------------------------------------- /
+//
+// agent
+// Project HEPCATS
+// Subsystem: C&DH
+// Created: October 17, 2026
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Standard libraries:
+#include <stdint.h> // Integer types
+#include <string.h> // String function definitions
+
+// Macro definitions:
+#define RTE_TLM_NAPID    (CCSDS_APID_MASK+1) // Number of descriptors
+#define RTE_TLM_NDST_MAX 4                   // Maximum number of destinations
+
+// Routing descriptor structure:
+struct rte_tlm_dsc {
+    uint8_t all_msk;                // Destinations taking every frame
+    uint8_t dcm_msk;                // Decimated destinations
+    uint8_t rng[RTE_TLM_NDST_MAX];  // Decimation range
+    uint8_t freq[RTE_TLM_NDST_MAX]; // Decimation frequency
+    uint8_t cnt[RTE_TLM_NDST_MAX];  // Decimation counter (0 to range-1)
+};
+
+// Compile filter tables for one mode into routing descriptors
+// (tbl[d] points to the row-major filter table of destination d; returns -1
+// and leaves descriptors untouched if the mode is not in the tables)
+static inline int8_t cmpl_rte_tlm(struct rte_tlm_dsc* rte_tbl,
+    const uint16_t* const* tbl, uint8_t ndst, uint16_t nrow, uint16_t ncol,
+    uint8_t mode, uint8_t dflt_msk) {
+    // Definitions and initializations:
+    uint8_t  d;   // Destination
+    uint16_t row; // Filter table row
+    uint16_t i;   // Counter
+
+    const uint16_t* ent; // Filter table row entry
+
+    struct rte_tlm_dsc* rte; // Routing descriptor
+
+    // Check arguments:
+    if ((ndst > RTE_TLM_NDST_MAX) || (mode*2+2 >= ncol)) {
+        return -1;
+    }
+
+    // Set all descriptors to default destinations:
+    memset(rte_tbl,0,RTE_TLM_NAPID*sizeof(struct rte_tlm_dsc));
+    for (i = 0; i < RTE_TLM_NAPID; ++i) {
+        rte_tbl[i].all_msk = dflt_msk;
+    }
+
+    // Clear default destinations of APIDs found in any table:
+    for (d = 0; d < ndst; ++d) {
+        for (row = 0; row < nrow; ++row) {
+            rte_tbl[tbl[d][row*ncol] & CCSDS_APID_MASK].all_msk = 0;
+        }
+    }
+
+    // Set destinations from range and frequency of mode:
+    for (d = 0; d < ndst; ++d) {
+        for (row = 0; row < nrow; ++row) {
+            ent = tbl[d]+row*ncol;
+            rte = &rte_tbl[ent[0] & CCSDS_APID_MASK];
+
+            // Check frequency:
+            if (ent[mode*2+2] == 0) {
+                continue;
+            } else if (ent[mode*2+2] >= ent[mode*2+1]) {
+                rte->all_msk |= 1 << d;
+            } else {
+                rte->dcm_msk |= 1 << d;
+                rte->rng[d]  = (uint8_t) ent[mode*2+1];
+                rte->freq[d] = (uint8_t) ent[mode*2+2];
+            }
+        }
+    }
+
+    return 0;
+}
+
+// Route transfer frame (returns destination bitmask)
+static inline uint8_t rte_tlm_frm(struct rte_tlm_dsc* rte_tbl,
+    uint16_t apid) {
+    // Definitions and initializations:
+    struct rte_tlm_dsc* rte = &rte_tbl[apid & CCSDS_APID_MASK];
+
+    uint8_t dst_msk = rte->all_msk; // Destination bitmask
+    uint8_t dcm_msk = rte->dcm_msk; // Decimated destinations left
+    uint8_t d;                      // Destination
+
+    // Step decimation counters:
+    while (dcm_msk != 0) {
+        d = __builtin_ctz(dcm_msk);
+        dcm_msk &= dcm_msk-1;
+
+        if (rte->cnt[d] < rte->freq[d]) {
+            dst_msk |= 1 << d;
+        }
+        if (++rte->cnt[d] == rte->rng[d]) {
+            rte->cnt[d] = 0;
+        }
+    }
+
+    return dst_msk;
+}
@@ -0,0 +1,19 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Segment Telemetry Packet Transfer Frames header
+//
+// Segment source data into telemetry packet transfer frames function
+// declaration
+//
+// -------------------------------------------------------------------------- /
+//
+// agent
+// Project HEPCATS
+// Subsystem: C&DH
+// Created: October 17, 2026
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Function declaration:
+int32_t seg_tlm_pkt_xfr_frm(char* src_dat, size_t src_dat_size,
+    uint16_t apid, struct flw_ctl* fc);
@@ -36,6 +36,8 @@ extern RT_SEM tx_tlm_pkt_sem;       // For tx_tlm_pkt_task, flt_tbl_task
                                     // and rtrv_file_task synchronization
 extern RT_SEM crt_file_sem;         // For crt_file_task and flt_tbl_task
                                     // synchronization
+extern RT_SEM wrt_file_sem;         // For crt_file_task and wrt_file_task
+                                    // synchronization (frames in ring)
 extern RT_SEM rtrv_file_sem;        // For rtrv_file_task and cmd_sw_task
                                     // synchronization
 extern RT_SEM new_img_sem;          // For run_cam_sgl and read_usb_img task
@@ -44,4 +46,7 @@ extern RT_SEM mdq_init_sem;         // For init_mdq and read_mdq task
                                     // synchronization
 extern RT_SEM read_mdq_sem;         // For cmd_mdq and read_mdq task
                                     // synchronization to indicate when the DAQ
-                                    // is readable (scanning)                                        
\ No newline at end of file
+                                    // is readable (scanning)                                        
+extern RT_SEM run_seq_sem;          // For cmd_sw and run_seq task
+                                    // synchronization (sequence started or
+                                    // stop requested)
\ No newline at end of file
@@ -0,0 +1,28 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Send Command
+//
+// Send command transfer frame to command application task function
+// declaration
+//
+// -------------------------------------------------------------------------- /
+//
+// agent
+// Project HEPCATS
+// Subsystem: C&DH
+// Created: October 17, 2026
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Macro definitions:
+#define DEST_APID_SW  0x00  // Software destination APID
+#define DEST_APID_IMG 0x64  // Image destination APID
+#define DEST_APID_MDQ 0xC8  // Magnetometer DAQ destination APID
+#define DEST_APID_ERS 0x12C // Electrical Relay Switch destination APID
+
+// Function declaration:
+int8_t send_cmd(char* cmd_xfr_frm_buf); // Send command to execute now
+                                        // (returns 1 if executed, 0 if not
+                                        // executed, 2 if status unknown
+                                        // (counted by command application),
+                                        // or -1 if APID invalid)
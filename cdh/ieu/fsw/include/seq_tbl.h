@@ -0,0 +1,67 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Sequence Table Header
+//
+// Onboard stored command sequence table macro, structure, and function
+// declarations
+//
+// A sequence is a list of commands, each executed a relative delay after the
+// previous one (the first after the sequence is started). It is uploaded
+// once with three software commands:
+//     - BGNSEQLD: argument is (sequence ID << 16) | number of steps (1 to
+//                 SEQ_TBL_NSTEP)
+//     - SEQLD:    argument is (word index << 16) | word; every step is
+//                 SEQ_TBL_STEP_NWRD words (APID, packet name, argument high
+//                 and low, delay in ms high and low)
+//     - ENDSEQLD: argument is the CRC-16 (ccsds_crc.h) of the sequence ID,
+//                 the number of steps, and every word, each big-endian
+// and then started any number of times with one command (RUNSEQ, argument is
+// the sequence ID) or stopped (STPSEQ). One sequence runs at a time, and a
+// sequence cannot be replaced while it runs.
+//
+// The table is persisted (SEQ_TBL_FILE) on every upload, so stored
+// sequences survive restart.
+//
+// -------------------------------------------------------------------------- /
+//
+// agent
+// Project HEPCATS
+// Subsystem: C&DH
+// Created: October 17, 2026
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Macro definitions:
+#define SEQ_TBL_NSEQ      16 // Sequences stored (maximum)
+#define SEQ_TBL_NSTEP     32 // Steps per sequence (maximum)
+#define SEQ_TBL_STEP_NWRD  6 // Upload words per step
+#define SEQ_TBL_NONE    0xFF // Sequence ID of no sequence (none running)
+
+#define SEQ_TBL_FILE "../seq_tbl.bin"     // Persisted table file
+#define SEQ_TBL_TMP  "../seq_tbl.bin.tmp" // Table file being written
+
+// Sequence step structure:
+struct seq_tbl_step {
+    uint16_t apid;     // Command APID
+    uint16_t pkt_name; // Command packet name
+    uint32_t arg;      // Command argument
+    uint32_t dly_ms;   // Delay after previous step (ms)
+};
+
+// Sequence structure:
+struct seq_tbl_seq {
+    uint16_t            nstep;               // Steps (0: empty)
+    uint16_t            crc;                 // CRC-16 of sequence
+    struct seq_tbl_step step[SEQ_TBL_NSTEP]; // Steps
+};
+
+// Function declarations:
+void   init_seq_tbl();             // Load persisted table
+const struct seq_tbl_seq* \
+       get_seq(uint8_t id);        // Get sequence (running sequence only)
+int8_t bgn_ld_seq(uint32_t arg);   // Begin upload
+int8_t ld_seq_wrd(uint32_t arg);   // Load word of upload
+int8_t end_ld_seq(uint16_t crc);   // Validate, store, and persist upload
+int8_t str_seq(uint32_t id);       // Start sequence
+int8_t stp_seq();                  // Stop running sequence
+uint8_t get_stp_seq();             // Get and clear stop request
@@ -28,13 +28,17 @@ extern RT_TASK cmd_ers_task;          // Execute electrical relay switch
 extern RT_TASK crt_tlm_pkt_task;      // Create telemetry packet
 extern RT_TASK cmd_img_task;          // Execute imaging command
 extern RT_TASK cmd_mdq_task;          // Execute magnetometer DAQ command
+extern RT_TASK agg_tlm_task;          // Aggregate telemetry
 extern RT_TASK flt_tbl_task;          // (Telemetry) Filter table
 extern RT_TASK tx_tlm_pkt_task;       // Transmit telemetry packet to downlink
                                       // serial port
 extern RT_TASK crt_file_task;         // Create file from telemetry packet
                                       // transfer frame
+extern RT_TASK wrt_file_task;         // Write recorded frames to storage
+                                      // (non-real-time)
 extern RT_TASK rtrv_file_task;        // Retrieve file for downlink
 extern RT_TASK get_hk_tlm_task;	      // Get housekeeping telemetry
+extern RT_TASK run_seq_task;          // Run stored command sequence
 
 // Task function declarations:
 void rx_telecmd_pkt(void* arg);    // Receive telecommand packet from uplink
@@ -49,10 +53,13 @@ void cmd_ers(void* arg);           // Execute electrical relay switch command
 void crt_tlm_pkt(void* arg);       // Create telemetry packet 
 void read_mdq(void* arg);          // Read magnetometer DAQ
 void read_img(void* arg);          // Read imaging
+void agg_tlm(void* arg);           // Aggregate telemetry
 void flt_tbl(void* arg);           // (Telemetry) Filter table
 void tx_tlm_pkt(void* arg);        // Transmit telemetry packet to downlink
                                    // serial port
 void crt_file(void* arg);          // Create file from telemetry packet
                                    // transfer frame
+void wrt_file(void* arg);          // Write recorded frames to storage
 void rtrv_file(void* arg);         // Retrieve file for downlink
-void get_hk_tlm(void* arg);	       // Get housekeeping telemetry
\ No newline at end of file
+void get_hk_tlm(void* arg);	       // Get housekeeping telemetry
+void run_seq(void* arg);           // Run stored command sequence
\ No newline at end of file
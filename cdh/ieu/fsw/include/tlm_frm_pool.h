@@ -0,0 +1,43 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Telemetry Frame Pool Header
+//
+// Telemetry packet transfer frame pool macro, variable, and function
+// declarations
+//
+// -------------------------------------------------------------------------- /
+//
+// agent
+// Project HEPCATS
+// Subsystem: C&DH
+// Created: October 17, 2026
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Macro definitions:
+#define TLM_PKT_XFR_FRM_SIZE 1089 // Telemetry transfer frame size in bytes
+#define TLM_FRM_POOL_NFRM      64 // Number of frames in frame pool
+#define TLM_FRM_HDL_SIZE        2 // Frame handle size in bytes (message size
+                                  // of frame handle message queues)
+#define TLM_FRM_SEG_NFRM       32 // Maximum number of frames per bulk enqueue
+                                  // (segmenter batch; half the pool so other
+                                  // producers are not starved)
+#define TLM_FRM_QUEUE_POOL_SIZE \
+    (TLM_FRM_POOL_NFRM*64)        // Frame handle message queue pool size in
+                                  // bytes (handle plus allocator overhead for
+                                  // every frame in pool)
+#define TLM_FRM_ALLOC_TIMEOUT \
+    500000000                     // Frame allocation timeout in ns (0.5 sec)
+
+// Type definitions:
+typedef uint16_t tlm_frm_hdl_t; // Frame handle (index into frame pool)
+
+// Function declarations:
+void    init_tlm_frm_pool();                       // Populate free list
+int16_t alloc_tlm_frm(tlm_frm_hdl_t* hdl,\
+    RTIME timeout);                                // Allocate frame
+int16_t alloc_tlm_frm_blk(tlm_frm_hdl_t* hdl,\
+    uint16_t nfrm, RTIME timeout);                 // Allocate block of frames
+void    ref_tlm_frm(tlm_frm_hdl_t hdl);            // Add frame reference
+void    rls_tlm_frm(tlm_frm_hdl_t hdl);            // Release frame reference
+char*   get_tlm_frm_buf(tlm_frm_hdl_t hdl);        // Get frame buffer
@@ -0,0 +1,24 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Time Service Header
+//
+// Onboard time service function declarations
+//
+// -------------------------------------------------------------------------- /
+//
+// agent
+// Project HEPCATS
+// Subsystem: C&DH
+// Created: October 17, 2026
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Function declarations:
+void     init_tm_svc(void);                      // Cache epoch offset
+uint64_t get_tm_ns(void);                        // Get time (ns since epoch)
+uint32_t get_tm_sec(void);                       // Get time (sec since epoch)
+uint64_t get_tm_tck(uint64_t ns);                // Get Xenomai timer time
+                                                 // (ticks) of time (ns since
+                                                 // epoch)
+void     get_tm_cuc(uint32_t* sec, uint16_t* frc); // Get time (CUC seconds
+                                                   // and fraction)
@@ -0,0 +1,367 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Absolutely Timed Command Schedule
+//
+// Schedule of absolutely timed commands used by command scheduler task (see
+// atc_sched.h). Only command scheduler task changes the schedule after it is
+// loaded at startup.
+//
+// Every slot of the slot table keeps its execution time, its position in the
+// heap, and the next slot of its hash bucket; free slots are kept on a
+// stack. A slot is added at the end of the heap and moved up, and a slot is
+// removed by moving the last slot of the heap into its position and moving
+// that slot up or down.
+//
+// The schedule file holds one entry per slot. It is created at its full size
+// and kept open; the entry of a slot added or freed is written in place and
+// synced (fdatasync) before the command is acknowledged. Entries failing
+// their CRC-16 are treated as free when the schedule is loaded, and the heap
+// is rebuilt from the loaded entries in O(n).
+//
+// -------------------------------------------------------------------------- /
+//
+// Dependencies:
+// - Xenomai 3 / Cobalt
+//
+// Input Arguments:
+// - N/A
+//
+// Output Arguments:
+// - N/A
+//
+// -------------------------------------------------------------------------- /
+//
+// agent
+// Project HEPCATS
+// Subsystem: C&DH
+// Created: October 17, 2026
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Standard libraries:
+#include <stdio.h>  // Standard input/output definitions
+#include <unistd.h> // UNIX standard function definitions
+#include <string.h> // String function definitions
+#include <stdint.h> // Standard integer types
+#include <stddef.h> // Standard definitions (offsetof)
+#include <fcntl.h>  // File control definitions
+
+// Header files:
+#include <atc_sched.h> // Absolutely timed command schedule declarations
+#include <ccsds_crc.h> // CCSDS packet error control (CRC)
+#include <tm_svc.h>    // Time service declarations
+
+// Macro definitions:
+#define ATC_SCHED_NONE 0xFFFF         // No slot
+#define NSEC_PER_SEC   1000000000ULL // Nanoseconds per second
+#define NSEC_PER_MSEC  1000000ULL    // Nanoseconds per millisecond
+
+#define ATC_SCHED_ENT_USED 0xA5 // Entry in use flag value
+
+// Slot table:
+static struct atc_sched_ent atc_sched_ent[ATC_SCHED_NCMD]; // Entries
+static uint64_t atc_sched_tm[ATC_SCHED_NCMD];  // Execution time (ns)
+static uint16_t atc_sched_pos[ATC_SCHED_NCMD]; // Position in heap
+static uint16_t atc_sched_nxt[ATC_SCHED_NCMD]; // Next slot of hash bucket
+
+// Heap of slots (next command first):
+static uint16_t atc_sched_heap[ATC_SCHED_NCMD];
+static uint16_t atc_sched_cnt = 0;
+
+// Free slots (stack):
+static uint16_t atc_sched_free[ATC_SCHED_NCMD];
+static uint16_t atc_sched_nfree = 0;
+
+// Hash buckets of slots by execution time (sec):
+static uint16_t atc_sched_bkt[ATC_SCHED_NBKT];
+
+static uint32_t atc_sched_seq = 0; // Order of next command scheduled
+static int      atc_sched_fd = -1; // Schedule file descriptor
+
+// Calculate CRC-16 of entry
+static uint16_t calc_atc_sched_crc(const struct atc_sched_ent* ent) {
+    return calc_ccsds_crc((const char*) ent,\
+        offsetof(struct atc_sched_ent,crc));
+}
+
+// Get execution time of command transfer frame (ns since epoch)
+static uint64_t get_atc_sched_frm_tm(const char* frm) {
+    // Definitions and initializations:
+    uint32_t sec;  // Execution time (seconds)
+    uint16_t msec; // Execution time (milliseconds)
+
+    memcpy(&sec,frm+5,4);
+    memcpy(&msec,frm+9,2);
+
+    return (uint64_t) sec*NSEC_PER_SEC+(uint64_t) msec*NSEC_PER_MSEC;
+}
+
+// Get hash bucket of execution time
+static uint16_t* get_atc_sched_bkt(uint64_t tm) {
+    return &atc_sched_bkt[(tm/NSEC_PER_SEC) & (ATC_SCHED_NBKT-1)];
+}
+
+// Check if slot a executes before slot b
+static uint8_t chk_atc_sched_lt(uint16_t a, uint16_t b) {
+    if (atc_sched_tm[a] != atc_sched_tm[b]) {
+        return atc_sched_tm[a] < atc_sched_tm[b];
+    }
+
+    return (int32_t) (atc_sched_ent[a].seq-atc_sched_ent[b].seq) < 0;
+}
+
+// Put slot at heap position
+static void put_atc_sched_heap(uint16_t pos, uint16_t slot) {
+    atc_sched_heap[pos] = slot;
+    atc_sched_pos[slot] = pos;
+
+    return;
+}
+
+// Move slot at heap position up (towards next command)
+static void up_atc_sched_heap(uint16_t pos) {
+    // Definitions and initializations:
+    uint16_t slot = atc_sched_heap[pos]; // Slot moved
+    uint16_t par;                        // Parent position
+
+    while (pos > 0) {
+        par = (pos-1)/2;
+        if (!chk_atc_sched_lt(slot,atc_sched_heap[par])) {
+            break;
+        }
+        put_atc_sched_heap(pos,atc_sched_heap[par]);
+        pos = par;
+    }
+    put_atc_sched_heap(pos,slot);
+
+    return;
+}
+
+// Move slot at heap position down (away from next command)
+static void dn_atc_sched_heap(uint16_t pos) {
+    // Definitions and initializations:
+    uint16_t slot = atc_sched_heap[pos]; // Slot moved
+    uint32_t chld;                       // Earlier child position
+
+    while ((chld = 2*(uint32_t) pos+1) < atc_sched_cnt) {
+        if ((chld+1 < atc_sched_cnt) && \
+            chk_atc_sched_lt(atc_sched_heap[chld+1],atc_sched_heap[chld])) {
+            chld++;
+        }
+        if (!chk_atc_sched_lt(atc_sched_heap[chld],slot)) {
+            break;
+        }
+        put_atc_sched_heap(pos,atc_sched_heap[chld]);
+        pos = chld;
+    }
+    put_atc_sched_heap(pos,slot);
+
+    return;
+}
+
+// Write entry of slot to schedule file (returns 0 or -1 on error)
+static int8_t wrt_atc_sched_ent(uint16_t slot) {
+    atc_sched_ent[slot].crc = calc_atc_sched_crc(&atc_sched_ent[slot]);
+    if ((pwrite(atc_sched_fd,&atc_sched_ent[slot],\
+        sizeof(struct atc_sched_ent),\
+        (off_t) slot*sizeof(struct atc_sched_ent)) != \
+        sizeof(struct atc_sched_ent)) || (fdatasync(atc_sched_fd) != 0)) {
+        return -1;
+    }
+
+    return 0;
+}
+
+// Link slot into schedule (heap and hash bucket)
+static void lnk_atc_sched(uint16_t slot) {
+    // Definitions and initializations:
+    uint16_t* bkt = get_atc_sched_bkt(atc_sched_tm[slot]); // Hash bucket
+
+    atc_sched_nxt[slot] = *bkt;
+    *bkt = slot;
+    put_atc_sched_heap(atc_sched_cnt++,slot);
+
+    return;
+}
+
+// Remove slot from schedule, free it, and write its entry
+static void rmv_atc_sched(uint16_t slot) {
+    // Definitions and initializations:
+    uint16_t* bkt = get_atc_sched_bkt(atc_sched_tm[slot]); // Hash bucket
+    uint16_t  pos = atc_sched_pos[slot];                   // Heap position
+    uint16_t  last;                                        // Last slot of
+                                                           // heap
+
+    // Unlink from hash bucket:
+    while (*bkt != slot) {
+        bkt = &atc_sched_nxt[*bkt];
+    }
+    *bkt = atc_sched_nxt[slot];
+
+    // Move last slot of heap into position:
+    last = atc_sched_heap[--atc_sched_cnt];
+    if (last != slot) {
+        put_atc_sched_heap(pos,last);
+        up_atc_sched_heap(pos);
+        dn_atc_sched_heap(atc_sched_pos[last]);
+    }
+
+    // Free slot (command is not executed again after a restart):
+    atc_sched_ent[slot].flg = 0;
+    if (wrt_atc_sched_ent(slot) != 0) {
+        // Print:
+        rt_printf("%d (ATC_SCHED) Error writing schedule entry %u\n",\
+            get_tm_sec(),slot);
+    }
+    atc_sched_free[atc_sched_nfree++] = slot;
+
+    return;
+}
+
+// Load persisted schedule (before tasks start)
+void init_atc_sched() {
+    // Definitions and initializations:
+    uint64_t late_tm;      // Execution time before which commands are
+                           // dropped
+    uint32_t ld_cnt = 0;   // Commands loaded
+    uint32_t drop_cnt = 0; // Late commands dropped
+    int32_t  i;            // Slot counter
+
+    memset(atc_sched_ent,0,sizeof(atc_sched_ent));
+    for (i = 0; i < ATC_SCHED_NBKT; ++i) {
+        atc_sched_bkt[i] = ATC_SCHED_NONE;
+    }
+    atc_sched_cnt = 0;
+    atc_sched_nfree = 0;
+
+    // Open schedule file (created at full size):
+    atc_sched_fd = open(ATC_SCHED_FILE,O_RDWR | O_CREAT,0644);
+    if (atc_sched_fd < 0) {
+        // Print:
+        rt_printf("%d (ATC_SCHED) Error opening schedule file\n",\
+            get_tm_sec());
+    } else {
+        pread(atc_sched_fd,atc_sched_ent,sizeof(atc_sched_ent),0);
+        ftruncate(atc_sched_fd,sizeof(atc_sched_ent));
+    }
+
+    // Load entries in use and not late (others freed):
+    late_tm = get_tm_ns()-(uint64_t) ATC_SCHED_LATE_SEC*NSEC_PER_SEC;
+    for (i = ATC_SCHED_NCMD-1; i >= 0; --i) {
+        if ((atc_sched_ent[i].flg != ATC_SCHED_ENT_USED) || \
+            (calc_atc_sched_crc(&atc_sched_ent[i]) != atc_sched_ent[i].crc)) {
+            memset(&atc_sched_ent[i],0,sizeof(struct atc_sched_ent));
+            atc_sched_free[atc_sched_nfree++] = i;
+
+            continue;
+        }
+        atc_sched_tm[i] = get_atc_sched_frm_tm(atc_sched_ent[i].frm);
+        if (atc_sched_tm[i] < late_tm) {
+            atc_sched_ent[i].flg = 0;
+            wrt_atc_sched_ent(i);
+            atc_sched_free[atc_sched_nfree++] = i;
+            drop_cnt++;
+
+            continue;
+        }
+
+        // Continue order scheduled after latest loaded command:
+        if ((ld_cnt == 0) || \
+            ((int32_t) (atc_sched_ent[i].seq-atc_sched_seq) >= 0)) {
+            atc_sched_seq = atc_sched_ent[i].seq+1;
+        }
+        lnk_atc_sched(i);
+        ld_cnt++;
+    }
+
+    // Build heap:
+    for (i = atc_sched_cnt/2-1; i >= 0; --i) {
+        dn_atc_sched_heap(i);
+    }
+
+    // Print:
+    rt_printf("%d (ATC_SCHED) %u scheduled commands loaded (%u late commands"
+        " dropped)\n",get_tm_sec(),ld_cnt,drop_cnt);
+
+    return;
+}
+
+int8_t add_atc_sched(const char* frm) {
+    // Definitions and initializations:
+    uint64_t tm = get_atc_sched_frm_tm(frm); // Execution time
+    uint16_t slot;                           // Slot
+
+    // Check for free slot and execution time not passed:
+    if ((atc_sched_nfree == 0) || (atc_sched_fd < 0) || \
+        (tm+(uint64_t) ATC_SCHED_LATE_SEC*NSEC_PER_SEC < get_tm_ns())) {
+        return -1;
+    }
+
+    // Fill slot and write its entry:
+    slot = atc_sched_free[--atc_sched_nfree];
+    atc_sched_ent[slot].seq = atc_sched_seq;
+    memcpy(atc_sched_ent[slot].frm,frm,ATC_SCHED_FRM_SIZE);
+    atc_sched_ent[slot].flg = ATC_SCHED_ENT_USED;
+    atc_sched_ent[slot].rsvd = 0;
+    if (wrt_atc_sched_ent(slot) != 0) {
+        atc_sched_ent[slot].flg = 0;
+        atc_sched_free[atc_sched_nfree++] = slot;
+
+        return -1;
+    }
+    atc_sched_seq++;
+
+    // Add slot to schedule:
+    atc_sched_tm[slot] = tm;
+    lnk_atc_sched(slot);
+    up_atc_sched_heap(atc_sched_pos[slot]);
+
+    return 1;
+}
+
+int8_t del_atc_sched(const char* frm) {
+    // Definitions and initializations:
+    uint64_t tm = get_atc_sched_frm_tm(frm); // Execution time
+    uint16_t slot = *get_atc_sched_bkt(tm);  // Slot
+    uint16_t nxt;                            // Next slot of bucket
+    uint8_t  del_flg = 0;                    // Command cancelled
+
+    // Cancel commands of hash bucket with APID, packet name, and execution
+    // time:
+    while (slot != ATC_SCHED_NONE) {
+        nxt = atc_sched_nxt[slot];
+        if ((atc_sched_tm[slot] == tm) && \
+            (memcmp(atc_sched_ent[slot].frm,frm,4) == 0)) {
+            rmv_atc_sched(slot);
+            del_flg = 1;
+        }
+        slot = nxt;
+    }
+
+    return del_flg ? 1 : -1;
+}
+
+uint64_t get_atc_sched_tm() {
+    return (atc_sched_cnt > 0) ? atc_sched_tm[atc_sched_heap[0]] : 0;
+}
+
+int8_t get_atc_sched(char* frm) {
+    if (atc_sched_cnt == 0) {
+        return -1;
+    }
+    memcpy(frm,atc_sched_ent[atc_sched_heap[0]].frm,ATC_SCHED_FRM_SIZE);
+
+    return 1;
+}
+
+void pop_atc_sched() {
+    if (atc_sched_cnt > 0) {
+        rmv_atc_sched(atc_sched_heap[0]);
+    }
+
+    return;
+}
+
+uint16_t get_atc_sched_cnt() {
+    return atc_sched_cnt;
+}
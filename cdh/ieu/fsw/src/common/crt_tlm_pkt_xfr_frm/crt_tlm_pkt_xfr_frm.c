@@ -3,12 +3,29 @@
 // Create Telemetry Packet Transfer Frame
 // 
 // Telemetry packet transfer frames are created from source data, source
-// origin APID, group flag, and sequence count. These parameters are placed
-// into packet fields.
+// origin APID, and group flag. These parameters are placed into packet
+// fields with the shared CCSDS packet codec (ccsds_pkt.h). The packet error
+// control field is the CRC-16-CCITT of the packet (ccsds_crc.h).
 //
-// Source data passed that is not TLM_PKT_USR_DAT_SIZE bytes in size is made
-// to TLM_PKT_USR_DAT_SIZE bytes by populating the remaining space with NULL.
-// This case would be for the last transfer frame of an image.
+// Sequence counts are owned here: each APID has its own counter, taken with
+// one atomic increment when the frame is built, so tasks creating frames
+// concurrently never share or skip a count. Counters are free running 16 bit
+// counters and the packet carries the low 14 bits; since 65536 is a multiple
+// of 16384 this wraps 16383 -> 0 as CCSDS expects without a compare. The
+// housekeeping packet sequence count is the total of telemetry packets built
+// (all APIDs).
+//
+// Packets are variable length: the packet length field is set from the size
+// of the source data and the packet error control field immediately follows
+// the source data. Source data is never padded, so the last transfer frame
+// of an image only carries the remaining image bytes.
+//
+// The frame is built in place in the caller's buffer (normally a frame pool
+// slot) so source data is copied exactly once. bld_tlm_pkt_xfr_frm takes the
+// creation time from the caller so a segmenter can stamp every frame of one
+// payload with a single time stamp; crt_tlm_pkt_xfr_frm reads the current
+// time itself from the time service. Creation time is the CUC seconds and
+// fraction of the T-field; the transfer frame header keeps milliseconds.
 //
 // -------------------------------------------------------------------------- /
 //
@@ -29,117 +46,93 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 // Standard libraries:
-#include <stdlib.h>  // Standard library
-#include <string.h>  // String function definitions
-#include <stdint.h>  // Integer types
-#include <time.h>    // Standard time function definitions
-
-// Macro definitions:
-#define TLM_PKT_USR_DAT_SIZE 1064 // Telemetry packet user data size in bytes
-
-#define APID_IMG 0x64 // Image destination APID
-#define APID_MDQ 0xC8 // Magnetometer DAQ destination APID
-
-// Packet header structure:
-struct pkt_hdr {
-    // Packet I.D.:
-    unsigned int pkt_id_vrs:          3;  //  3 bits
-    unsigned int pkt_id_typ:          1;  //  1 bit
-    unsigned int pkt_id_sec_hdr_flg:  1;  //  1 bit
-    unsigned int pkt_id_apid:        11;  // 11 bits
-
-    // Packet Sequence Control:
-    unsigned int pkt_seq_cnt_grp_flg:  2;  //  2 bits
-    unsigned int pkt_seq_cnt_seq_cnt: 14;  // 14 bits
-
-    // Packet Length:
-    uint16_t pkt_len; // 16 bits
-};
-
-// Packet data field structure:
-struct pkt_dat_fld {
-    // Packet Secondary Header:
-    uint32_t pkt_sec_hdr_t_sec;          //  32 bits
-    uint16_t pkt_sec_hdr_t_msec;         //  16 bits
-    uint8_t  pkt_sec_hdr_t_void;         //  8 bits
-    unsigned int pkt_sec_hdr_p_ext:   1; //  1 bit
-    unsigned int pkt_sec_hdr_p_id:    3; //  3 bits
-    unsigned int pkt_sec_hdr_p_bas:   2; //  2 bit
-    unsigned int pkt_sec_hdr_p_frc:   2; //  2 bits
-
-    // Packet User Data Field:
-    char pkt_usr_dat[TLM_PKT_USR_DAT_SIZE];
-
-    // Packet Error Control:
-    uint16_t pkt_err_cnt; // 16 bits
-};
-
-void crt_tlm_pkt_xfr_frm(char* src_dat, size_t src_dat_size,
+#include <stdlib.h>   // Standard library
+#include <string.h>   // String function definitions
+#include <stdint.h>   // Integer types
+#include <time.h>     // Standard time function definitions
+
+// Header files:
+#include <ccsds_pkt.h>  // CCSDS packet codec
+#include <ccsds_crc.h>  // CCSDS packet error control (CRC)
+#include <hk_tlm_var.h> // Housekeeping telemetry variable declarations
+#include <tm_svc.h>     // Time service declarations
+
+// Macro definitions (offsets in transfer frame):
+#define XFR_FRM_PKT_HDR_OFST      9 // Packet header
+#define XFR_FRM_PKT_USR_DAT_OFST \
+    (XFR_FRM_PKT_HDR_OFST+CCSDS_HDR_SIZE) // Packet user data field
+
+// Variable definitions:
+static uint16_t tlm_seq_cnt_tbl[CCSDS_APID_MASK+1]; // Per-APID sequence
+                                                    // counters
+
+uint16_t get_tlm_seq_cnt(uint16_t apid) {
+    // Take next sequence count of APID (low 14 bits of counter):
+    return __atomic_fetch_add(&tlm_seq_cnt_tbl[apid & CCSDS_APID_MASK],1,\
+        __ATOMIC_RELAXED) & CCSDS_SEQ_MASK;
+}
+
+void bld_tlm_pkt_xfr_frm(char* src_dat, size_t src_dat_size,
     char* tlm_pkt_xfr_frm_buf, uint16_t apid, uint8_t grp_flg,
-    uint16_t seq_cnt) {
+    uint32_t sec, uint16_t frc) {
     // Definitions and initializations: 
-    struct timeval tv; // Unix timestamp structure
+    struct ccsds_pri_hdr pri_hdr; // Packet primary header
 
-    struct pkt_hdr pkt_hdr;         // Packet header structure
-    struct pkt_dat_fld pkt_dat_fld; // Packet data field structure
+    uint16_t msec = ccsds_frc_to_msec(frc); // Creation time milliseconds
+
+    char* tlm_pkt_buf = tlm_pkt_xfr_frm_buf+XFR_FRM_PKT_HDR_OFST; // Packet
 
     // Populate packet I.D. fields:
-    pkt_hdr.pkt_id_vrs =         0; // (version 1)
-    pkt_hdr.pkt_id_typ =         0; // (telemetry packet)
-    pkt_hdr.pkt_id_sec_hdr_flg = 1; // (secondary header present)
-    pkt_hdr.pkt_id_apid =     apid; // (packet APID)
+    pri_hdr.vrs         = CCSDS_VRS;     // (version 1)
+    pri_hdr.typ         = CCSDS_TYP_TLM; // (telemetry packet)
+    pri_hdr.sec_hdr_flg = 1;             // (secondary header present)
+    pri_hdr.apid        = apid;          // (packet APID)
 
     // Populate packet sequence control fields
-    pkt_hdr.pkt_seq_cnt_grp_flg = grp_flg; // Grouping flag
-    pkt_hdr.pkt_seq_cnt_seq_cnt = seq_cnt; // Sequence count
-
-    // Populate packet length field:
-    pkt_hdr.pkt_len = 1073; // "C" (Octets in packet data field - 1)
-
-    // Get current Unix time stamp:
-    gettimeofday(&tv,NULL);
-
-    // Populate packet secondary header T fields:
-    pkt_dat_fld.pkt_sec_hdr_t_sec  = tv.tv_sec;       // Seconds
-    pkt_dat_fld.pkt_sec_hdr_t_msec = tv.tv_usec/1000; // Milliseconds  
-    pkt_dat_fld.pkt_sec_hdr_t_void = 0xFF;            // "11111111"
-
-    // Populate packet secondary header P fields:
-    pkt_dat_fld.pkt_sec_hdr_p_ext = 0; // "0"   (no extension)
-    pkt_dat_fld.pkt_sec_hdr_p_id =  2; // "010" (time code I.D.)
-    pkt_dat_fld.pkt_sec_hdr_p_bas = 3; // "11"  (Number of octets of the basic
-                                       //        time unit minus one)
-    pkt_dat_fld.pkt_sec_hdr_p_frc = 2; // "10"  (Number of octets of the 
-                                       //        fractional time unit)
-
-    // Populate user data field. Check to see if source data is the same size
-    // as the packet's user data size:
-    if (src_dat_size == TLM_PKT_USR_DAT_SIZE) {
-        // Set packet user data to source data:
-        memcpy(pkt_dat_fld.pkt_usr_dat,src_dat,TLM_PKT_USR_DAT_SIZE);
-    } else {
-        // Populate packet user data with source data:
-        memcpy(pkt_dat_fld.pkt_usr_dat+0,src_dat,src_dat_size);
-
-        // Populate remaining space with "E":
-        memset(pkt_dat_fld.pkt_usr_dat+src_dat_size,"E",\
-            (TLM_PKT_USR_DAT_SIZE - src_dat_size));
-    } 
-
-    // Populate packer error control field:
-    pkt_dat_fld.pkt_err_cnt = 0xFFFF; // "1"s (no error detection)
+    pri_hdr.grp_flg = grp_flg; // Grouping flag
+    pri_hdr.seq_cnt = get_tlm_seq_cnt(apid); // Sequence count
+
+    // Increment housekeeping packet sequence count:
+    __atomic_add_fetch(&tlm_pkt_xfr_frm_seq_cnt,1,__ATOMIC_RELAXED);
+
+    // Populate packet length field from source data size:
+    pri_hdr.pkt_len = CCSDS_PKT_LEN(src_dat_size); // "C" (Octets in packet
+                                                   // data field - 1)
+
+    // Encode packet primary and secondary header (T and P fields) in place:
+    enc_ccsds_pri_hdr(tlm_pkt_buf,&pri_hdr);
+    enc_ccsds_sec_hdr(tlm_pkt_buf,sec,frc);
+
+    // Populate user data field directly in transfer frame:
+    memcpy(tlm_pkt_xfr_frm_buf+XFR_FRM_PKT_USR_DAT_OFST,src_dat,src_dat_size);
+
+    // Populate packet error control field (after user data) with CRC of
+    // packet header and user data:
+    put_be16(tlm_pkt_xfr_frm_buf+XFR_FRM_PKT_USR_DAT_OFST+src_dat_size,\
+        calc_ccsds_crc(tlm_pkt_buf,CCSDS_HDR_SIZE+src_dat_size));
 
     // Copy APID, group flag, and creation time to transfer frame buffer:
+    // (transfer frame header is internal to flight software; host order)
     memcpy(tlm_pkt_xfr_frm_buf+0,&apid,2);
     memcpy(tlm_pkt_xfr_frm_buf+2,&grp_flg,1);
-    memcpy(tlm_pkt_xfr_frm_buf+3,&pkt_dat_fld.pkt_sec_hdr_t_sec,4);
-    memcpy(tlm_pkt_xfr_frm_buf+7,&pkt_dat_fld.pkt_sec_hdr_t_msec,2);
+    memcpy(tlm_pkt_xfr_frm_buf+3,&sec,4);
+    memcpy(tlm_pkt_xfr_frm_buf+7,&msec,2);
+
+    return;
+}
+
+void crt_tlm_pkt_xfr_frm(char* src_dat, size_t src_dat_size,
+    char* tlm_pkt_xfr_frm_buf, uint16_t apid, uint8_t grp_flg) {
+    // Definitions and initializations: 
+    uint32_t sec; // Creation time seconds
+    uint16_t frc; // Creation time fraction
 
-    // Copy Packet Header to transfer frame buffer:
-    memcpy(tlm_pkt_xfr_frm_buf+9,&pkt_hdr,6);
+    // Get current time:
+    get_tm_cuc(&sec,&frc);
 
-    // Copy Packet Data Field to transfer frame buffer:
-    memcpy(tlm_pkt_xfr_frm_buf+15,&pkt_dat_fld,1074);
+    // Build transfer frame:
+    bld_tlm_pkt_xfr_frm(src_dat,src_dat_size,tlm_pkt_xfr_frm_buf,apid,\
+        grp_flg,sec,frc);
 
     return;
 }
\ No newline at end of file
@@ -0,0 +1,255 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Flow Control
+//
+// Credit-based flow control over the telemetry message queues (agg_tlm,
+// flt_tbl, tx_tlm_pkt, and crt_file). Every queue has a counting semaphore of
+// credits, one per free message slot. A producer reserves a credit before it
+// builds and sends a message and the consumer returns the credit once it has
+// read the message, so a queue write never fails on a full queue.
+//
+// A producer waits for a credit at most the timeout of the queue. If no credit
+// frees up in time, the drop policy of the queue (flw_ctl.h) decides whether
+// the new message or the oldest message in the queue is dropped. Dropped
+// frame handles are released to the frame pool. Every queue keeps a
+// high-water mark (in messages) and a drop counter (in frames for queues of
+// frame handles, so a dropped block counts every frame in it, and in
+// messages otherwise) which are published in housekeeping telemetry. The
+// drop policy of a queue can be changed by the command software task.
+//
+// -------------------------------------------------------------------------- /
+//
+// Dependencies:
+// - Xenomai 3 / Cobalt
+//
+// Input Arguments:
+// - N/A
+//
+// Output Arguments:
+// - N/A
+//
+// -------------------------------------------------------------------------- /
+//
+// agent
+// Project HEPCATS
+// Subsystem: C&DH
+// Created: October 17, 2026
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Standard libraries:
+#include <stdlib.h>  // Standard library
+#include <string.h>  // String function definitions
+#include <errno.h>   // Error number definitions
+#include <stdint.h>  // Standard integer types
+#include <time.h>    // Standard time types
+
+// Xenomai libraries:
+#include <alchemy/queue.h> // Message queue services
+#include <alchemy/sem.h>   // Semaphore services
+
+// Header files:
+#include <msg_queues.h>   // Message queue variable declarations
+#include <tlm_frm_pool.h> // Telemetry frame pool declarations
+#include <agg_tlm_pkt.h>  // Aggregated telemetry packet sub-header
+#include <agg_tlm.h>      // Aggregate telemetry declarations
+#include <flw_ctl.h>      // Flow control declarations
+#include <tm_svc.h>       // Time service declarations
+
+// Macro definitions:
+#define FLW_CTL_MSG_MAX AGG_TLM_MSG_MAX // Largest message in flow controlled
+                                        // queues in bytes
+
+// Message queue definitions:
+RT_QUEUE agg_tlm_msg_queue;    // For telemetry samples
+                               // (read_mdq/get_hk_tlm --> agg_tlm_task)
+RT_QUEUE flt_tbl_msg_queue;    // For telemetry frame handles
+                               // (agg_tlm/read_img --> flt_tbl_task)
+RT_QUEUE tx_tlm_pkt_msg_queue; // For telemetry frame handles
+                               // (flt_tbl_task/rtrv_file_task
+                               // --> tx_tlm_pkt_task)
+RT_QUEUE crt_file_msg_queue;   // For telemetry frame handles
+                               // (flt_tbl_task --> crt_file_task)
+
+// Flow control table:
+// (queue, semaphore name, limit, drop policy, frame handles, timeout)
+struct flw_ctl flw_ctl_tbl[FLW_CTL_NQUEUE] = {
+    {&agg_tlm_msg_queue,"agg_tlm_cred_sem",AGG_TLM_QUEUE_NMSG,\
+        FLW_CTL_DROP_APID,0,10000000},
+    {&flt_tbl_msg_queue,"flt_tbl_cred_sem",TLM_FRM_POOL_NFRM,\
+        FLW_CTL_DROP_APID,1,100000000},
+    {&tx_tlm_pkt_msg_queue,"tx_tlm_pkt_cred_sem",TLM_FRM_POOL_NFRM,\
+        FLW_CTL_DROP_OLDEST,1,100000000},
+    {&crt_file_msg_queue,"crt_file_cred_sem",TLM_FRM_POOL_NFRM,\
+        FLW_CTL_DROP_NEWEST,1,100000000},
+};
+
+// Create credit semaphores (one credit per message queue slot)
+void crt_flw_ctl() {
+    // Definitions and initializations:
+    uint8_t i;
+
+    // Loop to create semaphores:
+    for (i = 0; i < FLW_CTL_NQUEUE; ++i) {
+        rt_sem_create(&flw_ctl_tbl[i].cred,flw_ctl_tbl[i].name,\
+            flw_ctl_tbl[i].nmsg,S_FIFO);
+    }
+
+    return;
+}
+
+// Get frames or messages in message of size (frame handles or one message)
+static uint16_t get_flw_ctl_nitem(struct flw_ctl* fc, size_t msg_size) {
+    return fc->hdl_flg ? msg_size/TLM_FRM_HDL_SIZE : 1;
+}
+
+void drop_flw_ctl(struct flw_ctl* fc, uint16_t ndrop) {
+    // Count dropped frames or messages:
+    __atomic_add_fetch(&fc->drop_cnt,ndrop,__ATOMIC_RELAXED);
+
+    return;
+}
+
+// Drop oldest message in queue (its credit passes to the caller)
+static int32_t drop_oldest_flw_ctl(struct flw_ctl* fc) {
+    // Definitions and initializations:
+    int32_t ret_val; // Function return value
+    int32_t i;       // Counter
+
+    tlm_frm_hdl_t tlm_frm_hdl; // Telemetry frame handle (frame pool)
+
+    char msg_buf[FLW_CTL_MSG_MAX]; // Dropped message buffer
+
+    // Read oldest message without waiting:
+    ret_val = rt_queue_read(fc->queue,msg_buf,FLW_CTL_MSG_MAX,TM_NONBLOCK);
+
+    // Check success:
+    if (ret_val < 0) {
+        return ret_val;
+    }
+
+    // Release frame handles in dropped message:
+    if (fc->hdl_flg) {
+        for (i = 0; i+TLM_FRM_HDL_SIZE <= ret_val; i += TLM_FRM_HDL_SIZE) {
+            memcpy(&tlm_frm_hdl,msg_buf+i,TLM_FRM_HDL_SIZE);
+            rls_tlm_frm(tlm_frm_hdl);
+        }
+    }
+
+    // Count dropped message (frames released or message):
+    __atomic_sub_fetch(&fc->nmsg_use,1,__ATOMIC_RELAXED);
+    drop_flw_ctl(fc,get_flw_ctl_nitem(fc,ret_val));
+
+    return 0;
+}
+
+// Reserve credit for one message (waits up to queue timeout, then applies
+// drop policy; returns -ETIMEDOUT if the new message is to be dropped, which
+// the caller counts with drop_flw_ctl)
+int32_t rsv_flw_ctl(struct flw_ctl* fc, uint16_t apid) {
+    // Definitions and initializations:
+    int32_t ret_val; // Function return value
+    uint8_t drop_pol = __atomic_load_n(&fc->drop_pol,__ATOMIC_RELAXED);
+
+    // Wait for credit:
+    ret_val = rt_sem_p(&fc->cred,fc->timeout);
+
+    // Check success:
+    if (ret_val == 0) {
+        return 0;
+    }
+
+    // Apply drop policy (evict oldest message or drop new message):
+    if ((drop_pol == FLW_CTL_DROP_OLDEST) || \
+        ((drop_pol == FLW_CTL_DROP_APID) && (apid == FLW_CTL_APID_KEEP))) {
+        if (drop_oldest_flw_ctl(fc) == 0) {
+            return 0;
+        }
+    }
+
+    return -ETIMEDOUT;
+}
+
+// Cancel reserved credit (nothing to send after all)
+void cncl_flw_ctl(struct flw_ctl* fc) {
+    // Return credit:
+    rt_sem_v(&fc->cred);
+
+    return;
+}
+
+// Send message with reserved credit (credit is returned on failure)
+int32_t send_flw_ctl(struct flw_ctl* fc, void* msg, size_t msg_size) {
+    // Definitions and initializations:
+    int32_t  ret_val;  // Function return value
+    uint16_t nmsg_use; // Messages in queue
+    uint16_t hwm;      // High-water mark
+
+    // Count message before it can be read:
+    nmsg_use = __atomic_add_fetch(&fc->nmsg_use,1,__ATOMIC_RELAXED);
+
+    // Send message:
+    ret_val = rt_queue_write(fc->queue,msg,msg_size,Q_NORMAL);
+
+    // Check success:
+    if (ret_val < 0) {
+        // Return credit and count dropped message:
+        __atomic_sub_fetch(&fc->nmsg_use,1,__ATOMIC_RELAXED);
+        drop_flw_ctl(fc,get_flw_ctl_nitem(fc,msg_size));
+        rt_sem_v(&fc->cred);
+
+        return ret_val;
+    }
+
+    // Update high-water mark:
+    hwm = __atomic_load_n(&fc->hwm,__ATOMIC_RELAXED);
+    while ((nmsg_use > hwm) && !__atomic_compare_exchange_n(&fc->hwm,&hwm,\
+        nmsg_use,0,__ATOMIC_RELAXED,__ATOMIC_RELAXED));
+
+    return ret_val;
+}
+
+// Reserve credit and send message
+int32_t put_flw_ctl(struct flw_ctl* fc, void* msg, size_t msg_size,
+    uint16_t apid) {
+    // Definitions and initializations:
+    int32_t ret_val; // Function return value
+
+    // Reserve credit:
+    ret_val = rsv_flw_ctl(fc,apid);
+
+    // Check success:
+    if (ret_val < 0) {
+        // Count dropped message:
+        drop_flw_ctl(fc,get_flw_ctl_nitem(fc,msg_size));
+
+        return ret_val;
+    }
+
+    return send_flw_ctl(fc,msg,msg_size);
+}
+
+// Return credit of message read by consumer
+void rtn_flw_ctl(struct flw_ctl* fc) {
+    // Uncount message and return credit:
+    __atomic_sub_fetch(&fc->nmsg_use,1,__ATOMIC_RELAXED);
+    rt_sem_v(&fc->cred);
+
+    return;
+}
+
+int8_t set_flw_ctl_pol(uint32_t arg) {
+    // Definitions and initializations:
+    uint32_t queue = arg >> 8;  // Flow controlled message queue
+    uint32_t pol = arg & 0xFF;  // Drop policy
+
+    // Check queue and policy:
+    if ((queue >= FLW_CTL_NQUEUE) || (pol > FLW_CTL_DROP_APID)) {
+        return -1;
+    }
+
+    // Set drop policy (read by producers of queue):
+    __atomic_store_n(&flw_ctl_tbl[queue].drop_pol,pol,__ATOMIC_RELAXED);
+
+    return 1;
+}
@@ -0,0 +1,390 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Load Filter Table
+//
+// In-flight upload of filter table (TO & DS) definitions. The command
+// software task loads a definition word by word (ld_flt_tbl.h) into the
+// inactive one of two definition buffers. Once every word is received, the
+// definition is checked (CRC-16, row size, APIDs, ranges and frequencies),
+// persisted, and published by storing the buffer pointer and then counting
+// the publication in a generation count.
+//
+// The filter table task is the only reader. It compares the published
+// generation against the generation it compiled from on every transfer frame
+// (the pointer cannot tell two uploads apart, as the two buffers take turns)
+// and only when it changed reads the definition (to recompile its routing
+// descriptors) inside a read-side section marked by an odd sequence count.
+// The reader never waits. After publishing, the writer waits until any
+// read-side section that may still use the old buffer has ended (grace
+// period) before the old buffer can be reused for the next upload.
+//
+// The persisted definition is written to a temporary file, synced, and
+// renamed over the definition file, so a power loss leaves either the old or
+// the new definition. At startup the persisted definition is loaded if valid;
+// otherwise the default tables (flt_tbl.h) are used.
+//
+// -------------------------------------------------------------------------- /
+//
+// Dependencies:
+// - Xenomai 3 / Cobalt
+//
+// Input Arguments:
+// - N/A
+//
+// Output Arguments:
+// - N/A
+//
+// -------------------------------------------------------------------------- /
+//
+// agent
+// Project HEPCATS
+// Subsystem: C&DH
+// Created: October 17, 2026
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Standard libraries:
+#include <stdio.h>   // Standard input/output definitions
+#include <stdlib.h>  // Standard library
+#include <unistd.h>  // UNIX standard function definitions
+#include <string.h>  // String function definitions
+#include <stdint.h>  // Standard integer types
+
+// Xenomai libraries:
+#include <alchemy/task.h> // Task management services
+
+// Header files:
+#include <ccsds_pkt.h>  // CCSDS packet codec
+#include <ccsds_crc.h>  // CCSDS packet error control (CRC)
+#include <hk_tlm_var.h> // Housekeeping telemetry variable declarations
+#include <flt_tbl.h>    // Filter table (TO & DS) declarations
+#include <ld_flt_tbl.h> // Load filter table declarations
+#include <tm_svc.h>     // Time service declarations
+
+// Definition buffers:
+static struct flt_tbl_def flt_tbl_def_buf[2];
+
+// Published definition (read by filter table task):
+static struct flt_tbl_def* flt_tbl_def_pub = &flt_tbl_def_buf[0];
+
+// Published definition generation (counted after every publication):
+static uint32_t flt_tbl_def_gen = 0;
+
+// Read-side sequence count (odd while filter table task reads definition):
+static uint32_t flt_tbl_def_rd_seq = 0;
+
+// Upload state (command software task only):
+static uint8_t  ld_flt_tbl_act = 0;                   // Upload in progress
+static uint16_t ld_flt_tbl_nwrd;                      // Words in upload
+static uint16_t ld_flt_tbl_rcv_cnt;                   // Words received
+static uint8_t  ld_flt_tbl_rcv_flg[FLT_TBL_DEF_NWRD]; // Word received flags
+
+// Get inactive (loading) definition buffer
+static struct flt_tbl_def* get_ld_flt_tbl_def() {
+    return (flt_tbl_def_pub == &flt_tbl_def_buf[0]) ? \
+        &flt_tbl_def_buf[1] : &flt_tbl_def_buf[0];
+}
+
+// Calculate CRC-16 of definition (row size and words, big-endian)
+static uint16_t calc_flt_tbl_def_crc(const struct flt_tbl_def* def) {
+    // Definitions and initializations:
+    uint16_t row;   // Row
+    uint16_t col;   // Column
+    size_t   n = 0; // Bytes serialized
+
+    char buf[2+FLT_TBL_DEF_NWRD*2]; // Serialized definition
+
+    // Serialize row size:
+    buf[n++] = def->nrow >> 8;
+    buf[n++] = def->nrow & 0xFF;
+
+    // Serialize TO then DS table rows:
+    for (row = 0; row < def->nrow; ++row) {
+        for (col = 0; col < FLT_TBL_COL; ++col) {
+            buf[n++] = def->to[row][col] >> 8;
+            buf[n++] = def->to[row][col] & 0xFF;
+        }
+    }
+    for (row = 0; row < def->nrow; ++row) {
+        for (col = 0; col < FLT_TBL_COL; ++col) {
+            buf[n++] = def->ds[row][col] >> 8;
+            buf[n++] = def->ds[row][col] & 0xFF;
+        }
+    }
+
+    return calc_ccsds_crc(buf,n);
+}
+
+// Check definition (returns -1 if invalid)
+static int8_t chk_flt_tbl_def(const struct flt_tbl_def* def) {
+    // Definitions and initializations:
+    uint16_t row; // Row
+    uint16_t col; // Column
+    uint16_t i;   // Counter
+
+    // Check row size:
+    if ((def->nrow == 0) || (def->nrow > FLT_TBL_ROW_MAX)) {
+        return -1;
+    }
+
+    // Check rows:
+    for (row = 0; row < def->nrow; ++row) {
+        // Check APID (valid, same in both tables, and not repeated):
+        if ((def->to[row][0] > CCSDS_APID_MASK) || \
+            (def->to[row][0] != def->ds[row][0])) {
+            return -1;
+        }
+        for (i = 0; i < row; ++i) {
+            if (def->to[i][0] == def->to[row][0]) {
+                return -1;
+            }
+        }
+
+        // Check ranges and frequencies (routing descriptors hold 8 bits):
+        for (col = 1; col < FLT_TBL_COL; ++col) {
+            if ((def->to[row][col] > 255) || (def->ds[row][col] > 255)) {
+                return -1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+// Write definition to definition file (temporary file renamed over it)
+static int8_t wrt_flt_tbl_def(const struct flt_tbl_def* def) {
+    // Definitions and initializations:
+    FILE* fd; // Definition file
+
+    // Write temporary file:
+    fd = fopen(FLT_TBL_DEF_TMP,"wb");
+    if (fd == NULL) {
+        return -1;
+    }
+    if ((fwrite(def,sizeof(struct flt_tbl_def),1,fd) != 1) || \
+        (fflush(fd) != 0) || (fsync(fileno(fd)) != 0)) {
+        fclose(fd);
+        remove(FLT_TBL_DEF_TMP);
+        return -1;
+    }
+    fclose(fd);
+
+    // Replace definition file:
+    if (rename(FLT_TBL_DEF_TMP,FLT_TBL_DEF_FILE) != 0) {
+        remove(FLT_TBL_DEF_TMP);
+        return -1;
+    }
+
+    return 0;
+}
+
+// Load persisted or default definition (before tasks start)
+void init_flt_tbl_def() {
+    // Definitions and initializations:
+    FILE*    fd;     // Definition file
+    uint8_t  ld_flg; // Persisted definition loaded flag
+    uint16_t row;    // Row
+
+    struct flt_tbl_def* def = &flt_tbl_def_buf[0]; // Definition
+
+    // Read persisted definition:
+    ld_flg = 0;
+    fd = fopen(FLT_TBL_DEF_FILE,"rb");
+    if (fd != NULL) {
+        if ((fread(def,sizeof(struct flt_tbl_def),1,fd) == 1) && \
+            (chk_flt_tbl_def(def) == 0) && \
+            (calc_flt_tbl_def_crc(def) == def->crc)) {
+            ld_flg = 1;
+        }
+        fclose(fd);
+    }
+
+    // Check success:
+    if (ld_flg) {
+        // Print:
+        rt_printf("%d (LD_FLT_TBL) Persisted filter table loaded (%d rows,"
+            " CRC 0x%04X)\n",get_tm_sec(),def->nrow,def->crc);
+    } else {
+        // Use default tables:
+        memset(def,0,sizeof(struct flt_tbl_def));
+        def->nrow = FLT_TBL_ROW;
+        for (row = 0; row < FLT_TBL_ROW; ++row) {
+            memcpy(def->to[row],flt_tbl_to[row],sizeof(flt_tbl_to[row]));
+            memcpy(def->ds[row],flt_tbl_ds[row],sizeof(flt_tbl_ds[row]));
+        }
+        def->crc = calc_flt_tbl_def_crc(def);
+
+        // Print:
+        rt_printf("%d (LD_FLT_TBL) No valid persisted filter table; default"
+            " filter table loaded (CRC 0x%04X)\n",get_tm_sec(),def->crc);
+    }
+
+    // Publish:
+    flt_tbl_def_crc = def->crc;
+    __atomic_store_n(&flt_tbl_def_pub,def,__ATOMIC_SEQ_CST);
+    __atomic_add_fetch(&flt_tbl_def_gen,1,__ATOMIC_SEQ_CST);
+
+    return;
+}
+
+// Get published definition generation (to check for a change)
+uint32_t get_flt_tbl_def_gen() {
+    return __atomic_load_n(&flt_tbl_def_gen,__ATOMIC_SEQ_CST);
+}
+
+// Begin reading published definition (filter table task)
+const struct flt_tbl_def* bgn_rd_flt_tbl_def(uint32_t* gen) {
+    // Mark read-side section, then get generation and definition (the
+    // generation is counted after the pointer is stored, so the definition
+    // is at least as new as the generation):
+    __atomic_add_fetch(&flt_tbl_def_rd_seq,1,__ATOMIC_SEQ_CST);
+    *gen = __atomic_load_n(&flt_tbl_def_gen,__ATOMIC_SEQ_CST);
+
+    return __atomic_load_n(&flt_tbl_def_pub,__ATOMIC_SEQ_CST);
+}
+
+// End reading published definition (filter table task)
+void end_rd_flt_tbl_def() {
+    __atomic_add_fetch(&flt_tbl_def_rd_seq,1,__ATOMIC_RELEASE);
+
+    return;
+}
+
+// Begin upload (command argument is the number of rows)
+int8_t bgn_ld_flt_tbl(uint32_t nrow) {
+    // Definitions and initializations:
+    struct flt_tbl_def* def = get_ld_flt_tbl_def(); // Loading definition
+
+    // Check row size:
+    if ((nrow == 0) || (nrow > FLT_TBL_ROW_MAX)) {
+        // Print:
+        rt_printf("%d (LD_FLT_TBL) Invalid filter table row size %d (maximum"
+            " %d)\n",get_tm_sec(),nrow,FLT_TBL_ROW_MAX);
+
+        return -1;
+    }
+
+    // Reset loading definition and received words:
+    memset(def,0,sizeof(struct flt_tbl_def));
+    memset(ld_flt_tbl_rcv_flg,0,sizeof(ld_flt_tbl_rcv_flg));
+    def->nrow = nrow;
+    ld_flt_tbl_nwrd = nrow*FLT_TBL_COL*2;
+    ld_flt_tbl_rcv_cnt = 0;
+    ld_flt_tbl_act = 1;
+
+    // Print:
+    rt_printf("%d (LD_FLT_TBL) Filter table upload started (%d rows, %d"
+        " words)\n",get_tm_sec(),nrow,ld_flt_tbl_nwrd);
+
+    return 1;
+}
+
+// Load word of upload (command argument is (word index << 16) | word)
+int8_t ld_flt_tbl_wrd(uint32_t arg) {
+    // Definitions and initializations:
+    uint16_t idx = arg >> 16;    // Word index
+    uint16_t wrd = arg & 0xFFFF; // Word
+    uint16_t tbl_nwrd;           // Words per table
+
+    struct flt_tbl_def* def = get_ld_flt_tbl_def(); // Loading definition
+
+    // Check upload in progress and word index:
+    if (!ld_flt_tbl_act || (idx >= ld_flt_tbl_nwrd)) {
+        // Print:
+        rt_printf("%d (LD_FLT_TBL) Filter table word %d unexpected; ignored"
+            "\n",get_tm_sec(),idx);
+
+        return -1;
+    }
+
+    // Store word (TO table first, then DS table):
+    tbl_nwrd = def->nrow*FLT_TBL_COL;
+    if (idx < tbl_nwrd) {
+        def->to[idx/FLT_TBL_COL][idx % FLT_TBL_COL] = wrd;
+    } else {
+        idx -= tbl_nwrd;
+        def->ds[idx/FLT_TBL_COL][idx % FLT_TBL_COL] = wrd;
+        idx += tbl_nwrd;
+    }
+
+    // Count word (a repeated word overwrites the previous one):
+    if (!ld_flt_tbl_rcv_flg[idx]) {
+        ld_flt_tbl_rcv_flg[idx] = 1;
+        ld_flt_tbl_rcv_cnt++;
+    }
+
+    return 1;
+}
+
+// Validate, persist, and publish upload (command argument is the CRC-16)
+int8_t end_ld_flt_tbl(uint16_t crc) {
+    // Definitions and initializations:
+    uint32_t seq; // Read-side sequence count
+
+    struct flt_tbl_def* def = get_ld_flt_tbl_def(); // Loading definition
+
+    // Check upload in progress:
+    if (!ld_flt_tbl_act) {
+        // Print:
+        rt_printf("%d (LD_FLT_TBL) No filter table upload in progress\n",\
+            get_tm_sec());
+
+        return -1;
+    }
+
+    // Upload ends here whether or not the definition is accepted:
+    ld_flt_tbl_act = 0;
+
+    // Check every word was received:
+    if (ld_flt_tbl_rcv_cnt != ld_flt_tbl_nwrd) {
+        // Print:
+        rt_printf("%d (LD_FLT_TBL) Filter table upload incomplete (%d of %d"
+            " words); rejected\n",get_tm_sec(),ld_flt_tbl_rcv_cnt,\
+            ld_flt_tbl_nwrd);
+
+        return -1;
+    }
+
+    // Check CRC and definition:
+    def->crc = calc_flt_tbl_def_crc(def);
+    if (def->crc != crc) {
+        // Print:
+        rt_printf("%d (LD_FLT_TBL) Filter table CRC 0x%04X does not match"
+            " 0x%04X; rejected\n",get_tm_sec(),def->crc,crc);
+
+        return -1;
+    }
+    if (chk_flt_tbl_def(def) < 0) {
+        // Print:
+        rt_printf("%d (LD_FLT_TBL) Filter table invalid; rejected\n",\
+            get_tm_sec());
+
+        return -1;
+    }
+
+    // Persist (definition is still published if this fails):
+    if (wrt_flt_tbl_def(def) < 0) {
+        // Print:
+        rt_printf("%d (LD_FLT_TBL) Error writing filter table file; table"
+            " will not survive restart\n",get_tm_sec());
+    }
+
+    // Publish:
+    __atomic_store_n(&flt_tbl_def_pub,def,__ATOMIC_SEQ_CST);
+    __atomic_add_fetch(&flt_tbl_def_gen,1,__ATOMIC_SEQ_CST);
+    flt_tbl_def_crc = def->crc;
+
+    // Wait for grace period (read-side section in progress may still use the
+    // old definition buffer, which is the next loading buffer):
+    seq = __atomic_load_n(&flt_tbl_def_rd_seq,__ATOMIC_SEQ_CST);
+    while ((seq & 1) && \
+        (__atomic_load_n(&flt_tbl_def_rd_seq,__ATOMIC_ACQUIRE) == seq)) {
+        rt_task_sleep(1000000);
+    }
+
+    // Print:
+    rt_printf("%d (LD_FLT_TBL) Filter table uploaded and published (%d rows,"
+        " CRC 0x%04X)\n",get_tm_sec(),def->nrow,def->crc);
+
+    return 1;
+}
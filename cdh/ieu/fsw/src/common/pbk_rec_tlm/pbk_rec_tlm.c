@@ -0,0 +1,1018 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Play Back Recorded Telemetry
+//
+// Indexed playback engine used by retrieve file task. Playback parameters
+// are staged and downlinked ranges are acknowledged by command software task
+// (see pbk_rec_tlm.h). Command software task only changes the state while no
+// playback is in progress, so the state is never changed by both tasks.
+// Write file task reads the downlinked ranges to evict downlinked segments
+// (rec_tlm.h); ranges are changed inside a sequence count, and a copy taken
+// while they change is not used (the segment is kept), so write file task
+// never waits on command software task.
+//
+// A playback is done in two passes over the segments of the selected
+// classes (oldest first):
+//     - Plan:   segments whose time window is outside the playback window are
+//               skipped by name; the index of every other segment is scanned
+//               for frames in the window (8 bytes per frame) that are after
+//               the cursor and not downlinked
+//     - Stream: segments with selected frames are mapped (mmap) for
+//               sequential access and selected frames are copied from the
+//               mapping into pool frames for the transmit task. The kernel is
+//               told to read PBK_REC_TLM_RDAHD_NREC frames ahead of playback
+//               (madvise), so playback does not wait on storage per frame.
+//
+// Frames are paced by a token bucket refilled at the playback share of the
+// downlink byte rate (flt_tbl.h), so playback leaves the rest of the link to
+// realtime telemetry instead of filling the transmit queue. The share is
+// published while streaming, and the filter table task takes it out of the
+// realtime downlink budget, so the two together never exceed the link.
+// Playback stops before the first frame that would exceed the byte budget.
+// Progress (percent of selected frames or of the byte budget, whichever is
+// further along; at least 1) is published in pbk_prog_flg.
+//
+// The state file is written to a temporary file that is synced and renamed
+// over the state file, so a power loss leaves either the old or the new
+// state. Cursors are saved every PBK_REC_TLM_SAVE_NFRM frames and at the end
+// of a playback; frames since the last save are played back again after a
+// restart.
+//
+// -------------------------------------------------------------------------- /
+//
+// Dependencies:
+// - Xenomai 3 / Cobalt
+//
+// Input Arguments:
+// - N/A
+//
+// Output Arguments:
+// - N/A
+//
+// -------------------------------------------------------------------------- /
+//
+// agent
+// Project HEPCATS
+// Subsystem: C&DH
+// Created: October 17, 2026
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Standard libraries:
+#include <stdio.h>    // Standard input/output definitions
+#include <stdlib.h>   // Standard library
+#include <unistd.h>   // UNIX standard function definitions
+#include <string.h>   // String function definitions
+#include <stdint.h>   // Standard integer types
+#include <stddef.h>   // Standard definitions (offsetof)
+#include <fcntl.h>    // File control definitions
+#include <sys/mman.h> // Memory mapped files
+#include <sys/stat.h> // File status (fstat)
+
+// Xenomai libraries:
+#include <alchemy/task.h>  // Task management services
+#include <alchemy/queue.h> // Message queue services
+#include <alchemy/sem.h>   // Semaphore services
+#include <alchemy/timer.h> // Timer management services
+
+// Header files:
+#include <tlm_frm_pool.h> // Telemetry frame pool declarations
+#include <rec_tlm.h>      // Record telemetry declarations
+#include <pbk_rec_tlm.h>  // Play back recorded telemetry declarations
+#include <flw_ctl.h>      // Flow control declarations
+#include <flt_tbl.h>      // Filter table (downlink byte rate)
+#include <ccsds_pkt.h>    // CCSDS packet codec
+#include <ccsds_asm.h>    // CCSDS attached sync marker
+#include <ccsds_crc.h>    // CCSDS packet error control (CRC)
+#include <hk_tlm_var.h>   // Housekeeping telemetry variable declarations
+#include <tm_svc.h>       // Time service declarations
+
+// Macro definitions:
+#define PBK_REC_TLM_PACE_DEPTH \
+    (2*(CCSDS_ASM_SIZE+CCSDS_TLM_PKT_MAX)) // Pacing bucket depth in bytes
+
+// Persisted state structure (host order; internal to flight software):
+struct pbk_rec_tlm_stat {
+    uint32_t bgn_sec;  // Staged window start (sec)
+    uint32_t end_sec;  // Staged window end (sec; 0: playback start)
+    uint32_t byte_lim; // Staged byte budget (0: none)
+    uint32_t pct;      // Staged share of link rate (%)
+
+    struct pbk_rec_tlm_cur cur[REC_TLM_NCLS]; // Cursors
+
+    // Window played back up to (sec, exclusive; 0: nothing) of class:
+    uint32_t pbk_sec[REC_TLM_NCLS];
+
+    // Downlinked ranges of class (merged, oldest first):
+    struct pbk_rec_tlm_rng ack[REC_TLM_NCLS][PBK_REC_TLM_NACK];
+    uint32_t nack[REC_TLM_NCLS];
+
+    uint16_t crc; // CRC-16 of state
+};
+
+// Mapped file structure:
+struct pbk_rec_tlm_map {
+    int         fd;   // File descriptor
+    const char* buf;  // Mapping (NULL: not mapped)
+    size_t      size; // Mapping size in bytes
+};
+
+// Playback progress structure:
+struct pbk_rec_tlm_prog {
+    uint32_t nfrm;     // Frames selected (plan)
+    uint32_t frm_cnt;  // Frames played back
+    uint32_t byte_cnt; // Bytes played back (on the line)
+    uint32_t byte_lim; // Byte budget (0: none)
+    uint8_t  lim_flg;  // Byte budget reached
+    uint8_t  err_flg;  // Frame could not be queued
+    uint32_t save_cnt; // Frames played back since cursor save
+};
+
+// Pacing token bucket structure:
+struct pbk_rec_tlm_pace {
+    uint32_t tkn;     // Tokens in bytes
+    uint32_t rate;    // Refill rate in bytes/sec
+    RTIME    tm_prev; // Last refill time
+    uint64_t rem;     // Refill remainder (bytes*ns/sec)
+};
+
+// Playback state:
+static struct pbk_rec_tlm_stat pbk_rec_tlm_stat;
+
+// Downlinked ranges sequence count (odd: ranges being changed):
+static uint32_t pbk_rec_tlm_ack_seq = 0;
+
+// Share of link rate of playback in progress (0: idle):
+static uint8_t pbk_rec_tlm_act_pct = 0;
+
+// Calculate CRC-16 of state
+static uint16_t calc_pbk_rec_tlm_crc(const struct pbk_rec_tlm_stat* stat) {
+    return calc_ccsds_crc((const char*) stat,\
+        offsetof(struct pbk_rec_tlm_stat,crc));
+}
+
+// Write state to state file (temporary file renamed over it)
+static int8_t wrt_pbk_rec_tlm() {
+    // Definitions and initializations:
+    FILE* fd; // State file
+
+    // Update CRC-16:
+    pbk_rec_tlm_stat.crc = calc_pbk_rec_tlm_crc(&pbk_rec_tlm_stat);
+
+    // Write temporary file:
+    fd = fopen(PBK_REC_TLM_TMP,"wb");
+    if (fd == NULL) {
+        return -1;
+    }
+    if ((fwrite(&pbk_rec_tlm_stat,sizeof(pbk_rec_tlm_stat),1,fd) != 1) || \
+        (fflush(fd) != 0) || (fsync(fileno(fd)) != 0)) {
+        fclose(fd);
+        remove(PBK_REC_TLM_TMP);
+        return -1;
+    }
+    fclose(fd);
+
+    // Replace state file:
+    if (rename(PBK_REC_TLM_TMP,PBK_REC_TLM_FILE) != 0) {
+        remove(PBK_REC_TLM_TMP);
+        return -1;
+    }
+
+    return 0;
+}
+
+// Load persisted state (before tasks start)
+void init_pbk_rec_tlm() {
+    // Definitions and initializations:
+    FILE*   fd;     // State file
+    uint8_t ld_flg; // Persisted state loaded flag
+    uint8_t cls;    // Class counter
+
+    // Read persisted state:
+    ld_flg = 0;
+    fd = fopen(PBK_REC_TLM_FILE,"rb");
+    if (fd != NULL) {
+        if ((fread(&pbk_rec_tlm_stat,sizeof(pbk_rec_tlm_stat),1,fd) == 1) \
+            && (calc_pbk_rec_tlm_crc(&pbk_rec_tlm_stat) == \
+            pbk_rec_tlm_stat.crc)) {
+            ld_flg = 1;
+            for (cls = 0; cls < REC_TLM_NCLS; ++cls) {
+                ld_flg &= (pbk_rec_tlm_stat.nack[cls] <= PBK_REC_TLM_NACK);
+            }
+            ld_flg &= (pbk_rec_tlm_stat.pct >= 1) && \
+                (pbk_rec_tlm_stat.pct <= 100);
+        }
+        fclose(fd);
+    }
+
+    // Check success:
+    if (ld_flg) {
+        // Print:
+        rt_printf("%d (PBK_REC_TLM) Persisted playback state loaded (window"
+            " %u to %u sec)\n",get_tm_sec(),pbk_rec_tlm_stat.bgn_sec,\
+            pbk_rec_tlm_stat.end_sec);
+    } else {
+        // Use defaults (whole record, no budget, nothing downlinked):
+        memset(&pbk_rec_tlm_stat,0,sizeof(pbk_rec_tlm_stat));
+        pbk_rec_tlm_stat.pct = PBK_REC_TLM_PCT_DFLT;
+
+        // Print:
+        rt_printf("%d (PBK_REC_TLM) No valid persisted playback state;"
+            " defaults loaded\n",get_tm_sec());
+    }
+
+    return;
+}
+
+int8_t set_pbk_rec_tlm_bgn(uint32_t sec) {
+    // Stage window start and reset cursors (new selection):
+    pbk_rec_tlm_stat.bgn_sec = sec;
+    memset(pbk_rec_tlm_stat.cur,0,sizeof(pbk_rec_tlm_stat.cur));
+    memset(pbk_rec_tlm_stat.pbk_sec,0,sizeof(pbk_rec_tlm_stat.pbk_sec));
+
+    return (wrt_pbk_rec_tlm() == 0) ? 1 : -1;
+}
+
+int8_t set_pbk_rec_tlm_end(uint32_t sec) {
+    // Stage window end and reset cursors (new selection):
+    pbk_rec_tlm_stat.end_sec = sec;
+    memset(pbk_rec_tlm_stat.cur,0,sizeof(pbk_rec_tlm_stat.cur));
+    memset(pbk_rec_tlm_stat.pbk_sec,0,sizeof(pbk_rec_tlm_stat.pbk_sec));
+
+    return (wrt_pbk_rec_tlm() == 0) ? 1 : -1;
+}
+
+int8_t set_pbk_rec_tlm_lim(uint32_t lim) {
+    pbk_rec_tlm_stat.byte_lim = lim;
+
+    return (wrt_pbk_rec_tlm() == 0) ? 1 : -1;
+}
+
+int8_t set_pbk_rec_tlm_pct(uint32_t pct) {
+    // Check share:
+    if ((pct < 1) || (pct > 100)) {
+        return -1;
+    }
+    pbk_rec_tlm_stat.pct = pct;
+
+    return (wrt_pbk_rec_tlm() == 0) ? 1 : -1;
+}
+
+int8_t get_pbk_rec_tlm_sel(uint32_t arg, struct pbk_rec_tlm_sel* sel) {
+    // Get classes from argument (class or class mask):
+    if (arg < REC_TLM_NCLS) {
+        sel->cls_msk = 1 << arg;
+    } else if (((arg & ~((1 << REC_TLM_NCLS)-1)) == PBK_REC_TLM_ARG_MSK) \
+        && (arg != PBK_REC_TLM_ARG_MSK)) {
+        sel->cls_msk = arg & ((1 << REC_TLM_NCLS)-1);
+    } else {
+        return -1;
+    }
+
+    // Get staged window (an open window ends at playback start, so frames
+    // recorded during playback are not chased) and byte budget:
+    sel->bgn_sec = pbk_rec_tlm_stat.bgn_sec;
+    sel->end_sec = (pbk_rec_tlm_stat.end_sec != 0) ? \
+        pbk_rec_tlm_stat.end_sec : get_tm_sec();
+    sel->byte_lim = pbk_rec_tlm_stat.byte_lim;
+
+    return 0;
+}
+
+// Map file read-only for sequential access (returns 0 or -1 on error or
+// empty file)
+static int8_t map_pbk_rec_tlm(const char* seg, const char* ext,\
+    struct pbk_rec_tlm_map* map) {
+    // Definitions and initializations:
+    struct stat st; // File status
+
+    char path[REC_TLM_NAME_MAX+4]; // File path
+
+    // Open file:
+    sprintf(path,"%s%s",seg,ext);
+    map->buf = NULL;
+    map->fd = open(path,O_RDONLY);
+    if ((map->fd < 0) || (fstat(map->fd,&st) != 0) || (st.st_size == 0)) {
+        if (map->fd >= 0) close(map->fd);
+
+        return -1;
+    }
+    map->size = st.st_size;
+
+    // Map file and advise sequential access (larger readahead, pages
+    // behind playback are dropped first):
+    map->buf = mmap(NULL,map->size,PROT_READ,MAP_SHARED,map->fd,0);
+    if (map->buf == MAP_FAILED) {
+        // Print:
+        rt_printf("%d (PBK_REC_TLM) Error mapping %s\n",get_tm_sec(),path);
+
+        map->buf = NULL;
+        close(map->fd);
+
+        return -1;
+    }
+    posix_fadvise(map->fd,0,0,POSIX_FADV_SEQUENTIAL);
+    madvise((void*) map->buf,map->size,MADV_SEQUENTIAL);
+
+    return 0;
+}
+
+// Unmap file
+static void unmap_pbk_rec_tlm(struct pbk_rec_tlm_map* map) {
+    if (map->buf != NULL) {
+        munmap((void*) map->buf,map->size);
+        close(map->fd);
+        map->buf = NULL;
+    }
+
+    return;
+}
+
+// Get time window start and part of segment from its name
+static void get_pbk_rec_tlm_seg(const char* seg, uint32_t* sec,\
+    uint32_t* part) {
+    *sec = 0;
+    *part = 0;
+    sscanf(strrchr(seg,'/')+1,"%u_%u",sec,part);
+
+    return;
+}
+
+// Get first frame of segment after cursor (returns -1 if segment is before
+// cursor)
+static int64_t get_pbk_rec_tlm_cur(const char* seg, uint8_t cls) {
+    // Definitions and initializations:
+    const struct pbk_rec_tlm_cur* cur = &pbk_rec_tlm_stat.cur[cls]; // Cursor
+    uint32_t sec;  // Segment time window start (sec)
+    uint32_t part; // Segment part of time window
+
+    // Compare segment with cursor segment (time window, then part):
+    get_pbk_rec_tlm_seg(seg,&sec,&part);
+    if ((sec < cur->sec) || ((sec == cur->sec) && (part < cur->part))) {
+        return -1;
+    }
+
+    return ((sec == cur->sec) && (part == cur->part)) ? cur->nrec : 0;
+}
+
+// Check if segment time window overlaps playback window
+static uint8_t chk_pbk_rec_tlm_seg(const char* seg,\
+    const struct pbk_rec_tlm_sel* sel) {
+    // Definitions and initializations:
+    uint32_t win;  // Segment time window start (sec)
+    uint32_t part; // Segment part of time window
+
+    // Get time window start from segment name:
+    get_pbk_rec_tlm_seg(seg,&win,&part);
+
+    return (win+REC_TLM_SEG_PRD > sel->bgn_sec) && (win < sel->end_sec);
+}
+
+// Check if frame time is in a downlinked range of class
+static uint8_t chk_pbk_rec_tlm_ack(uint32_t sec, uint8_t cls) {
+    // Definitions and initializations:
+    const struct pbk_rec_tlm_rng* ack = pbk_rec_tlm_stat.ack[cls];
+    uint32_t i;
+
+    for (i = 0; i < pbk_rec_tlm_stat.nack[cls]; ++i) {
+        if ((sec >= ack[i].bgn_sec) && (sec < ack[i].end_sec)) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+// Check if index entry is selected (in playback window, not downlinked)
+static inline uint8_t chk_pbk_rec_tlm_idx(const struct rec_tlm_idx* idx,\
+    const struct pbk_rec_tlm_sel* sel, uint8_t cls) {
+    return (idx->sec >= sel->bgn_sec) && (idx->sec < sel->end_sec) && \
+        !chk_pbk_rec_tlm_ack(idx->sec,cls);
+}
+
+// Count selected frames of segment after cursor (plan)
+static uint32_t cnt_pbk_rec_tlm_seg(const char* seg,\
+    const struct pbk_rec_tlm_sel* sel, uint8_t cls) {
+    // Definitions and initializations:
+    struct pbk_rec_tlm_map idx_map; // Mapped index
+    const struct rec_tlm_idx* idx;  // Index entries
+
+    int64_t  n;        // Frame counter
+    uint32_t nrec;     // Index entries
+    uint32_t nfrm = 0; // Selected frames
+
+    // Get first frame after cursor:
+    n = get_pbk_rec_tlm_cur(seg,cls);
+    if (n < 0) {
+        return 0;
+    }
+
+    // Map index:
+    if (map_pbk_rec_tlm(seg,".idx",&idx_map) != 0) {
+        return 0;
+    }
+    idx = (const struct rec_tlm_idx*) idx_map.buf;
+    nrec = idx_map.size/REC_TLM_IDX_SIZE;
+
+    // Count selected index entries:
+    for (; n < nrec; ++n) {
+        nfrm += chk_pbk_rec_tlm_idx(&idx[n],sel,cls);
+    }
+
+    // Unmap index:
+    unmap_pbk_rec_tlm(&idx_map);
+
+    return nfrm;
+}
+
+// Publish playback progress
+static void set_pbk_rec_tlm_prog(const struct pbk_rec_tlm_prog* prog) {
+    // Definitions and initializations:
+    uint32_t pct = 0; // Percent complete
+
+    // Get percent of selected frames or byte budget (further along):
+    if (prog->nfrm > 0) {
+        pct = (uint64_t) prog->frm_cnt*100/prog->nfrm;
+    }
+    if ((prog->byte_lim > 0) && \
+        ((uint64_t) prog->byte_cnt*100/prog->byte_lim > pct)) {
+        pct = (uint64_t) prog->byte_cnt*100/prog->byte_lim;
+    }
+
+    // Publish (0 is idle):
+    pbk_prog_flg = (pct < 1) ? 1 : (pct > 100) ? 100 : pct;
+
+    return;
+}
+
+// Refill pacing bucket from playback share of link rate
+static void fill_pbk_rec_tlm_pace(struct pbk_rec_tlm_pace* pace) {
+    // Definitions and initializations:
+    uint32_t byte_cnt; // Bytes since last refill
+
+    RTIME tm_now = rt_timer_read(); // Current time
+    RTIME tm_dlt;                   // Time since last refill (ns)
+
+    // Get time since last refill (at most one second; bucket holds less):
+    tm_dlt = rt_timer_ticks2ns(tm_now - pace->tm_prev);
+    if (tm_dlt > 1000000000) {
+        tm_dlt = 1000000000;
+        pace->rem = 0;
+    }
+    pace->tm_prev = tm_now;
+
+    // Get bytes (keep remainder for next refill):
+    pace->rem += (uint64_t) tm_dlt*pace->rate;
+    byte_cnt = pace->rem/1000000000;
+    pace->rem -= (uint64_t) byte_cnt*1000000000;
+
+    // Fill bucket (at most depth):
+    pace->tkn = (pace->tkn+byte_cnt > PBK_REC_TLM_PACE_DEPTH) ? \
+        PBK_REC_TLM_PACE_DEPTH : pace->tkn+byte_cnt;
+
+    return;
+}
+
+// Wait until pacing bucket can pay for frame and charge it
+static void wait_pbk_rec_tlm_pace(struct pbk_rec_tlm_pace* pace,\
+    uint16_t size) {
+    // Refill and sleep for missing tokens until frame is paid for:
+    fill_pbk_rec_tlm_pace(pace);
+    while (pace->tkn < size) {
+        rt_task_sleep(rt_timer_ns2ticks((uint64_t) (size-pace->tkn)*\
+            1000000000/pace->rate+1));
+        fill_pbk_rec_tlm_pace(pace);
+    }
+    pace->tkn -= size;
+
+    return;
+}
+
+// Set time window of class is played back up to (frames before time played
+// back)
+static void set_pbk_rec_tlm_end_sec(uint8_t cls, uint32_t sec) {
+    if (sec > pbk_rec_tlm_stat.pbk_sec[cls]) {
+        pbk_rec_tlm_stat.pbk_sec[cls] = sec;
+    }
+
+    return;
+}
+
+// Stream selected frames of segment after cursor (stops at byte budget or at
+// frame that could not be queued)
+static void strm_pbk_rec_tlm_seg(const char* seg,\
+    const struct pbk_rec_tlm_sel* sel, uint8_t cls,\
+    struct pbk_rec_tlm_pace* pace, struct pbk_rec_tlm_prog* prog) {
+    // Definitions and initializations:
+    struct pbk_rec_tlm_map idx_map; // Mapped index
+    struct pbk_rec_tlm_map seg_map; // Mapped segment
+    const struct rec_tlm_idx* idx;  // Index entries
+    const char* rec;                // Record (header and frame)
+    const char* frm;                // Recorded frame
+
+    struct pbk_rec_tlm_cur* cur = &pbk_rec_tlm_stat.cur[cls]; // Cursor
+
+    int32_t  ret_val;       // Function return value
+    int64_t  n;             // Frame counter
+    uint32_t nrec;          // Whole records with index entries
+    uint32_t rdahd_end = 0; // End of requested readahead (frame)
+    size_t   rdahd_off;     // Readahead offset (page aligned)
+    size_t   pg_size;       // Page size in bytes
+    uint16_t size;          // Frame size on the line in bytes
+    uint16_t apid;          // Transfer frame origin
+
+    tlm_frm_hdl_t tlm_frm_hdl; // Telemetry frame handle (frame pool)
+
+    // Get first frame after cursor:
+    n = get_pbk_rec_tlm_cur(seg,cls);
+    if (n < 0) {
+        return;
+    }
+
+    // Map index and segment:
+    if (map_pbk_rec_tlm(seg,".idx",&idx_map) != 0) {
+        return;
+    }
+    if (map_pbk_rec_tlm(seg,".seg",&seg_map) != 0) {
+        // Print:
+        rt_printf("%d (PBK_REC_TLM) Error opening segment %s\n",\
+            get_tm_sec(),seg);
+
+        unmap_pbk_rec_tlm(&idx_map);
+
+        return;
+    }
+    idx = (const struct rec_tlm_idx*) idx_map.buf;
+    pg_size = sysconf(_SC_PAGESIZE);
+
+    // Get whole records with index entries:
+    nrec = (seg_map.size < REC_TLM_SEG_HDR_SIZE) ? 0 : \
+        (seg_map.size-REC_TLM_SEG_HDR_SIZE)/REC_TLM_REC_SIZE;
+    if (idx_map.size/REC_TLM_IDX_SIZE < nrec) {
+        nrec = idx_map.size/REC_TLM_IDX_SIZE;
+    }
+
+    // Loop over frames of segment after cursor:
+    for (; n < nrec; ++n) {
+        // Skip frame not selected (not read from storage):
+        if (!chk_pbk_rec_tlm_idx(&idx[n],sel,cls)) {
+            continue;
+        }
+
+        // Request next frames ahead of playback:
+        if (n >= rdahd_end) {
+            rdahd_end = n+PBK_REC_TLM_RDAHD_NREC;
+            if (rdahd_end > nrec) {
+                rdahd_end = nrec;
+            }
+            rdahd_off = (REC_TLM_SEG_HDR_SIZE+(size_t) n*REC_TLM_REC_SIZE) & \
+                ~(pg_size-1);
+            madvise((void*) (seg_map.buf+rdahd_off),REC_TLM_SEG_HDR_SIZE+\
+                (size_t) rdahd_end*REC_TLM_REC_SIZE-rdahd_off,MADV_WILLNEED);
+        }
+        rec = seg_map.buf+REC_TLM_SEG_HDR_SIZE+(size_t) n*REC_TLM_REC_SIZE;
+        frm = rec+REC_TLM_REC_HDR_SIZE;
+
+        // Skip record failing its length or CRC check (never downlinked):
+        if (!chk_rec_tlm_rec(rec)) {
+            // Print:
+            rt_printf("%d (PBK_REC_TLM) Error checking record %u of segment"
+                " %s\n",get_tm_sec(),(uint32_t) n,seg);
+
+            continue;
+        }
+
+        // Stop before byte budget is exceeded:
+        size = CCSDS_ASM_SIZE+get_ccsds_pkt_size(frm+9);
+        if ((prog->byte_lim > 0) && \
+            (prog->byte_cnt+size > prog->byte_lim)) {
+            prog->lim_flg = 1;
+            set_pbk_rec_tlm_end_sec(cls,idx[n].sec);
+
+            break;
+        }
+
+        // Wait for playback share of link:
+        wait_pbk_rec_tlm_pace(pace,size);
+
+        // Allocate frame from frame pool:
+        // (waits for transmit task to release frames)
+        ret_val = alloc_tlm_frm(&tlm_frm_hdl,TM_INFINITE);
+
+        // Check success (cursor stays before frame not allocated):
+        if (ret_val < 0) {
+            // Print:
+            rt_printf("%d (PBK_REC_TLM) Error allocating telemetry packet"
+                " transfer frame; playback stopped\n",get_tm_sec());
+
+            prog->err_flg = 1;
+            set_pbk_rec_tlm_end_sec(cls,idx[n].sec);
+
+            break;
+        }
+
+        // Copy recorded frame into frame:
+        memcpy(get_tlm_frm_buf(tlm_frm_hdl),frm,TLM_PKT_XFR_FRM_SIZE);
+        memcpy(&apid,frm+0,2);
+
+        // Send frame handle to transmit telemetry packet task via flow
+        // controlled message queue:
+        ret_val = put_flw_ctl(&flw_ctl_tbl[FLW_CTL_TX_TLM_PKT],\
+            &tlm_frm_hdl,TLM_FRM_HDL_SIZE,apid);
+
+        // Check success (cursor stays before frame not queued; next
+        // playback starts with it):
+        if (ret_val >= 0) {
+            prog->frm_cnt++;
+            prog->byte_cnt += size;
+        } else {
+            // Print:
+            rt_printf("%d (PBK_REC_TLM) Error sending telemetry packet"
+                " transfer frame; playback stopped\n",get_tm_sec());
+
+            // Return frame to pool:
+            rls_tlm_frm(tlm_frm_hdl);
+
+            prog->err_flg = 1;
+            set_pbk_rec_tlm_end_sec(cls,idx[n].sec);
+
+            break;
+        }
+
+        // Move cursor after frame (save every PBK_REC_TLM_SAVE_NFRM
+        // frames):
+        get_pbk_rec_tlm_seg(seg,&cur->sec,&cur->part);
+        cur->nrec = n+1;
+        if (++prog->save_cnt >= PBK_REC_TLM_SAVE_NFRM) {
+            wrt_pbk_rec_tlm();
+            prog->save_cnt = 0;
+        }
+
+        // Publish progress:
+        set_pbk_rec_tlm_prog(prog);
+    }
+
+    // Unmap segment and index:
+    unmap_pbk_rec_tlm(&seg_map);
+    unmap_pbk_rec_tlm(&idx_map);
+
+    return;
+}
+
+uint32_t pbk_rec_tlm(const struct pbk_rec_tlm_sel* sel, uint32_t* byte_cnt) {
+    // Definitions and initializations:
+    struct pbk_rec_tlm_prog prog = {0}; // Playback progress
+    struct pbk_rec_tlm_pace pace;       // Pacing bucket
+
+    int32_t   nseg[REC_TLM_NCLS];     // Segments of class
+    uint32_t* seg_nfrm[REC_TLM_NCLS]; // Selected frames of segment
+    uint8_t   cls;                    // Class counter
+    int32_t   i;                      // Segment counter
+
+    char (*seg[REC_TLM_NCLS])[REC_TLM_NAME_MAX]; // Segment paths of class
+
+    prog.byte_lim = sel->byte_lim;
+
+    // Plan: count selected frames of every segment in window:
+    for (cls = 0; cls < REC_TLM_NCLS; ++cls) {
+        seg[cls] = NULL;
+        seg_nfrm[cls] = NULL;
+        nseg[cls] = 0;
+        if (!(sel->cls_msk & (1 << cls))) {
+            continue;
+        }
+
+        // List segments of class (oldest first):
+        nseg[cls] = list_rec_tlm_seg(cls,&seg[cls]);
+        if (nseg[cls] <= 0) {
+            nseg[cls] = 0;
+
+            continue;
+        }
+        seg_nfrm[cls] = calloc(nseg[cls],sizeof(uint32_t));
+        if (seg_nfrm[cls] == NULL) {
+            nseg[cls] = 0;
+
+            continue;
+        }
+
+        // Count selected frames (segments outside window are not opened):
+        for (i = 0; i < nseg[cls]; ++i) {
+            if (chk_pbk_rec_tlm_seg(seg[cls][i],sel)) {
+                seg_nfrm[cls][i] = cnt_pbk_rec_tlm_seg(seg[cls][i],sel,cls);
+                prog.nfrm += seg_nfrm[cls][i];
+            }
+        }
+    }
+
+    // Print:
+    rt_printf("%d (PBK_REC_TLM) Playing back %u frames (%u to %u sec, byte"
+        " budget %u, %u%% of link)\n",get_tm_sec(),prog.nfrm,sel->bgn_sec,\
+        sel->end_sec,sel->byte_lim,pbk_rec_tlm_stat.pct);
+
+    // Start pacing with one frame of tokens:
+    pace.rate = (uint64_t) FLT_TBL_DL_BYTE_RATE*pbk_rec_tlm_stat.pct/100;
+    pace.tkn = CCSDS_ASM_SIZE+CCSDS_TLM_PKT_MAX;
+    pace.tm_prev = rt_timer_read();
+    pace.rem = 0;
+
+    // Publish playback share (taken out of realtime downlink budget):
+    __atomic_store_n(&pbk_rec_tlm_act_pct,pbk_rec_tlm_stat.pct,\
+        __ATOMIC_RELAXED);
+
+    // Stream: play back selected frames of segments with any:
+    for (cls = 0; cls < REC_TLM_NCLS; ++cls) {
+        for (i = 0; (i < nseg[cls]) && !prog.lim_flg && !prog.err_flg; \
+            ++i) {
+            if (seg_nfrm[cls][i] > 0) {
+                strm_pbk_rec_tlm_seg(seg[cls][i],sel,cls,&pace,&prog);
+            }
+        }
+
+        // Window of class is played back if playback was not stopped:
+        if ((sel->cls_msk & (1 << cls)) && !prog.lim_flg && !prog.err_flg) {
+            set_pbk_rec_tlm_end_sec(cls,sel->end_sec);
+        }
+
+        // Free segment list:
+        free(seg[cls]);
+        free(seg_nfrm[cls]);
+    }
+
+    // Give playback share back to realtime downlink:
+    __atomic_store_n(&pbk_rec_tlm_act_pct,0,__ATOMIC_RELAXED);
+
+    // Save cursors:
+    if (wrt_pbk_rec_tlm() != 0) {
+        // Print:
+        rt_printf("%d (PBK_REC_TLM) Error saving playback cursors\n",\
+            get_tm_sec());
+    }
+
+    // Print:
+    if (prog.err_flg) {
+        rt_printf("%d (PBK_REC_TLM) Playback stopped after %u of %u"
+            " frames; next playback resumes\n",get_tm_sec(),prog.frm_cnt,\
+            prog.nfrm);
+    } else if (prog.lim_flg) {
+        rt_printf("%d (PBK_REC_TLM) Byte budget reached after %u of %u"
+            " frames; next playback resumes\n",get_tm_sec(),prog.frm_cnt,\
+            prog.nfrm);
+    }
+
+    *byte_cnt = prog.byte_cnt;
+
+    return prog.frm_cnt;
+}
+
+// Add downlinked range of class (merged with overlapping or adjacent ranges;
+// returns 0 or -1 if class has too many ranges)
+static int8_t add_pbk_rec_tlm_ack(uint8_t cls, uint32_t bgn_sec,\
+    uint32_t end_sec) {
+    // Definitions and initializations:
+    struct pbk_rec_tlm_rng* ack = pbk_rec_tlm_stat.ack[cls];
+    struct pbk_rec_tlm_rng  rng[PBK_REC_TLM_NACK+1]; // Ranges with new range
+    uint32_t nack = pbk_rec_tlm_stat.nack[cls]; // Ranges of class
+    uint32_t nrng;                              // Merged ranges
+    uint32_t pos;                               // New range position
+    uint32_t i;
+
+    // Insert new range in start order:
+    for (pos = 0; (pos < nack) && (ack[pos].bgn_sec <= bgn_sec); ++pos);
+    memcpy(rng,ack,pos*sizeof(struct pbk_rec_tlm_rng));
+    rng[pos].bgn_sec = bgn_sec;
+    rng[pos].end_sec = end_sec;
+    memcpy(rng+pos+1,ack+pos,(nack-pos)*sizeof(struct pbk_rec_tlm_rng));
+
+    // Merge overlapping or adjacent ranges:
+    nrng = 1;
+    for (i = 1; i <= nack; ++i) {
+        if (rng[i].bgn_sec <= rng[nrng-1].end_sec) {
+            if (rng[i].end_sec > rng[nrng-1].end_sec) {
+                rng[nrng-1].end_sec = rng[i].end_sec;
+            }
+        } else {
+            rng[nrng++] = rng[i];
+        }
+    }
+
+    // Check range count:
+    if (nrng > PBK_REC_TLM_NACK) {
+        return -1;
+    }
+    memcpy(ack,rng,nrng*sizeof(struct pbk_rec_tlm_rng));
+    pbk_rec_tlm_stat.nack[cls] = nrng;
+
+    return 0;
+}
+
+// Check if every frame of segment is downlinked
+static uint8_t chk_pbk_rec_tlm_rclm(const char* seg, uint8_t cls) {
+    // Definitions and initializations:
+    struct pbk_rec_tlm_map idx_map; // Mapped index
+    const struct rec_tlm_idx* idx;  // Index entries
+
+    uint32_t nrec;         // Index entries
+    uint32_t n;            // Frame counter
+    uint8_t  rclm_flg = 1; // Every frame downlinked
+
+    // Map index (segments that cannot be checked are kept):
+    if (map_pbk_rec_tlm(seg,".idx",&idx_map) != 0) {
+        return 0;
+    }
+    idx = (const struct rec_tlm_idx*) idx_map.buf;
+    nrec = idx_map.size/REC_TLM_IDX_SIZE;
+
+    // Check every index entry:
+    for (n = 0; (n < nrec) && rclm_flg; ++n) {
+        rclm_flg = chk_pbk_rec_tlm_ack(idx[n].sec,cls);
+    }
+
+    // Unmap index:
+    unmap_pbk_rec_tlm(&idx_map);
+
+    return rclm_flg;
+}
+
+uint8_t chk_pbk_rec_tlm_dl(const char* seg, uint8_t cls) {
+    // Definitions and initializations:
+    struct pbk_rec_tlm_rng ack[PBK_REC_TLM_NACK]; // Downlinked ranges (copy)
+    struct pbk_rec_tlm_map idx_map; // Mapped index
+    const struct rec_tlm_idx* idx;  // Index entries
+
+    uint32_t seq;        // Sequence count of copy
+    uint32_t nack;       // Downlinked ranges of copy
+    uint32_t win;        // Segment time window start (sec)
+    uint32_t part;       // Segment part of time window
+    uint32_t nrec;       // Index entries
+    uint32_t n;          // Frame counter
+    uint32_t i;          // Range counter
+    uint8_t  dl_flg = 1; // Every frame downlinked
+
+    // Copy downlinked ranges of class (not used if changed meanwhile):
+    seq = __atomic_load_n(&pbk_rec_tlm_ack_seq,__ATOMIC_SEQ_CST);
+    nack = pbk_rec_tlm_stat.nack[cls];
+    if (nack > PBK_REC_TLM_NACK) {
+        nack = PBK_REC_TLM_NACK;
+    }
+    memcpy(ack,pbk_rec_tlm_stat.ack[cls],sizeof(ack));
+    if ((seq & 1) || \
+        (seq != __atomic_load_n(&pbk_rec_tlm_ack_seq,__ATOMIC_SEQ_CST))) {
+        return 0;
+    }
+
+    // Check segment time window overlaps a range (index not read otherwise):
+    get_pbk_rec_tlm_seg(seg,&win,&part);
+    for (i = 0; (i < nack) && ((ack[i].end_sec <= win) || \
+        (ack[i].bgn_sec >= win+REC_TLM_SEG_PRD)); ++i);
+    if (i == nack) {
+        return 0;
+    }
+
+    // Map index (segments that cannot be checked are kept):
+    if (map_pbk_rec_tlm(seg,".idx",&idx_map) != 0) {
+        return 0;
+    }
+    idx = (const struct rec_tlm_idx*) idx_map.buf;
+    nrec = idx_map.size/REC_TLM_IDX_SIZE;
+
+    // Check every index entry is in a range:
+    for (n = 0; (n < nrec) && dl_flg; ++n) {
+        for (i = 0; (i < nack) && ((idx[n].sec < ack[i].bgn_sec) || \
+            (idx[n].sec >= ack[i].end_sec)); ++i);
+        dl_flg = (i < nack);
+    }
+
+    // Unmap index:
+    unmap_pbk_rec_tlm(&idx_map);
+
+    return dl_flg;
+}
+
+// Delete downlinked segments of class (segments whose time window ended
+// more than a time window ago, so write file task no longer appends to
+// them) and drop ranges before the remaining segments (returns segments
+// deleted)
+static uint32_t rclm_pbk_rec_tlm(uint8_t cls) {
+    // Definitions and initializations:
+    struct pbk_rec_tlm_rng* ack = pbk_rec_tlm_stat.ack[cls];
+    int32_t  nseg;         // Number of segments
+    int32_t  i;            // Segment counter
+    uint32_t j;            // Range counter
+    uint32_t n = 0;        // Ranges kept
+    uint32_t win;          // Segment time window start (sec)
+    uint32_t part;         // Segment part of time window
+    uint32_t old;          // Oldest segment kept time window start (sec)
+    uint32_t rclm_cnt = 0; // Segments deleted
+
+    char (*seg)[REC_TLM_NAME_MAX]; // Segment paths (without extension)
+    char path[REC_TLM_NAME_MAX+4]; // Segment or index path
+
+    // List segments of class (oldest first):
+    nseg = list_rec_tlm_seg(cls,&seg);
+
+    // Delete closed segments with every frame downlinked (segment first,
+    // so an index is never left without its segment):
+    old = get_tm_sec();
+    for (i = 0; i < nseg; ++i) {
+        get_pbk_rec_tlm_seg(seg[i],&win,&part);
+        if ((win+2*REC_TLM_SEG_PRD <= get_tm_sec()) && \
+            chk_pbk_rec_tlm_rclm(seg[i],cls)) {
+            sprintf(path,"%s.seg",seg[i]);
+            unlink(path);
+            sprintf(path,"%s.idx",seg[i]);
+            unlink(path);
+            rclm_cnt++;
+        } else if (win < old) {
+            old = win;
+        }
+    }
+
+    // Free segment list:
+    free(seg);
+
+    // Drop ranges that end before oldest segment kept:
+    __atomic_add_fetch(&pbk_rec_tlm_ack_seq,1,__ATOMIC_SEQ_CST);
+    for (j = 0; j < pbk_rec_tlm_stat.nack[cls]; ++j) {
+        if (ack[j].end_sec > old) {
+            ack[n++] = ack[j];
+        }
+    }
+    pbk_rec_tlm_stat.nack[cls] = n;
+    __atomic_add_fetch(&pbk_rec_tlm_ack_seq,1,__ATOMIC_SEQ_CST);
+
+    return rclm_cnt;
+}
+
+int8_t ack_pbk_rec_tlm(uint32_t arg) {
+    // Definitions and initializations:
+    struct pbk_rec_tlm_sel sel; // Acknowledged selection
+    uint8_t  cls;              // Class counter
+    uint8_t  ack_msk = 0;      // Classes with frames played back
+    uint32_t end_sec;          // Acknowledged window end of class (sec)
+    uint32_t rclm_cnt = 0;     // Segments deleted
+
+    // Downlinked ranges before acknowledgement (restored on error):
+    struct pbk_rec_tlm_rng ack[REC_TLM_NCLS][PBK_REC_TLM_NACK];
+    uint32_t nack[REC_TLM_NCLS];
+
+    // Get classes and staged window:
+    if ((get_pbk_rec_tlm_sel(arg,&sel) != 0) || \
+        (sel.end_sec <= sel.bgn_sec)) {
+        return -1;
+    }
+    memcpy(ack,pbk_rec_tlm_stat.ack,sizeof(ack));
+    memcpy(nack,pbk_rec_tlm_stat.nack,sizeof(nack));
+
+    // Mark window downlinked for classes up to where it was played back
+    // (all or none):
+    __atomic_add_fetch(&pbk_rec_tlm_ack_seq,1,__ATOMIC_SEQ_CST);
+    for (cls = 0; cls < REC_TLM_NCLS; ++cls) {
+        end_sec = (pbk_rec_tlm_stat.pbk_sec[cls] < sel.end_sec) ? \
+            pbk_rec_tlm_stat.pbk_sec[cls] : sel.end_sec;
+        if (!(sel.cls_msk & (1 << cls)) || (end_sec <= sel.bgn_sec)) {
+            continue;
+        }
+        ack_msk |= 1 << cls;
+        if (add_pbk_rec_tlm_ack(cls,sel.bgn_sec,end_sec) != 0) {
+            // Print:
+            rt_printf("%d (PBK_REC_TLM) Too many downlinked ranges of class"
+                " %u; acknowledge contiguous windows\n",get_tm_sec(),cls);
+
+            // Restore ranges:
+            memcpy(pbk_rec_tlm_stat.ack,ack,sizeof(ack));
+            memcpy(pbk_rec_tlm_stat.nack,nack,sizeof(nack));
+            __atomic_add_fetch(&pbk_rec_tlm_ack_seq,1,__ATOMIC_SEQ_CST);
+
+            return -1;
+        }
+    }
+    __atomic_add_fetch(&pbk_rec_tlm_ack_seq,1,__ATOMIC_SEQ_CST);
+
+    // Check frames were played back:
+    if (ack_msk == 0) {
+        // Print:
+        rt_printf("%d (PBK_REC_TLM) Nothing played back in window of classes"
+            " 0x%X; nothing marked downlinked\n",get_tm_sec(),sel.cls_msk);
+
+        return -1;
+    }
+
+    // Delete downlinked segments of classes:
+    for (cls = 0; cls < REC_TLM_NCLS; ++cls) {
+        if (ack_msk & (1 << cls)) {
+            rclm_cnt += rclm_pbk_rec_tlm(cls);
+        }
+    }
+
+    // Print:
+    rt_printf("%d (PBK_REC_TLM) %u sec to played back time marked downlinked"
+        " (classes 0x%X); %u segments deleted\n",get_tm_sec(),sel.bgn_sec,\
+        ack_msk,rclm_cnt);
+
+    return (wrt_pbk_rec_tlm() == 0) ? 1 : -1;
+}
+
+uint8_t get_pbk_rec_tlm_act_pct() {
+    return __atomic_load_n(&pbk_rec_tlm_act_pct,__ATOMIC_RELAXED);
+}
@@ -0,0 +1,990 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Record Telemetry
+//
+// Segmented, append-only recorder of telemetry packet transfer frames used by
+// write file task (recording) and retrieve file task (segment listing). See
+// rec_tlm.h for the directory layout.
+//
+// Every class keeps its current segment and index open, so recording costs
+// no directory listing, file creation, or process per frame. Frames handed
+// over together (rec_tlm_ring.h) are gathered per class into one batch of
+// up to REC_TLM_BAT_NFRM records (a record header and frame vector per
+// frame) and written with one vectored write at the end of the segment and
+// one write of the index entries, so the number of system calls follows the
+// number of batches rather than frames. With REC_TLM_URING (make URING=1)
+// the batches of every class are submitted to io_uring together and waited
+// for once; if io_uring cannot be set up, pwritev is used. Segments are
+// opened without stdio buffering and synced with fdatasync in batches; a
+// frame is on storage at most REC_TLM_SYNC_NREC frames or REC_TLM_SYNC_PRD
+// after it was appended (sync_rec_tlm is called by write file task when no
+// frame arrives within the period).
+//
+// Every record carries the length and CRC-16 of its transfer frame. The
+// segment header is rewritten after every sync with the records synced
+// before it (so it never claims records that are not on storage) and is
+// sealed with the record count when the segment is closed. Segments are
+// recovered by init_rec_tlm at startup (see rec_tlm.h); a segment that was
+// open at a restart is appended to again, a sealed one is not.
+//
+// Storage is checked when a segment is opened (one listing of the class and
+// a statvfs) and again when an append fails for lack of space, in which case
+// segments are evicted and the batch is retried once. Downlinked segments
+// are found with the downlinked ranges of the playback engine; an index is
+// only read if its segment time window overlaps a downlinked range.
+//
+// -------------------------------------------------------------------------- /
+//
+// Dependencies:
+// - Xenomai 3 / Cobalt
+//
+// Input Arguments:
+// - N/A
+//
+// Output Arguments:
+// - N/A
+//
+// -------------------------------------------------------------------------- /
+//
+// agent
+// Project HEPCATS
+// Subsystem: C&DH
+// Created: October 17, 2026
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Standard libraries:
+#include <stdio.h>    // Standard input/output definitions
+#include <stdlib.h>   // Standard library
+#include <unistd.h>   // UNIX standard function definitions
+#include <errno.h>    // Error number definitions
+#include <string.h>   // String function definitions
+#include <stdint.h>   // Standard integer types
+#include <fcntl.h>    // File control definitions
+#include <dirent.h>   // Directory listing
+#include <sys/stat.h> // File status (mkdir, fstat)
+#include <sys/statvfs.h> // File system status (statvfs)
+#include <sys/uio.h>  // Vectored input/output (pwritev)
+#ifdef REC_TLM_URING
+#include <liburing.h> // io_uring submission and completion
+#endif
+
+// Xenomai libraries:
+#include <alchemy/timer.h> // Timer management services
+
+// Header files:
+#include <tlm_frm_pool.h> // Telemetry frame pool declarations
+#include <rec_tlm.h>      // Record telemetry declarations
+#include <ccsds_pkt.h>    // CCSDS packet codec (packet size)
+#include <ccsds_crc.h>    // CCSDS packet error control (CRC)
+#include <pbk_rec_tlm.h>  // Play back recorded telemetry (downlinked check)
+#include <hk_tlm_var.h>   // Housekeeping telemetry variable declarations
+#include <tm_svc.h>       // Time service declarations
+
+// Macro definitions:
+#define REC_TLM_FRM_HDR_SIZE 9 // Transfer frame header size in bytes (APID,
+                               // grouping flag, and creation time)
+
+// Open segment structure:
+struct rec_tlm_seg {
+    int      fd;        // Segment file descriptor (-1: none open)
+    int      idx_fd;    // Index file descriptor
+    uint32_t sec;       // Time window start (sec)
+    uint16_t part;      // Part of time window
+    uint32_t nrec;      // Frames in segment
+    uint8_t  dirty_flg; // Frames appended since last sync
+
+    struct rec_tlm_seg_hdr hdr; // Segment header
+};
+
+// Pending batch structure (frames of class gathered for one write):
+struct rec_tlm_bat {
+    struct iovec           iov[2*REC_TLM_BAT_NFRM]; // Record headers and
+                                                    // frames
+    uint32_t               niov;                    // Write vectors
+    struct rec_tlm_rec_hdr rec[REC_TLM_BAT_NFRM];   // Record headers
+    struct rec_tlm_idx     idx[REC_TLM_BAT_NFRM];   // Index entries
+    uint32_t               nfrm;                    // Frames
+};
+
+// Class directories:
+static const char* rec_tlm_dir[REC_TLM_NCLS] = {
+    REC_TLM_DIR "hk",REC_TLM_DIR "mdq",REC_TLM_DIR "img"
+};
+
+// Open segment of each class:
+static struct rec_tlm_seg rec_tlm_seg[REC_TLM_NCLS] = {
+    {-1,-1},{-1,-1},{-1,-1}
+};
+
+// Pending batch of each class:
+static struct rec_tlm_bat rec_tlm_bat[REC_TLM_NCLS];
+
+#ifdef REC_TLM_URING
+// io_uring state:
+static struct io_uring rec_tlm_uring;   // Submission and completion rings
+static uint8_t rec_tlm_uring_flg = 0;   // Rings set up
+#endif
+
+// Sync state:
+static uint16_t rec_tlm_sync_nrec = 0; // Frames appended since last sync
+static RTIME    rec_tlm_sync_tm = 0;   // Last sync time
+
+// Storage used by segments of class in bytes (counted when checked):
+static uint64_t rec_tlm_use[REC_TLM_NCLS];
+
+int8_t get_rec_tlm_cls(uint16_t apid) {
+    // Definitions and initializations:
+    uint8_t i;
+
+    // Find class table row of APID:
+    for (i = 0; i < REC_TLM_NCLS; ++i) {
+        if (rec_tlm_cls_tbl[i][0] == apid) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+const char* get_rec_tlm_dir(uint8_t cls) {
+    return rec_tlm_dir[cls];
+}
+
+uint8_t get_rec_tlm_stor() {
+    // Definitions and initializations:
+    struct statvfs st; // File system status
+    uint64_t free_mb;  // Free storage in MB
+
+    // Get file system status:
+    if ((statvfs(REC_TLM_DIR,&st) != 0) || (st.f_blocks == 0)) {
+        return 0;
+    }
+
+    // Publish free storage (available to flight software):
+    free_mb = (uint64_t) st.f_bavail*st.f_frsize/REC_TLM_MB;
+    stor_free_mb = (free_mb > UINT16_MAX) ? UINT16_MAX : free_mb;
+
+    return 100-(uint64_t) st.f_bavail*100/st.f_blocks;
+}
+
+// Get storage used by segments of class in bytes
+static uint64_t get_rec_tlm_use(uint8_t cls) {
+    // Definitions and initializations:
+    struct stat st;   // Segment or index status
+    uint64_t use = 0; // Storage used in bytes
+    int32_t  nseg;    // Number of segments
+    int32_t  i;
+
+    char (*seg)[REC_TLM_NAME_MAX]; // Segment paths (without extension)
+    char path[REC_TLM_NAME_MAX+4]; // Segment or index path
+
+    // Add segment and index sizes:
+    nseg = list_rec_tlm_seg(cls,&seg);
+    for (i = 0; i < nseg; ++i) {
+        sprintf(path,"%s.seg",seg[i]);
+        if (stat(path,&st) == 0) use += st.st_size;
+        sprintf(path,"%s.idx",seg[i]);
+        if (stat(path,&st) == 0) use += st.st_size;
+    }
+
+    // Free segment list:
+    free(seg);
+
+    return use;
+}
+
+// Check if eviction is needed (class over its quota with room for a new
+// segment, or file system over the low-water mark if class is -1)
+static uint8_t chk_rec_tlm_evct(int8_t cls) {
+    if (cls >= 0) {
+        return rec_tlm_use[cls]+REC_TLM_SEG_SIZE > \
+            (uint64_t) rec_tlm_cls_tbl[cls][2]*REC_TLM_MB;
+    }
+
+    return get_rec_tlm_stor() > REC_TLM_LWM_PCT;
+}
+
+// Delete segment of class and count eviction (segment first, so an index is
+// never left without its segment)
+static void del_rec_tlm_seg(uint8_t cls, const char* seg) {
+    // Definitions and initializations:
+    struct stat st; // Segment or index status
+
+    char path[REC_TLM_NAME_MAX+4]; // Segment or index path
+
+    sprintf(path,"%s.seg",seg);
+    if (stat(path,&st) == 0) {
+        rec_tlm_use[cls] -= ((uint64_t) st.st_size < rec_tlm_use[cls]) ? \
+            (uint64_t) st.st_size : rec_tlm_use[cls];
+    }
+    unlink(path);
+    sprintf(path,"%s.idx",seg);
+    if (stat(path,&st) == 0) {
+        rec_tlm_use[cls] -= ((uint64_t) st.st_size < rec_tlm_use[cls]) ? \
+            (uint64_t) st.st_size : rec_tlm_use[cls];
+    }
+    unlink(path);
+
+    stor_evct_cnt[cls]++;
+
+    return;
+}
+
+// Evict segments of class (all classes if -1) until no longer needed:
+// downlinked segments first, then oldest segments in eviction rank order
+// (returns segments evicted)
+static uint32_t evct_rec_tlm(int8_t cls) {
+    // Definitions and initializations:
+    uint8_t  evct_flg;     // Eviction needed
+    uint8_t  pass;         // Pass (0: downlinked, 1: oldest)
+    uint8_t  rank;         // Eviction rank
+    uint8_t  i;            // Class counter
+    int32_t  nseg;         // Number of segments
+    int32_t  j;            // Segment counter
+    uint32_t win;          // Segment time window start (sec)
+    uint32_t evct_cnt = 0; // Segments evicted
+
+    char (*seg)[REC_TLM_NAME_MAX]; // Segment paths (without extension)
+
+    evct_flg = chk_rec_tlm_evct(cls);
+    for (pass = 0; (pass < 2) && evct_flg; ++pass) {
+        for (rank = 0; (rank < REC_TLM_NCLS) && evct_flg; ++rank) {
+            // Get class of rank:
+            for (i = 0; (i < REC_TLM_NCLS) && \
+                (rec_tlm_cls_tbl[i][1] != rank); ++i);
+            if ((i == REC_TLM_NCLS) || ((cls >= 0) && (i != cls))) {
+                continue;
+            }
+
+            // Evict segments of class (oldest first):
+            nseg = list_rec_tlm_seg(i,&seg);
+            for (j = 0; (j < nseg) && evct_flg; ++j) {
+                // Keep time window being recorded:
+                win = 0;
+                sscanf(strrchr(seg[j],'/')+1,"%u",&win);
+                if (win == rec_tlm_seg[i].sec) {
+                    continue;
+                }
+
+                // Keep segments not downlinked on first pass:
+                if ((pass == 0) && !chk_pbk_rec_tlm_dl(seg[j],i)) {
+                    continue;
+                }
+
+                del_rec_tlm_seg(i,seg[j]);
+                evct_cnt++;
+                evct_flg = chk_rec_tlm_evct(cls);
+            }
+
+            // Free segment list:
+            free(seg);
+        }
+    }
+
+    return evct_cnt;
+}
+
+// Keep storage within quota of class and file system high-water mark
+// (before a segment of class is opened)
+static void chk_rec_tlm_stor(uint8_t cls) {
+    // Definitions and initializations:
+    uint32_t evct_cnt; // Segments evicted
+
+    // Check quota of class:
+    rec_tlm_use[cls] = get_rec_tlm_use(cls);
+    if (chk_rec_tlm_evct(cls)) {
+        evct_cnt = evct_rec_tlm(cls);
+
+        // Print:
+        rt_printf("%d (REC_TLM) %s over quota; %u segments evicted\n",\
+            get_tm_sec(),rec_tlm_dir[cls],evct_cnt);
+    }
+
+    // Check file system high-water mark:
+    if (get_rec_tlm_stor() > REC_TLM_HWM_PCT) {
+        evct_cnt = evct_rec_tlm(-1);
+
+        // Print:
+        rt_printf("%d (REC_TLM) Storage over high-water mark; %u segments"
+            " evicted (%u MB free)\n",get_tm_sec(),evct_cnt,stor_free_mb);
+    }
+
+    return;
+}
+
+// Get index entry of transfer frame
+static void get_rec_tlm_idx(const char* frm, struct rec_tlm_idx* idx) {
+    memcpy(&idx->grp_flg,frm+2,1);
+    memcpy(&idx->sec,frm+3,4);
+    memcpy(&idx->msec,frm+7,2);
+    idx->rsvd = 0;
+
+    return;
+}
+
+// Get record header of transfer frame (length up to end of packet)
+static void get_rec_tlm_rec_hdr(const char* frm, struct rec_tlm_rec_hdr* rec) {
+    rec->len = REC_TLM_FRM_HDR_SIZE+get_ccsds_pkt_size(frm+\
+        REC_TLM_FRM_HDR_SIZE);
+    if (rec->len > TLM_PKT_XFR_FRM_SIZE) {
+        rec->len = TLM_PKT_XFR_FRM_SIZE;
+    }
+    rec->crc = calc_ccsds_crc(frm,rec->len);
+
+    return;
+}
+
+uint8_t chk_rec_tlm_rec(const char* rec) {
+    // Definitions and initializations:
+    struct rec_tlm_rec_hdr hdr; // Record header
+
+    memcpy(&hdr,rec,REC_TLM_REC_HDR_SIZE);
+
+    return (hdr.len >= REC_TLM_FRM_HDR_SIZE+CCSDS_PRI_HDR_SIZE) && \
+        (hdr.len <= TLM_PKT_XFR_FRM_SIZE) && \
+        (calc_ccsds_crc(rec+REC_TLM_REC_HDR_SIZE,hdr.len) == hdr.crc);
+}
+
+// Set up header of new (open) segment
+static void set_rec_tlm_seg_hdr(struct rec_tlm_seg_hdr* hdr, uint8_t cls,\
+    uint32_t sec, uint32_t part) {
+    memset(hdr,0,sizeof(*hdr));
+    hdr->magic = REC_TLM_SEG_MAGIC;
+    hdr->ver = REC_TLM_SEG_VER;
+    hdr->cls = cls;
+    hdr->sec = sec;
+    hdr->part = part;
+    hdr->sync_nrec = 0;
+    hdr->seal_nrec = REC_TLM_SEG_OPEN;
+
+    return;
+}
+
+// Check segment header of class
+static uint8_t chk_rec_tlm_seg_hdr(const struct rec_tlm_seg_hdr* hdr,\
+    uint8_t cls) {
+    return (hdr->magic == REC_TLM_SEG_MAGIC) && \
+        (hdr->ver == REC_TLM_SEG_VER) && (hdr->cls == cls) && \
+        (calc_ccsds_crc((const char*) hdr,REC_TLM_SEG_HDR_SIZE-2) == \
+        hdr->crc);
+}
+
+// Write segment header (returns 0 or -1 on error)
+static int8_t wrt_rec_tlm_seg_hdr(int fd, struct rec_tlm_seg_hdr* hdr) {
+    hdr->crc = calc_ccsds_crc((const char*) hdr,REC_TLM_SEG_HDR_SIZE-2);
+
+    return (pwrite(fd,hdr,REC_TLM_SEG_HDR_SIZE,0) == REC_TLM_SEG_HDR_SIZE) ? \
+        0 : -1;
+}
+
+// Recover segment of class after a restart: accept a sealed segment from
+// its header, otherwise check records after the last sync, truncate before
+// the first torn record, and rebuild missing index entries (returns records
+// dropped or -1 on error; fix_flg: segment changed)
+static int32_t rcvr_rec_tlm_seg(uint8_t cls, const char* seg,\
+    uint8_t* fix_flg) {
+    // Definitions and initializations:
+    struct rec_tlm_seg_hdr hdr; // Segment header
+    struct rec_tlm_idx     idx; // Index entry
+
+    struct stat seg_st; // Segment status
+    struct stat idx_st; // Index status
+
+    int      fd;       // Segment file descriptor
+    int      idx_fd;   // Index file descriptor
+    uint32_t nrec;     // Whole records in segment
+    uint32_t nidx;     // Index entries
+    uint32_t chk_nrec; // First record checked
+    uint32_t n;        // Record counter
+    uint32_t sec;      // Time window start (sec; from name)
+    uint32_t part;     // Part of time window (from name)
+
+    char rec[REC_TLM_REC_SIZE];    // Record
+    char path[REC_TLM_NAME_MAX+4]; // Segment or index path
+
+    *fix_flg = 0;
+
+    // Open segment and index (index is rebuilt if missing):
+    sprintf(path,"%s.seg",seg);
+    fd = open(path,O_RDWR);
+    sprintf(path,"%s.idx",seg);
+    idx_fd = open(path,O_RDWR | O_CREAT,0644);
+    if ((fd < 0) || (idx_fd < 0) || (fstat(fd,&seg_st) != 0) || \
+        (fstat(idx_fd,&idx_st) != 0)) {
+        if (fd >= 0) close(fd);
+        if (idx_fd >= 0) close(idx_fd);
+
+        return -1;
+    }
+    nrec = (seg_st.st_size < REC_TLM_SEG_HDR_SIZE) ? 0 : \
+        (seg_st.st_size-REC_TLM_SEG_HDR_SIZE)/REC_TLM_REC_SIZE;
+    nidx = idx_st.st_size/REC_TLM_IDX_SIZE;
+
+    // Get header (segment without a valid header is checked from its first
+    // record):
+    if ((nrec == 0) || \
+        (pread(fd,&hdr,REC_TLM_SEG_HDR_SIZE,0) != REC_TLM_SEG_HDR_SIZE) || \
+        !chk_rec_tlm_seg_hdr(&hdr,cls)) {
+        sec = 0;
+        part = 0;
+        sscanf(strrchr(seg,'/')+1,"%u_%u",&sec,&part);
+        set_rec_tlm_seg_hdr(&hdr,cls,sec,part);
+        *fix_flg = 1;
+    }
+
+    // Accept segment whose sizes match the records sealed (or synced) in
+    // its header (no record read):
+    chk_nrec = (hdr.seal_nrec != REC_TLM_SEG_OPEN) ? hdr.seal_nrec : \
+        hdr.sync_nrec;
+    if (!*fix_flg && (chk_nrec == nrec) && (nidx == nrec) && \
+        (seg_st.st_size == REC_TLM_SEG_HDR_SIZE+(off_t) nrec*\
+        REC_TLM_REC_SIZE) && (idx_st.st_size == (off_t) nrec*\
+        REC_TLM_IDX_SIZE)) {
+        close(fd);
+        close(idx_fd);
+
+        return 0;
+    }
+    *fix_flg = 1;
+
+    // Check records after last sync (or seal) and rebuild index entries
+    // from the first one missing:
+    if (chk_nrec > nrec) {
+        chk_nrec = nrec;
+    }
+    for (n = (nidx < chk_nrec) ? nidx : chk_nrec; n < nrec; ++n) {
+        if ((pread(fd,rec,REC_TLM_REC_SIZE,REC_TLM_SEG_HDR_SIZE+(off_t) n*\
+            REC_TLM_REC_SIZE) != REC_TLM_REC_SIZE) || \
+            ((n >= chk_nrec) && !chk_rec_tlm_rec(rec))) {
+            break;
+        }
+        get_rec_tlm_idx(rec+REC_TLM_REC_HDR_SIZE,&idx);
+        pwrite(idx_fd,&idx,REC_TLM_IDX_SIZE,(off_t) n*REC_TLM_IDX_SIZE);
+    }
+
+    // Remove segment without records:
+    if (n == 0) {
+        close(fd);
+        close(idx_fd);
+        sprintf(path,"%s.seg",seg);
+        unlink(path);
+        sprintf(path,"%s.idx",seg);
+        unlink(path);
+
+        return nrec;
+    }
+
+    // Truncate torn records and index entries, and update header:
+    ftruncate(fd,REC_TLM_SEG_HDR_SIZE+(off_t) n*REC_TLM_REC_SIZE);
+    ftruncate(idx_fd,(off_t) n*REC_TLM_IDX_SIZE);
+    hdr.sync_nrec = n;
+    if (hdr.seal_nrec != REC_TLM_SEG_OPEN) {
+        hdr.seal_nrec = n;
+    }
+    wrt_rec_tlm_seg_hdr(fd,&hdr);
+    fdatasync(idx_fd);
+    fdatasync(fd);
+    close(fd);
+    close(idx_fd);
+
+    return nrec-n;
+}
+
+// Recover segments of every class (before tasks start)
+static void rcvr_rec_tlm() {
+    // Definitions and initializations:
+    RTIME    tm = rt_timer_read(); // Recovery start time
+    int32_t  nseg;                 // Number of segments of class
+    int32_t  ret_val;              // Function return value
+    int32_t  i;                    // Segment counter
+    uint8_t  cls;                  // Class counter
+    uint8_t  fix_flg;              // Segment changed
+    uint32_t seg_cnt = 0;          // Segments recovered
+    uint32_t fix_cnt = 0;          // Segments changed
+    uint32_t drop_cnt = 0;         // Torn records dropped
+
+    char (*seg)[REC_TLM_NAME_MAX]; // Segment paths (without extension)
+
+    for (cls = 0; cls < REC_TLM_NCLS; ++cls) {
+        nseg = list_rec_tlm_seg(cls,&seg);
+        for (i = 0; i < nseg; ++i) {
+            ret_val = rcvr_rec_tlm_seg(cls,seg[i],&fix_flg);
+            if (ret_val < 0) {
+                // Print:
+                rt_printf("%d (REC_TLM) Error recovering segment %s\n",\
+                    get_tm_sec(),seg[i]);
+
+                continue;
+            }
+            seg_cnt++;
+            fix_cnt += fix_flg;
+            drop_cnt += ret_val;
+        }
+
+        // Free segment list:
+        free(seg);
+    }
+
+    // Print:
+    rt_printf("%d (REC_TLM) %u segments recovered in %u ms (%u repaired, %u"
+        " torn records dropped)\n",get_tm_sec(),seg_cnt,\
+        (uint32_t) (rt_timer_ticks2ns(rt_timer_read()-tm)/1000000),\
+        fix_cnt,drop_cnt);
+
+    return;
+}
+
+void init_rec_tlm() {
+    // Definitions and initializations:
+    uint8_t i;
+
+    // Create recorded telemetry and class directories (if not there):
+    mkdir(REC_TLM_DIR,0755);
+    for (i = 0; i < REC_TLM_NCLS; ++i) {
+        if ((mkdir(rec_tlm_dir[i],0755) != 0) && (errno != EEXIST)) {
+            // Print:
+            rt_printf("%d (REC_TLM) Error creating %s\n",get_tm_sec(),\
+                rec_tlm_dir[i]);
+        }
+    }
+
+    // Recover segments (torn records of a restart dropped):
+    rcvr_rec_tlm();
+
+#ifdef REC_TLM_URING
+    // Set up io_uring (two writes per class):
+    if (io_uring_queue_init(2*REC_TLM_NCLS,&rec_tlm_uring,0) == 0) {
+        rec_tlm_uring_flg = 1;
+    } else {
+        // Print:
+        rt_printf("%d (REC_TLM) Error setting up io_uring; using pwritev\n",\
+            get_tm_sec());
+    }
+#endif
+
+    // Start sync period:
+    rec_tlm_sync_tm = rt_timer_read();
+
+    // Publish free storage:
+    get_rec_tlm_stor();
+
+    return;
+}
+
+// Sync, seal, and close open segment of class
+static void close_rec_tlm_seg(struct rec_tlm_seg* seg) {
+    if (seg->fd < 0) {
+        return;
+    }
+
+    // Sync segment and index, then seal header with records synced:
+    if (seg->dirty_flg) {
+        fdatasync(seg->fd);
+        fdatasync(seg->idx_fd);
+    }
+    seg->hdr.sync_nrec = seg->nrec;
+    seg->hdr.seal_nrec = seg->nrec;
+    wrt_rec_tlm_seg_hdr(seg->fd,&seg->hdr);
+    fdatasync(seg->fd);
+
+    // Close segment and index:
+    close(seg->fd);
+    close(seg->idx_fd);
+    seg->fd = -1;
+    seg->idx_fd = -1;
+    seg->dirty_flg = 0;
+
+    return;
+}
+
+// Open segment of class for time window (first part that is open and not
+// full; returns 0 or -1 on error or when all parts are used)
+static int8_t open_rec_tlm_seg(uint8_t cls, uint32_t sec) {
+    // Definitions and initializations:
+    struct rec_tlm_seg* seg = &rec_tlm_seg[cls];
+
+    struct stat seg_st; // Segment status
+    struct stat idx_st; // Index status
+
+    char path[REC_TLM_NAME_MAX+4]; // Segment or index path
+
+    // Make room for segment (time window is kept):
+    seg->sec = sec;
+    chk_rec_tlm_stor(cls);
+
+    // Loop over parts of time window:
+    for (seg->part = 0; seg->part < REC_TLM_SEG_NPART; ++seg->part) {
+        // Open (or create) segment and index:
+        sprintf(path,"%s/%010u_%03u.seg",rec_tlm_dir[cls],sec,seg->part);
+        seg->fd = open(path,O_RDWR | O_CREAT,0644);
+        sprintf(path,"%s/%010u_%03u.idx",rec_tlm_dir[cls],sec,seg->part);
+        seg->idx_fd = open(path,O_WRONLY | O_CREAT,0644);
+
+        // Check success:
+        if ((seg->fd < 0) || (seg->idx_fd < 0) || \
+            (fstat(seg->fd,&seg_st) != 0) || \
+            (fstat(seg->idx_fd,&idx_st) != 0)) {
+            // Print:
+            rt_printf("%d (REC_TLM) Error opening segment %s\n",\
+                get_tm_sec(),path);
+
+            if (seg->fd >= 0) close(seg->fd);
+            if (seg->idx_fd >= 0) close(seg->idx_fd);
+            seg->fd = -1;
+            seg->idx_fd = -1;
+
+            return -1;
+        }
+
+        // Start new segment with header:
+        if (seg_st.st_size == 0) {
+            set_rec_tlm_seg_hdr(&seg->hdr,cls,sec,seg->part);
+            ftruncate(seg->idx_fd,0);
+            if (wrt_rec_tlm_seg_hdr(seg->fd,&seg->hdr) == 0) {
+                seg->nrec = 0;
+                break;
+            }
+
+            // Print:
+            rt_printf("%d (REC_TLM) Error writing segment header %s\n",\
+                get_tm_sec(),path);
+
+            // Remove empty segment and index just created:
+            close(seg->fd);
+            close(seg->idx_fd);
+            seg->fd = -1;
+            seg->idx_fd = -1;
+            unlink(path);
+            sprintf(path,"%s/%010u_%03u.seg",rec_tlm_dir[cls],sec,seg->part);
+            unlink(path);
+
+            return -1;
+        // Get whole records with index entries of segment (recovered):
+        } else if ((pread(seg->fd,&seg->hdr,REC_TLM_SEG_HDR_SIZE,0) == \
+            REC_TLM_SEG_HDR_SIZE) && chk_rec_tlm_seg_hdr(&seg->hdr,cls)) {
+            seg->nrec = (seg_st.st_size-REC_TLM_SEG_HDR_SIZE)/\
+                REC_TLM_REC_SIZE;
+            if (idx_st.st_size/REC_TLM_IDX_SIZE < seg->nrec) {
+                seg->nrec = idx_st.st_size/REC_TLM_IDX_SIZE;
+            }
+
+            // Use part if open and not full:
+            if ((seg->hdr.seal_nrec == REC_TLM_SEG_OPEN) && \
+                (seg->nrec < REC_TLM_SEG_NREC)) {
+                break;
+            }
+        }
+        close(seg->fd);
+        close(seg->idx_fd);
+    }
+
+    // Check for free part:
+    if (seg->part == REC_TLM_SEG_NPART) {
+        // Print:
+        rt_printf("%d (REC_TLM) No free segment part in %s/%010u\n",\
+            get_tm_sec(),rec_tlm_dir[cls],sec);
+
+        seg->fd = -1;
+        seg->idx_fd = -1;
+
+        return -1;
+    }
+
+    // Trim partial record or index entry:
+    if ((seg_st.st_size != REC_TLM_SEG_HDR_SIZE+(off_t) seg->nrec*\
+        REC_TLM_REC_SIZE) || \
+        (idx_st.st_size != (off_t) seg->nrec*REC_TLM_IDX_SIZE)) {
+        ftruncate(seg->fd,REC_TLM_SEG_HDR_SIZE+(off_t) seg->nrec*\
+            REC_TLM_REC_SIZE);
+        ftruncate(seg->idx_fd,(off_t) seg->nrec*REC_TLM_IDX_SIZE);
+    }
+
+    seg->dirty_flg = 0;
+
+    // Print:
+    rt_printf("%d (REC_TLM) Recording to %s/%010u_%03u (%u frames)\n",\
+        get_tm_sec(),rec_tlm_dir[cls],sec,seg->part,seg->nrec);
+
+    return 0;
+}
+
+void sync_rec_tlm() {
+    // Definitions and initializations:
+    uint8_t i;
+
+    // Sync segments and indexes with frames appended since last sync:
+    for (i = 0; i < REC_TLM_NCLS; ++i) {
+        if ((rec_tlm_seg[i].fd >= 0) && rec_tlm_seg[i].dirty_flg) {
+            fdatasync(rec_tlm_seg[i].fd);
+            fdatasync(rec_tlm_seg[i].idx_fd);
+            rec_tlm_seg[i].dirty_flg = 0;
+
+            // Record synced records in header (on storage with next sync):
+            rec_tlm_seg[i].hdr.sync_nrec = rec_tlm_seg[i].nrec;
+            wrt_rec_tlm_seg_hdr(rec_tlm_seg[i].fd,&rec_tlm_seg[i].hdr);
+        }
+    }
+
+    // Start next sync period:
+    rec_tlm_sync_nrec = 0;
+    rec_tlm_sync_tm = rt_timer_read();
+
+    // Publish free storage:
+    get_rec_tlm_stor();
+
+    return;
+}
+
+// Write pending batch of class at end of open segment (returns 0 or -1 with
+// errno set; ENOSPC for a short write)
+static int8_t wrt_rec_tlm_bat(uint8_t cls) {
+    // Definitions and initializations:
+    struct rec_tlm_seg* seg = &rec_tlm_seg[cls]; // Open segment of class
+    struct rec_tlm_bat* bat = &rec_tlm_bat[cls]; // Pending batch of class
+    ssize_t ret_val;                             // Function return value
+
+    // Write records, then index entries:
+    ret_val = pwritev(seg->fd,bat->iov,bat->niov,REC_TLM_SEG_HDR_SIZE+\
+        (off_t) seg->nrec*REC_TLM_REC_SIZE);
+    if (ret_val == (ssize_t) bat->nfrm*REC_TLM_REC_SIZE) {
+        ret_val = pwrite(seg->idx_fd,bat->idx,bat->nfrm*REC_TLM_IDX_SIZE,\
+            (off_t) seg->nrec*REC_TLM_IDX_SIZE);
+        if (ret_val == (ssize_t) bat->nfrm*REC_TLM_IDX_SIZE) {
+            return 0;
+        }
+    }
+    if (ret_val >= 0) {
+        errno = ENOSPC;
+    }
+
+    return -1;
+}
+
+#ifdef REC_TLM_URING
+// Write pending batches of classes in mask in one io_uring submission
+// (err[cls]: 0 or error number; returns 0 or -1 if io_uring is not set up)
+static int8_t wrt_rec_tlm_uring(uint8_t cls_msk, int* err) {
+    // Definitions and initializations:
+    struct io_uring_sqe* sqe; // Submission queue entry
+    struct io_uring_cqe* cqe; // Completion queue entry
+    struct rec_tlm_seg*  seg; // Open segment of class
+    struct rec_tlm_bat*  bat; // Pending batch of class
+
+    uint32_t nsub = 0; // Writes submitted
+    uint32_t tag;      // Write tag (2*class, +1 for index)
+    uint32_t size;     // Write size in bytes
+    uint32_t i;
+    uint8_t  cls;
+
+    if (!rec_tlm_uring_flg) {
+        return -1;
+    }
+
+    // Queue frame and index writes of every pending batch:
+    for (cls = 0; cls < REC_TLM_NCLS; ++cls) {
+        seg = &rec_tlm_seg[cls];
+        bat = &rec_tlm_bat[cls];
+        if (!(cls_msk & (1 << cls)) || (bat->nfrm == 0)) {
+            continue;
+        }
+        sqe = io_uring_get_sqe(&rec_tlm_uring);
+        io_uring_prep_writev(sqe,seg->fd,bat->iov,bat->niov,\
+            REC_TLM_SEG_HDR_SIZE+(off_t) seg->nrec*REC_TLM_REC_SIZE);
+        io_uring_sqe_set_data(sqe,(void*) (uintptr_t) (2*cls));
+        sqe = io_uring_get_sqe(&rec_tlm_uring);
+        io_uring_prep_write(sqe,seg->idx_fd,bat->idx,\
+            bat->nfrm*REC_TLM_IDX_SIZE,(off_t) seg->nrec*REC_TLM_IDX_SIZE);
+        io_uring_sqe_set_data(sqe,(void*) (uintptr_t) (2*cls+1));
+        nsub += 2;
+    }
+
+    // Submit and wait for every write:
+    if (io_uring_submit_and_wait(&rec_tlm_uring,nsub) < 0) {
+        nsub = 0;
+        for (cls = 0; cls < REC_TLM_NCLS; ++cls) {
+            err[cls] = EIO;
+        }
+    }
+    for (i = 0; i < nsub; ++i) {
+        if (io_uring_wait_cqe(&rec_tlm_uring,&cqe) != 0) {
+            for (cls = 0; cls < REC_TLM_NCLS; ++cls) {
+                err[cls] = EIO;
+            }
+            break;
+        }
+
+        // Check write (short write: out of space):
+        tag = (uintptr_t) io_uring_cqe_get_data(cqe);
+        cls = tag/2;
+        size = (tag & 1) ? rec_tlm_bat[cls].nfrm*REC_TLM_IDX_SIZE : \
+            rec_tlm_bat[cls].nfrm*REC_TLM_REC_SIZE;
+        if (cqe->res < 0) {
+            err[cls] = -cqe->res;
+        } else if ((uint32_t) cqe->res != size) {
+            err[cls] = ENOSPC;
+        }
+        io_uring_cqe_seen(&rec_tlm_uring,cqe);
+    }
+
+    return 0;
+}
+#endif
+
+// Write pending batches of classes in mask; storage full: evict and retry
+// once (returns frames recorded)
+static uint32_t flsh_rec_tlm(uint8_t cls_msk) {
+    // Definitions and initializations:
+    struct rec_tlm_seg* seg; // Open segment of class
+    struct rec_tlm_bat* bat; // Pending batch of class
+
+    int      err[REC_TLM_NCLS] = {0}; // Error number of class
+    uint8_t  uring_flg = 0;           // Written with io_uring
+    uint32_t rec_cnt = 0;             // Frames recorded
+    uint8_t  cls;
+
+#ifdef REC_TLM_URING
+    // Write batches together:
+    uring_flg = (wrt_rec_tlm_uring(cls_msk,err) == 0);
+#endif
+
+    for (cls = 0; cls < REC_TLM_NCLS; ++cls) {
+        seg = &rec_tlm_seg[cls];
+        bat = &rec_tlm_bat[cls];
+        if (!(cls_msk & (1 << cls)) || (bat->nfrm == 0)) {
+            continue;
+        }
+
+        // Write batch (if not written yet):
+        if (!uring_flg && (wrt_rec_tlm_bat(cls) != 0)) {
+            err[cls] = errno;
+        }
+
+        // Storage full: evict and retry once:
+        if ((err[cls] == ENOSPC) && (evct_rec_tlm(-1) > 0)) {
+            err[cls] = (wrt_rec_tlm_bat(cls) == 0) ? 0 : errno;
+        }
+
+        // Check success:
+        if (err[cls] == 0) {
+            seg->nrec += bat->nfrm;
+            seg->dirty_flg = 1;
+            rec_tlm_sync_nrec += bat->nfrm;
+            rec_cnt += bat->nfrm;
+        } else {
+            // Drop partial records and index entries:
+            ftruncate(seg->fd,REC_TLM_SEG_HDR_SIZE+(off_t) seg->nrec*\
+                REC_TLM_REC_SIZE);
+            ftruncate(seg->idx_fd,(off_t) seg->nrec*REC_TLM_IDX_SIZE);
+
+            // Print:
+            rt_printf("%d (REC_TLM) Error writing %u frames to %s; %s\n",\
+                get_tm_sec(),bat->nfrm,rec_tlm_dir[cls],strerror(err[cls]));
+        }
+
+        // Empty batch:
+        bat->nfrm = 0;
+        bat->niov = 0;
+    }
+
+    return rec_cnt;
+}
+
+uint32_t app_rec_tlm(const char* frm, uint32_t nfrm) {
+    // Definitions and initializations:
+    struct rec_tlm_seg* seg; // Open segment of class
+    struct rec_tlm_bat* bat; // Pending batch of class
+    struct rec_tlm_idx  idx; // Index entry
+
+    int8_t   cls;         // Class
+    uint16_t apid;        // Transfer frame origin
+    uint32_t win;         // Time window start (sec)
+    uint32_t rec_cnt = 0; // Frames recorded
+    uint32_t n;           // Frame counter
+
+    for (n = 0; n < nfrm; ++n, frm += TLM_PKT_XFR_FRM_SIZE) {
+        // Get APID, time, and grouping flag of transfer frame:
+        memcpy(&apid,frm+0,2);
+        get_rec_tlm_idx(frm,&idx);
+
+        // Get class:
+        cls = get_rec_tlm_cls(apid);
+        if (cls < 0) {
+            continue;
+        }
+        seg = &rec_tlm_seg[cls];
+        bat = &rec_tlm_bat[cls];
+
+        // Start new segment for new time window or full segment (pending
+        // batch is written to the old one first):
+        win = idx.sec-idx.sec % REC_TLM_SEG_PRD;
+        if ((seg->fd < 0) || (win != seg->sec) || \
+            (seg->nrec+bat->nfrm >= REC_TLM_SEG_NREC)) {
+            rec_cnt += flsh_rec_tlm(1 << cls);
+            close_rec_tlm_seg(seg);
+            if (open_rec_tlm_seg(cls,win) < 0) {
+                continue;
+            }
+        }
+
+        // Add record header and frame to batch:
+        get_rec_tlm_rec_hdr(frm,&bat->rec[bat->nfrm]);
+        bat->iov[bat->niov].iov_base = &bat->rec[bat->nfrm];
+        bat->iov[bat->niov].iov_len = REC_TLM_REC_HDR_SIZE;
+        bat->iov[bat->niov+1].iov_base = (void*) frm;
+        bat->iov[bat->niov+1].iov_len = TLM_PKT_XFR_FRM_SIZE;
+        bat->niov += 2;
+        bat->idx[bat->nfrm++] = idx;
+
+        // Write full batch:
+        if (bat->nfrm == REC_TLM_BAT_NFRM) {
+            rec_cnt += flsh_rec_tlm(1 << cls);
+        }
+    }
+
+    // Write pending batches of every class:
+    rec_cnt += flsh_rec_tlm((1 << REC_TLM_NCLS)-1);
+
+    // Sync batch when full or period is over:
+    if ((rec_tlm_sync_nrec >= REC_TLM_SYNC_NREC) || \
+        (rt_timer_ticks2ns(rt_timer_read()-rec_tlm_sync_tm) >= \
+        REC_TLM_SYNC_PRD)) {
+        sync_rec_tlm();
+    }
+
+    return rec_cnt;
+}
+// Select segment files (directory listing filter)
+static int sel_rec_tlm_seg(const struct dirent* ent) {
+    // Definitions and initializations:
+    size_t len = strlen(ent->d_name); // Name length
+
+    return (len > 4) && (strcmp(ent->d_name+len-4,".seg") == 0);
+}
+
+int32_t list_rec_tlm_seg(uint8_t cls, char (**seg)[REC_TLM_NAME_MAX]) {
+    // Definitions and initializations:
+    struct dirent** ent; // Segment directory entries
+    int32_t n;           // Number of segments
+    int32_t i;
+
+    // List segments in name (time) order:
+    *seg = NULL;
+    n = scandir(rec_tlm_dir[cls],&ent,sel_rec_tlm_seg,alphasort);
+    if (n <= 0) {
+        return n;
+    }
+
+    // Copy paths without extension:
+    *seg = malloc(n*sizeof(**seg));
+    for (i = 0; i < n; ++i) {
+        if (*seg != NULL) {
+            snprintf((*seg)[i],REC_TLM_NAME_MAX,"%s/%.*s",rec_tlm_dir[cls],\
+                (int) strlen(ent[i]->d_name)-4,ent[i]->d_name);
+        }
+        free(ent[i]);
+    }
+    free(ent);
+
+    return (*seg != NULL) ? n : -1;
+}
@@ -0,0 +1,108 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Record Telemetry Ring
+//
+// Lock-free ring of transfer frames between create file task (producer) and
+// write file task (consumer). See rec_tlm_ring.h.
+//
+// Head and tail count frames since startup (wrapping at 2^32) and are masked
+// to get slots. The producer publishes the head and then reads the tail; the
+// consumer publishes the tail and then reads the head (both sequentially
+// consistent). So if the consumer saw the ring empty before a frame was
+// published, the producer sees the tail at its frame and wakes the consumer;
+// a frame is never left in the ring with the consumer asleep.
+//
+// -------------------------------------------------------------------------- /
+//
+// Dependencies:
+// - Xenomai 3 / Cobalt
+//
+// Input Arguments:
+// - N/A
+//
+// Output Arguments:
+// - N/A
+//
+// -------------------------------------------------------------------------- /
+//
+// agent
+// Project HEPCATS
+// Subsystem: C&DH
+// Created: October 17, 2026
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Standard libraries:
+#include <string.h> // String function definitions
+#include <stdint.h> // Standard integer types
+
+// Xenomai libraries:
+#include <alchemy/timer.h> // Timer management services (RTIME)
+
+// Header files:
+#include <tlm_frm_pool.h> // Telemetry frame pool declarations
+#include <rec_tlm_ring.h> // Record telemetry ring declarations
+
+// Macro definitions:
+#define REC_TLM_RING_MSK (REC_TLM_RING_NFRM-1) // Slot mask
+
+// Ring frames (page aligned):
+static char rec_tlm_ring_buf[REC_TLM_RING_NFRM][TLM_PKT_XFR_FRM_SIZE] \
+    __attribute__((aligned(4096)));
+
+// Head (next frame put) and tail (next frame written), on separate cache
+// lines:
+static uint32_t rec_tlm_ring_head __attribute__((aligned(64))) = 0;
+static uint32_t rec_tlm_ring_tail __attribute__((aligned(64))) = 0;
+
+int8_t put_rec_tlm_ring(const char* frm) {
+    // Definitions and initializations:
+    uint32_t head; // Head
+    uint32_t tail; // Tail
+
+    // Check for room:
+    head = __atomic_load_n(&rec_tlm_ring_head,__ATOMIC_RELAXED);
+    tail = __atomic_load_n(&rec_tlm_ring_tail,__ATOMIC_ACQUIRE);
+    if (head-tail >= REC_TLM_RING_NFRM) {
+        return -1;
+    }
+
+    // Copy frame and publish it:
+    memcpy(rec_tlm_ring_buf[head & REC_TLM_RING_MSK],frm,\
+        TLM_PKT_XFR_FRM_SIZE);
+    __atomic_store_n(&rec_tlm_ring_head,head+1,__ATOMIC_SEQ_CST);
+
+    // Wake consumer if it has written every frame before this one:
+    tail = __atomic_load_n(&rec_tlm_ring_tail,__ATOMIC_SEQ_CST);
+
+    return (tail == head) ? 1 : 0;
+}
+
+uint32_t get_rec_tlm_ring(const char** frm) {
+    // Definitions and initializations:
+    uint32_t head; // Head
+    uint32_t tail; // Tail
+    uint32_t nfrm; // Frames to write
+
+    // Get frames published after tail:
+    tail = __atomic_load_n(&rec_tlm_ring_tail,__ATOMIC_RELAXED);
+    head = __atomic_load_n(&rec_tlm_ring_head,__ATOMIC_SEQ_CST);
+    nfrm = head-tail;
+
+    // Stop at end of ring (rest is written from the start next):
+    if (nfrm > REC_TLM_RING_NFRM-(tail & REC_TLM_RING_MSK)) {
+        nfrm = REC_TLM_RING_NFRM-(tail & REC_TLM_RING_MSK);
+    }
+    *frm = rec_tlm_ring_buf[tail & REC_TLM_RING_MSK];
+
+    return nfrm;
+}
+
+void rls_rec_tlm_ring(uint32_t nfrm) {
+    // Free frames (producer may reuse their slots):
+    __atomic_store_n(&rec_tlm_ring_tail,\
+        __atomic_load_n(&rec_tlm_ring_tail,__ATOMIC_RELAXED)+nfrm,\
+        __ATOMIC_SEQ_CST);
+
+    return;
+}
@@ -0,0 +1,177 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Segment Telemetry Packet Transfer Frames
+// 
+// Whole payload (e.g. a processed image) is segmented into telemetry packet
+// transfer frames in one pass. Frames are built directly in frame pool slots
+// straight from the source data buffer and every frame of the payload carries
+// the same creation time (one time stamp per payload). Grouping flags are
+// first (1), continuation (0), and last (2) segment, or unsegmented (3) if the
+// payload fits in one frame.
+//
+// Frames are allocated from the pool in blocks of up to TLM_FRM_SEG_NFRM and
+// each block of frame handles is published to the message queue with a single
+// rt_queue_write. The receiving task reads a block of handles at once. A
+// message queue credit (flw_ctl.h) is reserved before each block is allocated
+// and built, so no frame is built that cannot be published.
+//
+// -------------------------------------------------------------------------- /
+//
+// Input Arguments:
+// - Source data buffer
+// - Source data size in bytes
+// - Source origin APID
+// - Destination flow controlled message queue
+//
+// Output Arguments:
+// - Number of transfer frames published (or negative error)
+//
+// -------------------------------------------------------------------------- /
+//
+// agent
+// Project HEPCATS
+// Subsystem: C&DH
+// Created: October 17, 2026
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Standard libraries:
+#include <stdlib.h>   // Standard library
+#include <string.h>   // String function definitions
+#include <stdint.h>   // Integer types
+#include <time.h>     // Standard time function definitions
+
+// Xenomai libraries:
+#include <alchemy/queue.h> // Message queue services
+#include <alchemy/sem.h>   // Semaphore services
+
+// Header files:
+#include <tlm_frm_pool.h>         // Telemetry frame pool declarations
+#include <crt_tlm_pkt_xfr_frm.h>  // Create telemetry packet transfer frame
+                                  // function declarations
+#include <flw_ctl.h>              // Flow control declarations
+#include <seg_tlm_pkt_xfr_frm.h>  // Segment telemetry packet transfer frames
+                                  // function declaration
+#include <tm_svc.h>               // Time service declarations
+
+// Macro definitions:
+#define TLM_PKT_USR_DAT_SIZE 1064 // Telemetry packet user data size in bytes
+
+int32_t seg_tlm_pkt_xfr_frm(char* src_dat, size_t src_dat_size,
+    uint16_t apid, struct flw_ctl* fc) {
+    // Definitions and initializations:
+    int32_t  ret_val; // Function return value
+    uint32_t i;       // Transfer frame index
+    uint16_t j;       // Block index
+
+    uint32_t sec; // Creation time seconds
+    uint16_t frc; // Creation time fraction (1/65536 sec)
+
+    uint32_t num_tlm_pkt_xfr_frm_req; // Required number of transfer frames
+    uint32_t num_tlm_pkt_xfr_frm_pub; // Published number of transfer frames
+    uint16_t num_tlm_frm_blk;         // Number of frames in current block
+
+    uint8_t  tlm_pkt_xfr_frm_grp_flg; // Packet sequence grouping flag
+    uint16_t copy_size;               // Source data copy size
+
+    tlm_frm_hdl_t tlm_frm_hdl_blk[TLM_FRM_SEG_NFRM]; // Block of frame handles
+
+    // Determine how many transfer frames are required:
+    num_tlm_pkt_xfr_frm_req = \
+        (src_dat_size + TLM_PKT_USR_DAT_SIZE - 1)/TLM_PKT_USR_DAT_SIZE;
+
+    // Get current time (once for whole payload):
+    get_tm_cuc(&sec,&frc);
+
+    // Loop to create and publish blocks of transfer frames:
+    num_tlm_pkt_xfr_frm_pub = 0;
+    while (num_tlm_pkt_xfr_frm_pub < num_tlm_pkt_xfr_frm_req) {
+        // Determine block size:
+        num_tlm_frm_blk = TLM_FRM_SEG_NFRM;
+        if (num_tlm_pkt_xfr_frm_req - num_tlm_pkt_xfr_frm_pub < \
+            TLM_FRM_SEG_NFRM) {
+            num_tlm_frm_blk = \
+                num_tlm_pkt_xfr_frm_req - num_tlm_pkt_xfr_frm_pub;
+        }
+
+        // Reserve message queue credit for block:
+        ret_val = rsv_flw_ctl(fc,apid);
+
+        // Check success (rest of payload is dropped):
+        if (ret_val < 0) {
+            // Count dropped frames:
+            drop_flw_ctl(fc,num_tlm_pkt_xfr_frm_req-num_tlm_pkt_xfr_frm_pub);
+
+            return ret_val;
+        }
+
+        // Allocate block of frames from frame pool:
+        // (waits for at least one frame; takes whatever else is free)
+        ret_val = alloc_tlm_frm_blk(tlm_frm_hdl_blk,num_tlm_frm_blk,\
+            TM_INFINITE);
+
+        // Check success:
+        if (ret_val < 0) {
+            // Cancel reserved credit:
+            cncl_flw_ctl(fc);
+
+            return ret_val;
+        }
+
+        // Set block size to number of frames allocated:
+        num_tlm_frm_blk = ret_val;
+
+        // Loop to build transfer frames in block:
+        for (j = 0; j < num_tlm_frm_blk; ++j) {
+            // Set transfer frame index:
+            i = num_tlm_pkt_xfr_frm_pub + j;
+
+            // Set grouping flag based off index:
+            if (num_tlm_pkt_xfr_frm_req == 1) {
+                tlm_pkt_xfr_frm_grp_flg = 3; // Unsegmented data
+            } else if (i == 0) {
+                tlm_pkt_xfr_frm_grp_flg = 1; // First segment
+            } else if (i == (num_tlm_pkt_xfr_frm_req - 1)) {
+                tlm_pkt_xfr_frm_grp_flg = 2; // Last segment
+            } else {
+                tlm_pkt_xfr_frm_grp_flg = 0; // Continuation segment
+            }
+
+            // Set copy size in bytes:
+            if (i == (num_tlm_pkt_xfr_frm_req - 1)) {
+                copy_size = src_dat_size - TLM_PKT_USR_DAT_SIZE*i;
+            } else {
+                copy_size = TLM_PKT_USR_DAT_SIZE;
+            }
+
+            // Build transfer frame in frame pool slot straight from source
+            // data buffer:
+            bld_tlm_pkt_xfr_frm(src_dat+TLM_PKT_USR_DAT_SIZE*i,copy_size,\
+                get_tlm_frm_buf(tlm_frm_hdl_blk[j]),apid,\
+                tlm_pkt_xfr_frm_grp_flg,sec,frc);
+        }
+
+        // Publish block of frame handles via message queue:
+        ret_val = send_flw_ctl(fc,tlm_frm_hdl_blk,\
+            num_tlm_frm_blk*TLM_FRM_HDL_SIZE);
+
+        // Check success (rest of payload is dropped):
+        if (ret_val < 0) {
+            // Return block to pool:
+            for (j = 0; j < num_tlm_frm_blk; ++j) {
+                rls_tlm_frm(tlm_frm_hdl_blk[j]);
+            }
+
+            // Count dropped frames after block (block counted by send):
+            drop_flw_ctl(fc,num_tlm_pkt_xfr_frm_req-num_tlm_pkt_xfr_frm_pub-\
+                num_tlm_frm_blk);
+
+            return ret_val;
+        }
+
+        // Update published count:
+        num_tlm_pkt_xfr_frm_pub += num_tlm_frm_blk;
+    }
+
+    return num_tlm_pkt_xfr_frm_pub;
+}
@@ -0,0 +1,77 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Send Aggregate Telemetry Sample
+//
+// Time stamps a telemetry sample (e.g. one housekeeping record or one
+// magnetometer DAQ read) and sends it to the aggregate telemetry task via
+// message queue. The aggregate telemetry task packs samples of the same APID
+// into telemetry packet transfer frames.
+//
+// The message queue is flow controlled (flw_ctl.h); the sender waits a bounded
+// time for a free slot before the drop policy applies.
+//
+// -------------------------------------------------------------------------- /
+//
+// Input Arguments:
+// - Sample buffer
+// - Sample size in bytes (at most AGG_TLM_SMPL_MAX)
+// - Source origin APID
+//
+// Output Arguments:
+// - Message queue write return value (negative error, -ETIMEDOUT if dropped)
+//
+// -------------------------------------------------------------------------- /
+//
+// agent
+// Project HEPCATS
+// Subsystem: C&DH
+// Created: October 17, 2026
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Standard libraries:
+#include <stdlib.h>   // Standard library
+#include <string.h>   // String function definitions
+#include <errno.h>    // Error number definitions
+#include <stdint.h>   // Integer types
+#include <time.h>     // Standard time function definitions
+
+// Xenomai libraries:
+#include <alchemy/queue.h> // Message queue services
+#include <alchemy/sem.h>   // Semaphore services
+
+// Header files:
+#include <msg_queues.h>  // Message queue variable declarations
+#include <agg_tlm_pkt.h> // Aggregated telemetry packet sub-header
+#include <agg_tlm.h>     // Aggregate telemetry declarations
+#include <flw_ctl.h>     // Flow control declarations
+#include <tm_svc.h>      // Time service declarations
+
+int32_t send_agg_tlm(char* smpl, size_t smpl_size, uint16_t apid,
+    uint8_t enc_flg) {
+    // Definitions and initializations:
+    uint32_t sec; // Creation time seconds
+    uint16_t frc; // Creation time fraction (1/65536 sec)
+
+    char agg_tlm_msg_buf[AGG_TLM_MSG_MAX]; // Sample message buffer
+
+    // Check sample size:
+    if (smpl_size > AGG_TLM_SMPL_MAX) {
+        return -EINVAL;
+    }
+
+    // Get current time:
+    get_tm_cuc(&sec,&frc);
+
+    // Build sample message (APID, creation time, encoded flag, and sample):
+    memcpy(agg_tlm_msg_buf+0,&apid,2);
+    memcpy(agg_tlm_msg_buf+2,&sec,4);
+    memcpy(agg_tlm_msg_buf+6,&frc,2);
+    memcpy(agg_tlm_msg_buf+8,&enc_flg,1);
+    memcpy(agg_tlm_msg_buf+AGG_TLM_MSG_HDR_SIZE,smpl,smpl_size);
+
+    // Send sample message to aggregate telemetry task via flow controlled
+    // message queue:
+    return put_flw_ctl(&flw_ctl_tbl[FLW_CTL_AGG_TLM],agg_tlm_msg_buf,\
+        AGG_TLM_MSG_HDR_SIZE+smpl_size,apid);
+}
@@ -0,0 +1,139 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Send Command
+//
+// Function responsible for directing a command to execute now to its
+// command application task. The command's APID is compared against known
+// destination APIDs. When the command's APID is associated with the
+// destination, the command transfer frame is sent to the respective command
+// application task via synchronous messaging and the command execution
+// status is returned from its reply. A reply other than executed (1) or not
+// executed (0) means the status is not known yet (e.g. playback started);
+// the command application counts such a command itself when it is done.
+//
+// Used by command executor task (commands from the uplink and the command
+// scheduler) and the run sequence task (steps of stored sequences). Command
+// application tasks receive one message at a time, so both may send to the
+// same task.
+//
+// -------------------------------------------------------------------------- /
+//
+// Dependencies:
+// - Xenomai 3 / Cobalt
+//
+// Input Arguments:
+// - cmd_xfr_frm_buf
+//
+// Output Arguments:
+// - ret_val
+//
+// -------------------------------------------------------------------------- /
+//
+// agent
+// Project HEPCATS
+// Subsystem: C&DH
+// Created: October 17, 2026
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Standard libraries:
+#include <string.h> // String function definitions
+#include <stdint.h> // Standard integer types
+
+// Xenomai libraries:
+#include <alchemy/task.h> // Task management service
+
+// Header files:
+#include <tasks.h>    // Task variable and function declarations
+#include <send_cmd.h> // Send command declarations
+#include <tm_svc.h>   // Time service declarations
+
+// Macro definitions:
+#define CMD_XFR_FRM_SIZE 15 // Command transfer frame size in bytes
+#define RPLY_MSG_SIZE     1 // Command execution status reply message size in
+                            // bytes
+
+int8_t send_cmd(char* cmd_xfr_frm_buf) {
+    // Definitions and initializations:
+    int      ret_val;       // Function return value
+    uint16_t cmd_apid;      // Command APID
+    uint8_t  cmd_exec_stat; // Command execution status flag
+
+    RT_TASK* dest_task; // Destination task of command
+
+    // Message control blocks definitions:
+    RT_TASK_MCB cmd_xfr_frm_mcb; // For command transfer frame to command
+                                 // application tasks
+    RT_TASK_MCB rply_mcb;        // For command execution status reply message
+                                 // from command applications
+
+    cmd_xfr_frm_mcb.data = cmd_xfr_frm_buf;  // Command transfer frame message
+                                             // buffer
+    cmd_xfr_frm_mcb.size = CMD_XFR_FRM_SIZE; // Command transfer frame message
+                                             // size in bytes
+
+    rply_mcb.data = &cmd_exec_stat; // Reply message buffer
+    rply_mcb.size = RPLY_MSG_SIZE;  // Reply message size in bytes
+
+    // Switch to direct command to final destination by matching the
+    // command's APID to a destination's APID:
+    memcpy(&cmd_apid,cmd_xfr_frm_buf+0,2);
+    switch(cmd_apid) {
+        // Software:
+        case DEST_APID_SW :
+            dest_task = &cmd_sw_task; // Command software task
+
+            // Exit switch:
+            break;
+        // Imaging:
+        case DEST_APID_IMG :
+            dest_task = &cmd_img_task; // Command imaging task
+
+            // Exit switch:
+            break;
+        // Magnetometer DAQ:
+        case DEST_APID_MDQ :
+            dest_task = &cmd_mdq_task; // Command magnetometer DAQ task
+
+            // Exit switch:
+            break;
+        // Electrical power relay:
+        case DEST_APID_ERS :
+            dest_task = &cmd_ers_task; // Command electrical power relay task
+
+            // Exit switch:
+            break;
+        // If command APID does not match:
+        default :
+            // Print:
+            rt_printf("%d (SEND_CMD) Command APID 0x%X is invalid; command"
+                " transfer frame ignored\n",get_tm_sec(),cmd_apid);
+
+            return -1;
+    }
+
+    // Send command transfer frame to final destination via synchronous
+    // message passing. Reply required from destination task for command
+    // execution status:
+    ret_val = rt_task_send(dest_task,&cmd_xfr_frm_mcb,&rply_mcb,\
+        TM_INFINITE);
+
+    // Check success:
+    if (ret_val <= 0) {
+        // Print:
+        rt_printf("%d (SEND_CMD) Error sending command transfer frame to"
+            " command application; error %d\n",get_tm_sec(),ret_val);
+
+        return 0;
+    }
+
+    // Check command execution status (any other status is unknown, e.g.
+    // playback started; counted by command application when done):
+    if (cmd_exec_stat == 1) {
+        return 1;
+    } else if (cmd_exec_stat == 0) {
+        return 0;
+    }
+
+    return 2;
+}
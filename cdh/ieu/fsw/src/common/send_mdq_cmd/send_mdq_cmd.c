@@ -57,6 +57,7 @@
 
 // Header files:
 #include <mdq_dev.h> // Magnetometer DAQ device variable declarations
+#include <tm_svc.h>  // Time service declarations
 
 // Variable definitions:
 libusb_device_handle* dev_hdl; // Device handle
@@ -76,7 +77,7 @@ int8_t send_mdq_cmd(char* cmd_str) {
 
     // Print:
     rt_printf("%d (SEND_MDQ_CMD) Received command; sending \"%s\"\n",\
-        time(NULL),cmd_str);
+        get_tm_sec(),cmd_str);
 
     // Append return carriage to command:
     sprintf((char*) cmd,"%s\r",cmd_str);
@@ -139,11 +140,11 @@ int8_t send_mdq_cmd(char* cmd_str) {
                 (strcmp(rsp_str,exp_rsp_str) > 0)) {
                 // Print:
                 rt_printf("%d (SEND_MDQ_CMD) Received expected command"
-                    " response; command executed successfully\n",time(NULL));
+                    " response; command executed successfully\n",get_tm_sec());
             } else {
                 // Print:
                 rt_printf("%d (SEND_MDQ_CMD) Did not receive expected command"
-                    " response; command did not execute\n",time(NULL));
+                    " response; command did not execute\n",get_tm_sec());
 
                 // Set return value:
                 ret_val = -1; 
@@ -151,7 +152,7 @@ int8_t send_mdq_cmd(char* cmd_str) {
         } else {
             // Print:
             rt_printf("%d (SEND_MDQ_CMD) Error reading command response"
-                "; aborting with error %d\n",time(NULL),ret_val);
+                "; aborting with error %d\n",get_tm_sec(),ret_val);
 
             // Exit:
             return ret_val;
@@ -159,11 +160,11 @@ int8_t send_mdq_cmd(char* cmd_str) {
     } else if (rsp_exp_flg == 0) {
         // Print:
         rt_printf("%d (SEND_MDQ_CMD) Command response not expected;"
-            " ignoring check\n",time(NULL));
+            " ignoring check\n",get_tm_sec());
     } else if (ret_val < 0) {
         // Print:
         rt_printf("%d (SEND_MDQ_CMD) Error sending command; aborting"
-            " with error %d\n",time(NULL),ret_val);
+            " with error %d\n",get_tm_sec(),ret_val);
     }
 
     // Return:
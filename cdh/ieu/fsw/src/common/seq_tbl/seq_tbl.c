@@ -0,0 +1,365 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Sequence Table
+//
+// Onboard table of stored command sequences (seq_tbl.h). The command
+// software task uploads a sequence word by word into a loading buffer. Once
+// every word is received, the sequence is checked (CRC-16 and step count),
+// copied into its table entry, and the table is persisted. A sequence that
+// is running is never replaced, so the run sequence task reads its steps
+// without a lock.
+//
+// Starting and stopping are requested by the command software task and
+// served by the run sequence task: the running sequence ID (SEQ_TBL_NONE
+// when idle) is claimed with an atomic compare-and-swap, so only one
+// sequence runs at a time, and the run sequence task is woken by its
+// semaphore.
+//
+// The persisted table is written to a temporary file, synced, and renamed
+// over the table file, so a power loss leaves either the old or the new
+// table. At startup every persisted sequence with a valid CRC is loaded.
+//
+// -------------------------------------------------------------------------- /
+//
+// Dependencies:
+// - Xenomai 3 / Cobalt
+//
+// Input Arguments:
+// - N/A
+//
+// Output Arguments:
+// - N/A
+//
+// -------------------------------------------------------------------------- /
+//
+// agent
+// Project HEPCATS
+// Subsystem: C&DH
+// Created: October 17, 2026
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Standard libraries:
+#include <stdio.h>   // Standard input/output definitions
+#include <stdlib.h>  // Standard library
+#include <unistd.h>  // UNIX standard function definitions
+#include <string.h>  // String function definitions
+#include <stdint.h>  // Standard integer types
+
+// Xenomai libraries:
+#include <alchemy/task.h> // Task management services
+#include <alchemy/sem.h>  // Semaphore services
+
+// Header files:
+#include <ccsds_crc.h>  // CCSDS packet error control (CRC)
+#include <hk_tlm_var.h> // Housekeeping telemetry variable declarations
+#include <sems.h>       // Semaphore variable declarations
+#include <seq_tbl.h>    // Sequence table declarations
+#include <tm_svc.h>     // Time service declarations
+
+// Macro definitions:
+#define SEQ_TBL_SEQ_NWRD \
+    (SEQ_TBL_NSTEP*SEQ_TBL_STEP_NWRD) // Maximum sequence size in words
+
+// Sequence table:
+static struct seq_tbl_seq seq_tbl[SEQ_TBL_NSEQ];
+
+// Stop request flag (set by command software task, cleared by run sequence
+// task):
+static uint8_t seq_tbl_stp_flg = 0;
+
+// Upload state (command software task only):
+static uint8_t  ld_seq_act = 0;                   // Upload in progress
+static uint8_t  ld_seq_id;                        // Sequence ID of upload
+static uint16_t ld_seq_nwrd;                      // Words in upload
+static uint16_t ld_seq_rcv_cnt;                   // Words received
+static uint16_t ld_seq_wrd_buf[SEQ_TBL_SEQ_NWRD]; // Words received
+static uint8_t  ld_seq_rcv_flg[SEQ_TBL_SEQ_NWRD]; // Word received flags
+
+// Calculate CRC-16 of sequence (ID, step count, and words, big-endian)
+static uint16_t calc_seq_crc(uint8_t id, const struct seq_tbl_seq* seq) {
+    // Definitions and initializations:
+    uint16_t i;     // Step
+    size_t   n = 0; // Bytes serialized
+
+    char buf[4+SEQ_TBL_SEQ_NWRD*2]; // Serialized sequence
+
+    // Serialize ID and step count:
+    buf[n++] = 0;
+    buf[n++] = id;
+    buf[n++] = seq->nstep >> 8;
+    buf[n++] = seq->nstep & 0xFF;
+
+    // Serialize steps (as uploaded):
+    for (i = 0; i < seq->nstep; ++i) {
+        buf[n++] = seq->step[i].apid >> 8;
+        buf[n++] = seq->step[i].apid & 0xFF;
+        buf[n++] = seq->step[i].pkt_name >> 8;
+        buf[n++] = seq->step[i].pkt_name & 0xFF;
+        buf[n++] = seq->step[i].arg >> 24;
+        buf[n++] = (seq->step[i].arg >> 16) & 0xFF;
+        buf[n++] = (seq->step[i].arg >> 8) & 0xFF;
+        buf[n++] = seq->step[i].arg & 0xFF;
+        buf[n++] = seq->step[i].dly_ms >> 24;
+        buf[n++] = (seq->step[i].dly_ms >> 16) & 0xFF;
+        buf[n++] = (seq->step[i].dly_ms >> 8) & 0xFF;
+        buf[n++] = seq->step[i].dly_ms & 0xFF;
+    }
+
+    return calc_ccsds_crc(buf,n);
+}
+
+// Write table to table file (temporary file renamed over it)
+static int8_t wrt_seq_tbl() {
+    // Definitions and initializations:
+    FILE* fd; // Table file
+
+    // Write temporary file:
+    fd = fopen(SEQ_TBL_TMP,"wb");
+    if (fd == NULL) {
+        return -1;
+    }
+    if ((fwrite(seq_tbl,sizeof(seq_tbl),1,fd) != 1) || \
+        (fflush(fd) != 0) || (fsync(fileno(fd)) != 0)) {
+        fclose(fd);
+        remove(SEQ_TBL_TMP);
+        return -1;
+    }
+    fclose(fd);
+
+    // Replace table file:
+    if (rename(SEQ_TBL_TMP,SEQ_TBL_FILE) != 0) {
+        remove(SEQ_TBL_TMP);
+        return -1;
+    }
+
+    return 0;
+}
+
+// Load persisted table (before tasks start)
+void init_seq_tbl() {
+    // Definitions and initializations:
+    FILE*   fd;       // Table file
+    uint8_t id;       // Sequence ID
+    uint8_t nseq = 0; // Sequences loaded
+
+    // Read persisted table:
+    memset(seq_tbl,0,sizeof(seq_tbl));
+    fd = fopen(SEQ_TBL_FILE,"rb");
+    if (fd != NULL) {
+        if (fread(seq_tbl,sizeof(seq_tbl),1,fd) != 1) {
+            memset(seq_tbl,0,sizeof(seq_tbl));
+        }
+        fclose(fd);
+    }
+
+    // Keep valid sequences only:
+    for (id = 0; id < SEQ_TBL_NSEQ; ++id) {
+        if ((seq_tbl[id].nstep == 0) || \
+            (seq_tbl[id].nstep > SEQ_TBL_NSTEP) || \
+            (calc_seq_crc(id,&seq_tbl[id]) != seq_tbl[id].crc)) {
+            memset(&seq_tbl[id],0,sizeof(struct seq_tbl_seq));
+        } else {
+            ++nseq;
+        }
+    }
+
+    // Idle:
+    seq_run_id = SEQ_TBL_NONE;
+
+    // Print:
+    rt_printf("%d (SEQ_TBL) %d stored command sequences loaded\n",\
+        get_tm_sec(),nseq);
+
+    return;
+}
+
+// Get sequence (only the running sequence is read outside command software
+// task)
+const struct seq_tbl_seq* get_seq(uint8_t id) {
+    return &seq_tbl[id];
+}
+
+// Begin upload (command argument is (sequence ID << 16) | step count)
+int8_t bgn_ld_seq(uint32_t arg) {
+    // Definitions and initializations:
+    uint16_t id = arg >> 16;       // Sequence ID
+    uint16_t nstep = arg & 0xFFFF; // Steps
+
+    // Check sequence ID and step count:
+    if ((id >= SEQ_TBL_NSEQ) || (nstep == 0) || (nstep > SEQ_TBL_NSTEP)) {
+        // Print:
+        rt_printf("%d (SEQ_TBL) Invalid sequence %d or step count %d"
+            " (maximum %d)\n",get_tm_sec(),id,nstep,SEQ_TBL_NSTEP);
+
+        return -1;
+    }
+
+    // Reset received words:
+    memset(ld_seq_rcv_flg,0,sizeof(ld_seq_rcv_flg));
+    ld_seq_id = id;
+    ld_seq_nwrd = nstep*SEQ_TBL_STEP_NWRD;
+    ld_seq_rcv_cnt = 0;
+    ld_seq_act = 1;
+
+    // Print:
+    rt_printf("%d (SEQ_TBL) Sequence %d upload started (%d steps, %d"
+        " words)\n",get_tm_sec(),id,nstep,ld_seq_nwrd);
+
+    return 1;
+}
+
+// Load word of upload (command argument is (word index << 16) | word)
+int8_t ld_seq_wrd(uint32_t arg) {
+    // Definitions and initializations:
+    uint16_t idx = arg >> 16;    // Word index
+    uint16_t wrd = arg & 0xFFFF; // Word
+
+    // Check upload in progress and word index:
+    if (!ld_seq_act || (idx >= ld_seq_nwrd)) {
+        // Print:
+        rt_printf("%d (SEQ_TBL) Sequence word %d unexpected; ignored\n",\
+            get_tm_sec(),idx);
+
+        return -1;
+    }
+
+    // Store and count word (a repeated word overwrites the previous one):
+    ld_seq_wrd_buf[idx] = wrd;
+    if (!ld_seq_rcv_flg[idx]) {
+        ld_seq_rcv_flg[idx] = 1;
+        ld_seq_rcv_cnt++;
+    }
+
+    return 1;
+}
+
+// Validate, store, and persist upload (command argument is the CRC-16)
+int8_t end_ld_seq(uint16_t crc) {
+    // Definitions and initializations:
+    uint16_t i; // Step
+
+    const uint16_t*    wrd; // Words of step
+    struct seq_tbl_seq seq; // Uploaded sequence
+
+    // Check upload in progress:
+    if (!ld_seq_act) {
+        // Print:
+        rt_printf("%d (SEQ_TBL) No sequence upload in progress\n",\
+            get_tm_sec());
+
+        return -1;
+    }
+
+    // Upload ends here whether or not the sequence is accepted:
+    ld_seq_act = 0;
+
+    // Check every word was received:
+    if (ld_seq_rcv_cnt != ld_seq_nwrd) {
+        // Print:
+        rt_printf("%d (SEQ_TBL) Sequence %d upload incomplete (%d of %d"
+            " words); rejected\n",get_tm_sec(),ld_seq_id,ld_seq_rcv_cnt,\
+            ld_seq_nwrd);
+
+        return -1;
+    }
+
+    // Build sequence from words:
+    memset(&seq,0,sizeof(seq));
+    seq.nstep = ld_seq_nwrd/SEQ_TBL_STEP_NWRD;
+    for (i = 0; i < seq.nstep; ++i) {
+        wrd = ld_seq_wrd_buf+i*SEQ_TBL_STEP_NWRD;
+        seq.step[i].apid = wrd[0];
+        seq.step[i].pkt_name = wrd[1];
+        seq.step[i].arg = ((uint32_t) wrd[2] << 16) | wrd[3];
+        seq.step[i].dly_ms = ((uint32_t) wrd[4] << 16) | wrd[5];
+    }
+
+    // Check CRC:
+    seq.crc = calc_seq_crc(ld_seq_id,&seq);
+    if (seq.crc != crc) {
+        // Print:
+        rt_printf("%d (SEQ_TBL) Sequence %d CRC 0x%04X does not match 0x%04X;"
+            " rejected\n",get_tm_sec(),ld_seq_id,seq.crc,crc);
+
+        return -1;
+    }
+
+    // Check sequence is not running (its steps are being read):
+    if (__atomic_load_n(&seq_run_id,__ATOMIC_ACQUIRE) == ld_seq_id) {
+        // Print:
+        rt_printf("%d (SEQ_TBL) Sequence %d is running; rejected\n",\
+            get_tm_sec(),ld_seq_id);
+
+        return -1;
+    }
+
+    // Store:
+    memcpy(&seq_tbl[ld_seq_id],&seq,sizeof(seq));
+
+    // Persist (sequence is still stored if this fails):
+    if (wrt_seq_tbl() < 0) {
+        // Print:
+        rt_printf("%d (SEQ_TBL) Error writing sequence table file; sequence"
+            " will not survive restart\n",get_tm_sec());
+    }
+
+    // Print:
+    rt_printf("%d (SEQ_TBL) Sequence %d uploaded (%d steps, CRC 0x%04X)\n",\
+        get_tm_sec(),ld_seq_id,seq.nstep,seq.crc);
+
+    return 1;
+}
+
+// Start sequence (command argument is the sequence ID)
+int8_t str_seq(uint32_t id) {
+    // Definitions and initializations:
+    uint8_t run_id = SEQ_TBL_NONE; // Running sequence ID expected (idle)
+
+    // Check sequence is stored:
+    if ((id >= SEQ_TBL_NSEQ) || (seq_tbl[id].nstep == 0)) {
+        // Print:
+        rt_printf("%d (SEQ_TBL) Sequence %d is not stored\n",get_tm_sec(),\
+            id);
+
+        return -1;
+    }
+
+    // Clear stale stop request, then claim run (fails if one is running):
+    __atomic_store_n(&seq_tbl_stp_flg,0,__ATOMIC_SEQ_CST);
+    if (!__atomic_compare_exchange_n(&seq_run_id,&run_id,(uint8_t) id,0,\
+        __ATOMIC_SEQ_CST,__ATOMIC_SEQ_CST)) {
+        // Print:
+        rt_printf("%d (SEQ_TBL) Sequence %d is running; sequence %d not"
+            " started\n",get_tm_sec(),run_id,id);
+
+        return -1;
+    }
+
+    // Wake run sequence task:
+    rt_sem_v(&run_seq_sem);
+
+    return 1;
+}
+
+// Stop running sequence
+int8_t stp_seq() {
+    // Check a sequence is running:
+    if (__atomic_load_n(&seq_run_id,__ATOMIC_SEQ_CST) == SEQ_TBL_NONE) {
+        // Print:
+        rt_printf("%d (SEQ_TBL) No sequence running\n",get_tm_sec());
+
+        return -1;
+    }
+
+    // Request stop and wake run sequence task:
+    __atomic_store_n(&seq_tbl_stp_flg,1,__ATOMIC_SEQ_CST);
+    rt_sem_v(&run_seq_sem);
+
+    return 1;
+}
+
+// Get and clear stop request (run sequence task)
+uint8_t get_stp_seq() {
+    return __atomic_exchange_n(&seq_tbl_stp_flg,0,__ATOMIC_SEQ_CST);
+}
@@ -0,0 +1,148 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Telemetry Frame Pool
+//
+// Preallocated, fixed-size pool of telemetry packet transfer frames shared by
+// the whole downlink chain (read_mdq/img/get_hk_tlm --> flt_tbl -->
+// tx_tlm_pkt/crt_file and rtrv_file --> tx_tlm_pkt).
+//
+// Producers allocate a frame from the pool and build the transfer frame
+// directly in the pool slot. From then on only the frame handle (the index of
+// the slot) is passed through message queues, so the 1089 byte frame is never
+// copied again. Each frame carries a reference count so that one frame can
+// fan out to several consumers (e.g. downlink and recording); every consumer
+// releases its reference once done and the frame returns to the pool when the
+// last reference is released.
+//
+// The free list is itself a Xenomai message queue of frame handles
+// (tlm_frm_free_msg_queue) created with the other message queues during
+// startup. Allocating a frame reads a handle from that queue which lets a
+// producer wait (with a timeout) for a frame when the pool is exhausted.
+//
+// -------------------------------------------------------------------------- /
+//
+// Dependencies:
+// - Xenomai 3 / Cobalt
+//
+// Input Arguments:
+// - N/A
+//
+// Output Arguments:
+// - N/A
+//
+// -------------------------------------------------------------------------- /
+//
+// agent
+// Project HEPCATS
+// Subsystem: C&DH
+// Created: October 17, 2026
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Standard libraries:
+#include <stdlib.h>  // Standard library
+#include <errno.h>   // Error number definitions
+#include <stdint.h>  // Standard integer types
+#include <time.h>    // Standard time types
+
+// Xenomai libraries:
+#include <alchemy/queue.h> // Message queue services
+
+// Header files:
+#include <msg_queues.h>   // Message queue variable declarations
+#include <tlm_frm_pool.h> // Telemetry frame pool declarations
+
+// Frame pool definitions:
+static char tlm_frm_pool_buf[TLM_FRM_POOL_NFRM][TLM_PKT_XFR_FRM_SIZE];
+static uint8_t tlm_frm_pool_ref_cnt[TLM_FRM_POOL_NFRM]; // Reference counts
+
+// Populate free list with every frame in the pool
+void init_tlm_frm_pool() {
+    // Definitions and initializations:
+    tlm_frm_hdl_t hdl; // Frame handle
+
+    // Loop to place all frames on the free list:
+    for (hdl = 0; hdl < TLM_FRM_POOL_NFRM; ++hdl) {
+        // Set reference count:
+        tlm_frm_pool_ref_cnt[hdl] = 0; // Free
+
+        // Append handle to free list:
+        rt_queue_write(&tlm_frm_free_msg_queue,&hdl,TLM_FRM_HDL_SIZE,\
+            Q_NORMAL);
+    }
+
+    return;
+}
+
+// Allocate frame from pool (waits up to timeout for a free frame)
+int16_t alloc_tlm_frm(tlm_frm_hdl_t* hdl, RTIME timeout) {
+    // Definitions and initializations:
+    int32_t ret_val; // Function return value
+
+    // Get handle from free list:
+    ret_val = rt_queue_read(&tlm_frm_free_msg_queue,hdl,TLM_FRM_HDL_SIZE,\
+        timeout);
+
+    // Check success:
+    if (ret_val != TLM_FRM_HDL_SIZE) {
+        // Return error (-ETIMEDOUT, -EWOULDBLOCK, ...):
+        return (ret_val < 0) ? ret_val : -EIO;
+    }
+
+    // Set reference count (allocating task holds the only reference):
+    __atomic_store_n(&tlm_frm_pool_ref_cnt[*hdl],1,__ATOMIC_RELEASE);
+
+    return 0;
+}
+
+// Allocate up to nfrm frames from pool (waits up to timeout for the first
+// frame only; returns number of frames allocated)
+int16_t alloc_tlm_frm_blk(tlm_frm_hdl_t* hdl, uint16_t nfrm, RTIME timeout) {
+    // Definitions and initializations:
+    int16_t ret_val;  // Function return value
+    uint16_t i;       // Counter
+
+    // Allocate first frame (wait if pool is exhausted):
+    ret_val = alloc_tlm_frm(&hdl[0],timeout);
+
+    // Check success:
+    if (ret_val < 0) {
+        return ret_val;
+    }
+
+    // Loop to take any remaining free frames without waiting:
+    for (i = 1; i < nfrm; ++i) {
+        // Allocate frame:
+        if (alloc_tlm_frm(&hdl[i],TM_NONBLOCK) < 0) {
+            break;
+        }
+    }
+
+    return i;
+}
+
+// Add reference to frame (one per additional consumer)
+void ref_tlm_frm(tlm_frm_hdl_t hdl) {
+    // Increment reference count:
+    __atomic_add_fetch(&tlm_frm_pool_ref_cnt[hdl],1,__ATOMIC_RELAXED);
+
+    return;
+}
+
+// Release reference to frame (frame is returned to pool on last reference)
+void rls_tlm_frm(tlm_frm_hdl_t hdl) {
+    // Decrement reference count and check for last reference:
+    if (__atomic_sub_fetch(&tlm_frm_pool_ref_cnt[hdl],1,\
+        __ATOMIC_ACQ_REL) == 0) {
+        // Return handle to free list:
+        rt_queue_write(&tlm_frm_free_msg_queue,&hdl,TLM_FRM_HDL_SIZE,\
+            Q_NORMAL);
+    }
+
+    return;
+}
+
+// Get frame buffer from handle
+char* get_tlm_frm_buf(tlm_frm_hdl_t hdl) {
+    return tlm_frm_pool_buf[hdl];
+}
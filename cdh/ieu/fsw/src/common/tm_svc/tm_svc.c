@@ -0,0 +1,97 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Time Service
+//
+// Single onboard time source for flight software. Time is read from the
+// Xenomai timer (rt_timer_read), which is monotonic and cheap to read from
+// real-time context, plus an epoch offset cached once at startup from the
+// system real-time clock. Every task therefore sees the same, monotonic view
+// of time in Unix seconds.
+//
+// get_tm_tck converts onboard time back to the Xenomai timer, so tasks can
+// wait until an onboard time with absolute timeouts.
+//
+// get_tm_cuc returns time split as the CCSDS unsegmented time code (CUC)
+// declared by the packet P-field: seconds and a 16 bit binary fraction of a
+// second (1/65536 sec). Telemetry T-fields are encoded from it directly.
+//
+// -------------------------------------------------------------------------- /
+//
+// Dependencies:
+// - Xenomai 3 / Cobalt
+//
+// Input Arguments:
+// - N/A
+//
+// Output Arguments:
+// - N/A
+//
+// -------------------------------------------------------------------------- /
+//
+// agent
+// Project HEPCATS
+// Subsystem: C&DH
+// Created: October 17, 2026
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Standard libraries:
+#include <stdint.h> // Standard integer types
+#include <time.h>   // Standard time types
+
+// Xenomai libraries:
+#include <alchemy/timer.h> // Timer management services
+
+// Header files:
+#include <ccsds_pkt.h> // CCSDS packet codec
+#include <tm_svc.h>    // Time service declarations
+
+// Macro definitions:
+#define NSEC_PER_SEC 1000000000 // Nanoseconds per second
+
+// Variable definitions:
+static int64_t tm_svc_epoch_ns; // Epoch offset in ns (real-time clock minus
+                                // Xenomai timer)
+
+// Cache epoch offset (called once at startup before tasks are started)
+void init_tm_svc(void) {
+    // Definitions and initializations:
+    struct timespec ts; // Real-time clock
+
+    // Read real-time clock and Xenomai timer back to back:
+    clock_gettime(CLOCK_REALTIME,&ts);
+    tm_svc_epoch_ns = (int64_t) ts.tv_sec*NSEC_PER_SEC + ts.tv_nsec - \
+        rt_timer_ticks2ns(rt_timer_read());
+
+    return;
+}
+
+// Get time in ns since Unix epoch
+uint64_t get_tm_ns(void) {
+    return rt_timer_ticks2ns(rt_timer_read()) + tm_svc_epoch_ns;
+}
+
+// Get time in seconds since Unix epoch
+uint32_t get_tm_sec(void) {
+    return get_tm_ns()/NSEC_PER_SEC;
+}
+
+// Get Xenomai timer time in ticks of time in ns since Unix epoch
+uint64_t get_tm_tck(uint64_t ns) {
+    // Definitions and initializations:
+    int64_t tmr_ns = (int64_t) ns - tm_svc_epoch_ns; // Xenomai timer time
+
+    // Time before timer start is due at once (never 0: TM_INFINITE):
+    return (tmr_ns > 0) ? rt_timer_ns2ticks(tmr_ns) : 1;
+}
+
+// Get time as CUC seconds and fraction
+void get_tm_cuc(uint32_t* sec, uint16_t* frc) {
+    // Definitions and initializations:
+    uint64_t ns = get_tm_ns(); // Time in ns
+
+    *sec = ns/NSEC_PER_SEC;
+    *frc = ccsds_nsec_to_frc(ns % NSEC_PER_SEC);
+
+    return;
+}
@@ -30,7 +30,8 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 // Standard libraries:
-#include <time.h> // Time and date
+#include <time.h>   // Time and date
+#include <stdint.h> // Standard integer types
 
 // Xenomai libraries:
 #include <alchemy/queue.h> // Message queue services
@@ -38,9 +39,14 @@
 #include <alchemy/pipe.h>  // Message pipe services
 
 // Header files:
-#include <msg_queues.h> // Message queue variable declarations
-#include <msg_pipes.h>  // Message pipe variable declarations
-#include <sems.h>       // Semaphore variable declarations
+#include <msg_queues.h>   // Message queue variable declarations
+#include <msg_pipes.h>    // Message pipe variable declarations
+#include <sems.h>         // Semaphore variable declarations
+#include <tlm_frm_pool.h> // Telemetry frame pool declarations
+#include <agg_tlm_pkt.h>  // Aggregated telemetry packet sub-header
+#include <agg_tlm.h>      // Aggregate telemetry declarations
+#include <flw_ctl.h>      // Flow control declarations
+#include <tm_svc.h>       // Time service declarations
 
 // Message queue definitions:
 RT_QUEUE telecmd_pkt_msg_queue; // For command transfer frames
@@ -49,13 +55,17 @@ RT_QUEUE telecmd_pkt_msg_queue; // For command transfer frames
 RT_QUEUE cmd_xfr_frm_msg_queue; // For command transfer frames
                                 // (proc_telecmd_pkt_task/cmd_sched_task
                                 //  --> exec_cmd_task)
-RT_QUEUE flt_tbl_msg_queue;     // For telemetry packet transfer frames
-                                // (read_mdq/img/get_hk_tlm --> flt_tbl_task)
-RT_QUEUE tx_tlm_pkt_msg_queue;  // For telemetry packets
+RT_QUEUE agg_tlm_msg_queue;     // For telemetry samples
+                                // (read_mdq/get_hk_tlm --> agg_tlm_task)
+RT_QUEUE flt_tbl_msg_queue;     // For telemetry frame handles
+                                // (agg_tlm/read_img --> flt_tbl_task)
+RT_QUEUE tx_tlm_pkt_msg_queue;  // For telemetry frame handles
                                 // (flt_tbl_task/rtrv_file_task
                                 // --> tx_tlm_pkt_task)
-RT_QUEUE crt_file_msg_queue;    // For telemetry packet transfer frames
+RT_QUEUE crt_file_msg_queue;    // For telemetry frame handles
                                 // (flt_tbl_task --> crt_file_task)
+RT_QUEUE tlm_frm_free_msg_queue; // For free telemetry frame handles
+                                 // (frame pool free list)
 
 // Message pipe definitions:
 RT_PIPE ips_msg_pipe; // For raw and processed images
@@ -72,12 +82,14 @@ RT_SEM cmd_sw_sem;           // For exec_cmd and cmd_sw task synchronization
 RT_SEM cmd_img_sem;          // For exec_cmd and cmd_img task synchronization 
 RT_SEM cmd_mdq_sem;          // For exec_cmd and cmd_mdq task synchronization
 RT_SEM cmd_ers_sem;          // For exec_cmd and cmd_mdq task synchronization
-RT_SEM flt_tbl_sem;          // For flt_tbl_task and crt_tlm_pkt_task
-                             // synchronization
+RT_SEM flt_tbl_sem;          // For flt_tbl_task, agg_tlm_task, read_mdq/img,
+                             // and get_hk_tlm task synchronization
 RT_SEM tx_tlm_pkt_sem;       // For tx_tlm_pkt_task, flt_tbl_task, and 
                              // rtrv_file_task synchronization
 RT_SEM crt_file_sem;         // For crt_file_task and flt_tbl_task
                              // synchronization
+RT_SEM wrt_file_sem;         // For crt_file_task and wrt_file_task
+                             // synchronization (frames in ring)
 RT_SEM rtrv_file_sem;        // For rtrv_file_task and cmd_sw_task
                              // synchronization
 RT_SEM new_img_sem;          // For run_cam_sgl and read_usb_img task
@@ -85,23 +97,27 @@ RT_SEM new_img_sem;          // For run_cam_sgl and read_usb_img task
 RT_SEM mdq_init_sem;         // For init_mdq and read_mdq task synchronization    
 RT_SEM read_mdq_sem;         // For cmd_mdq and read_mdq task synchronization
                              // to indicate when DAQ is readable (scanning)
+RT_SEM run_seq_sem;          // For cmd_sw and run_seq task synchronization
+                             // (sequence started or stop requested)
 
 // Macro definitions:
 #define TELECMD_PKT_QUEUE_NMSG 10 // Message queue limit
 #define CMD_XFR_QUEUE_NMSG     10 // Message queue limit
-#define FLT_TBL_QUEUE_NMSG     10 // Message queue limit
-#define TX_TLM_PKT_QUEUE_NMSG  10 // Message queue limit
-#define CRT_FILE_QUEUE_NMSG    10 // Message queue limit
+#define FLT_TBL_QUEUE_NMSG     \
+    TLM_FRM_POOL_NFRM             // Message queue limit (every frame in pool)
+#define TX_TLM_PKT_QUEUE_NMSG  \
+    TLM_FRM_POOL_NFRM             // Message queue limit (every frame in pool)
+#define CRT_FILE_QUEUE_NMSG    \
+    TLM_FRM_POOL_NFRM             // Message queue limit (every frame in pool)
 #define TELECMD_PKT_SIZE       20 // Telecommand packet size in bytes
 #define CMD_XFR_FRM_SIZE       15 // Command transfer frame size in bytes
-#define TLM_PKT_XFR_FRM_SIZE 1089 // Telemetry transfer frame size in bytes
 #define IMG_SRC_DAT_SIZE  2304000 // Raw image size in bytes
 
 // Create message queues and message pipes
 void crt_msg_queues_pipes() {
     // Print:
     rt_printf("%d (STARTUP/CRT_MSG_QUEUES_PIPES)"
-        " Creating message queues and pipes\n",time(NULL));
+        " Creating message queues and pipes\n",get_tm_sec());
  
     // Create message queues:
     rt_queue_create(&telecmd_pkt_msg_queue,"telecmd_pkt_msg_queue",\
@@ -112,31 +128,42 @@ void crt_msg_queues_pipes() {
         CMD_XFR_FRM_SIZE*CMD_XFR_QUEUE_NMSG,CMD_XFR_QUEUE_NMSG,Q_FIFO);
 
     // Create message queues:
+    rt_queue_create(&agg_tlm_msg_queue,"agg_tlm_msg_queue",\
+        AGG_TLM_QUEUE_POOL_SIZE,AGG_TLM_QUEUE_NMSG,Q_FIFO);
+
+    // Create message queues:
+    // (telemetry queues carry frame handles, not frames; the filter table
+    // queue also carries blocks of handles from the segmenter)
     rt_queue_create(&flt_tbl_msg_queue,"flt_tbl_msg_queue",\
-        TLM_PKT_XFR_FRM_SIZE*FLT_TBL_QUEUE_NMSG,FLT_TBL_QUEUE_NMSG,Q_FIFO);
+        TLM_FRM_QUEUE_POOL_SIZE,FLT_TBL_QUEUE_NMSG,Q_FIFO);
 
     // Create message queues:
     rt_queue_create(&tx_tlm_pkt_msg_queue,"tx_tlm_pkt_msg_queue",\
-        TLM_PKT_XFR_FRM_SIZE*TX_TLM_PKT_QUEUE_NMSG,\
+        TLM_FRM_QUEUE_POOL_SIZE,\
         TX_TLM_PKT_QUEUE_NMSG,Q_FIFO);
 
     // Create message queues:
     rt_queue_create(&crt_file_msg_queue,"crt_file_msg_queue",\
-        TLM_PKT_XFR_FRM_SIZE*CRT_FILE_QUEUE_NMSG,CRT_FILE_QUEUE_NMSG,Q_FIFO);
+        TLM_FRM_QUEUE_POOL_SIZE,CRT_FILE_QUEUE_NMSG,Q_FIFO);
+
+    // Create telemetry frame pool free list and populate it:
+    rt_queue_create(&tlm_frm_free_msg_queue,"tlm_frm_free_msg_queue",\
+        TLM_FRM_QUEUE_POOL_SIZE,TLM_FRM_POOL_NFRM,Q_FIFO);
+    init_tlm_frm_pool();
 
     // Create message pipe:
     rt_pipe_create(&ips_msg_pipe,"rtp0",0,IMG_SRC_DAT_SIZE); // Always minor=0
 
     // Print:
     rt_printf("%d (STARTUP/CRT_MSG_QUEUES_PIPES)"
-        " Message queues and pipes created\n",time(NULL));
+        " Message queues and pipes created\n",get_tm_sec());
 }
 
 // Create semaphores
 void crt_sems() {
     // Print:
     rt_printf("%d (STARTUP/CRT_SEMS)"
-        " Creating semaphores\n",time(NULL));
+        " Creating semaphores\n",get_tm_sec());
 
     // Create semaphores:
     rt_sem_create(&rx_telecmd_pkt_sem,"rx_telecmd_pkt_sem",0,S_FIFO);
@@ -150,12 +177,17 @@ void crt_sems() {
     rt_sem_create(&flt_tbl_sem,"flt_tbl_sem",0,S_FIFO);
     rt_sem_create(&tx_tlm_pkt_sem,"tx_tlm_pkt_sem",0,S_FIFO);
     rt_sem_create(&crt_file_sem,"crt_file_sem",0,S_FIFO);
+    rt_sem_create(&wrt_file_sem,"wrt_file_sem",0,S_FIFO);
     rt_sem_create(&rtrv_file_sem,"rtrv_file_sem",0,S_FIFO);
     rt_sem_create(&new_img_sem,"new_img_sem",0,S_FIFO);
     rt_sem_create(&mdq_init_sem,"mdq_init_sem",0,S_FIFO);
     rt_sem_create(&read_mdq_sem,"read_mdq_sem",0,S_FIFO);
+    rt_sem_create(&run_seq_sem,"run_seq_sem",0,S_FIFO);
+
+    // Create flow control credit semaphores:
+    crt_flw_ctl();
 
     // Print:
     rt_printf("%d (STARTUP/CRT_SEMS)"
-        " Semaphores created\n",time(NULL));
+        " Semaphores created\n",get_tm_sec());
 }
\ No newline at end of file
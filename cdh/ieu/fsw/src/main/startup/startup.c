@@ -31,20 +31,34 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 // Standard libraries:
-#include <time.h> // Time and date
+#include <stdint.h> // Standard integer types
+#include <time.h>   // Time and date
 
 // Xenomai libraries:
-#include <alchemy/task.h> // Task management services
+#include <alchemy/task.h>  // Task management services
+#include <alchemy/timer.h> // Timer management services (RTIME)
 
 // Header files:
 #include <dat_struct_startup.h> // Create Xenomai data structures function 
                                 // declarations 
 #include <task_startup.h>       // Create and start Xenomai task function 
                                 // declarations
+#include <tm_svc.h>             // Time service declarations
+#include <flt_tbl.h>            // Filter table (TO & DS) declarations
+#include <ld_flt_tbl.h>         // Load filter table declarations
+#include <tlm_frm_pool.h>       // Telemetry frame pool declarations
+#include <rec_tlm.h>            // Record telemetry declarations
+#include <pbk_rec_tlm.h>        // Play back recorded telemetry declarations
+#include <atc_sched.h>          // Absolutely timed command schedule
+                                // declarations
+#include <seq_tbl.h>            // Sequence table declarations
 
 void startup(void) {
+    // Initialize time service (before any task reads time):
+    init_tm_svc();
+
     // Print:
-    rt_printf("%d (STARTUP) Flight software initialization started\n",time(NULL));
+    rt_printf("%d (STARTUP) Flight software initialization started\n",get_tm_sec());
 
     // Create message queues and pipes:
     crt_msg_queues_pipes();
@@ -52,6 +66,23 @@ void startup(void) {
     // Create semaphores:
     crt_sems();
 
+    // Load persisted (or default) filter table definition:
+    init_flt_tbl_def();
+
+    // Create recorded telemetry directories and recover segments (torn
+    // records of a restart dropped, indexes rebuilt):
+    init_rec_tlm();
+
+    // Load persisted playback state (staged selection, cursors, and
+    // downlinked ranges):
+    init_pbk_rec_tlm();
+
+    // Load persisted absolutely timed command schedule:
+    init_atc_sched();
+
+    // Load persisted stored command sequences:
+    init_seq_tbl();
+
     // Create tasks:
     crt_tasks();
 
@@ -59,7 +90,7 @@ void startup(void) {
     str_tasks();
 
     // Print:
-    rt_printf("%d (STARTUP) Flight software initialization complete\n",time(NULL));
+    rt_printf("%d (STARTUP) Flight software initialization complete\n",get_tm_sec());
 
     return;
 }
\ No newline at end of file
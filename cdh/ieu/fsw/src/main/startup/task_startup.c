@@ -30,13 +30,15 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 // Standard libraries:
-#include <time.h> // Standard time types
+#include <stdint.h> // Standard integer types
+#include <time.h>   // Standard time types
 
 // Xenomai libraries:
 #include <alchemy/task.h> // Task management services
 
 // Header files:
-#include <tasks.h> // Task variable and function declarations
+#include <tasks.h>  // Task variable and function declarations
+#include <tm_svc.h> // Time service declarations
 
 // Macro definitions:
 #define GET_HK_TLM_FREQ 1e9 // Housekeeping telemetry frequency in seconds
@@ -54,17 +56,21 @@ RT_TASK cmd_ers_task;          // Execute electrical relay switch command
 RT_TASK crt_tlm_pkt_task;      // Create telemetry packet
 RT_TASK read_mdq_task;         // Read magnetometer DAQ
 RT_TASK read_img_task;         // Read imaging
+RT_TASK agg_tlm_task;          // Aggregate telemetry
 RT_TASK flt_tbl_task;          // (Telemetry) Filter table
 RT_TASK tx_tlm_pkt_task;       // Transmit telemetry packet to downlink
                                // serial port
 RT_TASK crt_file_task;         // Create file
+RT_TASK wrt_file_task;         // Write recorded frames to storage
+                               // (non-real-time)
 RT_TASK rtrv_file_task;        // Retrieve file for downlink
 RT_TASK get_hk_tlm_task;       // Get housekeeping telemetry
+RT_TASK run_seq_task;          // Run stored command sequence
 
 // Create tasks
 void crt_tasks(void) {
     // Print:
-    rt_printf("%d (STARTUP/CRT_TASKS) Creating all tasks\n",time(NULL));
+    rt_printf("%d (STARTUP/CRT_TASKS) Creating all tasks\n",get_tm_sec());
 
     // Create tasks:
     rt_task_create(&rx_telecmd_pkt_task,"rx_telecmd_pkt_task",0,80,T_JOINABLE);
@@ -78,16 +84,19 @@ void crt_tasks(void) {
     rt_task_create(&read_mdq_task,"read_mdq_task",0,40,0);
     rt_task_create(&read_img_task,"read_img_task",0,40,0);
     rt_task_create(&get_hk_tlm_task,"get_hk_tlm_task",0,95,0);
+    rt_task_create(&agg_tlm_task,"agg_tlm_task",0,85,0);
     rt_task_create(&flt_tbl_task,"flt_tbl_task",0,85,0);
     rt_task_create(&tx_tlm_pkt_task,"tx_tlm_pkt_task",0,90,0);
     rt_task_create(&crt_file_task,"crt_file_task",0,70,0);
+    rt_task_create(&wrt_file_task,"wrt_file_task",0,0,0); // Non-real-time
     rt_task_create(&rtrv_file_task,"rtrv_file_task",0,90,0);
+    rt_task_create(&run_seq_task,"run_seq_task",0,85,0);
 
     // Set periodic mode on select tasks:
     rt_task_set_periodic(&get_hk_tlm_task,TM_NOW,GET_HK_TLM_FREQ); // Set NOW
 
     // Print:
-    rt_printf("%d (STARTUP/CRT_TASKS) All tasks created\n",time(NULL));
+    rt_printf("%d (STARTUP/CRT_TASKS) All tasks created\n",get_tm_sec());
 
     // Exit:
     return;
@@ -96,7 +105,7 @@ void crt_tasks(void) {
 // Start tasks
 void str_tasks(void){
     // Print:
-    rt_printf("%d (STARTUP/STR_TASKS) Starting all tasks\n",time(NULL));
+    rt_printf("%d (STARTUP/STR_TASKS) Starting all tasks\n",get_tm_sec());
 
     // Start tasks:
     rt_task_start(&rx_telecmd_pkt_task,&rx_telecmd_pkt,0);
@@ -109,14 +118,17 @@ void str_tasks(void){
     rt_task_start(&cmd_ers_task,&cmd_ers,0);
     rt_task_start(&read_mdq_task,&read_mdq,0);
     rt_task_start(&read_img_task,&read_img,0);
+    rt_task_start(&agg_tlm_task,&agg_tlm,0);
     rt_task_start(&flt_tbl_task,&flt_tbl,0);
     rt_task_start(&tx_tlm_pkt_task,&tx_tlm_pkt,0);
     rt_task_start(&crt_file_task,&crt_file,0);
+    rt_task_start(&wrt_file_task,&wrt_file,0);
     rt_task_start(&rtrv_file_task,&rtrv_file,0);
     rt_task_start(&get_hk_tlm_task,&get_hk_tlm,0);
+    rt_task_start(&run_seq_task,&run_seq,0);
 
     // Print:
-    rt_printf("%d (STARTUP/STR_TASKS) All tasks started\n",time(NULL));
+    rt_printf("%d (STARTUP/STR_TASKS) All tasks started\n",get_tm_sec());
 
     // Exit:
     return;
@@ -0,0 +1,379 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Aggregate Telemetry
+//
+// Task responsible for packing small telemetry samples (housekeeping records
+// and magnetometer DAQ reads) of the same APID into one telemetry packet
+// transfer frame. Samples are received via message queue from get_hk_tlm and
+// read_mdq tasks (send_agg_tlm) and packed frames are sent to the filter
+// table task via message queue.
+//
+// Each APID has its own aggregation buffer. Every sample is preceded by a
+// sub-header (agg_tlm_pkt.h) with its creation time relative to the packet
+// T-field (creation time of the first sample in the packet) and its size. A
+// sample that does not fit in the remaining space is split on a record
+// boundary (e.g. one magnetometer DAQ scan), or on a codec block boundary if
+// the sample is encoded (mdq_cdc.h), and continued in the next packet.
+//
+// A buffer is flushed (packed into a transfer frame and sent) when it cannot
+// hold another record or when the flush deadline of its first sample expires
+// (agg_tlm.h), whichever comes first. Samples of an APID not in the
+// aggregation table are sent in a packet of their own.
+//
+// -------------------------------------------------------------------------- /
+//
+// Dependencies:
+// - Xenomai 3 / Cobalt
+//
+// Input Arguments:
+// - N/A
+//
+// Output Arguments:
+// - N/A
+//
+// -------------------------------------------------------------------------- /
+//
+// agent
+// Project HEPCATS
+// Subsystem: C&DH
+// Created: October 17, 2026
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Standard libraries:
+#include <stdlib.h>  // Standard library
+#include <unistd.h>  // UNIX standard function definitions
+#include <errno.h>   // Error number definitions
+#include <string.h>  // String function definitions
+#include <stdint.h>  // Standard integer types
+#include <time.h>    // Standard time types
+
+// Xenomai libraries:
+#include <alchemy/queue.h> // Message queue services
+#include <alchemy/sem.h>   // Semaphore services
+#include <alchemy/timer.h> // Timer management services
+
+// Header files:
+#include <ccsds_pkt.h>           // CCSDS packet codec
+#include <msg_queues.h>          // Message queue variable declarations
+#include <sems.h>                // Semaphore variable declarations
+#include <tlm_frm_pool.h>        // Telemetry frame pool declarations
+#include <crt_tlm_pkt_xfr_frm.h> // Create telemetry packet transfer frame
+                                 // function declarations
+#include <agg_tlm_pkt.h>         // Aggregated telemetry packet sub-header
+#include <mdq_cdc.h>             // Magnetometer DAQ codec
+#include <agg_tlm.h>             // Aggregate telemetry declarations
+#include <flw_ctl.h>             // Flow control declarations
+#include <tm_svc.h>              // Time service declarations
+
+// Macro definitions:
+#define APID_SW  0x00 // Software origin
+#define APID_MDQ 0xC8 // Magnetometer DAQ origin
+
+#define AGG_TLM_NAPID 2 // Number of aggregated APIDs
+
+// Message queue definitions:
+RT_QUEUE agg_tlm_msg_queue; // For telemetry samples
+                            // (read_mdq/get_hk_tlm --> agg_tlm_task)
+RT_QUEUE flt_tbl_msg_queue; // For telemetry frame handles
+                            // (agg_tlm/read_img --> flt_tbl_task)
+
+// Semaphore definitions:
+RT_SEM flt_tbl_sem; // For flt_tbl_task, agg_tlm, read_mdq/img, and
+                    // get_hk_tlm task synchronization
+
+// Aggregation buffer structure:
+struct agg_tlm_buf {
+    uint16_t apid;     // APID
+    uint16_t rec_size; // Record size in bytes (samples split on records)
+    RTIME    dl;       // Flush deadline relative to first sample (ns)
+
+    uint16_t fill;     // Bytes used in user data
+    uint32_t sec;      // Creation time seconds of first sample
+    uint16_t frc;      // Creation time fraction of first sample
+    RTIME    dl_abs;   // Absolute flush deadline (0 if empty)
+
+    char usr_dat[AGG_TLM_USR_DAT_SIZE]; // Packet user data
+};
+
+// Aggregation table:
+static struct agg_tlm_buf agg_tlm_buf[AGG_TLM_NAPID] = {
+    {APID_SW,AGG_TLM_HK_REC_SIZE,AGG_TLM_HK_DL},
+    {APID_MDQ,AGG_TLM_MDQ_REC_SIZE,AGG_TLM_MDQ_DL},
+};
+
+// Pack aggregation buffer into transfer frame and send to filter table task
+static void flush_agg_tlm_buf(struct agg_tlm_buf* buf) {
+    // Definitions and initializations:
+    int32_t ret_val; // Function return value
+
+    tlm_frm_hdl_t tlm_frm_hdl; // Telemetry frame handle (frame pool)
+
+    // Check for empty buffer:
+    if (buf->fill == 0) {
+        return;
+    }
+
+    // Reserve filter table message queue credit before building frame:
+    // (drop buffered samples if no credit frees up)
+    ret_val = rsv_flw_ctl(&flw_ctl_tbl[FLW_CTL_FLT_TBL],buf->apid);
+
+    // Check success:
+    if (ret_val < 0) {
+        // Print:
+        rt_printf("%d (AGG_TLM_TASK) Filter table message queue full;"
+            " telemetry samples dropped\n",get_tm_sec());
+
+        // Count dropped frame:
+        drop_flw_ctl(&flw_ctl_tbl[FLW_CTL_FLT_TBL],1);
+
+        // Empty buffer:
+        buf->fill = 0;
+        buf->dl_abs = 0;
+
+        return;
+    }
+
+    // Allocate frame from frame pool:
+    // (drop buffered samples if pool stays exhausted)
+    ret_val = alloc_tlm_frm(&tlm_frm_hdl,TLM_FRM_ALLOC_TIMEOUT);
+
+    // Check success:
+    if (ret_val < 0) {
+        // Print:
+        rt_printf("%d (AGG_TLM_TASK) Error allocating telemetry frame; frame"
+            " pool exhausted\n",get_tm_sec());
+
+        // Cancel reserved credit:
+        cncl_flw_ctl(&flw_ctl_tbl[FLW_CTL_FLT_TBL]);
+    } else {
+        // Build transfer frame (directly in frame pool) stamped with creation
+        // time of first sample:
+        bld_tlm_pkt_xfr_frm(buf->usr_dat,buf->fill,\
+            get_tlm_frm_buf(tlm_frm_hdl),buf->apid,3,buf->sec,buf->frc);
+
+        // Send frame handle to filter table task via flow controlled
+        // message queue:
+        ret_val = send_flw_ctl(&flw_ctl_tbl[FLW_CTL_FLT_TBL],&tlm_frm_hdl,\
+            TLM_FRM_HDL_SIZE);
+
+        // Check success:
+        if (ret_val < 0) {
+            // Print:
+            rt_printf("%d (AGG_TLM_TASK) Error sending telemetry packet"
+                " transfer frame\n",get_tm_sec());
+
+            // Return frame to pool:
+            rls_tlm_frm(tlm_frm_hdl);
+        }
+    }
+
+    // Empty buffer:
+    buf->fill = 0;
+    buf->dl_abs = 0;
+
+    return;
+}
+
+// Get bytes of encoded sample to copy (as many whole codec blocks as fit;
+// returns -1 if the sample is malformed)
+static int32_t get_agg_tlm_enc_size(char* smpl, uint16_t smpl_size,
+    uint16_t room) {
+    // Definitions and initializations:
+    uint16_t copy_size = 0; // Sample bytes to copy
+    size_t   blk_size;      // Codec block size
+
+    // Loop over codec blocks:
+    while (copy_size < smpl_size) {
+        blk_size = get_mdq_cdc_blk_size(smpl+copy_size,smpl_size-copy_size);
+        if (blk_size == 0) {
+            return -1;
+        } else if (copy_size+blk_size > room) {
+            break;
+        }
+        copy_size += blk_size;
+    }
+
+    return copy_size;
+}
+
+// Append sample to aggregation buffer (flushing as buffer fills)
+static void app_agg_tlm_buf(struct agg_tlm_buf* buf, char* smpl,
+    uint16_t smpl_size, uint32_t sec, uint16_t frc, uint8_t enc_flg) {
+    // Definitions and initializations:
+    int32_t  t_ofst;    // Sample time offset from first sample (ms)
+    int32_t  copy_size; // Sample bytes copied to buffer
+
+    // Loop until whole sample is in buffer:
+    while (smpl_size > 0) {
+        // Determine bytes to copy (as many whole records or codec blocks as
+        // fit):
+        copy_size = AGG_TLM_USR_DAT_SIZE - buf->fill - AGG_SUB_HDR_SIZE;
+        if (enc_flg) {
+            copy_size = get_agg_tlm_enc_size(smpl,smpl_size,copy_size);
+        } else {
+            copy_size = copy_size - (copy_size % buf->rec_size);
+        }
+        if (copy_size > smpl_size) {
+            copy_size = smpl_size;
+        }
+
+        // Check for malformed encoded sample (drop rest of sample):
+        if (copy_size < 0) {
+            // Print:
+            rt_printf("%d (AGG_TLM_TASK) Malformed encoded telemetry sample;"
+                " sample dropped\n",get_tm_sec());
+
+            break;
+        }
+
+        // Check for no room (flush and retry in next packet):
+        if (copy_size == 0) {
+            flush_agg_tlm_buf(buf);
+
+            continue;
+        }
+
+        // Start new packet with sample time if buffer is empty:
+        if (buf->fill == 0) {
+            buf->sec = sec;
+            buf->frc = frc;
+            buf->dl_abs = rt_timer_read() + buf->dl;
+        }
+
+        // Get sample time offset from first sample in packet:
+        t_ofst = ((((int64_t) (int32_t) (sec - buf->sec)) << \
+            CCSDS_CUC_FRC_SHFT) + frc - buf->frc)*1000 >> CCSDS_CUC_FRC_SHFT;
+        if (t_ofst < 0) {
+            t_ofst = 0;
+        } else if (t_ofst > 65535) {
+            t_ofst = 65535;
+        }
+
+        // Append sub-header and sample:
+        enc_agg_sub_hdr(buf->usr_dat+buf->fill,t_ofst,copy_size,enc_flg);
+        memcpy(buf->usr_dat+buf->fill+AGG_SUB_HDR_SIZE,smpl,copy_size);
+        buf->fill += AGG_SUB_HDR_SIZE + copy_size;
+
+        // Advance sample:
+        smpl += copy_size;
+        smpl_size -= copy_size;
+
+        // Flush if another record will not fit:
+        if (AGG_TLM_USR_DAT_SIZE - buf->fill < \
+            AGG_SUB_HDR_SIZE + buf->rec_size) {
+            flush_agg_tlm_buf(buf);
+        }
+    }
+
+    return;
+}
+
+void agg_tlm(void* arg) {
+    // Print:
+    rt_printf("%d (AGG_TLM_TASK) Task started\n",get_tm_sec());
+
+    // Task synchronize with filter table task:
+    // (wait for task to be ready to telemetry packet transfer frames)
+    rt_printf("%d (AGG_TLM_TASK) Waiting for filter table task"
+        " to be ready\n",get_tm_sec());
+
+    // Wait for signal:
+    rt_sem_p(&flt_tbl_sem,TM_INFINITE);
+
+    // Print:
+    rt_printf("%d (AGG_TLM_TASK) Filter table task is ready;"
+        " continuing\n",get_tm_sec());
+
+    // Definitions and initializations:
+    uint8_t i;
+    int32_t ret_val; // Function return value
+
+    uint16_t apid;      // Sample APID
+    uint32_t sec;       // Sample creation time seconds
+    uint16_t frc;       // Sample creation time fraction
+    uint16_t smpl_size; // Sample size in bytes
+    uint8_t  enc_flg;   // Sample encoded flag
+
+    RTIME tm_now;      // Current time
+    RTIME dl_abs_next; // Next absolute flush deadline (TM_INFINITE if none)
+
+    struct agg_tlm_buf smpl_buf; // Buffer for unaggregated APID
+
+    char agg_tlm_msg_buf[AGG_TLM_MSG_MAX]; // Sample message buffer
+
+    // Print:
+    rt_printf("%d (AGG_TLM_TASK) Ready to aggregate telemetry samples\n",\
+        get_tm_sec());
+
+    // Infinite loop to receive samples via message queue and pack them into
+    // telemetry packet transfer frames:
+    while (1) {
+        // Get next flush deadline:
+        dl_abs_next = TM_INFINITE;
+        for (i = 0; i < AGG_TLM_NAPID; ++i) {
+            if ((agg_tlm_buf[i].dl_abs != 0) && \
+                ((dl_abs_next == TM_INFINITE) || \
+                (agg_tlm_buf[i].dl_abs < dl_abs_next))) {
+                dl_abs_next = agg_tlm_buf[i].dl_abs;
+            }
+        }
+
+        // Read sample from message queue (wait until next flush deadline):
+        ret_val = rt_queue_read_until(&agg_tlm_msg_queue,agg_tlm_msg_buf,\
+            AGG_TLM_MSG_MAX,dl_abs_next);
+
+        // Return credit of message read:
+        if (ret_val >= 0) {
+            rtn_flw_ctl(&flw_ctl_tbl[FLW_CTL_AGG_TLM]);
+        }
+
+        // Check success:
+        if (ret_val >= AGG_TLM_MSG_HDR_SIZE) {
+            // Parse sample message:
+            memcpy(&apid,agg_tlm_msg_buf+0,2);
+            memcpy(&sec,agg_tlm_msg_buf+2,4);
+            memcpy(&frc,agg_tlm_msg_buf+6,2);
+            memcpy(&enc_flg,agg_tlm_msg_buf+8,1);
+            smpl_size = ret_val - AGG_TLM_MSG_HDR_SIZE;
+
+            // Find aggregation buffer for APID:
+            for (i = 0; i < AGG_TLM_NAPID; ++i) {
+                if (agg_tlm_buf[i].apid == apid) {
+                    break;
+                }
+            }
+
+            // Check for aggregated APID:
+            if (i < AGG_TLM_NAPID) {
+                // Append sample to aggregation buffer:
+                app_agg_tlm_buf(&agg_tlm_buf[i],\
+                    agg_tlm_msg_buf+AGG_TLM_MSG_HDR_SIZE,smpl_size,sec,frc,\
+                    enc_flg);
+            } else if (smpl_size > 0) {
+                // Send sample in packet of its own:
+                smpl_buf.apid = apid;
+                smpl_buf.rec_size = smpl_size;
+                smpl_buf.dl = 0;
+                smpl_buf.fill = 0;
+                app_agg_tlm_buf(&smpl_buf,\
+                    agg_tlm_msg_buf+AGG_TLM_MSG_HDR_SIZE,smpl_size,sec,frc,\
+                    enc_flg);
+                flush_agg_tlm_buf(&smpl_buf);
+            }
+        } else if ((ret_val != -ETIMEDOUT) && (ret_val != -EWOULDBLOCK)) {
+            // Print:
+            rt_printf("%d (AGG_TLM_TASK) Error receiving telemetry sample\n",\
+                get_tm_sec());
+        }
+
+        // Flush buffers whose deadline expired:
+        tm_now = rt_timer_read();
+        for (i = 0; i < AGG_TLM_NAPID; ++i) {
+            if ((agg_tlm_buf[i].dl_abs != 0) && \
+                (agg_tlm_buf[i].dl_abs <= tm_now)) {
+                flush_agg_tlm_buf(&agg_tlm_buf[i]);
+            }
+        }
+    }
+}
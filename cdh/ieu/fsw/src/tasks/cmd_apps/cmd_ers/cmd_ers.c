@@ -59,6 +59,7 @@
 // Header files:
 #include <sems.h>       // Semaphore variable declarations
 #include <hk_tlm_var.h> // Housekeeping telemetry variable declarations
+#include <tm_svc.h>     // Time service declarations
 
 // Macro definitions:
 #define CMD_XFR_FRM_SIZE 15 // Command transfer frame size in bytes
@@ -77,7 +78,7 @@ uint8_t ers_rly_swtch_state = 0; // Electrical relay switch state
 
 void cmd_ers(void* arg) {
     // Print:
-    rt_printf("%d (CMD_ERS_TASK) Task started\n",time(NULL));
+    rt_printf("%d (CMD_ERS_TASK) Task started\n",get_tm_sec());
 
     // Declarations and initialization:
     int8_t   ret_val; // Function return value
@@ -118,12 +119,12 @@ void cmd_ers(void* arg) {
 
     // Print:
     rt_printf("%d (CMD_ERS_TASK) Relay 1 & 2 set to OFF position by default"
-        "; magnetometer system now OFF\n",time(NULL));
+        "; magnetometer system now OFF\n",get_tm_sec());
 
     // Task synchronize with exec_cmd task
     // (tell task that it is now ready to receive frames)
     rt_printf("%d (CMD_ERS_TASK) Ready to receive command transfer"
-        " frames\n",time(NULL));
+        " frames\n",get_tm_sec());
 
     // Signal task to continue executing:
     rt_sem_v(&cmd_ers_sem);
@@ -141,11 +142,11 @@ void cmd_ers(void* arg) {
         if (flw_id > 0) {
             // Print
             rt_printf("%d (CMD_ERS_TASK) Received command transfer"
-                " frame\n",time(NULL));
+                " frame\n",get_tm_sec());
         } else {
             // Print
             rt_printf("%d (CMD_ERS_TASK) Error receiving command transfer"
-                " frame\n",time(NULL));
+                " frame\n",get_tm_sec());
             // NEED ERROR HANDLING
         }
 
@@ -159,7 +160,7 @@ void cmd_ers(void* arg) {
 
         // Print:
         rt_printf("%d (CMD_ERS_TASK) Checking command packet"
-            " name...\n",time(NULL));
+            " name...\n",get_tm_sec());
 
         // Switch to match command packet name to know command packet
         // names; execute command if match:
@@ -167,7 +168,7 @@ void cmd_ers(void* arg) {
             case CMD_MAGON:
                 // Print:
                 rt_printf("%d (CMD_ERS_TASK) Switching relay 1 & 2 to ON"
-                    " position\n",time(NULL));
+                    " position\n",get_tm_sec());
 
                 // Set command string:
                 sprintf(cmd_str,"sudo usbrelay BITFT_1=1 BITFT_2=1 >/dev/null 2>&1");
@@ -177,7 +178,7 @@ void cmd_ers(void* arg) {
 
                 // Print:
                 rt_printf("%d (CMD_ERS_TASK) Relay 1 & 2 set to ON position"
-                    "; magnetometer system now ON\n",time(NULL));
+                    "; magnetometer system now ON\n",get_tm_sec());
 
                 // Set relay switch state:
                 ers_rly_swtch_state = 1; // ON position
@@ -191,7 +192,7 @@ void cmd_ers(void* arg) {
             case CMD_MAGOFF:
                 // Print:
                 rt_printf("%d (CMD_ERS_TASK) Switching relay 1 & 2 to OFF"
-                    " position\n",time(NULL));
+                    " position\n",get_tm_sec());
 
                 // Set command string:
                 sprintf(cmd_str,"sudo usbrelay BITFT_1=0 BITFT_2=0"
@@ -202,7 +203,7 @@ void cmd_ers(void* arg) {
 
                 // Print:
                 rt_printf("%d (CMD_ERS_TASK) Relay 1 & 2 set to OFF position"
-                    "; magnetometer system now OFF\n",time(NULL));
+                    "; magnetometer system now OFF\n",get_tm_sec());
 
                 // Set relay switch state:
                 ers_rly_swtch_state = 0; // OFF position
@@ -216,7 +217,7 @@ void cmd_ers(void* arg) {
             case CMD_NOOP :
                 // Print:
                 rt_printf("%d (CMD_ERS_TASK) Executing NOOP command"
-                    "\n",time(NULL));
+                    "\n",get_tm_sec());
 
                 // Execute command and check for success:
                 // HERE HERE HERE HERE
@@ -226,7 +227,7 @@ void cmd_ers(void* arg) {
                 if (ret_val > 0) {
                     // Print:
                     rt_printf("%d (CMD_ERS_TASK) Command executed"
-                        " successfully\n",time(NULL));
+                        " successfully\n",get_tm_sec());
 
                     // Set reply message data field to indicate command
                     // executed:
@@ -234,7 +235,7 @@ void cmd_ers(void* arg) {
                 } else {
                     // Print:
                     rt_printf("%d (CMD_ERS_TASK) Command did not execute"
-                        "\n",time(NULL));
+                        "\n",get_tm_sec());
 
                     // Set reply message data field to indicate command
                     // executed:
@@ -248,7 +249,7 @@ void cmd_ers(void* arg) {
                 // Print:
                 rt_printf("%d (CMD_ERS_TASK) Command packet is invalid;" 
                     " command transfer frame ignored\n",\
-                    time(NULL));
+                    get_tm_sec());
 
                 // Set reply message data field to indicate command
                 // did not execute:
@@ -262,11 +263,11 @@ void cmd_ers(void* arg) {
         if (ret_val == 0) {
             // Print:
             rt_printf("%d (CMD_ERS_TASK) Reply message sent to execute command"
-                " task\n",time(NULL));
+                " task\n",get_tm_sec());
         } else {
             // Print:
             rt_printf("%d (CMD_ERS_TASK) Error sending reply message to execute"
-                " command task\n",time(NULL));
+                " command task\n",get_tm_sec());
         }
     }
     
@@ -45,10 +45,11 @@
 
 // Header files:
 #include <run_cam_sgl.h> // Acquire image from camera function declaration
+#include <tm_svc.h>      // Time service declarations
 
 int acq_img() {
     // Print:
-    rt_printf("%d (ACQ_IMG) Initializing camera\n",time(NULL));
+    rt_printf("%d (ACQ_IMG) Initializing camera\n",get_tm_sec());
 
     // Definitions and initializations:
     spinError spin_ret_val = SPINNAKER_ERR_SUCCESS;
@@ -75,7 +76,7 @@ int acq_img() {
     if (spin_ret_val != SPINNAKER_ERR_SUCCESS) {
         // Print:
         rt_printf("%d (ACQ_IMG) Unable to retrieve system instance;"
-            " aborting with error %d\n",time(NULL),spin_ret_val);
+            " aborting with error %d\n",get_tm_sec(),spin_ret_val);
 
         // Exit:
         return spin_ret_val;
@@ -88,7 +89,7 @@ int acq_img() {
     if (spin_ret_val != SPINNAKER_ERR_SUCCESS) {
         // Print:
         rt_printf("%d (ACQ_IMG) Unable to create camera list; aborting"
-            " with error %d\n",time(NULL),spin_ret_val);
+            " with error %d\n",get_tm_sec(),spin_ret_val);
 
         // Exit:
         return spin_ret_val;
@@ -101,7 +102,7 @@ int acq_img() {
     if (spin_ret_val != SPINNAKER_ERR_SUCCESS) {
         // Print:
         rt_printf("%d (ACQ_IMG) Unable to retrieve camera list; aborting"
-            " with error %d\n",time(NULL),spin_ret_val);
+            " with error %d\n",get_tm_sec(),spin_ret_val);
 
         // Exit:
         return spin_ret_val;
@@ -114,7 +115,7 @@ int acq_img() {
     if (spin_ret_val != SPINNAKER_ERR_SUCCESS) {
         // Print:
         rt_printf("%d (ACQ_IMG) Unable to retrieve number of cameras;"
-            " aborting with error %d\n",time(NULL),spin_ret_val);
+            " aborting with error %d\n",get_tm_sec(),spin_ret_val);
 
         // Exit:
         return spin_ret_val;
@@ -130,7 +131,7 @@ int acq_img() {
         if (spin_ret_val != SPINNAKER_ERR_SUCCESS) {
             // Print:
             rt_printf("%d (ACQ_IMG) Unable to clear camera list;"
-                " aborting with error %d\n",time(NULL),spin_ret_val);
+                " aborting with error %d\n",get_tm_sec(),spin_ret_val);
 
             // Exit:
             return spin_ret_val;
@@ -143,7 +144,7 @@ int acq_img() {
         if (spin_ret_val != SPINNAKER_ERR_SUCCESS) {
             // Print:
             rt_printf("%d (ACQ_IMG) Unable to destroy camera list; aborting"
-                " with error %d\n",time(NULL),spin_ret_val);
+                " with error %d\n",get_tm_sec(),spin_ret_val);
 
             // Exit:
             return spin_ret_val;
@@ -155,7 +156,7 @@ int acq_img() {
         // Check success:
         if (spin_ret_val != SPINNAKER_ERR_SUCCESS) {
             rt_printf("%d (ACQ_IMG) Unable to release system instance;"
-                " aborting with error %d\n",time(NULL),spin_ret_val);
+                " aborting with error %d\n",get_tm_sec(),spin_ret_val);
 
             // Exit:
             return spin_ret_val;
@@ -163,7 +164,7 @@ int acq_img() {
 
         // Print:
         rt_printf("%d (ACQ_IMG) Found %d cameras (expected 1); aborting"
-            " acquisition\n",time(NULL),numCameras);
+            " acquisition\n",get_tm_sec(),numCameras);
 
         // Exit:
         return -1;
@@ -182,7 +183,7 @@ int acq_img() {
     if (spin_ret_val != SPINNAKER_ERR_SUCCESS) {
         // Print:
         rt_printf("%d (ACQ_IMG) Unable to initialize camera; aborting"
-            " with error %d\n",time(NULL),spin_ret_val);
+            " with error %d\n",get_tm_sec(),spin_ret_val);
 
         // Exit:
         return spin_ret_val;
@@ -195,7 +196,7 @@ int acq_img() {
     if (spin_ret_val != SPINNAKER_ERR_SUCCESS) {
         // Print:
         rt_printf("%d (ACQ_IMG) Unable to retrieve GenICam nodemap;"
-            " aborting with error %d\n",time(NULL),spin_ret_val);
+            " aborting with error %d\n",get_tm_sec(),spin_ret_val);
         
         // Exit:
         return spin_ret_val;
@@ -209,7 +210,7 @@ int acq_img() {
     if (spin_ret_val != SPINNAKER_ERR_SUCCESS) {
         // Print:
         rt_printf("%d (ACQ_IMG) Unable to get aquisition mode"
-            " node map; aborting with error %d\n",time(NULL),\
+            " node map; aborting with error %d\n",get_tm_sec(),\
             spin_ret_val);
 
         // Exit:
@@ -224,7 +225,7 @@ int acq_img() {
     if (spin_ret_val != SPINNAKER_ERR_SUCCESS) {
         // Print:
         rt_printf("%d (ACQ_IMG) Unable to set aquisition mode"
-            " to single frame; aborting with error %d\n",time(NULL),\
+            " to single frame; aborting with error %d\n",get_tm_sec(),\
             spin_ret_val);
 
         // Exit:
@@ -239,7 +240,7 @@ int acq_img() {
     if (spin_ret_val != SPINNAKER_ERR_SUCCESS) {
         // Print:
         rt_printf("%d (ACQ_IMG) Unable to set acquisition mode"
-            " to single frame; aborting with error %d\n",time(NULL),\
+            " to single frame; aborting with error %d\n",get_tm_sec(),\
             spin_ret_val);
 
         // Exit:
@@ -254,7 +255,7 @@ int acq_img() {
     if (spin_ret_val != SPINNAKER_ERR_SUCCESS) {
         // Print:
         rt_printf("%d (ACQ_IMG) Unable to set acquisition mode"
-            " to single frame; aborting with error %d\n",time(NULL),\
+            " to single frame; aborting with error %d\n",get_tm_sec(),\
             spin_ret_val);
 
         // Exit:
@@ -268,7 +269,7 @@ int acq_img() {
     if (spin_ret_val != SPINNAKER_ERR_SUCCESS) {
         // Print:
         rt_printf("%d (ACQ_IMG) Unable to acquire image;"
-            " aborting with error %d\n",time(NULL),spin_ret_val);
+            " aborting with error %d\n",get_tm_sec(),spin_ret_val);
 
         // Exit:
         return spin_ret_val;
@@ -280,7 +281,7 @@ int acq_img() {
     // Check success:
     if (spin_ret_val != SPINNAKER_ERR_SUCCESS) {
         rt_printf("%d (ACQ_IMG) Unable to de-initialize camera;"
-            " non-fatal error %d\n",time(NULL),spin_ret_val);
+            " non-fatal error %d\n",get_tm_sec(),spin_ret_val);
 
         // Exit:
         return spin_ret_val;
@@ -293,7 +294,7 @@ int acq_img() {
     if (spin_ret_val != SPINNAKER_ERR_SUCCESS) {
         // Print:
         rt_printf("%d (ACQ_IMG) Unable to release camera; aborting with"
-            " error %d\n",time(NULL),spin_ret_val);
+            " error %d\n",get_tm_sec(),spin_ret_val);
 
         // Exit:
         return spin_ret_val;
@@ -306,7 +307,7 @@ int acq_img() {
     if (spin_ret_val != SPINNAKER_ERR_SUCCESS) {
         // Print:
         rt_printf("%d (ACQ_IMG) Unable to clear camera list;"
-            " aborting with error %d\n",time(NULL),spin_ret_val);
+            " aborting with error %d\n",get_tm_sec(),spin_ret_val);
 
         // Exit:
         return spin_ret_val;
@@ -319,7 +320,7 @@ int acq_img() {
     if (spin_ret_val != SPINNAKER_ERR_SUCCESS) {
         // Print:
         rt_printf("%d (ACQ_IMG) Unable to destroy camera list; aborting"
-            " with error %d\n",time(NULL),spin_ret_val);
+            " with error %d\n",get_tm_sec(),spin_ret_val);
 
         // Exit:
         return spin_ret_val;
@@ -332,7 +333,7 @@ int acq_img() {
     if (spin_ret_val != SPINNAKER_ERR_SUCCESS) {
         // Print:
         rt_printf("%d (ACQ_IMG) Unable to release system instance; aborting"
-            " with error %d\n",time(NULL),spin_ret_val);
+            " with error %d\n",get_tm_sec(),spin_ret_val);
 
         // Exit:
         return spin_ret_val;
@@ -43,6 +43,9 @@
 // Spinnaker libraries:
 #include <SpinnakerC.h> // FLIR machine vision camera interface definitions
 
+// Header files:
+#include <tm_svc.h> // Time service declarations
+
 // Semaphore definitions:
 RT_SEM new_img_sem; // For run_cam_sgl and read_usb_img task
                     // synchronization 
@@ -66,13 +69,13 @@ spinError run_cam_sgl(spinCamera hCamera, spinNodeMapHandle hNodeMap,\
     if (spin_ret_val != SPINNAKER_ERR_SUCCESS) {
         // Print:
         rt_printf("%d (RUN_CAM_SGL) Unable to start image acquisition"
-            " ; aborting with error %d\n",time(NULL),spin_ret_val);
+            " ; aborting with error %d\n",get_tm_sec(),spin_ret_val);
 
         // Exit:
         return spin_ret_val;
     } else {
         // Print:
-        rt_printf("%d (RUN_CAM_SGL) Starting image acquisition\n",time(NULL));
+        rt_printf("%d (RUN_CAM_SGL) Starting image acquisition\n",get_tm_sec());
     }
     
     // Get acquired image:
@@ -82,14 +85,14 @@ spinError run_cam_sgl(spinCamera hCamera, spinNodeMapHandle hNodeMap,\
     if (spin_ret_val != SPINNAKER_ERR_SUCCESS) {
         // Print:
         rt_printf("%d (RUN_CAM_SGL) Image acquisition failed; aborting with"
-            " error %d\n",time(NULL),spin_ret_val);
+            " error %d\n",get_tm_sec(),spin_ret_val);
 
         // Exit:
         return spin_ret_val;
     } else {
         // Print:
         rt_printf("%d (RUN_CAM_SGL) Image acquisition successful\n",\
-            time(NULL));
+            get_tm_sec());
     }
     
     // Convert the buffer to the right pixelspace:    
@@ -99,7 +102,7 @@ spinError run_cam_sgl(spinCamera hCamera, spinNodeMapHandle hNodeMap,\
     if (spin_ret_val != SPINNAKER_ERR_SUCCESS) {
         // Print:
         rt_printf("%d (RUN_CAM_SGL) Unable to create an empty image to hold"
-            " converted image; aborting with error %d\n",time(NULL),\
+            " converted image; aborting with error %d\n",get_tm_sec(),\
             spin_ret_val);
 
         // Exit:
@@ -114,7 +117,7 @@ spinError run_cam_sgl(spinCamera hCamera, spinNodeMapHandle hNodeMap,\
     if (spin_ret_val != SPINNAKER_ERR_SUCCESS) {
         // Print:
         rt_printf("%d (RUN_CAM_SGL) Unable to convert image with error %d\n",\
-            time(NULL),spin_ret_val);
+            get_tm_sec(),spin_ret_val);
     }
 
     // Create file name:
@@ -127,14 +130,14 @@ spinError run_cam_sgl(spinCamera hCamera, spinNodeMapHandle hNodeMap,\
     if(spin_ret_val != SPINNAKER_ERR_SUCCESS) {
         // Print:
         rt_printf("%d (RUN_CAM_SGL) Unable to save image to file; aborting"
-            " with error %d\n",time(NULL),spin_ret_val);
+            " with error %d\n",get_tm_sec(),spin_ret_val);
 
         // Exit:
         return spin_ret_val;
     } else {
         // Print:
         rt_printf("%d (RUN_CAM_SGL) Image saved to file; notifying"
-            " read_usb_img task\n",time(NULL));
+            " read_usb_img task\n",get_tm_sec());
 
         // Signal read_usb_img task that new image is ready to read:
         rt_sem_v(&new_img_sem);
@@ -147,7 +150,7 @@ spinError run_cam_sgl(spinCamera hCamera, spinNodeMapHandle hNodeMap,\
     if (spin_ret_val != SPINNAKER_ERR_SUCCESS) {
         // Print:
         //rt_printf("%d (RUN_CAM_SGL) Unable to destroy image with error %d\n",\
-            time(NULL),spin_ret_val);
+            get_tm_sec(),spin_ret_val);
     }
 
     // Destroy image:
@@ -157,7 +160,7 @@ spinError run_cam_sgl(spinCamera hCamera, spinNodeMapHandle hNodeMap,\
     if (spin_ret_val != SPINNAKER_ERR_SUCCESS) {
         // Print:
         //rt_printf("%d (RUN_CAM_SGL) Unable to destroy image with error %d\n",\
-            time(NULL),spin_ret_val);
+            get_tm_sec(),spin_ret_val);
     }
 
     // End acquisition:
@@ -167,7 +170,7 @@ spinError run_cam_sgl(spinCamera hCamera, spinNodeMapHandle hNodeMap,\
     if (spin_ret_val != SPINNAKER_ERR_SUCCESS) {
         // Print:
         rt_printf("%d (RUN_CAM_SGL) Unable to end image acquisition"
-            " with error %d\n",time(NULL),spin_ret_val);
+            " with error %d\n",get_tm_sec(),spin_ret_val);
     }
     
     // Return:
@@ -56,6 +56,7 @@
 #include <init_cam.h>   // Initialize camera function declaration
 #include <acq_img.h>    // Acquire image function declaration
 #include <hk_tlm_var.h> // Housekeeping telemetry variable declarations
+#include <tm_svc.h>     // Time service declarations
 
 // Macro definitions:
 #define CMD_XFR_FRM_SIZE 15 // Command transfer frame size in bytes
@@ -80,7 +81,7 @@ uint8_t  ips_mdl_ld_state;     // IPS model load state
 
 void cmd_img(void* arg) {
     // Print:
-    rt_printf("%d (CMD_IMG_TASK) Task started\n",time(NULL));
+    rt_printf("%d (CMD_IMG_TASK) Task started\n",get_tm_sec());
 
     // Declarations and initialization:
     int8_t   ret_val; // Function return value
@@ -121,12 +122,12 @@ void cmd_img(void* arg) {
     ret_val = init_cam();
 
     // Print:
-    rt_printf("%d (CMD_IMG_TASK) Camera initialization complete\n",time(NULL));
+    rt_printf("%d (CMD_IMG_TASK) Camera initialization complete\n",get_tm_sec());
 
     // Task synchronize with exec_cmd task
     // (tell task that it is now ready to receive frames)
     rt_printf("%d (CMD_IMG_TASK) Ready to receive command transfer"
-        " frames\n",time(NULL));
+        " frames\n",get_tm_sec());
 
     // Signal task to continue executing:
     rt_sem_v(&cmd_img_sem);
@@ -147,11 +148,11 @@ void cmd_img(void* arg) {
         if (flw_id > 0) {
             // Print
             rt_printf("%d (CMD_IMG_TASK) Received command transfer"
-                " frame\n",time(NULL));
+                " frame\n",get_tm_sec());
         } else {
             // Print
             rt_printf("%d (CMD_IMG_TASK) Error receiving command transfer"
-                " frame\n",time(NULL));
+                " frame\n",get_tm_sec());
             // NEED ERROR HANDLING
         }
 
@@ -165,7 +166,7 @@ void cmd_img(void* arg) {
 
         // Print:
         rt_printf("%d (CMD_IMG_TASK) Checking command packet"
-            " name...\n",time(NULL));
+            " name...\n",get_tm_sec());
 
         // Switch to match command packet name to know command packet
         // names; execute command if match:
@@ -175,7 +176,7 @@ void cmd_img(void* arg) {
                 if ((img_acq_prog_flag == 0) && (ips_mdl_ld_state == 1)) {
                     // Print:
                     rt_printf("%d (CMD_IMG_TASK) Starting image acquisition"
-                        " loop for duration %d seconds\n",time(NULL),cmd_arg);
+                        " loop for duration %d seconds\n",get_tm_sec(),cmd_arg);
 
                     // Set flag:
                     img_acq_prog_flag = 1; // Acquisition is in progress
@@ -197,11 +198,11 @@ void cmd_img(void* arg) {
                     if (ret_val == 0) {
                         // Print:
                         rt_printf("%d (CMD_IMG_TASK) Reply message sent to"
-                            " execute command task\n",time(NULL));
+                            " execute command task\n",get_tm_sec());
                     } else {
                         // Print:
                         rt_printf("%d (CMD_IMG_TASK) Error sending reply"
-                            " message to execute command task\n",time(NULL));
+                            " message to execute command task\n",get_tm_sec());
                     }
 
                     // Image acquisition label. This label is reached if a
@@ -223,7 +224,7 @@ void cmd_img(void* arg) {
                         // (This is to check for the last loop)
                         if (elp_time < acq_dur) {
                             // Set next image acquisition time:
-                            next_img_acq_tm = time(NULL) + acq_ivl;
+                            next_img_acq_tm = get_tm_sec() + acq_ivl;
 
                             // Receive command transfer frames from command
                             // executor task via synchronous message if message
@@ -250,7 +251,7 @@ void cmd_img(void* arg) {
                     // Print:
                     rt_printf("%d (CMD_IMG_TASK) Image acquisition loop"
                         " complete; command executed successfully\n",\
-                        time(NULL));
+                        get_tm_sec());
 
                     // Exit switch:
                     break;
@@ -259,7 +260,7 @@ void cmd_img(void* arg) {
                     // Print:
                     rt_printf("%d (CMD_IMG_TASK) Image acquisition loop"
                         " already in progress; command transfer frame"
-                        " ignored\n",time(NULL));
+                        " ignored\n",get_tm_sec());
 
                     // Set reply message data field to indicate command
                     // did not execute:
@@ -270,7 +271,7 @@ void cmd_img(void* arg) {
                 } else if (ips_mdl_ld_state == 0) {
                     // Print:
                     rt_printf("%d (CMD_IMG_TASK) IPS model loading (not ready);"
-                        " command transfer frame ignored\n",time(NULL));
+                        " command transfer frame ignored\n",get_tm_sec());
 
                     // Set reply message data field to indicate command
                     // did not execute:
@@ -284,7 +285,7 @@ void cmd_img(void* arg) {
                 if (img_acq_prog_flag == 1) {
                     // Print:
                     rt_printf("%d (CMD_IMG_TASK) Halting image acquisition"
-                        " loop\n",time(NULL));
+                        " loop\n",get_tm_sec());
 
                     // Set flag:
                     img_acq_prog_flag = 0; // Acquisition not in progress
@@ -299,7 +300,7 @@ void cmd_img(void* arg) {
                     // Print:
                     rt_printf("%d (CMD_IMG_TASK) Image acquisition loop not"
                         " in progress; command transfer frame ignored\n",\
-                        time(NULL));
+                        get_tm_sec());
 
                     // Set reply message data field to indicate command
                     // did not execute:
@@ -311,7 +312,7 @@ void cmd_img(void* arg) {
             case CMD_NOOP :
                 // Print:
                 rt_printf("%d (CMD_IMG_TASK) Executing NOOP command"
-                    "\n",time(NULL));
+                    "\n",get_tm_sec());
 
                 // Execute command and check for success:
                 // HERE HERE HERE HERE
@@ -321,7 +322,7 @@ void cmd_img(void* arg) {
                 if (ret_val > 0) {
                     // Print:
                     rt_printf("%d (CMD_IMG_TASK) Command executed"
-                        " successfully\n",time(NULL));
+                        " successfully\n",get_tm_sec());
 
                     // Set reply message data field to indicate command
                     // executed:
@@ -329,7 +330,7 @@ void cmd_img(void* arg) {
                 } else {
                     // Print:
                     rt_printf("%d (CMD_IMG_TASK) Command did not execute"
-                        "\n",time(NULL));
+                        "\n",get_tm_sec());
 
                     // Set reply message data field to indicate command
                     // executed:
@@ -343,7 +344,7 @@ void cmd_img(void* arg) {
                 // Print:
                 rt_printf("%d (CMD_IMG_TASK) Command packet name is invalid;" 
                     " command transfer frame ignored\n",\
-                    time(NULL));
+                    get_tm_sec());
 
                 // Set reply message data field to indicate command
                 // did not execute:
@@ -360,11 +361,11 @@ void cmd_img(void* arg) {
         if (ret_val == 0) {
             // Print:
             rt_printf("%d (CMD_IMG_TASK) Reply message sent to execute command"
-                " task\n",time(NULL));
+                " task\n",get_tm_sec());
         } else {
             // Print:
             rt_printf("%d (CMD_IMG_TASK) Error sending reply message to execute"
-                " command task\n",time(NULL));
+                " command task\n",get_tm_sec());
         }
 
         // Check if image acquisition is in progress:
@@ -42,6 +42,9 @@
 // Spinnaker libraries:
 #include <SpinnakerC.h> // FLIR machine vision camera interface definitions
 
+// Header files:
+#include <tm_svc.h> // Time service declarations
+
 // Macro definitions:
 #define CAM_EXPOSURE 200000; // Camera exposure in microseconds
 
@@ -61,7 +64,7 @@ bool8_t IsAvailableAndReadable(spinNodeHandle hNode, char nodeName[]) {
     if (spin_ret_val != SPINNAKER_ERR_SUCCESS) {
         // Print:
         rt_printf("%d (CONFIG_CAM_EXP) Unable to retrieve node availability"
-            " (%s node) with error %d\n",time(NULL),nodeName,spin_ret_val);
+            " (%s node) with error %d\n",get_tm_sec(),nodeName,spin_ret_val);
     }
 
     // Check if node is readable:
@@ -71,7 +74,7 @@ bool8_t IsAvailableAndReadable(spinNodeHandle hNode, char nodeName[]) {
     if (spin_ret_val != SPINNAKER_ERR_SUCCESS) {
         // Print:
         rt_printf("%d (CONFIG_CAM_EXP) Unable to retrieve node readability"
-            " (%s node) with error %d\n",time(NULL),nodeName,spin_ret_val);
+            " (%s node) with error %d\n",get_tm_sec(),nodeName,spin_ret_val);
     }
 
     // Exit:
@@ -94,7 +97,7 @@ bool8_t IsAvailableAndWritable(spinNodeHandle hNode, char nodeName[]) {
     if (spin_ret_val != SPINNAKER_ERR_SUCCESS) {
         // Print:
         rt_printf("%d (CONFIG_CAM_EXP) Unable to retrieve node availability"
-            " (%s node) with error %d\n",time(NULL),nodeName,spin_ret_val);
+            " (%s node) with error %d\n",get_tm_sec(),nodeName,spin_ret_val);
     }
 
     // Check if node is writable:
@@ -104,7 +107,7 @@ bool8_t IsAvailableAndWritable(spinNodeHandle hNode, char nodeName[]) {
     if (spin_ret_val != SPINNAKER_ERR_SUCCESS) {
         // Print:
         rt_printf("%d (CONFIG_CAM_EXP) Unable to retrieve node writ-ability"
-            " (%s node) with error %d\n",time(NULL),nodeName,spin_ret_val);
+            " (%s node) with error %d\n",get_tm_sec(),nodeName,spin_ret_val);
     }
 
     // Exit:
@@ -116,12 +119,12 @@ bool8_t IsAvailableAndWritable(spinNodeHandle hNode, char nodeName[]) {
 void PrintRetrieveNodeFailure(char node[], char name[]) {
     // Print:
     rt_printf("%d (CONFIG_CAM_EXP) Unable to get %s (%s %s retrieval"
-        " failed)\n",time(NULL),node, name, node);
+        " failed)\n",get_tm_sec(),node, name, node);
 }
 
 spinError config_cam_exp(spinNodeMapHandle hNodeMap) {
     // Print:
-    rt_printf("%d (CONFIG_CAM_EXP) Configuring camera exposure\n",time(NULL));
+    rt_printf("%d (CONFIG_CAM_EXP) Configuring camera exposure\n",get_tm_sec());
 
     // Definitions and initializations:
     spinError spin_ret_val = SPINNAKER_ERR_SUCCESS; // Spinnaker function
@@ -151,7 +154,7 @@ spinError config_cam_exp(spinNodeMapHandle hNodeMap) {
     if (spin_ret_val != SPINNAKER_ERR_SUCCESS) {
         // Print:
         rt_printf("%d (CONFIG_CAM_EXP) Unable to disable automatic exposure"
-        " (node retrieval); aborting with error %d\n",time(NULL),spin_ret_val);
+        " (node retrieval); aborting with error %d\n",get_tm_sec(),spin_ret_val);
 
         // Exit:
         return spin_ret_val;
@@ -168,7 +171,7 @@ spinError config_cam_exp(spinNodeMapHandle hNodeMap) {
             // Print:
             rt_printf("%d (CONFIG_CAM_EXP Unable to disable automatic"
                 " exposure (enum entry retrieval); aborting with error %d\n",\
-                time(NULL),spin_ret_val);
+                get_tm_sec(),spin_ret_val);
 
             // Exit:
             return spin_ret_val;
@@ -192,7 +195,7 @@ spinError config_cam_exp(spinNodeMapHandle hNodeMap) {
             // Print:
             rt_printf("%d (CONFIG_CAM_EXP) Unable to disable automatic"
             " exposure (enum entry int value retrieval); aborting with error"\
-                " %d\n",time(NULL),spin_ret_val);
+                " %d\n",get_tm_sec(),spin_ret_val);
 
             // Exit
             return spin_ret_val;
@@ -217,7 +220,7 @@ spinError config_cam_exp(spinNodeMapHandle hNodeMap) {
             // Print:
             rt_printf("%d (CONFIG_CAM_EXP) Unable to disable automatic"
                 " exposure (enum entry setting). Aborting with error %d\n",\
-                time(NULL),spin_ret_val);
+                get_tm_sec(),spin_ret_val);
 
             // Exit:
             return spin_ret_val;
@@ -242,7 +245,7 @@ spinError config_cam_exp(spinNodeMapHandle hNodeMap) {
     if (spin_ret_val != SPINNAKER_ERR_SUCCESS) {
         // Print:
         rt_printf("%d (CONFIG_CAM_EXP) Unable to set exposure time; aborting"
-            " with error %d\n",time(NULL),spin_ret_val);
+            " with error %d\n",get_tm_sec(),spin_ret_val);
 
         // Exit:
         return spin_ret_val;
@@ -257,7 +260,7 @@ spinError config_cam_exp(spinNodeMapHandle hNodeMap) {
         if (spin_ret_val != SPINNAKER_ERR_SUCCESS) {
             // Print:
             rt_printf("%d (CONFIG_CAM_EXP) Unable to set exposure time;"
-                " aborting with error %d\n",time(NULL),spin_ret_val);
+                " aborting with error %d\n",get_tm_sec(),spin_ret_val);
 
             // Exit:
             return spin_ret_val;
@@ -285,7 +288,7 @@ spinError config_cam_exp(spinNodeMapHandle hNodeMap) {
         if (spin_ret_val != SPINNAKER_ERR_SUCCESS) {
             // Print:
             rt_printf("%d (CONFIG_CAM_EXP) Unable to set exposure time;"
-                " aborting with error %d\n",time(NULL),spin_ret_val);
+                " aborting with error %d\n",get_tm_sec(),spin_ret_val);
 
             // Exit:
             return spin_ret_val;
@@ -299,7 +302,7 @@ spinError config_cam_exp(spinNodeMapHandle hNodeMap) {
     }
 
     // Print:
-    rt_printf("%d (CONFIG_CAM_EXP) Camera exposure set to %f us\n",time(NULL),\
+    rt_printf("%d (CONFIG_CAM_EXP) Camera exposure set to %f us\n",get_tm_sec(),\
         exposureTimeToSet);
 
     // Exit:
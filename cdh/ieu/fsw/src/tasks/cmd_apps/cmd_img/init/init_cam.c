@@ -45,6 +45,7 @@
 
 // Header files:
 #include <config_cam_exp.h> // Configure camera exposure function declaration
+#include <tm_svc.h>         // Time service declarations
 
 int init_cam() {
     // Definitions and initializations:
@@ -67,7 +68,7 @@ int init_cam() {
     if (ret_val != SPINNAKER_ERR_SUCCESS) {
         // Print:
         rt_printf("%d (INIT_CAM) Unable to retrieve system instance;"
-            " aborting with error %d\n",time(NULL),ret_val);
+            " aborting with error %d\n",get_tm_sec(),ret_val);
 
         // Exit:
         return ret_val;
@@ -80,7 +81,7 @@ int init_cam() {
     if (ret_val != SPINNAKER_ERR_SUCCESS) {
         // Print:
         rt_printf("%d (INIT_CAM) Unable to create camera list; aborting"
-            " with error %d\n",time(NULL),ret_val);
+            " with error %d\n",get_tm_sec(),ret_val);
 
         // Exit:
         return ret_val;
@@ -93,7 +94,7 @@ int init_cam() {
     if (ret_val != SPINNAKER_ERR_SUCCESS) {
         // Print:
         rt_printf("%d (INIT_CAM) Unable to retrieve camera list; aborting"
-            " with error %d\n",time(NULL),ret_val);
+            " with error %d\n",get_tm_sec(),ret_val);
 
         // Exit:
         return ret_val;
@@ -106,7 +107,7 @@ int init_cam() {
     if (ret_val != SPINNAKER_ERR_SUCCESS) {
         // Print:
         rt_printf("%d (INIT_CAM) Unable to retrieve number of cameras;"
-            " aborting with error %d\n",time(NULL),ret_val);
+            " aborting with error %d\n",get_tm_sec(),ret_val);
 
         // Exit:
         return ret_val;
@@ -122,7 +123,7 @@ int init_cam() {
         if (ret_val != SPINNAKER_ERR_SUCCESS) {
             // Print:
             rt_printf("%d (INIT_CAM) Unable to clear camera list;"
-                " aborting with error %d\n",time(NULL),ret_val);
+                " aborting with error %d\n",get_tm_sec(),ret_val);
 
             // Exit:
             return ret_val;
@@ -135,7 +136,7 @@ int init_cam() {
         if (ret_val != SPINNAKER_ERR_SUCCESS) {
             // Print:
             rt_printf("%d (INIT_CAM) Unable to destroy camera list; aborting"
-                " with error %d\n",time(NULL),ret_val);
+                " with error %d\n",get_tm_sec(),ret_val);
 
             // Exit:
             return ret_val;
@@ -147,7 +148,7 @@ int init_cam() {
         // Check success:
         if (ret_val != SPINNAKER_ERR_SUCCESS) {
             rt_printf("%d (INIT_CAM) Unable to release system instance;"
-                " aborting with error %d\n",time(NULL),ret_val);
+                " aborting with error %d\n",get_tm_sec(),ret_val);
 
             // Exit:
             return ret_val;
@@ -155,7 +156,7 @@ int init_cam() {
 
         // Print:
         rt_printf("%d (INIT_CAM) Found %d cameras (expected 1); aborting\n",\
-            time(NULL),numCameras);
+            get_tm_sec(),numCameras);
 
         // Exit:
         return -1;
@@ -168,7 +169,7 @@ int init_cam() {
     if (ret_val != SPINNAKER_ERR_SUCCESS) {
         // Print:
         rt_printf("%d (INIT_CAM) Unable to retrieve camera from list;"
-            " aborting with error %d\n",time(NULL),ret_val);
+            " aborting with error %d\n",get_tm_sec(),ret_val);
 
         // Exit:
         err_ret = ret_val;
@@ -180,7 +181,7 @@ int init_cam() {
         if (ret_val != SPINNAKER_ERR_SUCCESS) {
             // Print:
             rt_printf("%d (INIT_CAM) Unable to initialize camera; aborting"
-                " with error %d\n",time(NULL),ret_val);
+                " with error %d\n",get_tm_sec(),ret_val);
 
             // Set return:
             err_ret = ret_val;
@@ -193,7 +194,7 @@ int init_cam() {
         if (ret_val != SPINNAKER_ERR_SUCCESS) {
             // Print:
             rt_printf("%d (INIT_CAM) Unable to retrieve GenICam nodemap;"
-                " aborting with error %d\n",time(NULL),ret_val);
+                " aborting with error %d\n",get_tm_sec(),ret_val);
             
             // Set return:
             err_ret = ret_val;
@@ -216,7 +217,7 @@ int init_cam() {
         if (ret_val != SPINNAKER_ERR_SUCCESS) {
             // Print:
             rt_printf("%d (INIT_CAM) Unable to de-initialize camera;"
-                " non-fatal error %d\n",time(NULL),ret_val);
+                " non-fatal error %d\n",get_tm_sec(),ret_val);
             // Set return:
             err_ret = ret_val;
         }
@@ -235,7 +236,7 @@ int init_cam() {
     if (ret_val != SPINNAKER_ERR_SUCCESS) {
         // Print:
         rt_printf("%d (INIT_CAM) Unable to release camera; aborting with"
-            " error %d\n",time(NULL),ret_val);
+            " error %d\n",get_tm_sec(),ret_val);
 
         // Exit:
         err_ret = ret_val;
@@ -248,7 +249,7 @@ int init_cam() {
     if (ret_val != SPINNAKER_ERR_SUCCESS) {
         // Print:
         rt_printf("%d (INIT_CAM) Unable to clear camera list;"
-            " aborting with error %d\n",time(NULL),ret_val);
+            " aborting with error %d\n",get_tm_sec(),ret_val);
 
         // Exit:
         return ret_val;
@@ -261,7 +262,7 @@ int init_cam() {
     if (ret_val != SPINNAKER_ERR_SUCCESS) {
         // Print:
         rt_printf("%d (INIT_CAM) Unable to destroy camera list; aborting"
-            " with error %d\n",time(NULL),ret_val);
+            " with error %d\n",get_tm_sec(),ret_val);
 
         // Exit:
         return ret_val;
@@ -274,7 +275,7 @@ int init_cam() {
     if (ret_val != SPINNAKER_ERR_SUCCESS) {
         // Print:
         rt_printf("%d (INIT_CAM) Unable to release system instance; aborting"
-            " with error %d\n",time(NULL),ret_val);
+            " with error %d\n",get_tm_sec(),ret_val);
 
         // Exit:
         return ret_val;
@@ -61,6 +61,7 @@
                           // declaration
 #include <send_mdq_cmd.h> // Send Magnetometer DAQ command function declaration
 #include <hk_tlm_var.h>   // Housekeeping telemetry variable declarations
+#include <tm_svc.h>       // Time service declarations
 
 // Macro definitions:
 #define CMD_XFR_FRM_SIZE 15 // Command transfer frame size in bytes
@@ -69,6 +70,7 @@
 
 #define CMD_BGNMDQSCAN  0x00 // Command: Begin MDQ scan
 #define CMD_HALTMDQSCAN 0x01 // Command: Halt MDQ scan
+#define CMD_SETMDQCDC   0x02 // Command: Set MDQ codec (0: raw, 1: encoded)
 #define CMD_NOOP      0x3FFF // Command: Non-operational
 
 // Semaphore definitions:
@@ -78,10 +80,11 @@ RT_SEM read_mdq_sem; // For cmd_mdq and read_mdq task synchronization to
 
 // Global variable definitions:
 uint8_t mdq_scan_state = 0; // Magnetometer DAQ scanning state
+uint8_t mdq_cdc_flg = 0;    // Magnetometer DAQ codec flag (raw by default)
 
 void cmd_mdq(void* arg) {
     // Print:
-    rt_printf("%d (CMD_MDQ_TASK) Task started\n",time(NULL));
+    rt_printf("%d (CMD_MDQ_TASK) Task started\n",get_tm_sec());
 
     // Declarations and initialization:
     int8_t   ret_val; // Function return value
@@ -117,7 +120,7 @@ void cmd_mdq(void* arg) {
     // Task synchronize with exec_cmd task
     // (tell task that it is now ready to receive frames)
     rt_printf("%d (CMD_MDQ_TASK) Ready to receive command transfer"
-        " frames\n",time(NULL));
+        " frames\n",get_tm_sec());
 
     // Signal task to continue executing:
     rt_sem_v(&cmd_mdq_sem);
@@ -135,11 +138,11 @@ void cmd_mdq(void* arg) {
         if (flw_id > 0) {
             // Print
             rt_printf("%d (CMD_MDQ_TASK) Received command transfer"
-                " frame\n",time(NULL));
+                " frame\n",get_tm_sec());
         } else {
             // Print
             rt_printf("%d (CMD_MDQ_TASK) Error receiving command transfer"
-                " frame\n",time(NULL));
+                " frame\n",get_tm_sec());
             // NEED ERROR HANDLING
         }
 
@@ -153,7 +156,7 @@ void cmd_mdq(void* arg) {
 
         // Print:
         rt_printf("%d (CMD_MDQ_TASK) Checking command packet"
-            " name...\n",time(NULL));
+            " name...\n",get_tm_sec());
 
         // Switch to match command packet name to know command packet
         // names; execute command if match:
@@ -165,7 +168,7 @@ void cmd_mdq(void* arg) {
                 if (mdq_scan_state == 0) {
                     // Printstate
                     rt_printf("%d (CMD_MDQ_TASK) Starting magnetometer DAQ"
-                        " scanning\n",time(NULL));
+                        " scanning\n",get_tm_sec());
 
                     // Send command to start scanning:
                     ret_val = send_mdq_cmd("start 0");
@@ -174,7 +177,7 @@ void cmd_mdq(void* arg) {
                     if (ret_val == 0) {
                         // Print:
                         rt_printf("%d (CMD_IMG_TASK) Command executed"
-                            " successfully\n",time(NULL));
+                            " successfully\n",get_tm_sec());
 
                         // Signal read mdq task to start reading data from DAQ:
                         rt_sem_v(&read_mdq_sem);
@@ -188,7 +191,7 @@ void cmd_mdq(void* arg) {
                     } else if (ret_val < 0) {
                         // Print:
                         rt_printf("%d (CMD_IMG_TASK) Command did not execute"
-                            "\n",time(NULL));
+                            "\n",get_tm_sec());
 
                         // Set reply message data field to indicate command
                         // did not execute:
@@ -198,7 +201,7 @@ void cmd_mdq(void* arg) {
                     // Printstate
                     rt_printf("%d (CMD_MDQ_TASK) Magnetometer DAQ is already"
                         " scanning; command transfer frame ignored\n",\
-                        time(NULL));
+                        get_tm_sec());
 
                     // Set reply message data field to indicate command
                     // did not execute:
@@ -212,7 +215,7 @@ void cmd_mdq(void* arg) {
                 if (mdq_scan_state == 1) {
                     // Printstate
                     rt_printf("%d (CMD_MDQ_TASK) Halting magnetometer DAQ"
-                        " scanning\n",time(NULL));
+                        " scanning\n",get_tm_sec());
 
                     // Signal read mdq task to stop reading data from DAQ:
                     rt_sem_p(&read_mdq_sem,TM_INFINITE);
@@ -224,7 +227,7 @@ void cmd_mdq(void* arg) {
                     if (ret_val == 0) {
                         // Print:
                         rt_printf("%d (CMD_IMG_TASK) Command executed"
-                            " successfully\n",time(NULL));
+                            " successfully\n",get_tm_sec());
 
                         // Send command to start scanning:
                         ret_val = send_mdq_cmd("led 6");
@@ -238,7 +241,7 @@ void cmd_mdq(void* arg) {
                     } else if (ret_val < 0) {
                         // Print:
                         rt_printf("%d (CMD_IMG_TASK) Command did not execute"
-                            "\n",time(NULL));
+                            "\n",get_tm_sec());
 
                         // Set reply message data field to indicate command
                         // did not execute:
@@ -248,18 +251,45 @@ void cmd_mdq(void* arg) {
                     // Printstate
                     rt_printf("%d (CMD_MDQ_TASK) Magnetometer DAQ is not"
                         " scanning; command transfer frame ignored\n",\
-                        time(NULL));
+                        get_tm_sec());
 
                     // Set reply message data field to indicate command
                     // did not execute:
                     cmd_exec_stat = 0;
                 }
+                // Exit switch:
+                break;
+            case CMD_SETMDQCDC :
+                // Check argument (raw or encoded):
+                if (cmd_arg <= 1) {
+                    // Print:
+                    rt_printf("%d (CMD_MDQ_TASK) Setting magnetometer DAQ"
+                        " codec to %s\n",get_tm_sec(),\
+                        cmd_arg ? "encoded" : "raw");
+
+                    // Set codec flag (read by read mdq task for next read):
+                    mdq_cdc_flg = cmd_arg;
+
+                    // Set reply message data field to indicate command
+                    // executed:
+                    cmd_exec_stat = 1;
+                } else {
+                    // Print:
+                    rt_printf("%d (CMD_MDQ_TASK) Invalid magnetometer DAQ"
+                        " codec %u; command transfer frame ignored\n",\
+                        get_tm_sec(),cmd_arg);
+
+                    // Set reply message data field to indicate command
+                    // did not execute:
+                    cmd_exec_stat = 0;
+                }
+
                 // Exit switch:
                 break;
             case CMD_NOOP :
                 // Print:
                 rt_printf("%d (CMD_MDQ_TASK) Executing NOOP command"
-                    "\n",time(NULL));
+                    "\n",get_tm_sec());
 
                 // Execute command and check for success:
                 // HERE HERE HERE HERE
@@ -269,7 +299,7 @@ void cmd_mdq(void* arg) {
                 if (ret_val > 0) {
                     // Print:
                     rt_printf("%d (CMD_MDQ_TASK) Command executed"
-                        " successfully\n",time(NULL));
+                        " successfully\n",get_tm_sec());
 
                     // Set reply message data field to indicate command
                     // executed:
@@ -277,7 +307,7 @@ void cmd_mdq(void* arg) {
                 } else {
                     // Print:
                     rt_printf("%d (CMD_MDQ_TASK) Command did not execute"
-                        "\n",time(NULL));
+                        "\n",get_tm_sec());
 
                     // Set reply message data field to indicate command
                     // executed:
@@ -291,7 +321,7 @@ void cmd_mdq(void* arg) {
                 // Print:
                 rt_printf("%d (CMD_MDQ_TASK) Command packet is invalid;" 
                     " command transfer frame ignored\n",\
-                    time(NULL));
+                    get_tm_sec());
 
                 // Set reply message data field to indicate command
                 // did not execute:
@@ -305,11 +335,11 @@ void cmd_mdq(void* arg) {
         if (ret_val == 0) {
             // Print:
             rt_printf("%d (CMD_MDQ_TASK) Reply message sent to execute command"
-                " task\n",time(NULL));
+                " task\n",get_tm_sec());
         } else {
             // Print:
             rt_printf("%d (CMD_MDQ_TASK) Error sending reply message to execute"
-                " command task\n",time(NULL));
+                " command task\n",get_tm_sec());
         }
     }
     
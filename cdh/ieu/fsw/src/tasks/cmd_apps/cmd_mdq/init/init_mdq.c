@@ -49,6 +49,7 @@
 // Header files:
 #include <mdq_dev.h>      // Magnetometer DAQ device variable declarations
 #include <send_mdq_cmd.h> // Send Magnetometer DAQ command function declaration
+#include <tm_svc.h>       // Time service declarations
 
 // Macro definitions:
 #define PID 0x4108 // DAQ product I.D.
@@ -74,7 +75,7 @@ int8_t init_mdq() {
     if (ret_val < 0) {
         // Print:
         rt_printf("%d (INIT_MDQ) Could not initialize library"
-            " session; aborting with error %d\n",time(NULL),ret_val);
+            " session; aborting with error %d\n",get_tm_sec(),ret_val);
 
         // Exit
         return ret_val;
@@ -90,7 +91,7 @@ int8_t init_mdq() {
     if (ret_val < 0) {
         // Print:
         rt_printf("%d (INIT_MDQ) Could not get device list; aborting"
-            " with error %d\n",time(NULL),ret_val);
+            " with error %d\n",get_tm_sec(),ret_val);
 
         // Exit
         return ret_val;
@@ -103,7 +104,7 @@ int8_t init_mdq() {
     if (dev_hdl == NULL) {
         // Print:
         rt_printf("%d (INIT_MDQ) Could not open device; aborting\n",\
-            time(NULL));
+            get_tm_sec());
 
         return -1;
     }
@@ -118,7 +119,7 @@ int8_t init_mdq() {
     // If attached, then detach it:
     if (ret_val == 1) {
         // Print:
-        rt_printf("%d (INIT_MDQ) Kernel driver is active\n",time(NULL));
+        rt_printf("%d (INIT_MDQ) Kernel driver is active\n",get_tm_sec());
 
         // Detach:
         ret_val = libusb_detach_kernel_driver(dev_hdl,0);
@@ -126,7 +127,7 @@ int8_t init_mdq() {
         // Check:
         if (ret_val == 0) {
             // Print:
-            rt_printf("%d (INIT_MDQ) Kernel driver detached\n",time(NULL));
+            rt_printf("%d (INIT_MDQ) Kernel driver detached\n",get_tm_sec());
         }
     }
 
@@ -137,7 +138,7 @@ int8_t init_mdq() {
     if (ret_val < 0) {
         // Print:
         rt_printf("%d (INIT_MDQ) Could not claim interface; aborting with"
-            " error %d\n",time(NULL),ret_val);
+            " error %d\n",get_tm_sec(),ret_val);
 
         return ret_val;
     }
@@ -175,7 +176,7 @@ int8_t init_mdq() {
     ret_val = send_mdq_cmd("filter * 1");
 
     // Print:
-    rt_printf("%d (INIT_MDQ) DAQ initialization complete\n",time(NULL));
+    rt_printf("%d (INIT_MDQ) DAQ initialization complete\n",get_tm_sec());
 
     // Signal initialization has been complete:
     rt_sem_v(&mdq_init_sem);
@@ -4,7 +4,8 @@
 //
 // Task responsible for executing software commands. Software commands are
 // received in command transfer frames via synchronous message passing from
-// the command executor task. 
+// the command executor task or the run sequence task (steps of stored
+// sequences). 
 //
 // Command transfer frames consist of
 //     - APID
@@ -43,6 +44,7 @@
 #include <stdlib.h>  // Standard library
 #include <unistd.h>  // UNIX standard function definitions
 #include <errno.h>   // Error number definitions
+#include <string.h>  // String function definitions
 #include <stdint.h>  // Standard integer types
 #include <time.h>    // Standard time types
 
@@ -50,9 +52,16 @@
 #include <alchemy/task.h>  // Task management service
 #include <alchemy/timer.h> // Timer management services
 #include <alchemy/sem.h>   // Semaphore services
+#include <alchemy/queue.h> // Message queue services
 
 // Header files:
-#include <sems.h> // Semaphore variable declarations
+#include <sems.h>       // Semaphore variable declarations
+#include <tm_svc.h>     // Time service declarations
+#include <flt_tbl.h>    // Filter table (TO & DS) declarations
+#include <ld_flt_tbl.h> // Load filter table declarations
+#include <pbk_rec_tlm.h> // Play back recorded telemetry declarations
+#include <seq_tbl.h>    // Sequence table declarations
+#include <flw_ctl.h>    // Flow control declarations
 
 // Macro definitions:
 #define CMD_XFR_FRM_SIZE 15 // Command transfer frame size in bytes
@@ -62,6 +71,20 @@
 #define CMD_NOOP        0x00 // Command: Non-operationa
 #define CMD_BGNPBK      0x01 // Command: Begin playback
 #define CMD_SETFLTTBLMD 0x02 // Command: Set filter table mode
+#define CMD_BGNFLTTBLLD 0x03 // Command: Begin filter table load
+#define CMD_FLTTBLLD    0x04 // Command: Filter table load (one word)
+#define CMD_ENDFLTTBLLD 0x05 // Command: End filter table load
+#define CMD_SETPBKBGN   0x06 // Command: Set playback window start
+#define CMD_SETPBKEND   0x07 // Command: Set playback window end
+#define CMD_SETPBKLIM   0x08 // Command: Set playback byte budget
+#define CMD_SETPBKRATE  0x09 // Command: Set playback share of link rate
+#define CMD_ACKPBK      0x0A // Command: Acknowledge playback (downlinked)
+#define CMD_BGNSEQLD    0x0B // Command: Begin sequence load
+#define CMD_SEQLD       0x0C // Command: Sequence load (one word)
+#define CMD_ENDSEQLD    0x0D // Command: End sequence load
+#define CMD_RUNSEQ      0x0E // Command: Run stored sequence
+#define CMD_STPSEQ      0x0F // Command: Stop running sequence
+#define CMD_SETFLWPOL   0x10 // Command: Set message queue drop policy
 
 #define ARG_FLTTBL_NORM 0x00 // Argument: Filter table normal (NORM)
 #define ARG_FLTTBL_RT   0x01 // Argument: Filter table realtime (RT)
@@ -79,23 +102,23 @@ RT_SEM rtrv_file_sem; // For rtrv_file_task and cmd_sw_task
 
 // Global variable definition:
 uint8_t flt_tbl_mode; // Filter table mode
-uint8_t pbk_prog_flg; // Playback in progress flag
+uint8_t pbk_prog_flg; // Playback progress (0: idle; 1-100: percent)
 
 void cmd_sw(void* arg) {
     // Print:
-    rt_printf("%d (CMD_SW_TASK) Task started\n",time(NULL));
+    rt_printf("%d (CMD_SW_TASK) Task started\n",get_tm_sec());
 
     // Task synchronize with retrieve file task:
     // (wait for task to be ready to receive command transfer frames)
     rt_printf("%d (CMD_SW_TASK) Waiting for retrieve file task to be ready"
-        "\n",time(NULL));
+        "\n",get_tm_sec());
 
     // Wait for signal:
     rt_sem_p(&rtrv_file_sem,TM_INFINITE);
 
     // Print:
     rt_printf("%d (CMD_SW_TASK) Retrieve file task is ready;"
-        " continuing\n",time(NULL));
+        " continuing\n",get_tm_sec());
 
     // Declarations and initialization:
     int8_t   ret_val; // Function return value
@@ -128,7 +151,7 @@ void cmd_sw(void* arg) {
     // Task synchronize with execute command task
     // (tell task that it is now ready to receive frames)
     rt_printf("%d (CMD_SW_TASK) Ready to receive command transfer"
-        " frames\n",time(NULL));
+        " frames\n",get_tm_sec());
 
     // Signal task to continue executing:
     rt_sem_v(&cmd_sw_sem);
@@ -146,11 +169,11 @@ void cmd_sw(void* arg) {
         if (flw_id > 0) {
             // Print
             rt_printf("%d (CMD_SW_TASK) Received command transfer"
-                " frame\n",time(NULL));
+                " frame\n",get_tm_sec());
         } else {
             // Print
             rt_printf("%d (CMD_SW_TASK) Error receiving command transfer"
-                " frame\n",time(NULL));
+                " frame\n",get_tm_sec());
             // NEED ERROR HANDLING
         }
 
@@ -164,7 +187,7 @@ void cmd_sw(void* arg) {
 
         // Print:
         rt_printf("%d (CMD_SW_TASK) Checking command packet"
-            " name...\n",time(NULL));
+            " name...\n",get_tm_sec());
 
         // Switch to match command packet name to know command packet
         // names; execute command if match:
@@ -172,7 +195,7 @@ void cmd_sw(void* arg) {
             case CMD_NOOP :
                 // Print:
                 rt_printf("%d (CMD_SW_TASK) Executing NOOP command"
-                    "\n",time(NULL));
+                    "\n",get_tm_sec());
 
                 // Execute command and check for success:
                 // HERE HERE HERE HERE
@@ -182,7 +205,7 @@ void cmd_sw(void* arg) {
                 if (ret_val > 0) {
                     // Print:
                     rt_printf("%d (CMD_SW_TASK) Command executed"
-                        " successfully\n",time(NULL));
+                        " successfully\n",get_tm_sec());
 
                     // Set reply message data field to indicate command
                     // executed:
@@ -190,7 +213,7 @@ void cmd_sw(void* arg) {
                 } else {
                     // Print:
                     rt_printf("%d (CMD_SW_TASK) Command did not execute"
-                        "\n",time(NULL));
+                        "\n",get_tm_sec());
 
                     // Set reply message data field to indicate command
                     // executed:
@@ -201,10 +224,10 @@ void cmd_sw(void* arg) {
                 break;
             case CMD_BGNPBK :
                 // Check if playback is not in progress:
-                if (pbk_prog_flg != 1) {
+                if (pbk_prog_flg == 0) {
                     // Print:
                     rt_printf("%d (CMD_SW_TASK) Executing BGNPBK command with"
-                        " arguments: 0x%X\n",time(NULL),cmd_arg);
+                        " arguments: 0x%X\n",get_tm_sec(),cmd_arg);
 
                     ret_val = rt_task_send(&rtrv_file_task,&cmd_xfr_frm_mcb,\
                         &rply_mcb,TM_INFINITE);
@@ -212,18 +235,18 @@ void cmd_sw(void* arg) {
                     if (ret_val > 0) {
                         // Print:
                         rt_printf("%d (CMD_SW_TASK) Reply message received"
-                            " from retrieve file\n",time(NULL));
+                            " from retrieve file\n",get_tm_sec());
                     } else { 
                         // Print:
                         rt_printf("%d (CMD_SW_TASK) Error sending command"
-                            " transfer frame to retrieve file task\n",time(NULL));
+                            " transfer frame to retrieve file task\n",get_tm_sec());
                         // NEED ERROR HANDLING
                     }
                 } else {
                     // Print:
                     rt_printf("%d (CMD_SW_TASK) Recorded telemetry playback"
                         " already in progress; ignoring command transfer"
-                        " frame\n",time(NULL));
+                        " frame\n",get_tm_sec());
 
                     // Set reply message data field to indicate command
                     // did not execute:
@@ -235,13 +258,13 @@ void cmd_sw(void* arg) {
             case CMD_SETFLTTBLMD :
                 // Print:
                 rt_printf("%d (CMD_SW_TASK) Executing SETFLTTBLMD command with"
-                    " arguments: 0x%X\n",time(NULL),cmd_arg);
+                    " arguments: 0x%X\n",get_tm_sec(),cmd_arg);
 
                 // Check if command argument matches known arguments:
                 if (cmd_arg > ARG_FLTTBL_MAG) {
                     // Print:
                     rt_printf("%d (CMD_SW_TASK) Command argument is invalid;"
-                        " command transfer frame ignored\n",time(NULL));
+                        " command transfer frame ignored\n",get_tm_sec());
 
                     // Set reply message data field to indicate command
                     // did not execute:
@@ -255,6 +278,259 @@ void cmd_sw(void* arg) {
                     cmd_exec_stat = 1; 
                 }
 
+                // Exit switch:
+                break;
+            case CMD_BGNFLTTBLLD :
+                // Print:
+                rt_printf("%d (CMD_SW_TASK) Executing BGNFLTTBLLD command with"
+                    " arguments: 0x%X\n",get_tm_sec(),cmd_arg);
+
+                // Begin filter table upload:
+                ret_val = bgn_ld_flt_tbl(cmd_arg);
+
+                // Set reply message data field to indicate command
+                // executed or not:
+                cmd_exec_stat = (ret_val > 0) ? 1 : 0;
+
+                // Exit switch:
+                break;
+            case CMD_FLTTBLLD :
+                // Print:
+                rt_printf("%d (CMD_SW_TASK) Executing FLTTBLLD command with"
+                    " arguments: 0x%X\n",get_tm_sec(),cmd_arg);
+
+                // Load filter table word:
+                ret_val = ld_flt_tbl_wrd(cmd_arg);
+
+                // Set reply message data field to indicate command
+                // executed or not:
+                cmd_exec_stat = (ret_val > 0) ? 1 : 0;
+
+                // Exit switch:
+                break;
+            case CMD_ENDFLTTBLLD :
+                // Print:
+                rt_printf("%d (CMD_SW_TASK) Executing ENDFLTTBLLD command with"
+                    " arguments: 0x%X\n",get_tm_sec(),cmd_arg);
+
+                // Validate, persist, and publish uploaded filter table:
+                ret_val = end_ld_flt_tbl(cmd_arg);
+
+                // Set reply message data field to indicate command
+                // executed or not:
+                cmd_exec_stat = (ret_val > 0) ? 1 : 0;
+
+                // Exit switch:
+                break;
+            case CMD_SETPBKBGN :
+                // Print:
+                rt_printf("%d (CMD_SW_TASK) Executing SETPBKBGN command with"
+                    " arguments: 0x%X\n",get_tm_sec(),cmd_arg);
+
+                // Check if playback is not in progress (playback state is
+                // only changed by one task at a time):
+                if (pbk_prog_flg == 0) {
+                    // Stage playback window start (resets cursors):
+                    ret_val = set_pbk_rec_tlm_bgn(cmd_arg);
+                } else {
+                    // Print:
+                    rt_printf("%d (CMD_SW_TASK) Recorded telemetry playback"
+                        " in progress; ignoring command transfer frame\n",\
+                        get_tm_sec());
+
+                    ret_val = 0;
+                }
+
+                // Set reply message data field to indicate command
+                // executed or not:
+                cmd_exec_stat = (ret_val > 0) ? 1 : 0;
+
+                // Exit switch:
+                break;
+            case CMD_SETPBKEND :
+                // Print:
+                rt_printf("%d (CMD_SW_TASK) Executing SETPBKEND command with"
+                    " arguments: 0x%X\n",get_tm_sec(),cmd_arg);
+
+                // Check if playback is not in progress (playback state is
+                // only changed by one task at a time):
+                if (pbk_prog_flg == 0) {
+                    // Stage playback window end (resets cursors):
+                    ret_val = set_pbk_rec_tlm_end(cmd_arg);
+                } else {
+                    // Print:
+                    rt_printf("%d (CMD_SW_TASK) Recorded telemetry playback"
+                        " in progress; ignoring command transfer frame\n",\
+                        get_tm_sec());
+
+                    ret_val = 0;
+                }
+
+                // Set reply message data field to indicate command
+                // executed or not:
+                cmd_exec_stat = (ret_val > 0) ? 1 : 0;
+
+                // Exit switch:
+                break;
+            case CMD_SETPBKLIM :
+                // Print:
+                rt_printf("%d (CMD_SW_TASK) Executing SETPBKLIM command with"
+                    " arguments: 0x%X\n",get_tm_sec(),cmd_arg);
+
+                // Check if playback is not in progress (playback state is
+                // only changed by one task at a time):
+                if (pbk_prog_flg == 0) {
+                    // Stage playback byte budget:
+                    ret_val = set_pbk_rec_tlm_lim(cmd_arg);
+                } else {
+                    // Print:
+                    rt_printf("%d (CMD_SW_TASK) Recorded telemetry playback"
+                        " in progress; ignoring command transfer frame\n",\
+                        get_tm_sec());
+
+                    ret_val = 0;
+                }
+
+                // Set reply message data field to indicate command
+                // executed or not:
+                cmd_exec_stat = (ret_val > 0) ? 1 : 0;
+
+                // Exit switch:
+                break;
+            case CMD_SETPBKRATE :
+                // Print:
+                rt_printf("%d (CMD_SW_TASK) Executing SETPBKRATE command with"
+                    " arguments: 0x%X\n",get_tm_sec(),cmd_arg);
+
+                // Check if playback is not in progress (playback state is
+                // only changed by one task at a time):
+                if (pbk_prog_flg == 0) {
+                    // Stage playback share of link rate:
+                    ret_val = set_pbk_rec_tlm_pct(cmd_arg);
+                } else {
+                    // Print:
+                    rt_printf("%d (CMD_SW_TASK) Recorded telemetry playback"
+                        " in progress; ignoring command transfer frame\n",\
+                        get_tm_sec());
+
+                    ret_val = 0;
+                }
+
+                // Set reply message data field to indicate command
+                // executed or not:
+                cmd_exec_stat = (ret_val > 0) ? 1 : 0;
+
+                // Exit switch:
+                break;
+            case CMD_ACKPBK :
+                // Print:
+                rt_printf("%d (CMD_SW_TASK) Executing ACKPBK command with"
+                    " arguments: 0x%X\n",get_tm_sec(),cmd_arg);
+
+                // Check if playback is not in progress (playback state is
+                // only changed by one task at a time):
+                if (pbk_prog_flg == 0) {
+                    // Mark staged window downlinked and delete downlinked
+                    // segments:
+                    ret_val = ack_pbk_rec_tlm(cmd_arg);
+                } else {
+                    // Print:
+                    rt_printf("%d (CMD_SW_TASK) Recorded telemetry playback"
+                        " in progress; ignoring command transfer frame\n",\
+                        get_tm_sec());
+
+                    ret_val = 0;
+                }
+
+                // Set reply message data field to indicate command
+                // executed or not:
+                cmd_exec_stat = (ret_val > 0) ? 1 : 0;
+
+                // Exit switch:
+                break;
+            case CMD_BGNSEQLD :
+                // Print:
+                rt_printf("%d (CMD_SW_TASK) Executing BGNSEQLD command with"
+                    " arguments: 0x%X\n",get_tm_sec(),cmd_arg);
+
+                // Begin sequence upload:
+                ret_val = bgn_ld_seq(cmd_arg);
+
+                // Set reply message data field to indicate command
+                // executed or not:
+                cmd_exec_stat = (ret_val > 0) ? 1 : 0;
+
+                // Exit switch:
+                break;
+            case CMD_SEQLD :
+                // Print:
+                rt_printf("%d (CMD_SW_TASK) Executing SEQLD command with"
+                    " arguments: 0x%X\n",get_tm_sec(),cmd_arg);
+
+                // Load sequence word:
+                ret_val = ld_seq_wrd(cmd_arg);
+
+                // Set reply message data field to indicate command
+                // executed or not:
+                cmd_exec_stat = (ret_val > 0) ? 1 : 0;
+
+                // Exit switch:
+                break;
+            case CMD_ENDSEQLD :
+                // Print:
+                rt_printf("%d (CMD_SW_TASK) Executing ENDSEQLD command with"
+                    " arguments: 0x%X\n",get_tm_sec(),cmd_arg);
+
+                // Validate, store, and persist uploaded sequence:
+                ret_val = end_ld_seq(cmd_arg);
+
+                // Set reply message data field to indicate command
+                // executed or not:
+                cmd_exec_stat = (ret_val > 0) ? 1 : 0;
+
+                // Exit switch:
+                break;
+            case CMD_RUNSEQ :
+                // Print:
+                rt_printf("%d (CMD_SW_TASK) Executing RUNSEQ command with"
+                    " arguments: 0x%X\n",get_tm_sec(),cmd_arg);
+
+                // Start stored sequence:
+                ret_val = str_seq(cmd_arg);
+
+                // Set reply message data field to indicate command
+                // executed or not:
+                cmd_exec_stat = (ret_val > 0) ? 1 : 0;
+
+                // Exit switch:
+                break;
+            case CMD_STPSEQ :
+                // Print:
+                rt_printf("%d (CMD_SW_TASK) Executing STPSEQ command with"
+                    " arguments: 0x%X\n",get_tm_sec(),cmd_arg);
+
+                // Stop running sequence:
+                ret_val = stp_seq();
+
+                // Set reply message data field to indicate command
+                // executed or not:
+                cmd_exec_stat = (ret_val > 0) ? 1 : 0;
+
+                // Exit switch:
+                break;
+            case CMD_SETFLWPOL :
+                // Print:
+                rt_printf("%d (CMD_SW_TASK) Executing SETFLWPOL command with"
+                    " arguments: 0x%X\n",get_tm_sec(),cmd_arg);
+
+                // Set drop policy of flow controlled message queue (argument
+                // is queue << 8 | policy):
+                ret_val = set_flw_ctl_pol(cmd_arg);
+
+                // Set reply message data field to indicate command
+                // executed or not:
+                cmd_exec_stat = (ret_val > 0) ? 1 : 0;
+
                 // Exit switch:
                 break;
             // If command packet name does not match:
@@ -262,7 +538,7 @@ void cmd_sw(void* arg) {
                 // Print:
                 rt_printf("%d (CMD_SW_TASK) Command packet is invalid;"
                     " command transfer frame ignored\n",\
-                    time(NULL));
+                    get_tm_sec());
 
                 // Set reply message data field to indicate command
                 // did not execute:
@@ -276,11 +552,11 @@ void cmd_sw(void* arg) {
         if (ret_val == 0) {
             // Print:
             rt_printf("%d (CMD_SW_TASK) Reply message sent to execute command"
-                " task\n",time(NULL));
+                " task\n",get_tm_sec());
         } else {
             // Print:
             rt_printf("%d (CMD_SW_TASK) Error sending reply message to execute"
-                " command task\n",time(NULL));
+                " command task\n",get_tm_sec());
         }
     }
     
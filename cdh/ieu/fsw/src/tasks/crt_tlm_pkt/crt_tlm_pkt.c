@@ -74,6 +74,7 @@
 #include <sems.h>                // Semaphore variable declarations
 #include <crt_tlm_pkt_xfr_frm.h> // Create telemetry packet transfer frame
                                  // function declaration
+#include <tm_svc.h>              // Time service declarations
 
 // Macro definitions:
 #define TLM_PKT_XFR_FRM_SIZE 1089 // Telemetry transfer frame size in bytes
@@ -107,19 +108,19 @@ RT_SEM crt_tlm_pkt_sem; // For crt_tlm_pkt_task and read_usb tasks
 
 void crt_tlm_pkt(void) {
     // Print:
-    rt_printf("%d (CRT_TLM_PKT_TASK) Task started\n",time(NULL));
+    rt_printf("%d (CRT_TLM_PKT_TASK) Task started\n",get_tm_sec());
 
     // Task synchronize with filter table task:
     // (wait for task to be ready to receive transfer frames)
     rt_printf("%d (CRT_TLM_PKT_TASK) Waiting for filter table task to be"
-        " ready \n",time(NULL));
+        " ready \n",get_tm_sec());
 
     // Wait for signal:
     rt_sem_p(&flt_tbl_sem,TM_INFINITE);
 
     // Print:
     rt_printf("%d (CRT_TLM_PKT_TASK) Filter table task is ready;"
-        " continuing \n",time(NULL));
+        " continuing \n",get_tm_sec());
     
     // Definitions and initializations:
     uint8_t i;
@@ -127,9 +128,8 @@ void crt_tlm_pkt(void) {
     int16_t  ret_val;   // Function return value
     uint16_t copy_size; // Buffer copy size
 
-    uint16_t tlm_pkt_xfr_frm_apid;        // Source data origin
-    uint8_t  tlm_pkt_xfr_frm_grp_flg;     // Packet sequence grouping flag
-    uint16_t tlm_pkt_xfr_frm_seq_cnt = 0; // Packet sequence count
+    uint16_t tlm_pkt_xfr_frm_apid;    // Source data origin
+    uint8_t  tlm_pkt_xfr_frm_grp_flg; // Packet sequence grouping flag
 
     uint16_t num_tlm_pkt_xfr_frm_req; // Required number of tranfer frames
 
@@ -153,7 +153,7 @@ void crt_tlm_pkt(void) {
     // Task synchronize with read USB tasks:
     // (tell tasks that it is now ready to receive source data)
     rt_printf("%d (CRT_TLM_PKT_TASK) Ready to receive source data"
-        "\n",time(NULL));
+        "\n",get_tm_sec());
 
     // Signal:
     for (i = 0; i < 3; ++i) {
@@ -183,7 +183,7 @@ void crt_tlm_pkt(void) {
                 if (ret_val == HK_TLM_SIZE) {
                     // Print
                     rt_printf("%d (CRT_TLM_PKT_TASK) Received housekeeping"
-                        " telemetry\n",time(NULL));
+                        " telemetry\n",get_tm_sec());
 
                     // Set tlm_pkt_xfr_frm_apid:
                     tlm_pkt_xfr_frm_apid = APID_SW;
@@ -198,12 +198,12 @@ void crt_tlm_pkt(void) {
                     // Print
                     rt_printf("%d (CRT_TLM_PKT_TASK) Timed out waiting for"
                         " housekeeping telemetry; checking magnetometer"
-                        " DAQ\n",time(NULL));
+                        " DAQ\n",get_tm_sec());
                 // Error:
                 } else {
                     // Print
                     rt_printf("%d (CRT_TLM_PKT_TASK) Error receiving"
-                        " housekeeping telemetry\n",time(NULL));
+                        " housekeeping telemetry\n",get_tm_sec());
                     // NEED ERROR HANDLING                                          
                 }
             }
@@ -225,7 +225,7 @@ void crt_tlm_pkt(void) {
                     if (ret_val == DAQ_SRC_DAT_SIZE) {
                         // Print
                         rt_printf("%d (CRT_TLM_PKT_TASK) Received magnetometer"
-                            " DAQ source data \n",time(NULL));
+                            " DAQ source data \n",get_tm_sec());
 
                         // Set tlm_pkt_xfr_frm_apid:
                         tlm_pkt_xfr_frm_apid = APID_MDQ;
@@ -240,12 +240,12 @@ void crt_tlm_pkt(void) {
                         // Print
                         rt_printf("%d (CRT_TLM_PKT_TASK) Timed out waiting for"
                             " magnetometer DAQ source data; checking"
-                            " imaging\n",time(NULL));
+                            " imaging\n",get_tm_sec());
                     // Error:
                     } else {
                         // Print
                         rt_printf("%d (CRT_TLM_PKT_TASK) Error receiving"
-                            " magnetometer DAQ source data\n",time(NULL));
+                            " magnetometer DAQ source data\n",get_tm_sec());
                         // NEED ERROR HANDLING                                          
                     }
                 }
@@ -262,7 +262,7 @@ void crt_tlm_pkt(void) {
                 if (ret_val == IMG_SRC_DAT_SIZE) {
                     // Print
                     rt_printf("%d (CRT_TLM_PKT_TASK) Received imaging source" 
-                        " data\n",time(NULL));
+                        " data\n",get_tm_sec());
 
                     // Set tlm_pkt_xfr_frm_apid:
                     tlm_pkt_xfr_frm_apid = APID_IMG;
@@ -279,7 +279,7 @@ void crt_tlm_pkt(void) {
                     // Print
                     rt_printf("%d (CRT_TLM_PKT_TASK) Timed out waiting for"
                         " imaging source data; checking housekeeping"
-                        " telemetry\n",time(NULL));
+                        " telemetry\n",get_tm_sec());
 
                     // Set flags:
                     skip_hk_tlm_flg = 0;  // Don't skip checking magnetometer
@@ -292,7 +292,7 @@ void crt_tlm_pkt(void) {
                 } else {
                     // Print
                     rt_printf("%d (CRT_TLM_PKT_TASK) Error receiving imaging"
-                        " source data\n",time(NULL));
+                        " source data\n",get_tm_sec());
                     // NEED ERROR HANDLING
                 }
             }
@@ -300,27 +300,18 @@ void crt_tlm_pkt(void) {
 
         // Print:
         rt_printf("%d (CRT_TLM_PKT_TASK) Creating telemetry packet transfer"
-        " frame(s)\n",time(NULL));
+        " frame(s)\n",get_tm_sec());
 
         // Create transfer frames depending on which source data was just
         // received:
         if (tlm_pkt_xfr_frm_apid == APID_SW) {
-            // Increment sequence count:
-            tlm_pkt_xfr_frm_seq_cnt++;
-
-            // Force counter roll over at 16383:
-            // (the field in the packet that sequence occupies is only 14 bits)
-            if (tlm_pkt_xfr_frm_seq_cnt == 16383) {
-                tlm_pkt_xfr_frm_seq_cnt = 1; // 1 because it's logical (0 ain't)
-            }
-
             // Set grouping flag:
             tlm_pkt_xfr_frm_grp_flg = 3; // Unsegmented data
 
             // Create transfer frame:
             crt_tlm_pkt_xfr_frm(hk_tlm_buf,HK_TLM_SIZE,\
                 tlm_pkt_xfr_frm_buf,tlm_pkt_xfr_frm_apid,\
-                tlm_pkt_xfr_frm_grp_flg,tlm_pkt_xfr_frm_seq_cnt);
+                tlm_pkt_xfr_frm_grp_flg);
 
             // Send transfer frame to filter table task via message queue:
             ret_val = rt_queue_write(&flt_tbl_msg_queue,&tlm_pkt_xfr_frm_buf,\
@@ -330,30 +321,21 @@ void crt_tlm_pkt(void) {
             if ((ret_val > 0) || (ret_val == 0)) {
                 // Print:
                 rt_printf("%d (CRT_TLM_PKT_TASK) Telemetry packet transfer"
-                    " frame sent to filter table task\n",time(NULL));
+                    " frame sent to filter table task\n",get_tm_sec());
             } else {
                 // Print:
                 rt_printf("%d (CRT_TLM_PKT_TASK) Error sending telemetry"
-                    " packet transfer frame\n",time(NULL));
+                    " packet transfer frame\n",get_tm_sec());
                 // NEED ERROR HANDLING
             }
         } else if (tlm_pkt_xfr_frm_apid == APID_MDQ) {
-            // Increment sequence count:
-            tlm_pkt_xfr_frm_seq_cnt++;
-
-            // Force counter roll over at 16383:
-            // (the field in the packet that sequence occupies is only 14 bits)
-            if (tlm_pkt_xfr_frm_seq_cnt == 16383) {
-                tlm_pkt_xfr_frm_seq_cnt = 1; // 1 because it's logical (0 ain't)
-            }
-
             // Set grouping flag:
             tlm_pkt_xfr_frm_grp_flg = 3; // Unsegmented data
 
             // Create transfer frame:
             crt_tlm_pkt_xfr_frm(daq_src_dat_buf,DAQ_SRC_DAT_SIZE,\
                 tlm_pkt_xfr_frm_buf,tlm_pkt_xfr_frm_apid,\
-                tlm_pkt_xfr_frm_grp_flg,tlm_pkt_xfr_frm_seq_cnt);
+                tlm_pkt_xfr_frm_grp_flg);
 
             // Send transfer frame to filter table task via message queue:
             ret_val = rt_queue_write(&flt_tbl_msg_queue,&tlm_pkt_xfr_frm_buf,\
@@ -363,11 +345,11 @@ void crt_tlm_pkt(void) {
             if ((ret_val > 0) || (ret_val == 0)) {
                 // Print:
                 rt_printf("%d (CRT_TLM_PKT_TASK) Telemetry packet transfer"
-                    " frame sent to filter table task\n",time(NULL));
+                    " frame sent to filter table task\n",get_tm_sec());
             } else {
                 // Print:
                 rt_printf("%d (CRT_TLM_PKT_TASK) Error sending telemetry"
-                    " packet transfer frame\n",time(NULL));
+                    " packet transfer frame\n",get_tm_sec());
                 // NEED ERROR HANDLING
             } 
         } else if (tlm_pkt_xfr_frm_apid == APID_IMG) {
@@ -377,17 +359,6 @@ void crt_tlm_pkt(void) {
 
             // Loop to create required number of transfer frames:
             for (i = 0; i < num_tlm_pkt_xfr_frm_req; ++i) {
-                // Increment sequence count:
-                tlm_pkt_xfr_frm_seq_cnt++;
-
-                // Force counter roll over at 16383:
-                // (the field in the packet that sequence occupies is only
-                // 14 bits)
-                if (tlm_pkt_xfr_frm_seq_cnt == 16383) {
-                    tlm_pkt_xfr_frm_seq_cnt = 1; // 1 because it's logical
-                                                 // (0 ain't)
-                }
-
                 // Set grouping flag based off iteration:
                 if (i == 0) {
                     // Set grouping flag:
@@ -417,7 +388,7 @@ void crt_tlm_pkt(void) {
                 // Create transfer frame:
                 crt_tlm_pkt_xfr_frm(tmp_buffer,copy_size,\
                     tlm_pkt_xfr_frm_buf,tlm_pkt_xfr_frm_apid,\
-                    tlm_pkt_xfr_frm_grp_flg,tlm_pkt_xfr_frm_seq_cnt);
+                    tlm_pkt_xfr_frm_grp_flg);
 
                 // Send transfer frame to filter table task via message queue:
                 ret_val = rt_queue_write(&flt_tbl_msg_queue,\
@@ -428,18 +399,18 @@ void crt_tlm_pkt(void) {
                 if ((ret_val > 0) || (ret_val == 0)) {
                     // Print:
                     rt_printf("%d (CRT_TLM_PKT_TASK) Telemetry packet transfer"
-                        " frame sent to filter table task\n",time(NULL));
+                        " frame sent to filter table task\n",get_tm_sec());
                 } else {
                     // Print:
                     rt_printf("%d (CRT_TLM_PKT_TASK) Error sending telemetry"
-                        " packet transfer frame\n",time(NULL));
+                        " packet transfer frame\n",get_tm_sec());
                     // NEED ERROR HANDLING
                 }
             }
 
             // Print:
             rt_printf("%d (CRT_TLM_PKT_TASK) All %d telemetry packet transfer"
-                    " frame sent to filter table task\n",time(NULL),\
+                    " frame sent to filter table task\n",get_tm_sec(),\
                     num_tlm_pkt_xfr_frm_req);
         }
 
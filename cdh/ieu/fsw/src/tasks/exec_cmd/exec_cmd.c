@@ -15,15 +15,16 @@
 //
 // When a command transfer frame is received from the message queue, the ATC
 // flag is checked to determine if command is to be executed now or is
-// absolutely timed. If ATC flag = 1, then the command is executed
-// now (following a sanity check on the command execution time). If ATC
-// flag = 0, them the command transfer frame is sent to the command scheduler.
+// absolutely timed. If ATC flag = 0, then the command is executed
+// now. If ATC flag = 1 (schedule) or 2 (cancel), then the command transfer
+// frame is sent to the command scheduler via synchronous messaging; the
+// scheduler sends the command back with ATC flag = 0 at its execution time.
 //
-// Commands to execute now are directed to command application tasks. The 
-// command's APID is compared against known destination APIDs. When the
-// command's APID is associated with the destination, the command transfer
-// frame is sent to the respective command application task via synchronous
-// messaging.
+// Commands to execute now are directed to command application tasks by
+// send_cmd (shared with the run sequence task). The command's APID is
+// compared against known destination APIDs. When the command's APID is
+// associated with the destination, the command transfer frame is sent to
+// the respective command application task via synchronous messaging.
 //
 // Before addressing another command frame, a response from the command
 // application is required indicating whether the command was
@@ -68,6 +69,8 @@
 #include <msg_queues.h> // Message queue variable declarations
 #include <sems.h>       // Semaphore variable declarations
 #include <hk_tlm_var.h> // Housekeeping telemetry variable declarations
+#include <tm_svc.h>     // Time service declarations
+#include <send_cmd.h>   // Send command declarations
 
 // Macro definitions:
 #define CMD_XFR_FRM_SIZE 15 // Command transfer frame size in bytes
@@ -78,14 +81,8 @@
                      // is absolutely timed (true)
 #define ATC_FLG_F  0 // ATC flag value indicating that the command
                      // is to execute now (false)
-
-#define DEST_APID_SW  0x00 // Software destination APID
-#define DEST_APID_IMG 0x64 // Image destination APID
-#define DEST_APID_MDQ 0xC8 // Magnetometer DAQ destination APID
-#define DEST_APID_ERS 0x12C // Electrical Relay Switch destination APID
-
-// Task definitions:
-RT_TASK dest_task; // Destination task of command (only local)
+#define ATC_FLG_D  2 // ATC flag value indicating that the scheduled
+                     // command is cancelled (delete)
 
 // Message queue definitions:
 RT_QUEUE cmd_xfr_frm_msg_queue; // For command transfer frames
@@ -110,24 +107,24 @@ uint8_t cmd_exec_err_cnt = 0; // Commands not executed (error) counter
 
 void exec_cmd(void* arg) {
     // Print:
-    rt_printf("%d (EXEC_CMD_TASK) Task started\n",time(NULL));
+    rt_printf("%d (EXEC_CMD_TASK) Task started\n",get_tm_sec());
 
     // Task synchronize with command scheduler:
     // (wait for task to be ready to receive and processs frames)
     rt_printf("%d (EXEC_CMD_TASK) Waiting for command scheduler task"
-        " to be ready\n",time(NULL));
+        " to be ready\n",get_tm_sec());
 
     // Wait for signals:
     rt_sem_p(&cmd_sched_sem,TM_INFINITE);
 
     // Print:
     rt_printf("%d (EXEC_CMD_TASK) Command scheduler task is" 
-        " ready; continuing\n",time(NULL));
+        " ready; continuing\n",get_tm_sec());
 
     // Task synchronize with command application tasks:
     // (wait for tasks to be ready to receive and process frames)
     rt_printf("%d (EXEC_CMD_TASK) Waiting for command application tasks"
-        " to be ready\n",time(NULL));
+        " to be ready\n",get_tm_sec());
 
     // Wait for signals:
     rt_sem_p(&cmd_sw_sem,TM_INFINITE);  // Command software
@@ -137,13 +134,12 @@ void exec_cmd(void* arg) {
 
     // Print:
     rt_printf("%d (EXEC_CMD_TASK) Command application tasks are" 
-        " ready; continuing\n",time(NULL));
+        " ready; continuing\n",get_tm_sec());
 
     // Definitions and initializations:
     int8_t ret_val; // Function return value
 
-    uint8_t cmd_exec_stat;    // Command execution status flag
-    uint8_t val_apid_flg = 1; // Valid command APID flag
+    uint8_t cmd_exec_stat; // Command schedule status flag
 
     char cmd_xfr_frm_buf[CMD_XFR_FRM_SIZE]; // Buffer for command transfer
                                             // frame
@@ -172,7 +168,7 @@ void exec_cmd(void* arg) {
     // Task synchronize with proc_telecmd_pkt task
     // (tell task that it is now ready to receive frames)
     rt_printf("%d (EXEC_CMD_TASK) Ready to receive command transfer"
-        " frames\n",time(NULL));
+        " frames\n",get_tm_sec());
 
     // Signal task to continue executing:
     rt_sem_v(&proc_telecmd_pkt_sem);
@@ -193,11 +189,11 @@ void exec_cmd(void* arg) {
         if (ret_val == CMD_XFR_FRM_SIZE) {
             // Print
             rt_printf("%d (EXEC_CMD_TASK) Received command transfer"
-                " frame\n",time(NULL));
+                " frame\n",get_tm_sec());
         } else {
             // Print
             rt_printf("%d (EXEC_CMD_TASK) Error receiving command transfer"
-                " frame\n",time(NULL));
+                " frame\n",get_tm_sec());
             // NEED ERROR HANDLING
         }
 
@@ -211,7 +207,7 @@ void exec_cmd(void* arg) {
 
         // Print:
         rt_printf("%d (EXEC_CMD_TASK) Checking command execution"
-            " time...\n",time(NULL));
+            " time...\n",get_tm_sec());
 
         // Check for ATC flag. If ATC flag = 0, then execute the command now.
         // If ATC flag = 1, then send command transfer frame to the command
@@ -219,128 +215,73 @@ void exec_cmd(void* arg) {
         if (cmd_atc_flg == ATC_FLG_F) {
             // Print:
             rt_printf("%d (EXEC_CMD_TASK) Command will execute"
-                " NOW\n",time(NULL));
+                " NOW\n",get_tm_sec());
 
-            // Switch to direct command to final destination by matching
-            // the command's APID to a destination's APID:
-            switch(cmd_apid) {
-                // Software
-                case DEST_APID_SW :
-                    // Print:
-                    rt_printf("%d (EXEC_CMD_TASK) Command APID is valid;"
-                        " command transfer frame directed to command software"
-                        " task\n",time(NULL));
-
-                    // Set destination task:
-                    dest_task = cmd_sw_task; // Command software task
-
-                    // Exit switch:
-                    break;
-                // Imaging:
-                case DEST_APID_IMG :
-                    rt_printf("%d (EXEC_CMD_TASK) Command APID is valid;"
-                        " command transfer frame directed to command imaging"
-                        " task\n",time(NULL));
-
-                    // Set destination task:
-                    dest_task = cmd_img_task; // Command imaging task
-
-                    // Exit switch:
-                    break;
-                // Magnetometer DAQ:
-                case DEST_APID_MDQ :
-                    rt_printf("%d (EXEC_CMD_TASK) Command APID is valid;"
-                        " command transfer frame directed to command"
-                        " magnetometer task\n",time(NULL));
-
-                    // Set destination task:
-                    dest_task = cmd_mdq_task; // Command magnetometer DAQ task
-
-                    // Exit switch:
-                    break;
-                // Electrical power relay:
-                case DEST_APID_ERS :
-                    rt_printf("%d (EXEC_CMD_TASK) Command APID is valid;"
-                        " command transfer frame directed to command"
-                        " electrical relay task\n",time(NULL));
-
-                    // Set destination task:
-                    dest_task = cmd_ers_task; // Command electrical power relay task
-
-                    // Exit switch:
-                    break;
-                // If command APID does not match:
-                default :
-                    // Print:
-                    rt_printf("%d (EXEC_CMD_TASK) Command APID is invalid;" 
-                        " command transfer frame ignored\n",\
-                        time(NULL));
+            // Send command transfer frame to its command application task
+            // and wait for command execution status:
+            ret_val = send_cmd(cmd_xfr_frm_buf);
 
-                    // Set valid APID flag to false:
-                    val_apid_flg = 0;
-            }
-            
             // Check for valid APID (command APID matches known destinations):
-            if (val_apid_flg == 1) {
+            if (ret_val >= 0) {
                 // Increase counter:
                 ++val_cmd_cnt;
 
-                // Send command transfer frame to final destination via
-                // synchronous message passing. Final destination is command
-                // application task. Reply required from destination task for
-                // command execution status:
-                ret_val = rt_task_send(&dest_task,&cmd_xfr_frm_mcb,\
-                    &rply_mcb,TM_INFINITE);
-
-                if (ret_val > 0) {
-                    // Print:
-                    rt_printf("%d (EXEC_CMD_TASK) Reply message received"
-                        " from command application task\n",time(NULL));
-                } else { 
-                    // Print:
-                    rt_printf("%d (EXEC_CMD_TASK) Error sending command"
-                        " transfer frame to command application\n",time(NULL));
-                    // NEED ERROR HANDLING
-                }
-
                 // Check command execution status:
-                if (cmd_exec_stat == 1) {
+                if (ret_val == 1) {
                     // Print:
                     rt_printf("%d (EXEC_CMD_TASK) Command executed" 
-                        " successfully\n",time(NULL));
+                        " successfully\n",get_tm_sec());
 
                     // Increment counter:
                     ++cmd_exec_suc_cnt;
-                } else if (cmd_exec_stat == 0) {
+                } else if (ret_val == 0) {
                     // Print:
                     rt_printf("%d (EXEC_CMD_TASK) Command did not"
-                        " execute\n",time(NULL));
+                        " execute\n",get_tm_sec());
 
                     // Increment counter:
                     ++cmd_exec_err_cnt;
                 } else {
                     // Print:
                     rt_printf("%d (EXEC_CMD_TASK) Command execution status"
-                    " is unkown\n",time(NULL));
+                        " unknown; counted by command application\n",\
+                        get_tm_sec());
                 }
             // Invalid command APID:
             } else {
                 // Increase counter:
                 ++inv_cmd_cnt;
-
-                // Set valid APID flag to true:
-                val_apid_flg = 1;
             }
-        // Absolutely timed command:
-        } else if (cmd_atc_flg == ATC_FLG_T) {
+        // Absolutely timed command (schedule or cancel):
+        } else if ((cmd_atc_flg == ATC_FLG_T) || (cmd_atc_flg == ATC_FLG_D)) {
             // Print:
             rt_printf("%d (EXEC_CMD_TASK) Command is absolutely"
-                " timed; sending command to command scheduler\n",time(NULL));
+                " timed; sending command to command scheduler\n",get_tm_sec());
+
+            // Send command transfer frame to command scheduler via
+            // synchronous message passing. Reply required from scheduler for
+            // command schedule status:
+            ret_val = rt_task_send(&sched_cmd_task,&cmd_xfr_frm_mcb,\
+                &rply_mcb,TM_INFINITE);
+
+            // Check schedule status:
+            if ((ret_val > 0) && (cmd_exec_stat == 1)) {
+                // Print:
+                rt_printf("%d (EXEC_CMD_TASK) Command schedule"
+                    " changed\n",get_tm_sec());
+            } else {
+                // Print:
+                rt_printf("%d (EXEC_CMD_TASK) Command schedule not"
+                    " changed\n",get_tm_sec());
+
+                // Increase counter:
+                ++inv_cmd_cnt;
+            }
         // Unrecognized ATC flag:
         } else {
             // Print:
             rt_printf("%d (EXEC_CMD_TASK) Invalid absolutely timed command" 
-                " flag; ignoring command transfer frame\n",time(NULL));
+                " flag; ignoring command transfer frame\n",get_tm_sec());
         }
 
     }
@@ -4,7 +4,14 @@
 //
 // Task responsible for directing telemetry transfer frames for either downlink
 // or storage for later downlink. Transfer frames are received via message
-// queue from read_usb tasks, get_hk_tlm task, or retrieve file task. 
+// queue from aggregate telemetry task (housekeeping and magnetometer DAQ
+// samples packed into frames) or read_img task. 
+//
+// Transfer frames live in the telemetry frame pool (tlm_frm_pool.h); only
+// frame handles pass through the message queues. A frame directed to both
+// downlink and storage gets an additional reference so each consumer can
+// release it independently. A frame directed nowhere is released here.
+//
 // Telemetry packet transfer frames are fixed length and consist of
 //     - Packet Identification
 //       - APID (origin)
@@ -37,6 +44,23 @@
 // itself) to find the column indicies to read to get range and frequency
 // values. This would be flt_tbl_mode*2+1 and flt_tbl_mode*2+2.
 //
+// Whenever the mode or the filter table definition changes (in-flight
+// upload, ld_flt_tbl.h), the tables are compiled into a dense per-APID
+// routing descriptor table (rte_tlm.h), so directing a frame is a single
+// lookup giving a destination bitmask. Each set bit is one consumer; the
+// frame gets one reference per consumer.
+//
+// Frames directed to downlink then pass the downlink scheduler (flt_tbl.h):
+// per-class token buckets refilled from the downlink byte rate in strict
+// priority order (HK, MDQ, IMG). A payload over its class budget is diverted
+// to recording, so image bursts cannot starve housekeeping or overrun the
+// transmit telemetry packet message queue. While recorded telemetry is played
+// back, its share of the link rate (pbk_rec_tlm.h) is taken out of the bytes
+// given to the buckets. The decision is made on the first segment of a
+// payload and applied to the rest of it, so a payload is either downlinked or
+// recorded whole. Diverted frames are counted per class in
+// housekeeping telemetry.
+//
 // The "Normal" filter table mode is set as the default when the filter table
 // task is started. This mode however can be changed by the command software
 // task.
@@ -76,25 +100,26 @@
 #include <alchemy/timer.h> // Timer management services
 
 // Header files:
-#include <msg_queues.h> // Message queue variable declarations
-#include <sems.h>       // Semaphore variable declarations
-#include <hk_tlm_var.h> // Housekeeping telemetry variable declarations
-#include <flt_tbl.h>    // Filter table (TD & DS) declarations
-
-// Macro definitions:
-#define TLM_PKT_XFR_FRM_SIZE 1089 // Telemetry transfer frame size in bytes
-
-#define APID_SW  0x00 // Software origin
-#define APID_IMG 0x64 // Image origin
-#define APID_MDQ 0xC8 // Magnetometer DAQ origin
+#include <ccsds_pkt.h>    // CCSDS packet codec
+#include <ccsds_asm.h>    // CCSDS attached sync marker
+#include <msg_queues.h>   // Message queue variable declarations
+#include <sems.h>         // Semaphore variable declarations
+#include <hk_tlm_var.h>   // Housekeeping telemetry variable declarations
+#include <flt_tbl.h>      // Filter table (TD & DS) declarations
+#include <ld_flt_tbl.h>   // Load filter table declarations
+#include <tlm_frm_pool.h> // Telemetry frame pool declarations
+#include <rte_tlm.h>      // Route telemetry declarations
+#include <flw_ctl.h>      // Flow control declarations
+#include <pbk_rec_tlm.h>  // Play back recorded telemetry declarations
+#include <tm_svc.h>       // Time service declarations
 
 // Message queue definitions:
-RT_QUEUE flt_tbl_msg_queue;     // For telemetry packet transfer frames
-                                // (read_mdq/img/get_hk_tlm --> flt_tbl_task)
-RT_QUEUE tx_tlm_pkt_msg_queue;  // For telemetry packets
+RT_QUEUE flt_tbl_msg_queue;     // For telemetry frame handles
+                                // (agg_tlm/read_img --> flt_tbl_task)
+RT_QUEUE tx_tlm_pkt_msg_queue;  // For telemetry frame handles
                                 // (flt_tbl_task/rtrv_file_task
                                 // --> tx_tlm_pkt_task)
-RT_QUEUE crt_file_msg_queue;    // For telemetry packet transfer frames
+RT_QUEUE crt_file_msg_queue;    // For telemetry frame handles
                                 // (flt_tbl_task --> crt_file_task)
 
 // Semaphore definitions:
@@ -107,262 +132,345 @@ RT_SEM crt_file_sem;    // For crt_file_task and flt_tbl_task synchronization
 // Global variable definitions:
 uint8_t flt_tbl_mode = 1;  // Filter table mode (set to normal by default)
 
-uint16_t flt_tbl_to[FLT_TBL_ROW][FLT_TBL_COL]; // Telemetry output table
-uint16_t flt_tbl_ds[FLT_TBL_ROW][FLT_TBL_COL]; // Data storage outtput table
+// Flow controlled message queue of each destination:
+static struct flw_ctl* flt_tbl_dst_fc[FLT_TBL_NDST] = {
+    &flw_ctl_tbl[FLW_CTL_TX_TLM_PKT],&flw_ctl_tbl[FLW_CTL_CRT_FILE]
+};
+
+// Consumer task of each destination (for printing):
+static const char* flt_tbl_dst_name[FLT_TBL_NDST] = {
+    "transmit telemetry packet","create file"
+};
+
+// Routing descriptors of current filter table mode:
+static struct rte_tlm_dsc flt_tbl_rte[RTE_TLM_NAPID];
+
+// Downlink class token bucket structure:
+struct flt_tbl_dl_bkt {
+    int32_t  tkn;   // Tokens in bytes (negative: debt of a payload
+                    // downlinked past the budget)
+    uint32_t depth; // Depth in bytes
+    uint16_t pct;   // Share of link rate in percent
+};
+
+// Downlink scheduler state:
+static struct flt_tbl_dl_bkt flt_tbl_dl_bkt[FLT_TBL_DL_NCLS]; // Buckets
+static uint8_t  flt_tbl_dl_cls_idx[RTE_TLM_NAPID]; // Class of each APID
+static RTIME    flt_tbl_dl_tm_prev;                // Last refill time
+static uint64_t flt_tbl_dl_rem;                    // Refill remainder
+                                                   // (bytes*ns/sec)
+static uint8_t  flt_tbl_dl_dvrt[RTE_TLM_NAPID];    // Payload in progress
+                                                   // diverted flag of each
+                                                   // APID
+
+// Initialize downlink scheduler (full buckets)
+static void init_flt_tbl_dl() {
+    // Definitions and initializations:
+    uint16_t i;
+
+    // Set class of every APID to last (lowest priority) class:
+    memset(flt_tbl_dl_cls_idx,FLT_TBL_DL_NCLS-1,sizeof(flt_tbl_dl_cls_idx));
+
+    // Set class table rows:
+    for (i = 0; i < FLT_TBL_DL_NCLS; ++i) {
+        flt_tbl_dl_cls_idx[flt_tbl_dl_cls[i][0] & CCSDS_APID_MASK] = i;
+
+        flt_tbl_dl_bkt[i].pct   = flt_tbl_dl_cls[i][1];
+        flt_tbl_dl_bkt[i].depth = flt_tbl_dl_cls[i][2]*CCSDS_TLM_PKT_MAX;
+        flt_tbl_dl_bkt[i].tkn   = flt_tbl_dl_bkt[i].depth;
+    }
+
+    flt_tbl_dl_tm_prev = rt_timer_read();
+    flt_tbl_dl_rem = 0;
+}
+
+// Refill downlink class buckets from link byte rate in priority order
+static void fill_flt_tbl_dl() {
+    // Definitions and initializations:
+    uint8_t  i;
+    uint32_t byte_cnt; // Link bytes since last refill
+    uint32_t byte_avl; // Link bytes not yet given to a class
+    uint32_t byte_cls; // Bytes given to class
+
+    RTIME tm_now = rt_timer_read(); // Current time
+    RTIME tm_dlt;                   // Time since last refill (ns)
+
+    // Get time since last refill (at most one second; buckets hold less):
+    tm_dlt = rt_timer_ticks2ns(tm_now - flt_tbl_dl_tm_prev);
+    if (tm_dlt > 1000000000) {
+        tm_dlt = 1000000000;
+        flt_tbl_dl_rem = 0;
+    }
+    flt_tbl_dl_tm_prev = tm_now;
+
+    // Get link bytes (keep remainder for next refill):
+    flt_tbl_dl_rem += (uint64_t) tm_dlt*FLT_TBL_DL_BYTE_RATE;
+    byte_cnt = flt_tbl_dl_rem/1000000000;
+    flt_tbl_dl_rem -= (uint64_t) byte_cnt*1000000000;
+
+    // Leave playback share of link to playback in progress:
+    byte_cnt -= (uint64_t) byte_cnt*get_pbk_rec_tlm_act_pct()/100;
+
+    // Give bytes to classes in priority order:
+    byte_avl = byte_cnt;
+    for (i = 0; (i < FLT_TBL_DL_NCLS) && (byte_avl > 0); ++i) {
+        byte_cls = byte_cnt*flt_tbl_dl_bkt[i].pct/100;
+        if (byte_cls > byte_avl) {
+            byte_cls = byte_avl;
+        }
+        if (byte_cls > (int64_t) flt_tbl_dl_bkt[i].depth - \
+            flt_tbl_dl_bkt[i].tkn) {
+            byte_cls = (int64_t) flt_tbl_dl_bkt[i].depth - \
+                flt_tbl_dl_bkt[i].tkn;
+        }
+
+        flt_tbl_dl_bkt[i].tkn += byte_cls;
+        byte_avl -= byte_cls;
+    }
+}
+
+// Charge packet to downlink class bucket (returns 0 if payload is diverted)
+static uint8_t chrg_flt_tbl_dl(uint16_t apid, uint16_t pkt_size,
+    uint8_t grp_flg) {
+    // Definitions and initializations:
+    uint16_t idx = apid & CCSDS_APID_MASK;   // APID index
+    uint8_t  cls = flt_tbl_dl_cls_idx[idx]; // Class
+
+    // Check budget on first segment (or unsegmented payload) only; the rest
+    // of the payload follows its first segment:
+    if ((grp_flg == 1) || (grp_flg == 3)) {
+        flt_tbl_dl_dvrt[idx] = (flt_tbl_dl_bkt[cls].tkn < pkt_size);
+    }
+    if (flt_tbl_dl_dvrt[idx]) {
+        // Count diverted frame:
+        dl_dvrt_cnt[cls]++;
+
+        return 0;
+    }
+
+    flt_tbl_dl_bkt[cls].tkn -= pkt_size;
+
+    return 1;
+}
 
 void flt_tbl(void* arg) {
     // Print:
-    rt_printf("%d (FLT_TBL_TASK) Task started\n",time(NULL));
+    rt_printf("%d (FLT_TBL_TASK) Task started\n",get_tm_sec());
 
     // Task synchronize with transmit telemetry packet task:
     // (wait for task to be ready to receive telemetry packets)
     rt_printf("%d (FLT_TBL_TASK) Waiting for transmit telemetry packet"
-        " task to be ready \n",time(NULL));
+        " task to be ready \n",get_tm_sec());
 
     // Wait for signal:
     rt_sem_p(&tx_tlm_pkt_sem,TM_INFINITE);
 
     // Print:
     rt_printf("%d (FLT_TBL_TASK) Transmit telemetry packet task is ready;"
-        " continuing\n",time(NULL));
+        " continuing\n",get_tm_sec());
 
     // Task synchronize with crt_file task:
     // (wait for task to be ready to receive telemetry packets)
     rt_printf("%d (FLT_TBL_TASK) Waiting for create file"
-        " task to be ready \n",time(NULL));
+        " task to be ready \n",get_tm_sec());
 
     // Wait for signal:
     rt_sem_p(&crt_file_sem,TM_INFINITE);
 
     // Print:
     rt_printf("%d (FLT_TBL_TASK) Create file task is ready continuing\n",\
-        time(NULL));  
+        get_tm_sec());  
 
     // Definitions and initializations:
     uint8_t i;
     int16_t ret_val = 0; // Function return value
 
-    uint8_t dl_tlm_pkt_flg;   // Downlink telemetry packet flag
-    uint8_t rcrd_tlm_pkt_flg; // Record telemetry packet flag
+    uint8_t dst;     // Destination
+    uint8_t dst_msk; // Destination bitmask of transfer frame
 
     uint16_t tlm_pkt_xfr_frm_apid; // Telemetry packet transfer frame origin
 
-    char tlm_pkt_xfr_frm_buf[TLM_PKT_XFR_FRM_SIZE]; // Buffer for telemetry
-                                                    // packet transfer frame
-                                                    // buffer
+    tlm_frm_hdl_t tlm_frm_hdl; // Telemetry frame handle (frame pool)
+
+    tlm_frm_hdl_t tlm_frm_hdl_blk[TLM_FRM_SEG_NFRM]; // Block of frame handles
+    uint16_t tlm_frm_hdl_blk_cnt = 0; // Number of handles in block
+    uint16_t tlm_frm_hdl_blk_idx = 0; // Next handle in block
+
+    uint16_t tlm_pkt_size; // Telemetry packet size in bytes
+
+    struct ccsds_pri_hdr pri_hdr; // Telemetry packet primary header
 
     uint8_t flt_tbl_mode_prev = 255; // Previous filter table mode (set to 255
-                                     // to force initialization of xfr frame
-                                     // counts)
+                                     // to force compiling of routing
+                                     // descriptors)
 
-    uint8_t flt_tbl_row; // Filter table row
+    const struct flt_tbl_def* flt_tbl_def; // Filter table definition
 
-    uint8_t flt_tbl_to_rng;  // Filter table TO range
-    uint8_t flt_tbl_to_freq; // Filter table TO frequency
-    uint8_t flt_tbl_ds_rng;  // Filter table DS range
-    uint8_t flt_tbl_ds_freq; // Filter table DS frequency
+    uint32_t flt_tbl_def_gen;          // Definition generation
+    uint32_t flt_tbl_def_gen_prev = 0; // Definition generation compiled from
+                                       // (0 is never published)
 
-    uint8_t flt_tbl_xfr_frm_cnt_to[FLT_TBL_ROW]; // Current transfer frame
-                                                 // count for TO filter table
-    uint8_t flt_tbl_xfr_frm_cnt_ds[FLT_TBL_ROW]; // Current transfer frame
-                                                 // count for DS filter table
+    const uint16_t* flt_tbl_dst_tbl[FLT_TBL_NDST]; // Filter table of each
+                                                   // destination
 
-    // Task synchronize with read_usb and get_hk_tlm tasks:
+    // Initialize downlink scheduler:
+    init_flt_tbl_dl();
+
+    // Task synchronize with agg_tlm, read_mdq/img, and get_hk_tlm tasks:
     // (tell task that it is now ready to receive telemetry packet transfer
     // frames)
     rt_printf("%d (FLT_TBL_TASK) Filter table task ready to receive telemetry"
-        " packet transfer frames\n",time(NULL));
+        " packet transfer frames\n",get_tm_sec());
     
     // Signal:
-    for (i = 0; i < 3; ++i)
+    for (i = 0; i < 4; ++i)
         rt_sem_v(&flt_tbl_sem);
 
     // Infinite loop to receive telemetry packet transfer frames via message
     // queue and direct to either transmit telemetry packet task or create file
     // task:
     while (1) {
-        // Read transfer frame from message queue:
-        ret_val = rt_queue_read(&flt_tbl_msg_queue,\
-            &tlm_pkt_xfr_frm_buf,TLM_PKT_XFR_FRM_SIZE,TM_INFINITE);
-
-        // Check success:
-        if (ret_val == TLM_PKT_XFR_FRM_SIZE) {
-            // Print
-            rt_printf("%d (FLT_TBL_TASK) Received telemetry packet transfer"
-                " frame\n",time(NULL));
-        // Error:
-        } else {
-            // Print
-            rt_printf("%d (FLT_TBL_TASK) Error receiving telemetry packet"
-                " transfer frame\n",time(NULL));
-            // NEED ERROR HANDLING                                          
-        }
-
-        // Get APID from transfer frame:
-        memcpy(&tlm_pkt_xfr_frm_apid,tlm_pkt_xfr_frm_buf+0,2);
-
-        // Determine filter table row depending of transfer frame APID:
-        if (tlm_pkt_xfr_frm_apid == APID_SW) {
-            // Set row:
-            flt_tbl_row = 0;
-        } else if (tlm_pkt_xfr_frm_apid == APID_IMG) {
-            // Set row:
-            flt_tbl_row = 1;
-        } else if (tlm_pkt_xfr_frm_apid == APID_MDQ) {
-            // Set row:FLT_TBL_ROW
-            flt_tbl_row = 2;
-        }
+        // Read next block of frame handles from message queue once the
+        // current block is used up:
+        // (producers send single handles; the segmenter sends blocks)
+        if (tlm_frm_hdl_blk_idx == tlm_frm_hdl_blk_cnt) {
+            // Read block of frame handles from message queue:
+            ret_val = rt_queue_read(&flt_tbl_msg_queue,\
+                tlm_frm_hdl_blk,sizeof(tlm_frm_hdl_blk),TM_INFINITE);
+
+            // Return credit of message read:
+            if (ret_val >= 0) {
+                rtn_flw_ctl(&flw_ctl_tbl[FLW_CTL_FLT_TBL]);
+            }
 
-        // Set range and frequency:
-        flt_tbl_to_rng  = flt_tbl_to[flt_tbl_row][flt_tbl_mode*2+1];
-        flt_tbl_to_freq = flt_tbl_to[flt_tbl_row][flt_tbl_mode*2+2];
-        flt_tbl_ds_rng  = flt_tbl_ds[flt_tbl_row][flt_tbl_mode*2+1];
-        flt_tbl_ds_freq = flt_tbl_ds[flt_tbl_row][flt_tbl_mode*2+2];
-
-        // Check if filter table changed since last transfer frame:
-        if (flt_tbl_mode != flt_tbl_mode_prev) {
-            // Reset transfer frame counts to frequency:
-            // (This ensures that the first transfer frame after a mode change
-            // will either downlinked and/or recorded always if the frequency
-            // is non-zero.)
-            for (i = 0; i < FLT_TBL_ROW; ++i) {
-                // Set to value:
-                flt_tbl_xfr_frm_cnt_to[i] = flt_tbl_to[i][flt_tbl_mode*2+2];
-                flt_tbl_xfr_frm_cnt_ds[i] = flt_tbl_ds[i][flt_tbl_mode*2+2];
+            // Check success:
+            if ((ret_val > 0) && (ret_val % TLM_FRM_HDL_SIZE == 0)) {
+                // Print
+                rt_printf("%d (FLT_TBL_TASK) Received %d telemetry packet"
+                    " transfer frame(s)\n",get_tm_sec(),\
+                    ret_val/TLM_FRM_HDL_SIZE);
+
+                // Set block:
+                tlm_frm_hdl_blk_cnt = ret_val/TLM_FRM_HDL_SIZE;
+                tlm_frm_hdl_blk_idx = 0;
+            // Error:
+            } else {
+                // Print
+                rt_printf("%d (FLT_TBL_TASK) Error receiving telemetry packet"
+                    " transfer frame\n",get_tm_sec());
+
+                // No frame to direct:
+                tlm_frm_hdl_blk_cnt = 0;
+                tlm_frm_hdl_blk_idx = 0;
+                continue;
             }
         }
 
-        // Based on range, frequency, and current count, determine
-        // destination of transfer frame if frequency is non-zero:
-        if (flt_tbl_to_freq != 0) {
-            if (flt_tbl_xfr_frm_cnt_to[flt_tbl_row] == flt_tbl_to_freq) {
-                // Set direction flags:
-                dl_tlm_pkt_flg = 1; // Downlink packet
-
-                // Check for case range = frequency:
-                if (flt_tbl_xfr_frm_cnt_to[flt_tbl_row] != flt_tbl_to_rng) {
-                    // Increment:
-                    flt_tbl_xfr_frm_cnt_to[flt_tbl_row]++;
-                }
-            } else if (flt_tbl_xfr_frm_cnt_to[flt_tbl_row] == flt_tbl_to_rng) {
-                // Reset counter:
-                flt_tbl_xfr_frm_cnt_to[flt_tbl_row] = flt_tbl_to_freq;
-
-                // Set direction flags:
-                dl_tlm_pkt_flg = 0; // Do not downlink
-            } else {
-                // Increment:
-                flt_tbl_xfr_frm_cnt_to[flt_tbl_row]++;
+        // Check if filter table mode or definition changed since last
+        // transfer frame:
+        // (compiling resets decimation counters, so the first transfer frame
+        // after a change is always downlinked and/or recorded if the
+        // frequency is non-zero)
+        if ((flt_tbl_mode != flt_tbl_mode_prev) || \
+            (get_flt_tbl_def_gen() != flt_tbl_def_gen_prev)) {
+            // Read published definition (never waits on an upload):
+            flt_tbl_def = bgn_rd_flt_tbl_def(&flt_tbl_def_gen);
+            flt_tbl_dst_tbl[FLT_TBL_DST_TO] = flt_tbl_def->to[0];
+            flt_tbl_dst_tbl[FLT_TBL_DST_DS] = flt_tbl_def->ds[0];
+
+            // Compile filter tables into routing descriptors:
+            ret_val = cmpl_rte_tlm(flt_tbl_rte,flt_tbl_dst_tbl,FLT_TBL_NDST,\
+                flt_tbl_def->nrow,FLT_TBL_COL,flt_tbl_mode,FLT_TBL_DFLT_MSK);
+
+            // End reading definition:
+            end_rd_flt_tbl_def();
 
-                // Set direction flags:
-                dl_tlm_pkt_flg = 0; // Do not downlink
+            // Check success:
+            if (ret_val < 0) {
+                // Print:
+                rt_printf("%d (FLT_TBL_TASK) Error compiling filter table"
+                    " mode %d; keeping previous routing\n",get_tm_sec(),\
+                    flt_tbl_mode);
+            } else if (flt_tbl_def_gen != flt_tbl_def_gen_prev) {
+                // Print:
+                rt_printf("%d (FLT_TBL_TASK) Filter table definition (CRC"
+                    " 0x%04X) in use\n",get_tm_sec(),flt_tbl_def->crc);
             }
-        // If frequency is zero, do not record:
-        } else {
-            // Set direction flags:
-            dl_tlm_pkt_flg = 0; // Do not downlink
+
+            // Update "previous" filter mode and definition:
+            flt_tbl_mode_prev = flt_tbl_mode;
+            flt_tbl_def_gen_prev = flt_tbl_def_gen;
         }
 
-        // Based on range, frequency, and current count, determine
-        // destination of transfer frame if frequency is non-zero:
-        if (flt_tbl_ds_freq != 0) {
-            if (flt_tbl_xfr_frm_cnt_ds[flt_tbl_row] == flt_tbl_ds_freq) {
-                // Set direction flags:
-                rcrd_tlm_pkt_flg = 1; // Record
-
-                // Check for case range = frequency:
-                if (flt_tbl_xfr_frm_cnt_ds[flt_tbl_row] != flt_tbl_ds_rng) {
-                    // Increment:
-                    flt_tbl_xfr_frm_cnt_ds[flt_tbl_row]++;
-                }
-            } else if (flt_tbl_xfr_frm_cnt_ds[flt_tbl_row] == flt_tbl_ds_rng) {
-                // Reset counter:
-                flt_tbl_xfr_frm_cnt_ds[flt_tbl_row] = flt_tbl_ds_freq;
-
-                // Set direction flags:
-                rcrd_tlm_pkt_flg = 0; // Do not record
-            } else {
-                // Increment:
-                flt_tbl_xfr_frm_cnt_ds[flt_tbl_row]++;
+        // Get next frame handle in block:
+        tlm_frm_hdl = tlm_frm_hdl_blk[tlm_frm_hdl_blk_idx++];
 
-                // Set direction flags:
-                rcrd_tlm_pkt_flg = 0; // Do not record
+        // Get APID from transfer frame:
+        memcpy(&tlm_pkt_xfr_frm_apid,get_tlm_frm_buf(tlm_frm_hdl)+0,2);
+
+        // Route transfer frame:
+        dst_msk = rte_tlm_frm(flt_tbl_rte,tlm_pkt_xfr_frm_apid);
+
+        // Check downlink budget if directed to downlink:
+        if (dst_msk & (1 << FLT_TBL_DST_TO)) {
+            // Get telemetry packet size on the line (attached sync marker
+            // and packet size from packet length field):
+            tlm_pkt_size = CCSDS_ASM_SIZE+\
+                get_ccsds_pkt_size(get_tlm_frm_buf(tlm_frm_hdl)+9);
+            dec_ccsds_pri_hdr(get_tlm_frm_buf(tlm_frm_hdl)+9,&pri_hdr);
+
+            // Refill buckets and charge packet to its class (diverted frames
+            // are counted in housekeeping telemetry):
+            fill_flt_tbl_dl();
+            if (!chrg_flt_tbl_dl(tlm_pkt_xfr_frm_apid,tlm_pkt_size,\
+                pri_hdr.grp_flg)) {
+                // Divert to recording:
+                dst_msk = (dst_msk & ~(1 << FLT_TBL_DST_TO)) | \
+                    (1 << FLT_TBL_DST_DS);
             }
-        // If frequency is zero, do not record:
-        } else {
-            // Set direction flags:
-            rcrd_tlm_pkt_flg = 0; // Do not record
         }
 
-        // If directed to downlink, send transfer frame to transmit telemetry
-        // packet via message queue:
-        if (dl_tlm_pkt_flg == 1) {
-            // Print:
-            rt_printf("%d (FLT_TBL_TASK) Telemetry packet will be"
-                " downlinked\n",time(NULL));
-
-            // Send transfer frame to transmit telemetry packet task via
-            // message queue:
-            ret_val = rt_queue_write(&tx_tlm_pkt_msg_queue,\
-                &tlm_pkt_xfr_frm_buf,TLM_PKT_XFR_FRM_SIZE,Q_NORMAL);
+        // Hand frame reference(s) to consumers:
+        // (the producer's reference is passed on to the first consumer; every
+        // other consumer needs its own and no consumer means the frame goes
+        // straight back to the pool)
+        if (dst_msk == 0) {
+            // Return frame to pool:
+            rls_tlm_frm(tlm_frm_hdl);
 
-            // Check success:
-            if ((ret_val > 0) || (ret_val == 0)) {
-                // Print:
-                rt_printf("%d (FLT_TBL_TASK) Telemetry packet transfer"
-                    " frame sent to transmit telemetry packet task\n",\
-                    time(NULL));
-            } else if (ret_val == -ENOMEM) {
-                // Wait for a set time to allow transmit packet task to
-                // process message queue:
-                sleep(0.35);
-
-                // Send transfer frame to filter table task via message queue:
-                ret_val = rt_queue_write(&tx_tlm_pkt_msg_queue,\
-                &tlm_pkt_xfr_frm_buf,TLM_PKT_XFR_FRM_SIZE,Q_NORMAL);
-            } else {
-                // Print:
-                rt_printf("%d (FLT_TBL_TASK) Error sending telemetry"
-                    " packet transfer frame\n",time(NULL));
-                // NEED ERROR HANDLING
-            }
-        } else {
-            // Print:
-            //rt_printf("%d (FLT_TBL_TASK) Telemetry packet will not be"
-                //" downlinked\n",time(NULL));
+            continue;
+        }
+        for (i = __builtin_popcount(dst_msk); i > 1; --i) {
+            // Add reference for additional consumer:
+            ref_tlm_frm(tlm_frm_hdl);
         }
 
-        // If directed to record, send transfer frame to create file task via
-        // message queue:
-        if (rcrd_tlm_pkt_flg == 1) {
-            // Print:
-            rt_printf("%d (FLT_TBL_TASK) Telemetry packet will be recorded\n",\
-                time(NULL));
+        // Send frame handle to each destination via message queue:
+        while (dst_msk != 0) {
+            // Get next destination:
+            dst = __builtin_ctz(dst_msk);
+            dst_msk &= dst_msk-1;
 
-            // Send transfer frame to create file tasks to record them to
-            // storage:
-            ret_val = rt_queue_write(&crt_file_msg_queue,&tlm_pkt_xfr_frm_buf,\
-                TLM_PKT_XFR_FRM_SIZE,Q_NORMAL); // Append message to queue
+            // Send frame handle to consumer task via flow controlled
+            // message queue:
+            ret_val = put_flw_ctl(flt_tbl_dst_fc[dst],&tlm_frm_hdl,\
+                TLM_FRM_HDL_SIZE,tlm_pkt_xfr_frm_apid);
 
             // Check success:
             if ((ret_val > 0) || (ret_val == 0)) {
                 // Print:
                 rt_printf("%d (FLT_TBL_TASK) Telemetry packet transfer"
-                    " frame sent to create file task\n",\
-                    time(NULL));
+                    " frame sent to %s task\n",get_tm_sec(),\
+                    flt_tbl_dst_name[dst]);
             } else {
                 // Print:
                 rt_printf("%d (FLT_TBL_TASK) Error sending telemetry"
-                    " packet transfer frame\n",time(NULL));
-                // NEED ERROR HANDLING
+                    " packet transfer frame to %s task\n",get_tm_sec(),\
+                    flt_tbl_dst_name[dst]);
+
+                // Release consumer reference:
+                rls_tlm_frm(tlm_frm_hdl);
             }
-        } else {
-            // Print:
-            //rt_printf("%d (FLT_TBL_TASK) Telemetry packet will not be"
-            //    " recorded\n",time(NULL));
         }
-
-        // Update "previous" filter mode:
-        flt_tbl_mode_prev = flt_tbl_mode;
     }
 }
@@ -2,9 +2,10 @@
 //
 // Get Housekeeping (HK) Telemetry
 //
-// Task responsible for retrievig values of counters (housekeeping telemetry),
-// creating telemetry packet transfer frames, and send those frames to filter
-// table task for either downlink or recording on storage for later downlink.
+// Task responsible for retrievig values of counters (housekeeping telemetry)
+// and sending them to the aggregate telemetry task, which packs records into
+// telemetry packet transfer frames for the filter table task for either
+// downlink or recording on storage for later downlink.
 // This is done be reading variables defined in the housekeeping variable
 // declaration header file.
 //
@@ -52,17 +53,19 @@
 #include <sems.h>                // Semaphore variable declarations
 #include <hk_tlm_var.h>          // Housekeeping telemetry variable
                                  // declarations
-#include <crt_tlm_pkt_xfr_frm.h> // Create telemetry packet transfer frame
-                                 // function declaration
+#include <agg_tlm_pkt.h>         // Aggregated telemetry packet sub-header
+#include <agg_tlm.h>             // Aggregate telemetry declarations
+#include <flw_ctl.h>             // Flow control declarations
+#include <tm_svc.h>              // Time service declarations
+
 // Macro definitions:
-#define HK_TLM_SIZE            33 // Housekeeping telemetry size in bytes
-#define TLM_PKT_XFR_FRM_SIZE 1089 // Telemetry transfer frame size in bytes
+#define HK_TLM_SIZE            80 // Housekeeping telemetry size in bytes
 
 #define APID_SW 0x00 // Software origin
 
 // Message queue definitions:
-RT_QUEUE flt_tbl_msg_queue; // For telemetry packet transfer frames
-                            // (read_usb/get_hk_tlm --> flt_tbl_task)
+RT_QUEUE agg_tlm_msg_queue; // For telemetry samples
+                            // (read_mdq/get_hk_tlm --> agg_tlm_task)
 
 // Semaphore definitions:
 RT_SEM flt_tbl_sem;     // For flt_tbl_task, read_usb, and get_hk_tlm task
@@ -86,53 +89,88 @@ uint16_t img_accpt_cnt;           // Accepted images (from IPS) count
 uint16_t img_rej_cnt;             // Rejected images (from IPS) count
 uint32_t next_img_acq_tm;         // Next image acquisition time
 uint32_t next_atc_tm;             // Next absolutely timed command time
-uint8_t  pbk_prog_flg;            // Playback in progress flag
+uint8_t  pbk_prog_flg;            // Playback progress (0: idle; 1-100:
+                                  // percent)
 uint32_t sys_tm;                  // System time
 uint8_t  ips_mdl_ld_state;        // IPS model load state
+uint16_t dl_dvrt_cnt[3];          // Frames diverted from downlink to recording
+                                  // (HK, MDQ, IMG class)
+uint16_t flt_tbl_def_crc;         // Filter table definition CRC-16
+uint8_t  dl_util_pct;             // Downlink line utilization (%)
+uint8_t  mdq_cdc_flg;             // Magnetometer DAQ codec flag
+uint16_t stor_free_mb;            // Free recording storage (MB)
+uint16_t stor_evct_cnt[3];        // Recorded segments evicted (HK, MDQ, IMG
+                                  // class)
+uint16_t atc_cnt;                 // Scheduled absolutely timed commands
+uint8_t  seq_run_id;              // Running sequence ID (0xFF: idle)
+uint16_t seq_suc_cnt;             // Sequence steps executed successfully
+                                  // counter
+uint16_t seq_err_cnt;             // Sequence steps not executed (error)
+                                  // counter
+uint16_t telecmd_sync_loss_cnt;   // Uplink sync loss counter
+uint16_t telecmd_resync_cnt;      // Uplink resynchronization counter
+uint16_t telecmd_crc_err_cnt;     // Uplink packet CRC failure counter
+
+// Format Unix timestamp as "YYYY/DOY-HH:MM:SS" (only when it changed)
+static void fmt_tm_str(uint32_t tm_val, uint32_t* tm_prv, char* tm_str,
+    size_t tm_str_size) {
+    // Definitions and initializations:
+    time_t tm_unix = tm_val; // Unix timestamp
+
+    // Check for unchanged timestamp (string already formatted):
+    if ((tm_val == *tm_prv) && (tm_str[0] != '\0')) {
+        return;
+    }
+
+    // Format:
+    strftime(tm_str,tm_str_size,"%Y/%j-%H:%M:%S",gmtime(&tm_unix));
+    *tm_prv = tm_val;
+
+    return;
+}
 
 void get_hk_tlm(void* arg){
     // Print:
-    rt_printf("%d (GET_HK_TLM_TASK) Task started\n",time(NULL));
+    rt_printf("%d (GET_HK_TLM_TASK) Task started\n",get_tm_sec());
 
     // Task synchronize with filter table task:
     // (wait for task to be ready to telemetry packet transfer frames)
     rt_printf("%d (GET_HK_TLM_TASK) Waiting for filter table task"
-        " to be ready\n",time(NULL));
+        " to be ready\n",get_tm_sec());
 
     // Wait for signals:
     rt_sem_p(&flt_tbl_sem,TM_INFINITE);
 
     // Print:
     rt_printf("%d (GET_HK_TLM_TASK) Create telemetry packet task is" 
-        " ready; continuing\n",time(NULL));
+        " ready; continuing\n",get_tm_sec());
 
     // Definitions and initializations:
-    int8_t ret_val; // Function return value
-
-    uint8_t tlm_pkt_xfr_frm_grp_flg; // Packet sequence grouping flag
+    uint8_t i;
+    int8_t  ret_val; // Function return value
 
     char hk_tlm_buf[HK_TLM_SIZE]; // Buffer housekeeping telemetry
 
-    char tlm_pkt_xfr_frm_buf[TLM_PKT_XFR_FRM_SIZE]; // Buffer for telemetry
-                                                    // packet transfer frame
-                                                    // buffer
+    char next_img_acq_tm_str[200] = ""; // Next image acquisition time string
+    char next_atc_tm_str[200] = "";     // Next absolutely timed command time
+                                        // string
+    char sys_tm_str[200] = "";          // System time string
+    char pbk_prog_str[10];              // Playback progress string
+    char seq_run_id_str[10];            // Running sequence string
+
+    uint32_t next_img_acq_tm_prv = 0; // Last formatted next image acquisition
+                                      // time
+    uint32_t next_atc_tm_prv = 0;     // Last formatted next absolutely timed
+                                      // command time
+    uint32_t sys_tm_prv = 0;          // Last formatted system time
 
     // Print 
     rt_printf("%d (GET_HK_TLM_TASK) Ready to get housekeeping telemetry"
-        " and create telemetry packets\n",time(NULL));
+        " and send telemetry records\n",get_tm_sec());
 
-    // Infinite loop to get housekeeping telemetry and send to create
-    // telemetry packet task via message queue:
+    // Infinite loop to get housekeeping telemetry and send to aggregate
+    // telemetry task via message queue:
     while (1) {
-        // Increment sequence count:
-        tlm_pkt_xfr_frm_seq_cnt++;
-
-        // Force counter roll over at 16384:
-        // (the field in the packet that sequence occupies is only 14 bits)
-        if (tlm_pkt_xfr_frm_seq_cnt > 16383) {
-            tlm_pkt_xfr_frm_seq_cnt = 1; // 1 because it's logical (0 ain't)
-        }
-
         // Copy housekeeping telemetry to buffer:
         memcpy(hk_tlm_buf+0,&rx_telecmd_pkt_cnt,1);
         memcpy(hk_tlm_buf+1,&val_telecmd_pkt_cnt,1);
@@ -152,34 +190,63 @@ void get_hk_tlm(void* arg){
         memcpy(hk_tlm_buf+19,&next_img_acq_tm,4);
         memcpy(hk_tlm_buf+23,&next_atc_tm,4);
         memcpy(hk_tlm_buf+27,&pbk_prog_flg,1);
-        sys_tm = time(NULL); memcpy(hk_tlm_buf+28,&sys_tm,4);
+        sys_tm = get_tm_sec();
+        memcpy(hk_tlm_buf+28,&sys_tm,4);
         memcpy(hk_tlm_buf+32,&ips_mdl_ld_state,1);
+        memcpy(hk_tlm_buf+33,&dl_dvrt_cnt[0],2);
+        memcpy(hk_tlm_buf+35,&dl_dvrt_cnt[1],2);
+        memcpy(hk_tlm_buf+37,&dl_dvrt_cnt[2],2);
+        for (i = 0; i < FLW_CTL_NQUEUE; ++i) {
+            memcpy(hk_tlm_buf+39+4*i,&flw_ctl_tbl[i].hwm,2);
+            memcpy(hk_tlm_buf+41+4*i,&flw_ctl_tbl[i].drop_cnt,2);
+        }
+        memcpy(hk_tlm_buf+55,&flt_tbl_def_crc,2);
+        memcpy(hk_tlm_buf+57,&dl_util_pct,1);
+        memcpy(hk_tlm_buf+58,&mdq_cdc_flg,1);
+        memcpy(hk_tlm_buf+59,&stor_free_mb,2);
+        memcpy(hk_tlm_buf+61,&stor_evct_cnt[0],2);
+        memcpy(hk_tlm_buf+63,&stor_evct_cnt[1],2);
+        memcpy(hk_tlm_buf+65,&stor_evct_cnt[2],2);
+        memcpy(hk_tlm_buf+67,&atc_cnt,2);
+        memcpy(hk_tlm_buf+69,&seq_run_id,1);
+        memcpy(hk_tlm_buf+70,&seq_suc_cnt,2);
+        memcpy(hk_tlm_buf+72,&seq_err_cnt,2);
+        memcpy(hk_tlm_buf+74,&telecmd_sync_loss_cnt,2);
+        memcpy(hk_tlm_buf+76,&telecmd_resync_cnt,2);
+        memcpy(hk_tlm_buf+78,&telecmd_crc_err_cnt,2);
 
 
 //TELEMETRY HACK
 	//Take all the telemerty values before they're written and write them to a file.
 	//Take all the telemerty values before they're written
-        char next_img_acq_tm_str[200]; // Next image acquisition
-        char next_atc_tm_str[200];     // Next absolutely timed 
-        char sys_tm_str[200];          // System time string
-
-        struct tm* tm;
-         // Convert Unix timestamps to "YYYY/DOY-HH:MM:SS"
-        tm = gmtime(&next_img_acq_tm);
-        strftime(next_img_acq_tm_str,sizeof(next_img_acq_tm_str),\
-            "%Y/%j-%H:%M:%S",tm);
-
-        tm = gmtime(&next_atc_tm);
-        strftime(next_atc_tm_str,sizeof(next_atc_tm_str),\
-            "%Y/%j-%H:%M:%S",tm);
+        // Convert Unix timestamps to "YYYY/DOY-HH:MM:SS"
+        // (next image acquisition and absolutely timed command times rarely
+        // change, so they are only reformatted when they do)
+        fmt_tm_str(next_img_acq_tm,&next_img_acq_tm_prv,next_img_acq_tm_str,\
+            sizeof(next_img_acq_tm_str));
+        fmt_tm_str(next_atc_tm,&next_atc_tm_prv,next_atc_tm_str,\
+            sizeof(next_atc_tm_str));
+        fmt_tm_str(sys_tm,&sys_tm_prv,sys_tm_str,sizeof(sys_tm_str));
+
+        // Format playback progress ("PBK <percent>%" or "IDLE"):
+        if (pbk_prog_flg) {
+            sprintf(pbk_prog_str,"PBK %u%%",pbk_prog_flg);
+        } else {
+            strcpy(pbk_prog_str,"IDLE");
+        }
 
-        tm = gmtime(&sys_tm);
-        strftime(sys_tm_str,sizeof(sys_tm_str),\
-            "%Y/%j-%H:%M:%S",tm);
+        // Format running sequence ("SEQ <ID>" or "IDLE"):
+        if (seq_run_id != 0xFF) {
+            sprintf(seq_run_id_str,"SEQ %u",seq_run_id);
+        } else {
+            strcpy(seq_run_id_str,"IDLE");
+        }
 
 	FILE *hackfd;
 	hackfd = fopen("/tmp/tlmhackfile", "w+");
-	fprintf(hackfd,"0x00:%u,%u,%u,%u,%u,%u,%u,%u,%u,%s,%s,%s,%s,%u,%u,%s,%s,%s,%s,%s\n",\
+	fprintf(hackfd,"0x00:%u,%u,%u,%u,%u,%u,%u,%u,%u,%s,%s,%s,%s,%u,%u,%s,%s,%s,%s,%s,%u,%u,%u,"
+            "%u,%u,%u,%u,%u,%u,%u,%u,0x%04X,%u,%s,%u,%u,%u,%u,%u,%s,%u,%u,"
+            "%u,%u,%u\n",\
             rx_telecmd_pkt_cnt,val_telecmd_pkt_cnt,inv_telecmd_pkt_cnt,\
             val_cmd_cnt,inv_cmd_cnt,cmd_exec_suc_cnt,\
             cmd_exec_err_cnt,tlm_pkt_xfr_frm_seq_cnt,acq_img_cnt,\
@@ -189,8 +256,20 @@ void get_hk_tlm(void* arg){
             flt_tbl_mode == 0 ? "NORM" : flt_tbl_mode == 1 ? \
             "RT" : flt_tbl_mode == 2 ? "PBK" : flt_tbl_mode == 3 ? "IMG" : "MAG",\
             img_accpt_cnt,img_rej_cnt,next_img_acq_tm_str,next_atc_tm_str,\
-            pbk_prog_flg ? "PBK" : "IDLE",sys_tm_str,ips_mdl_ld_state == 0 ? \
-            "LOADING" : "READY");
+            pbk_prog_str,sys_tm_str,ips_mdl_ld_state == 0 ? \
+            "LOADING" : "READY",dl_dvrt_cnt[0],dl_dvrt_cnt[1],\
+            dl_dvrt_cnt[2],flw_ctl_tbl[FLW_CTL_AGG_TLM].hwm,\
+            flw_ctl_tbl[FLW_CTL_AGG_TLM].drop_cnt,\
+            flw_ctl_tbl[FLW_CTL_FLT_TBL].hwm,\
+            flw_ctl_tbl[FLW_CTL_FLT_TBL].drop_cnt,\
+            flw_ctl_tbl[FLW_CTL_TX_TLM_PKT].hwm,\
+            flw_ctl_tbl[FLW_CTL_TX_TLM_PKT].drop_cnt,\
+            flw_ctl_tbl[FLW_CTL_CRT_FILE].hwm,\
+            flw_ctl_tbl[FLW_CTL_CRT_FILE].drop_cnt,flt_tbl_def_crc,\
+            dl_util_pct,mdq_cdc_flg ? "CDC" : "RAW",stor_free_mb,\
+            stor_evct_cnt[0],stor_evct_cnt[1],stor_evct_cnt[2],atc_cnt,\
+            seq_run_id_str,seq_suc_cnt,seq_err_cnt,telecmd_sync_loss_cnt,\
+            telecmd_resync_cnt,telecmd_crc_err_cnt);
 	fclose(hackfd);
 
 
@@ -200,36 +279,15 @@ void get_hk_tlm(void* arg){
 
 
 
-        // Set grouping flag:
-        tlm_pkt_xfr_frm_grp_flg = 3; // Unsegmented data
-
-        // Create transfer frame:
-        crt_tlm_pkt_xfr_frm(hk_tlm_buf,HK_TLM_SIZE,\
-            tlm_pkt_xfr_frm_buf,APID_SW,\
-            tlm_pkt_xfr_frm_grp_flg,tlm_pkt_xfr_frm_seq_cnt);
-
-        // Send transfer frame to filter table task via message queue:
-        ret_val = rt_queue_write(&flt_tbl_msg_queue,&tlm_pkt_xfr_frm_buf,\
-            TLM_PKT_XFR_FRM_SIZE,Q_NORMAL); // Append message to queue
+        // Send record to aggregate telemetry task via message queue:
+        ret_val = send_agg_tlm(hk_tlm_buf,HK_TLM_SIZE,APID_SW,0);
 
         // Check success:
-        if ((ret_val > 0) || (ret_val == 0)) {
-            // Print:
-            //rt_printf("%d (GET_HK_TLM_TASK) Telemetry packet transfer"
-            //    " frame sent to filter table task\n",time(NULL));
-        } else if (ret_val == -ENOMEM) {
-            // Wait for a set time to allow filter table task to
-            // process message queue:
-            sleep(0.35);
-
-            // Send transfer frame to filter table task via message queue:
-            ret_val = rt_queue_write(&flt_tbl_msg_queue,&tlm_pkt_xfr_frm_buf,\
-                TLM_PKT_XFR_FRM_SIZE,Q_NORMAL); // Append message to queue 
-        } else {
+        if (ret_val < 0) {
             // Print:
-            rt_printf("%d (GET_HK_TLM_TASK) Error sending telemetry"
-                " packet transfer frame\n",time(NULL));
-            // NEED ERROR HANDLING
+            rt_printf("%d (GET_HK_TLM_TASK) Error sending housekeeping"
+                " record to aggregate telemetry task; error %d\n",\
+                get_tm_sec(),ret_val);
         }
 
         // Release processor and wait for next period to execute again:
@@ -4,7 +4,7 @@
 //
 // Task responsible for processing telecommand packets received via message
 // queue from receive telecommand packet task. Packets are processed to
-// recover packet
+// recover packet (decoded with the shared CCSDS packet codec, ccsds_pkt.h)
 //     - APID
 //     - Packet name
 //     - Execution time
@@ -38,6 +38,7 @@
 #include <stdlib.h>  // Standard library
 #include <unistd.h>  // UNIX standard function definitions
 #include <errno.h>   // Error number definitions
+#include <string.h>  // String function definitions
 #include <stdint.h>  // Standard integer types
 #include <time.h>    // Standard time types
 
@@ -51,6 +52,9 @@
 #include <msg_queues.h> // Message queue variable declarations
 #include <sems.h>       // Semaphore variable declarations
 #include <hk_tlm_var.h> // Housekeeping variable declarations
+#include <ccsds_pkt.h>  // CCSDS packet codec
+#include <ccsds_crc.h>  // CCSDS packet error control (CRC)
+#include <tm_svc.h>     // Time service declarations
 
 // Macro definitions:
 #define TELECMD_PKT_SIZE    20 // Telecommand packet size in bytes
@@ -64,9 +68,8 @@
                                // range (max)
 #define EXP_PKT_NAME_RNG 16383 // Expected telecommand packet name range
 #define EXP_PKT_LEN         13 // Expected telecommand packet length - 1
-#define EXP_PKT_ATC_FLG_RNG  1 // Expected telecommand packet ATC flag
+#define EXP_PKT_ATC_FLG_RNG  2 // Expected telecommand packet ATC flag
                                // range (max)
-#define EXP_PKT_ERR_CNT  65535 // Expected telecommand packet error control
 #define EXP_PKT_CMD_ARG_RNG \
     2147483647                 // Expected telecommand packet argument range
 #define CMD_EXEC_TM_TOL    -20 // Telecommand packet execution time tolerance
@@ -102,19 +105,19 @@ uint8_t inv_telecmd_pkt_cnt = 0; // Invalid telecommand packet counter
 
 void proc_telecmd_pkt(void) {
     // Print:
-    rt_printf("%d (PROC_TELECMD_PKT_TASK) Task started\n",time(NULL));
+    rt_printf("%d (PROC_TELECMD_PKT_TASK) Task started\n",get_tm_sec());
 
     // Task synchronize with cmd_exec task
     // (Wait for task to be ready to receive frames)
     rt_printf("%d (PROC_TELECMD_PKT_TASK) Waiting for execute command"
-        " task to be ready\n",time(NULL));
+        " task to be ready\n",get_tm_sec());
 
     // Wait for signal:
     rt_sem_p(&proc_telecmd_pkt_sem,TM_INFINITE);
 
     // Print:
     rt_printf("%d (PROC_TELECMD_PKT_TASK)"
-        " Execute command task is ready; continuing\n",time(NULL));
+        " Execute command task is ready; continuing\n",get_tm_sec());
 
     // Definitions and initializations:
     int8_t ret_val; // Function return value
@@ -123,36 +126,20 @@ void proc_telecmd_pkt(void) {
     char cmd_xfr_frm_buf[CMD_XFR_FRM_SIZE]; // Buffer for command transfer
                                              // frame
 
-    // Packet fields (raw data)
-    // Packet header
-    uint16_t pkt_hdr_pkt_id;      // Packet identification
-    uint16_t pkt_hdr_pkt_seq_cnt; // Packet sequence count
-    uint16_t pkt_hdr_pkt_len;     // Packet length
-
-    // Packet data field
-    uint32_t pkt_dat_fld_sec_hdr_t_fld_sec;  // T-field seconds
-    uint16_t pkt_dat_fld_sec_hdr_t_fld_msec; // T-field milliseconds
-    uint8_t  pkt_dat_fld_sec_hdr_p_fld;      // P-field
-    uint32_t pkt_dat_fld_app_dat;            // Application data
-    uint16_t pkt_dat_fld_pkt_err_cnt;        // Packet error control
+    // Packet fields (decoded by CCSDS packet codec):
+    struct ccsds_pri_hdr pri_hdr; // Packet primary header
+    struct ccsds_sec_hdr sec_hdr; // Packet secondary header
 
     // Packet sub-fields (converted)
     // Packet header:
-    uint8_t  pkt_id_vrs;           // Version
-    uint8_t  pkt_id_typ;           // Type
-    uint8_t  pkt_id_sec_hdr_flg;   // Secondary header flag
     uint16_t pkt_id_apid;          // Application I.D.
-    uint8_t  pkt_seq_cnt_grp_flg;  // Group flag
     uint16_t pkt_seq_cnt_pkt_name; // Packet name
-    uint16_t pkt_len;              // Packet length (in octets - 1)
 
     // Packet data field packet secondary header:
     uint32_t pkt_t_fld_sec;   // T-field seconds (Unix timestamp)
     uint16_t pkt_t_fld_msec;  // T-field milliseconds (Unix timestamp)
-    uint8_t  pkt_p_fld_ext;   // P-field extension
-    uint8_t  pkt_p_fld_id;    // P-field I.D.
-    uint8_t  pkt_p_fld_bas;   // P-field basic time size (in octets - 1)
-    uint8_t  pkt_p_fld_frc;   // P-field fractional time size (in octets - 1)
+
+    uint32_t tm_now; // Current time (Unix timestamp)
 
     // Packet data field application data:
     uint8_t  pkt_app_dat_atc_flg; // Absolutely timed command flag
@@ -164,7 +151,7 @@ void proc_telecmd_pkt(void) {
     // Task synchronize with rx_telecmd_pkt task
     // (tell task that it is now ready to receive packets)
     rt_printf("%d (PROC_TELECMD_PKT_TASK) Ready to process telecommand"
-        " packets\n",time(NULL));
+        " packets\n",get_tm_sec());
 
     // Signal task to continue executing:
     rt_sem_v(&rx_telecmd_pkt_sem);
@@ -191,71 +178,68 @@ void proc_telecmd_pkt(void) {
             // Print:
             rt_printf("%d (PROC_TELECMD_PKT_TASK)"
                 " Received telecommand packet from receiver"
-                " task\n",time(NULL));
+                " task\n",get_tm_sec());
         } else {
             // Print:
             rt_printf("%d (PROC_TELECMD_PKT_TASK)"
                 " Error reading telecommand packet from receiver"
-                " task\n",time(NULL));
+                " task\n",get_tm_sec());
             // NEED ERROR HANDLING
         }
 
-        // Parse packet telecommand into packet fields (raw data):
-        memcpy(&pkt_hdr_pkt_id,telecmd_pkt_buf,2);
-        memcpy(&pkt_hdr_pkt_seq_cnt,telecmd_pkt_buf+2,2);
-        memcpy(&pkt_hdr_pkt_len,telecmd_pkt_buf+4,2);
-        memcpy(&pkt_dat_fld_sec_hdr_t_fld_sec,telecmd_pkt_buf+6,4);
-        memcpy(&pkt_dat_fld_sec_hdr_t_fld_msec,telecmd_pkt_buf+10,2);
-        memcpy(&pkt_dat_fld_sec_hdr_p_fld,telecmd_pkt_buf+13,1);
-        memcpy(&pkt_dat_fld_app_dat,telecmd_pkt_buf+14,4);
-        memcpy(&pkt_dat_fld_pkt_err_cnt,telecmd_pkt_buf+18,2);
-
-        // Convert packet fields (raw data) to packet sub-fields (values)
+        // Print:
+        rt_printf("%d (PROC_TELECMD_PKT_TASK) Processing telecommand"
+            " packet\n",get_tm_sec());
+
+        // Decode telecommand packet into packet sub-fields (values):
+        dec_ccsds_pri_hdr(telecmd_pkt_buf,&pri_hdr);
+        dec_ccsds_sec_hdr(telecmd_pkt_buf,&sec_hdr);
+        dec_ccsds_app_dat(telecmd_pkt_buf,&pkt_app_dat_atc_flg,\
+            &pkt_app_dat_cmd_arg);
+        pkt_err_cnt = get_be16(telecmd_pkt_buf+CCSDS_HDR_SIZE+\
+            CCSDS_APP_DAT_SIZE);
+
+        // Check packet error control against CRC of packet (header and
+        // application data). If CRC does not match, packet is corrupted and
+        // no other field can be trusted; go to invalid packet label:
+        if (pkt_err_cnt != calc_ccsds_crc(telecmd_pkt_buf,\
+            CCSDS_HDR_SIZE+CCSDS_APP_DAT_SIZE)) {
+            // Print:
+            rt_printf("%d (PROC_TELECMD_PKT_TASK) Packet error control"
+                " mismatch\n",get_tm_sec());
+
+            // Goto invalid packet:
+            goto inv_pkt;
+        }
+
         // Check for expected values of data fields to validate telecommand
         // packet. If a value does not match what is expected (either range
         // or exact value, go to inv_pkt label to ignore telecommand packet
         // and skip further processing.
 
-        // Print:
-        rt_printf("%d (PROC_TELECMD_PKT_TASK) Processing telecommand"
-            " packet\n",time(NULL));
-
-        // Packet I.D. version:
-        pkt_id_vrs = pkt_hdr_pkt_id & 0x07; // Mask to keep bits 0-2
-
         // Check packet version for expected value. If true, go to invalid
         // packet label:
-        if ((pkt_id_vrs != EXP_PKT_VER)) {
+        if ((pri_hdr.vrs != EXP_PKT_VER)) {
             // Goto invalid packet:
             goto inv_pkt;
         }
 
-        // Packet I.D. type:
-        pkt_id_typ = pkt_hdr_pkt_id & 0x08; // Mask to keep bit 3
-        pkt_id_typ = pkt_id_typ >> 3;       // Shift right by 3 bits
-
         // Check packet type for expected value. If true, go to invalid
         // packet label:
-        if ((pkt_id_typ != EXP_PKT_TYP)) {
+        if ((pri_hdr.typ != EXP_PKT_TYP)) {
             // Goto invalid packet:
             goto inv_pkt;
         }
 
-        // Packet I.D. secondary header flag:
-        pkt_id_sec_hdr_flg = pkt_hdr_pkt_id & 0x10;   // Mask to keep bit 4
-        pkt_id_sec_hdr_flg = pkt_id_sec_hdr_flg >> 4; // Shift right by
-                                                      // 4 bits
-
         // Check packet secondary header flag for expected value. If true,
         // go to invalid packet label:
-        if ((pkt_id_sec_hdr_flg != EXP_PKT_SEC_HDR_FLG)) {
+        if ((pri_hdr.sec_hdr_flg != EXP_PKT_SEC_HDR_FLG)) {
             // Goto invalid packet:
             goto inv_pkt;
         }
 
         // Packet I.D. APID:
-        pkt_id_apid = pkt_hdr_pkt_id & 0xFFE0; // Mask to keep bits 5-15
-        pkt_id_apid = pkt_id_apid >> 5;        // Shift right by 5 bits
+        pkt_id_apid = pri_hdr.apid;
 
         // Check packet APID range. If true, go to invalid packet label:
         if (pkt_id_apid > EXP_PKT_APID_RNG) {
@@ -263,22 +247,14 @@ void proc_telecmd_pkt(void) {
             goto inv_pkt;
         }
 
-        // Packet sequence control grouping flag:
-        pkt_seq_cnt_grp_flg = pkt_hdr_pkt_seq_cnt & 0x3; // Mask to keep
-                                                         // bits 0-1
-
         // Check packet APID range. If true, go to invalid packet label:
-        if (pkt_seq_cnt_grp_flg > EXP_PKT_GRP_FLG_RNG) {
+        if (pri_hdr.grp_flg > EXP_PKT_GRP_FLG_RNG) {
             // Goto invalid packet:
             goto inv_pkt;
         }
 
         // Packet sequence control packet name:
-        pkt_seq_cnt_pkt_name = pkt_hdr_pkt_seq_cnt \
-            & 0xFFFC; // Mask to keep
-                      // bits 2-15
-        pkt_seq_cnt_pkt_name = pkt_hdr_pkt_seq_cnt >> 2; // Shift right
-                                                         // by 2 bits
+        pkt_seq_cnt_pkt_name = pri_hdr.seq_cnt;
 
         // Check packet name range. If true, go to invalid packet label:
         if (pkt_seq_cnt_pkt_name > EXP_PKT_NAME_RNG) {
@@ -286,84 +262,59 @@ void proc_telecmd_pkt(void) {
             goto inv_pkt;
         }
 
-        // Packet header packet length
-        pkt_len = pkt_hdr_pkt_len;
-
         // Check packet name range. If true, go to invalid packet label:
-        if (pkt_len > EXP_PKT_LEN) {
+        if (pri_hdr.pkt_len > EXP_PKT_LEN) {
             // Goto invalid packet:
             goto inv_pkt;
         }
 
         // Packet data field packet secondary header T-fields:
-        pkt_t_fld_sec = pkt_dat_fld_sec_hdr_t_fld_sec;
-        pkt_t_fld_msec = pkt_dat_fld_sec_hdr_t_fld_msec;
+        pkt_t_fld_sec = sec_hdr.t_sec;
+        pkt_t_fld_msec = ccsds_frc_to_msec(sec_hdr.t_frc);
 
         // Check packet T-field for a command execution time in the past by
         // a specificed tolerance. Will not accept packet if execution time is
         // in this past by more than this many seconds. If true, go to 
         // invalid packet label:
-        if ((pkt_t_fld_sec - time(NULL)) < CMD_EXEC_TM_TOL) {
+        tm_now = get_tm_sec();
+        if ((int32_t) (pkt_t_fld_sec - tm_now) < CMD_EXEC_TM_TOL) {
             // Print:
             rt_printf("%d (PROC_TELECMD_PKT_TASK) Command execution time is" 
-                " in the past by %d seconds \n",time(NULL),\
-                (time(NULL) - pkt_t_fld_sec));
+                " in the past by %d seconds \n",tm_now,\
+                (int32_t) (tm_now - pkt_t_fld_sec));
 
             // Goto invalid packet:
             goto inv_pkt;
         }
 
-        // Packet secondary header P-field extension:
-        pkt_p_fld_ext = pkt_dat_fld_sec_hdr_p_fld & 0x0; // Mask to keep bit 0
-
         // Check packet P-field extension flag for expected value. If true, 
         // go to invalid packet label:
-        if (pkt_p_fld_ext != EXP_PKT_P_EXT) {
+        if (sec_hdr.p_ext != EXP_PKT_P_EXT) {
             // Goto invalid packet:
             goto inv_pkt;
         }
 
-        // Packet secondary header P-field identification:
-        pkt_p_fld_id = pkt_dat_fld_sec_hdr_p_fld & 0xE; // Mask to keep
-                                                        // bits 1-3
-        pkt_p_fld_id = pkt_p_fld_id >> 1;               // Shift right by 1 bit
-
         // Check packet P-field extension identification for expected value. 
         // If true, go to invalid packet label:
-        if (pkt_p_fld_id != EXP_PKT_P_ID) {
+        if (sec_hdr.p_id != EXP_PKT_P_ID) {
             // Goto invalid packet:
             goto inv_pkt;
         }
 
-        // Packet secondary header P-field basic time octets:
-        pkt_p_fld_bas = pkt_dat_fld_sec_hdr_p_fld & 0x30; // Mask to keep
-                                                          // bit 4-5
-        pkt_p_fld_bas = pkt_p_fld_bas >> 4;               // Shift right
-                                                          // by 4 bits
-
         // Check packet p-field basic time octets for expected value.
         // If true, go to invalid packet label:
-        if (pkt_p_fld_bas != EXP_PKT_P_BAS_LEN) {
+        if (sec_hdr.p_bas != EXP_PKT_P_BAS_LEN) {
             // Goto invalid packet:
             goto inv_pkt;
         }
 
-        // Packet secondary header P-field fractional time octets:
-        pkt_p_fld_frc = pkt_dat_fld_sec_hdr_p_fld & 0xC0; // Mask to keep
-                                                          // bit 6-7
-        pkt_p_fld_frc = pkt_p_fld_frc >> 6;               // Shift right by
-                                                          // 5 bits
-
         // Check packet p-field basic time octets for expected value.
         // If true, go to invalid packet label:
-        if (pkt_p_fld_frc != EXP_PKT_P_FRC_LEN) {
+        if (sec_hdr.p_frc != EXP_PKT_P_FRC_LEN) {
             // Goto invalid packet:
             goto inv_pkt;
         }
 
-        // Packet data field application data ATC flag:
-        pkt_app_dat_atc_flg = pkt_dat_fld_app_dat & 0x01; // Mask to keep bit 0
-
         // Check packet error control for expected value. If true, go
         // to invalid packet label:
         if (pkt_app_dat_atc_flg > EXP_PKT_ATC_FLG_RNG) {
@@ -371,12 +322,6 @@ void proc_telecmd_pkt(void) {
             goto inv_pkt;
         }
 
-        // Packet data field application data command arguments:
-        pkt_app_dat_cmd_arg = pkt_dat_fld_app_dat & 0xFFFFFFFE; // Mast to keep
-                                                                // bits 1-7
-        pkt_app_dat_cmd_arg = pkt_app_dat_cmd_arg >> 1;         // Shift right
-                                                                // by 1 bit
-
         // Check packet error control for expected value. If true, go
         // to invalid packet label:
         if (pkt_app_dat_cmd_arg > EXP_PKT_CMD_ARG_RNG) {
@@ -384,19 +329,9 @@ void proc_telecmd_pkt(void) {
             goto inv_pkt;
         }
 
-        // Packet data field packet error control:
-        pkt_err_cnt = pkt_dat_fld_pkt_err_cnt;
-
-        // Check packet error control for expected value. If true, go
-        // to invalid packet label:
-        if (pkt_err_cnt != EXP_PKT_ERR_CNT) {
-            // Goto invalid packet:
-            goto inv_pkt;
-        }
-
         // Print:
         rt_printf("%d (PROC_TELECMD_PKT_TASK) Telecommand packet is valid;"
-            " creating command transfer frame\n",time(NULL));
+            " creating command transfer frame\n",get_tm_sec());
 
         // Build command transfer frame:
         // (APID, packet name, execution time, ATC flag, and command arguments)
@@ -409,7 +344,7 @@ void proc_telecmd_pkt(void) {
 
         // Print:
         rt_printf("%d (PROC_TELECMD_PKT_TASK) Command transfer frame"
-            " created\n",time(NULL));
+            " created\n",get_tm_sec());
 
         // Send command transfer frame to command executor task
         // via message que:
@@ -420,11 +355,11 @@ void proc_telecmd_pkt(void) {
         if (ret_val > 0) {
             // Print:
             //rt_printf("%d (PROC_TELECMD_PKT_TASK) Command transfer frame" 
-            //" sent to execute command task\n",time(NULL));
+            //" sent to execute command task\n",get_tm_sec());
         } else {
             // Print:
             rt_printf("%d (PROC_TELECMD_PKT_TASK) Error sending command"
-                " transfer frame to execute command task\n",time(NULL));
+                " transfer frame to execute command task\n",get_tm_sec());
             // NEED ERROR HANDLING
         }
 
@@ -445,7 +380,7 @@ void proc_telecmd_pkt(void) {
 
         // Print:
         rt_printf("%d (PROC_TELECMD_PKT_TASK) Telecommand packet is"
-            " invalid; packet ignored\n",time(NULL));
+            " invalid; packet ignored\n",get_tm_sec());
 
         // Increase counter:
         inv_telecmd_pkt_cnt++;
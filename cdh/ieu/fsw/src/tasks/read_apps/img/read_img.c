@@ -17,8 +17,9 @@
 //     2. non-zero: image does have an aurora present so expect processed image
 //                  of this non-zero number size
 // If non-zero, the processed image is then received from IPS via the real-time
-// message pipe. Once received, telemetry packet transfer frames are created
-// and then sent to filter table task via message queue.
+// message pipe. Once received, the whole processed image is segmented into
+// telemetry packet transfer frames in one pass (seg_tlm_pkt_xfr_frm) and the
+// frames are sent to filter table task via message queue in blocks.
 //
 // -------------------------------------------------------------------------- /
 //
@@ -65,17 +66,20 @@
                                  // function declaration
 #include <hk_tlm_var.h>          // Housekeeping telemetry variable
                                  // declarations
+#include <tlm_frm_pool.h>        // Telemetry frame pool declarations
+#include <flw_ctl.h>             // Flow control declarations
+#include <seg_tlm_pkt_xfr_frm.h> // Segment telemetry packet transfer frames
+                                 // function declaration
+#include <tm_svc.h>              // Time service declarations
 
 // Macro definitions:
 #define RAW_IMG_SIZE      2304000 // Imaging source data message queue
                                   // size in bytes
-#define TLM_PKT_XFR_FRM_SIZE 1089 // Telemetry transfer frame size in bytes
-#define TLM_PKT_USR_DAT_SIZE 1064 // Telemetry packet user data size in bytes
 
 #define APID_IMG 0x64 // Image origin
 
 // Message queue definitions:
-RT_QUEUE flt_tbl_msg_queue; // For telemetry packet transfer frames
+RT_QUEUE flt_tbl_msg_queue; // For telemetry frame handles
                             // (read_mdq/img/get_hk_tlm --> flt_tbl_task)
 
 // Message pipe declarations:
@@ -96,35 +100,23 @@ uint8_t  ips_mdl_ld_state = 0;        // IPS model load state
 
 void read_img(void) {
     // Print:
-    rt_printf("%d (READ_IMG_TASK) Task started\n",time(NULL));
+    rt_printf("%d (READ_IMG_TASK) Task started\n",get_tm_sec());
 
     // Task synchronize with filter table task:
     // (wait for task to be ready to telemetry packet transfer frames)
     rt_printf("%d (READ_IMG_TASK) Waiting for filter table task"
-        " to be ready\n",time(NULL));
+        " to be ready\n",get_tm_sec());
 
     // Wait for signals:
     rt_sem_p(&flt_tbl_sem,TM_INFINITE);
 
     // Print:
     rt_printf("%d (READ_IMG_TASK) Filter table task is ready;"
-        " continuing\n",time(NULL));
+        " continuing\n",get_tm_sec());
 
     // Definitions and initializations:
-    uint32_t i;
     int32_t ret_val; // Function retern value
 
-    uint16_t copy_size; // Buffer copy size
-
-    uint8_t tlm_pkt_xfr_frm_grp_flg; // Packet sequence grouping flag
-
-    uint16_t num_tlm_pkt_xfr_frm_req; // Required number of tranfer frames
-
-    char tmp_buffer[TLM_PKT_USR_DAT_SIZE]; // Temporary buffer
-    char tlm_pkt_xfr_frm_buf[TLM_PKT_XFR_FRM_SIZE]; // Buffer for telemetry
-                                                    // packet transfer frame
-                                                    // buffer
-
     FILE* file_ptr; // File pointer
 
     char* img_buf = (char*) malloc(RAW_IMG_SIZE); // Buffer for image
@@ -133,7 +125,7 @@ void read_img(void) {
 
     // Print:
     rt_printf("%d (READ_IMG_TASK) Waiting for IPS to be ready to receive"
-        " and process images\n",time(NULL));
+        " and process images\n",get_tm_sec());
 
     // Synchronize with IPS:
     // (Wait IPS to be ready to receive and process images. Wait for message
@@ -141,14 +133,14 @@ void read_img(void) {
     ret_val = rt_pipe_read(&ips_msg_pipe,&ips_ret,1,TM_INFINITE);
 
     // Print:
-    rt_printf("%d (READ_IMG_TASK) IPS is ready; continuing\n",time(NULL));
+    rt_printf("%d (READ_IMG_TASK) IPS is ready; continuing\n",get_tm_sec());
 
     // Set state:
     ips_mdl_ld_state = 1; // Ready
 
     // Print:
     rt_printf("%d (READ_IMG_TASK) Ready to process images, interface with"
-        " IPS, and create telemetry packets\n",time(NULL));
+        " IPS, and create telemetry packets\n",get_tm_sec());
 
     // Infinite loop to read images and send to create telemetry packets
     // task via message queue.
@@ -157,7 +149,7 @@ void read_img(void) {
         rt_sem_p(&new_img_sem,TM_INFINITE);
 
         // Print:
-        rt_printf("%d (READ_IMG_TASK) Reading new raw image\n",time(NULL));
+        rt_printf("%d (READ_IMG_TASK) Reading new raw image\n",get_tm_sec());
 
         // Open file:
         file_ptr = fopen("/tmp/img.raw","rb");
@@ -176,10 +168,10 @@ void read_img(void) {
         if (ret_val == RAW_IMG_SIZE) {
             // Print:
             rt_printf("%d (READ_IMG_TASK) Sent raw image to IPS; waiting"
-                " for reply\n",time(NULL));
+                " for reply\n",get_tm_sec());
         } else {
             rt_printf("%d (READ_IMG_TASK) Error sending raw image"
-                " to IPS\n",time(NULL));
+                " to IPS\n",get_tm_sec());
 
             // NEED ERROR HANDLING
         }
@@ -195,7 +187,7 @@ void read_img(void) {
         if (ips_ret != 0) {
             // Print:
             rt_printf("%d (READ_IMG_TASK) Image classified to have an"
-                " aurora by IPS; waiting for processed image\n",time(NULL));
+                " aurora by IPS; waiting for processed image\n",get_tm_sec());
 
             // Increment counter:
             img_accpt_cnt++;
@@ -208,95 +200,33 @@ void read_img(void) {
             if (ret_val == ips_ret) {
                 // Print:
                 rt_printf("%d (READ_IMG_TASK) Received processed image"
-                    " from IPS\n",time(NULL));
+                    " from IPS\n",get_tm_sec());
             } else {
                 rt_printf("%d (READ_IMG_TASK) Error receiving processed"
-                    " image from IPS\n",time(NULL));
+                    " image from IPS\n",get_tm_sec());
                 // NEED ERROR HANDLING
             }
 
-            // Determine how many transfer frames are required:
-            num_tlm_pkt_xfr_frm_req = \
-                (ips_ret/TLM_PKT_USR_DAT_SIZE) + 1; 
-
-            // Loop to create required number of transfer frames:
-            for (i = 0; i < num_tlm_pkt_xfr_frm_req; ++i) {
-                // Increment sequence count:
-                tlm_pkt_xfr_frm_seq_cnt++;
-
-                // Force counter roll over at 16384:
-                // (the field in the packet that sequence occupies is only
-                // 14 bits)
-                if (tlm_pkt_xfr_frm_seq_cnt > 16383) {
-                    tlm_pkt_xfr_frm_seq_cnt = 1; // 1 because it's logical
-                                                 // (0 ain't)
-                }
-
-                // Set grouping flag based off iteration:
-                if (i == 0) {
-                    // Set grouping flag:
-                    tlm_pkt_xfr_frm_grp_flg = 1; // First segment
-
-                    // Set copy size in bytes:
-                    copy_size = TLM_PKT_USR_DAT_SIZE;
-                } else if (i == (num_tlm_pkt_xfr_frm_req - 1)) {
-                    // Set grouping flag:
-                    tlm_pkt_xfr_frm_grp_flg = 2; // Last segment
-
-                    // Set copy size in bytes:
-                    copy_size = ips_ret - TLM_PKT_USR_DAT_SIZE*i;
-                } else {
-                    // Set grouping flag:
-                    tlm_pkt_xfr_frm_grp_flg = 0; // Continuation segment
-
-                    // Set copy size in bytes:
-                    copy_size = TLM_PKT_USR_DAT_SIZE;
-                }
-
-                // Copy source data buffer to temporary buffer using dynamic
-                // offset and size:
-                memcpy(tmp_buffer,img_buf+TLM_PKT_USR_DAT_SIZE*i,\
-                    copy_size);
-
-                // Create transfer frame:
-                crt_tlm_pkt_xfr_frm(tmp_buffer,copy_size,\
-                    tlm_pkt_xfr_frm_buf,APID_IMG,\
-                    tlm_pkt_xfr_frm_grp_flg,tlm_pkt_xfr_frm_seq_cnt);
-
-                // Send transfer frame to filter table task via message queue:
-                ret_val = rt_queue_write(&flt_tbl_msg_queue,\
-                    &tlm_pkt_xfr_frm_buf,TLM_PKT_XFR_FRM_SIZE,\
-                    Q_NORMAL); // Append message to queue
-
-                // Check success:
-                if ((ret_val > 0) || (ret_val == 0)) {
-                    // Print:
-                    //rt_printf("%d (READ_IMG_TASK) Telemetry packet transfer"
-                    //    " frame sent to filter table task\n",time(NULL));
-                } else if (ret_val == -ENOMEM) {
-                    // Wait for a set time to allow filter table task to
-                    // process message queue:
-                    sleep(0.35);
-
-                    // Send transfer frame to filter table task via message queue:
-                    ret_val = rt_queue_write(&flt_tbl_msg_queue,\
-                        &tlm_pkt_xfr_frm_buf,TLM_PKT_XFR_FRM_SIZE,\
-                        Q_NORMAL); // Append message to queue
-                } else {
-                    // Print:
-                    rt_printf("%d (READ_IMG_TASK) Error sending telemetry"
-                        " packet transfer frame\n",time(NULL));
-                    // NEED ERROR HANDLING
-                }
+            // Segment processed image into transfer frames and publish them
+            // to filter table task in blocks:
+            ret_val = seg_tlm_pkt_xfr_frm(img_buf,ips_ret,APID_IMG,\
+                &flw_ctl_tbl[FLW_CTL_FLT_TBL]);
+
+            // Check success:
+            if (ret_val >= 0) {
+                // Print:
+                rt_printf("%d (READ_IMG_TASK) All %d telemetry packet"
+                    " transfer frames sent to filter table task\n",\
+                    get_tm_sec(),ret_val);
+            } else {
+                // Print:
+                rt_printf("%d (READ_IMG_TASK) Error sending telemetry"
+                    " packet transfer frames\n",get_tm_sec());
             }
-            // Print:
-            rt_printf("%d (READ_IMG_TASK) All %d telemetry packet transfer"
-                " frames sent to filter table task\n",time(NULL),\
-                num_tlm_pkt_xfr_frm_req);
         } else {
             // Print:
             rt_printf("%d (READ_IMG_TASK) Image classified to not have an"
-                " aurora by IPS; ignoring image\n",time(NULL));
+                " aurora by IPS; ignoring image\n",get_tm_sec());
 
             // Increment counter:
             img_rej_cnt++;
@@ -2,10 +2,10 @@
 //
 // Read MDQ (Magnetometer DAQ)
 //
-// Task responsible for reading data from the magnetometer DAQ, creating
-// telemetry packet transfer frames from the source data, and sending those
-// frames to the filter table task via message queue for for either downlink
-// or recording to storage for later downlink.
+// Task responsible for reading data from the magnetometer DAQ and sending the
+// source data to the aggregate telemetry task via message queue, which packs
+// reads into telemetry packet transfer frames for the filter table task for
+// either downlink or recording to storage for later downlink.
 //
 // DAQ initialization is performed by the command mdq task by calling a
 // function that enables channels 0, 1, and 2 and sets the sampling rate to
@@ -25,6 +25,11 @@
 // 8 bits, so the measurement in each channel is composed of two chars: the one
 // at 2n and the one at 2n+1.
 //
+// If the magnetometer DAQ codec is selected (command mdq task), each read is
+// encoded (mdq_cdc.h: per channel difference, zigzag, and bit packing)
+// before it is sent to the aggregate telemetry task. A read that does not
+// get smaller is sent raw.
+//
 // White paper for communication protocol:
 // https://www.dataq.com/resources/pdfs/misc/DI-4108-DI-4208-Protocol.pdf
 // -------------------------------------------------------------------------- /
@@ -71,20 +76,23 @@
 #include <sems.h>                // Semaphore variable declarations
 #include <mdq_dev.h>             // Magnetometer DAQ device variable
                                  // declarations
-#include <crt_tlm_pkt_xfr_frm.h> // Create telemetry packet transfer frame
-                                 // function declaration
+#include <agg_tlm_pkt.h>         // Aggregated telemetry packet sub-header
+#include <agg_tlm.h>             // Aggregate telemetry declarations
+#include <mdq_cdc.h>             // Magnetometer DAQ codec
+#include <hk_tlm_var.h>          // Housekeeping telemetry variable
+                                 // declarations
+#include <tm_svc.h>              // Time service declarations
 
 // Macro definitions:
 #define MDQ_READ_SIZE     768     // Magnetometer DAQ read size in bytes
 #define MDQ_SRC_DAT_SIZE 1064     // Magnetometer DAQ source data message queue
                                   // size in bytes
-#define TLM_PKT_XFR_FRM_SIZE 1089 // Telemetry transfer frame size in bytes
 
 #define APID_MDQ 0xC8 // Magnetometer DAQ origin
 
 // Message queue definitions:
-RT_QUEUE flt_tbl_msg_queue; // For telemetry packet transfer frames
-                            // (read_mdq/img/get_hk_tlm --> flt_tbl_task)
+RT_QUEUE agg_tlm_msg_queue; // For telemetry samples
+                            // (read_mdq/get_hk_tlm --> agg_tlm_task)
 
 // Semaphore definitions:
 RT_SEM flt_tbl_sem;  // For flt_tbl_task, read_mdq/img, and get_hk_tlm task
@@ -96,56 +104,51 @@ RT_SEM read_mdq_sem; // For cmd_mdq and read_mdq task synchronization to
 // Variable declarations:
 libusb_device_handle* dev_hdl;    // Device handle
 libusb_context* ctx;              // libusb session
-uint16_t tlm_pkt_xfr_frm_seq_cnt; // Packet sequence count
 
 void read_mdq(void) {
     // Print:
-    rt_printf("%d (READ_MDQ_TASK) Task started\n",time(NULL));
+    rt_printf("%d (READ_MDQ_TASK) Task started\n",get_tm_sec());
 
     // Task synchronize with filter table task:
     // (wait for task to be ready to telemetry packet transfer frames)
     rt_printf("%d (READ_MDQ_TASK) Waiting for filter table task"
-        " to be ready\n",time(NULL));
+        " to be ready\n",get_tm_sec());
 
     // Wait for signals:
     rt_sem_p(&flt_tbl_sem,TM_INFINITE);
 
     // Print:
     rt_printf("%d (READ_MDQ_TASK) Filter table task is ready;"
-        " continuing\n",time(NULL));
+        " continuing\n",get_tm_sec());
 
     // Synchronization with initialize magnetometer DAQ called by command
     // DAQ task:
     // (Wait for initialization)
     rt_printf("%d (READ_MDQ_TASK) Waiting for magnetometer DAQ initialization"
-        " to complete\n",time(NULL));
+        " to complete\n",get_tm_sec());
 
     // Wait for signal:
     rt_sem_p(&mdq_init_sem,TM_INFINITE);
 
     // Print:
     rt_printf("%d (READ_MDQ_TASK) DAQ initialization complete;"
-        " continuing\n",time(NULL));
+        " continuing\n",get_tm_sec());
 
     // Definitions and initializations:
     int8_t ret_val; // Function return value
 
-    uint16_t bytes = 0; // Bytes written or received
-
-    uint8_t tlm_pkt_xfr_frm_grp_flg = 3; // Packet sequence grouping flag
+    uint16_t bytes = 0;   // Bytes written or received
+    size_t   enc_size;    // Encoded read size in bytes
 
-    char mdq_buf[MDQ_READ_SIZE]; // Buffer for MDQ
-
-    char tlm_pkt_xfr_frm_buf[TLM_PKT_XFR_FRM_SIZE]; // Buffer for telemetry
-                                                    // packet transfer frame
-                                                    // buffer
+    char mdq_buf[MDQ_READ_SIZE];     // Buffer for MDQ
+    char mdq_enc_buf[MDQ_READ_SIZE]; // Buffer for encoded MDQ read
 
     float chan0;
     float chan1;
     float chan2; //Channel defs for telemetry hack 
     // Print:
     rt_printf("%d (READ_MDQ_TASK) Ready to read magnetometer DAQ and"
-        " create telemetry packets\n",time(NULL));
+        " send telemetry samples\n",get_tm_sec());
 
     // Infinite loop to read magnetometer DAQ data if the DAQ is currently
     // readable (currently scanning). This is done using a semaphore that is
@@ -166,26 +169,21 @@ void read_mdq(void) {
 
         // (If no return error and number of bytes written is expected)
         if ((ret_val == 0) && (bytes == MDQ_READ_SIZE)) {
-            // Increment sequence count:
-            tlm_pkt_xfr_frm_seq_cnt++;
-
-            // Force counter roll over at 16384:
-            // (the field in the packet that sequence occupies is only
-            // 14 bits)
-            if (tlm_pkt_xfr_frm_seq_cnt > 16383) {
-                tlm_pkt_xfr_frm_seq_cnt = 1; // 1 because it's logical
-                                             // (0 ain't)
-            } 
-
-            // Create transfer frame:
-            crt_tlm_pkt_xfr_frm(mdq_buf,MDQ_READ_SIZE,\
-                tlm_pkt_xfr_frm_buf,APID_MDQ,\
-                tlm_pkt_xfr_frm_grp_flg,tlm_pkt_xfr_frm_seq_cnt);
+            // Encode read if codec is selected:
+            enc_size = 0;
+            if (mdq_cdc_flg) {
+                enc_size = enc_mdq_cdc(mdq_buf,\
+                    MDQ_READ_SIZE/MDQ_CDC_SCAN_SIZE,mdq_enc_buf,\
+                    MDQ_READ_SIZE);
+            }
 
-            // Send transfer frame to filter table task via message queue:
-            ret_val = rt_queue_write(&flt_tbl_msg_queue,\
-                &tlm_pkt_xfr_frm_buf,TLM_PKT_XFR_FRM_SIZE,\
-                Q_NORMAL); // Append message to queue
+            // Send read (encoded or raw) to aggregate telemetry task via
+            // message queue:
+            if (enc_size > 0) {
+                ret_val = send_agg_tlm(mdq_enc_buf,enc_size,APID_MDQ,1);
+            } else {
+                ret_val = send_agg_tlm(mdq_buf,MDQ_READ_SIZE,APID_MDQ,0);
+            }
 
 
 
@@ -224,33 +222,20 @@ void read_mdq(void) {
 //////////////////////////////////////////////////////
 
             // Check success:
-            if ((ret_val > 0) || (ret_val == 0)) {
-                // Print:
-                rt_printf("%d (READ_MDQ_TASK) Telemetry packet transfer"
-                    " frame sent to filter table task\n",time(NULL));
-            } else if (ret_val == -ENOMEM) {
-                // Wait for a set time to allow filter table task to
-                // process message queue:
-                sleep(0.35);
-
-                // Send transfer frame to filter table task via message queue:
-                ret_val = rt_queue_write(&flt_tbl_msg_queue,\
-                    &tlm_pkt_xfr_frm_buf,TLM_PKT_XFR_FRM_SIZE,\
-                    Q_NORMAL); // Append message to queue
-            } else {
+            if (ret_val < 0) {
                 // Print:
                 rt_printf("%d (READ_MDQ_TASK) Error sending telemetry"
-                    " packet transfer frame\n",time(NULL));
-                // NEED ERROR HANDLING
+                    " sample to aggregate telemetry task; error %d\n",\
+                    get_tm_sec(),ret_val);
             }
         } else if (bytes != MDQ_READ_SIZE) {
             // Print:
             rt_printf("%d (READ_MDQ_TASK) Number of bytes read (%d) from DAQ"
-                " is not what is expected; ignoring data\n",time(NULL),bytes);
+                " is not what is expected; ignoring data\n",get_tm_sec(),bytes);
         } else {
             // Print:
             rt_printf("%d (SEND_MDQ_CMD) Error reading DAQ;"
-                " error %d\n",time(NULL),ret_val);
+                " error %d\n",get_tm_sec(),ret_val);
         }
     }
 
@@ -18,30 +18,11 @@
 // imaging data is received from command software task via synchronous message
 // passing.
 //
-// File retrieval is done by reading directory listing files created by
-// create file task. These listings are in time order such that files are
-// downlinked oldest -> newest. Files are found as binary files in the
-// following tree (names may not be correct but structure is)
-//
-//  |--raw_record_tlm
-//     |-- mdq
-//         |-- sec_msec.dat
-//         |-- sec_msec.dat
-//         |-- ...
-//         |-- mdq_dir.ls
-//     |-- img
-//         |-- sec_msec
-//             |-- 1.dat
-//             |-- 2.dat
-//             |-- ...
-//             |-- n.dat
-//         |-- sec_msec_dir.ls
-//         |-- ...
-//     |-- hk
-//         |-- sec_msec.dat
-//         |-- sec_msec.dat
-//         |-- ...
-//         |-- hk_dir.ls
+// Recorded frames of the requested classes in the staged time window are
+// played back oldest -> newest within each class, up to the staged byte
+// budget (see pbk_rec_tlm.h). Frames are paced to the staged share of the
+// link rate, and a playback resumes after the last frame of the previous
+// one. Progress is published in pbk_prog_flg.
 //
 // -------------------------------------------------------------------------- /
 //
@@ -72,7 +53,6 @@
 #include <string.h>  // String function definitions 
 #include <stdint.h>  // Standard integer types
 #include <time.h>    // Standard time types
-#include <dirent.h>  // Pseudo standard directory listing library
 
 // Xenomai libraries:
 #include <alchemy/task.h>  // Task management service
@@ -81,24 +61,22 @@
 #include <alchemy/timer.h> // Timer management services
 
 // Header files:
-#include <msg_queues.h> // Message queue variable declarations
-#include <sems.h>       // Semaphore variable declarations
-#include <hk_tlm_var.h> // Housekeeping telemetry variable
-                        // declarations
+#include <msg_queues.h>   // Message queue variable declarations
+#include <sems.h>         // Semaphore variable declarations
+#include <hk_tlm_var.h>   // Housekeeping telemetry variable
+                          // declarations
+#include <tlm_frm_pool.h> // Telemetry frame pool declarations
+#include <rec_tlm.h>      // Record telemetry declarations
+#include <pbk_rec_tlm.h>  // Play back recorded telemetry declarations
+#include <tm_svc.h>       // Time service declarations
 
 // Macro definitions:
 #define CMD_XFR_FRM_SIZE       15 // Command transfer frame size in bytes
 #define RPLY_MSG_SIZE           1 // Command execution status reply message to
                                   // command executor task size in bytes
-#define TLM_PKT_XFR_FRM_SIZE 1089 // Telemetry packet transfer frame size in
-                                  // bytes
-
-#define ARG_HK  0x00 // Command argument: Housekeeping telemetry
-#define ARG_MAG 0x01 // Command argument: Magnetometer
-#define ARG_IMG 0x02 // Command argument: Imaging
 
 // Message queue definitions:
-RT_QUEUE tx_tlm_pkt_msg_queue; // For telemetry packets
+RT_QUEUE tx_tlm_pkt_msg_queue; // For telemetry frame handles
                                // (flt_tbl_task/rtrv_file_task
                                // --> tx_tlm_pkt_task)
 
@@ -109,45 +87,35 @@ RT_SEM rtrv_file_sem;    // For rtrv_file_task and cmd_sw_task
                          // synchronization
 
 // Global variables:
-uint8_t pbk_prog_flg = 0; // Playback in progress flag
+uint8_t pbk_prog_flg = 0; // Playback progress (0: idle; 1-100: percent)
 uint8_t cmd_exec_suc_cnt; // Commands executed successfully counter
 uint8_t cmd_exec_err_cnt; // Commands not executed (error) counter
 
 void rtrv_file(void* arg) {
 	// Print:
-    rt_printf("%d (RTRV_FILE_TASK) Task started\n",time(NULL));
+    rt_printf("%d (RTRV_FILE_TASK) Task started\n",get_tm_sec());
 
     // Task synchronize with transmit telemetry packet task:
     // (wait for task to be ready to receive telemetry packets)
     rt_printf("%d (RTRV_FILE_TASK) Waiting for transmit telemetry packet"
-        " task to be ready \n",time(NULL));
+        " task to be ready \n",get_tm_sec());
 
     // Wait for signal:
     rt_sem_p(&tx_tlm_pkt_sem,TM_INFINITE);
 
     // Print:
     rt_printf("%d (RTRV_FILE_TASK) Transmit telemetry packet task is ready;"
-        " continuing\n",time(NULL));
+        " continuing\n",get_tm_sec());
 
     // Definitions and initializations:
-    uint16_t file_cnt = 0; // Retrieved file count
+    uint32_t file_cnt = 0; // Retrieved frame count
+    uint32_t byte_cnt;     // Retrieved bytes (on the line)
     int16_t ret_val;       // Function return value
     int8_t  flw_id;        // Flow identifier returned by rt_task_receive
 
-    uint32_t cmd_arg; // Command APID
-
-    DIR* dir;           // Directory
-    struct dirent* ent; // Directory entry (file) 
+    struct pbk_rec_tlm_sel pbk_sel; // Playback selection
 
-    FILE* dir_ls_file_ptr;   // Directory listing file pointer
-    FILE* src_dat_file_ptr;  // Source data file
-    char file_line[100];     // File line
-    char file_name[100];     // File name
-    char file_path[100];     // File path
-
-    char tlm_pkt_xfr_frm_buf[TLM_PKT_XFR_FRM_SIZE]; // Buffer for telemetry
-                                                    // packet transfer frame
-                                                    // buffer
+    uint32_t cmd_arg; // Command APID
 
     char cmd_xfr_frm_buf[CMD_XFR_FRM_SIZE]; // Buffer for command transfer
                                             // frame
@@ -170,7 +138,7 @@ void rtrv_file(void* arg) {
     // Task synchronize with command software task
     // (tell task that it is now ready receive command transfer frames)
     rt_printf("%d (RTRV_FILE_TASK) Ready to receive command transfer"
-        " frames\n",time(NULL));
+        " frames\n",get_tm_sec());
 
     // Signal task to continue executing:
     rt_sem_v(&rtrv_file_sem);
@@ -189,27 +157,29 @@ void rtrv_file(void* arg) {
         if (flw_id > 0) {
             // Print
             rt_printf("%d (RTRV_FILE_TASK) Received command transfer"
-                " frame\n",time(NULL));
+                " frame\n",get_tm_sec());
         } else {
             // Print
             rt_printf("%d (RTRV_FILE_TASK) Error receiving command transfer"
-                " frame\n",time(NULL));
+                " frame\n",get_tm_sec());
             // NEED ERROR HANDLING
         }
 
         // Parse command transfer frame:
         memcpy(&cmd_arg,cmd_xfr_frm_buf+11,4);
 
-        // Check command argument to retrieve files:
-        if (cmd_arg == ARG_HK) { 
+        // Check command argument and get playback selection (classes from
+        // argument; staged window and byte budget):
+        if (get_pbk_rec_tlm_sel(cmd_arg,&pbk_sel) == 0) { 
             // Print:
-            rt_printf("%d (RTRV_FILE_TASK) Starting stored housekeeping"
-                " data playback\n",time(NULL));
+            rt_printf("%d (RTRV_FILE_TASK) Starting stored data playback"
+                " (classes 0x%X)\n",get_tm_sec(),pbk_sel.cls_msk);
 
             // Set flag:
             pbk_prog_flg = 1; // In progress
 
-            // Set execution status to successful:
+            // Set execution status to unknown (counted below when playback
+            // is done):
             cmd_exec_stat = -1;
 
             // Reply to command executor task with command execution status:
@@ -219,292 +189,43 @@ void rtrv_file(void* arg) {
             if (ret_val == 0) {
                 // Print:
                 rt_printf("%d (RTRV_FILE_TASK) Reply message sent to command"
-                    " software task\n",time(NULL));
+                    " software task\n",get_tm_sec());
             } else {
                 // Print:
                 rt_printf("%d (RTRV_FILE_TASK) Error sending reply message to"
-                    " execute command task\n",time(NULL));
+                    " execute command task\n",get_tm_sec());
             }
 
-            // Open directory listing file:
-            dir_ls_file_ptr = fopen("../raw_record_tlm/hk/hk_dir.ls","r");
-
-            // Loop to read directory listing file:
-            while (fgets(file_line,sizeof(file_line),dir_ls_file_ptr) != NULL) {
-                // Strip newline character:
-                file_line[strcspn(file_line,"\n")] = 0;
-
-                // Ignore directory listing file:
-                if (strcmp(file_line,"hk_dir.ls") != 0) {
-                    // Append directory to file name:
-                    sprintf(file_path,"../raw_record_tlm/hk/%s",file_line);
-
-                    // Open file to read
-                    src_dat_file_ptr = fopen(file_path,"rb");
-
-                    // Read file:
-                    fread(&tlm_pkt_xfr_frm_buf,1,TLM_PKT_XFR_FRM_SIZE,\
-                        src_dat_file_ptr);
-
-                    // Send transfer frame to transmit telemetry packet task via
-                    // message queue:
-                    ret_val = rt_queue_write(&tx_tlm_pkt_msg_queue,\
-                        &tlm_pkt_xfr_frm_buf,TLM_PKT_XFR_FRM_SIZE,\
-                        Q_NORMAL); // Append message to queue
-
-                    // Check success:
-                    if ((ret_val > 0) || (ret_val == 0)) {
-                        // Print:
-                        rt_printf("%d (RTRV_FILE_TASK) Telemetry packet"
-                            " transfer frame sent to transmit telemetry packet"
-                            " task\n",time(NULL));
-                    } else if (ret_val == -ENOMEM) {
-                        // Wait for a set time to allow transmit task to
-                        // process message queue:
-                        sleep(0.35);
-
-                        // Send transfer frame to filter table task via message
-                        // queue:
-                        ret_val = rt_queue_write(&tx_tlm_pkt_msg_queue,\
-                            &tlm_pkt_xfr_frm_buf,TLM_PKT_XFR_FRM_SIZE,\
-                            Q_NORMAL); // Append message to queue
-                    } else {
-                        // Print:
-                        rt_printf("%d (RTRV_FILE_TASK) Error sending telemetry"
-                            " packet transfer frame\n",time(NULL));
-                        // NEED ERROR HANDLING
-                    }
-
-                    // Close file:
-                    fclose(src_dat_file_ptr);
-
-                    // Increment file count:
-                    file_cnt++;
-                }
-            }
+            // Play back selected recorded frames:
+            file_cnt = pbk_rec_tlm(&pbk_sel,&byte_cnt);
 
-            // Check if any files were playedback:
+            // Check if any frames were played back:
             if (file_cnt > 0) {
                 // Print:
-                rt_printf("%d (RTRV_FILE_TASK) Housekeeping data playback"
-                    " complete\n",time(NULL));
+                rt_printf("%d (RTRV_FILE_TASK) Stored data playback complete"
+                    " (%u frames, %u bytes)\n",get_tm_sec(),file_cnt,\
+                    byte_cnt);
             } else {
                 // Print:
-                rt_printf("%d (RTRV_FILE_TASK) No housekeeping data"
-                    " recorded to playback\n",time(NULL));
+                rt_printf("%d (RTRV_FILE_TASK) No data recorded in playback"
+                    " window\n",get_tm_sec());
             }
 
-            // Close file:
-            fclose(dir_ls_file_ptr);
-        } else if (cmd_arg == ARG_MAG) {
-            // Print:
-            rt_printf("%d (RTRV_FILE_TASK) Starting stored magnetometer DAQ"
-                " playback\n",time(NULL));
-
-            // Set flag:
-            pbk_prog_flg = 1; // In progress
-
-            // Set execution status to successful:
-            cmd_exec_stat = -1;
-
-            // Reply to command executor task with command execution status:
-            ret_val = rt_task_reply(flw_id,&rply_mcb);
-
-            // Check for success:
-            if (ret_val == 0) {
-                // Print:
-                rt_printf("%d (RTRV_FILE_TASK) Reply message sent to command"
-                    " software task\n",time(NULL));
-            } else {
-                // Print:
-                rt_printf("%d (RTRV_FILE_TASK) Error sending reply message to"
-                    " execute command task\n",time(NULL));
-            }
-
-            // Open directory listing file:
-            dir_ls_file_ptr = fopen("../raw_record_tlm/mdq/mdq_dir.ls", "r");
-
-            // Loop to read directory listing file:
-            while (fgets(file_line,sizeof(file_line),dir_ls_file_ptr) != NULL) {
-                // Strip newline character:
-                file_line[strcspn(file_line,"\n")] = 0;
-
-                // Ignore directory listing file:
-                if (strcmp(file_line,"mdq_dir.ls") != 0) {
-                    // Append directory to file name:
-                    sprintf(file_path,"../raw_record_tlm/mdq/%s",file_line);
-
-                    // Open file to read
-                    src_dat_file_ptr = fopen(file_path,"rb");
-
-                    // Read file:
-                    fread(&tlm_pkt_xfr_frm_buf,1,TLM_PKT_XFR_FRM_SIZE,\
-                        src_dat_file_ptr);
-
-                    // Send transfer frame to transmit telemetry packet task
-                    // via message queue:
-                    ret_val = rt_queue_write(&tx_tlm_pkt_msg_queue,\
-                        &tlm_pkt_xfr_frm_buf,TLM_PKT_XFR_FRM_SIZE,\
-                        Q_NORMAL); // Append message to queue
-
-                    // Check success:
-                    if ((ret_val > 0) || (ret_val == 0)) {
-                        // Print:
-                        rt_printf("%d (RTRV_FILE_TASK) Telemetry packet"
-                            " transfer frame sent to transmit telemetry packet"
-                            " task\n",time(NULL));
-                    } else if (ret_val == -ENOMEM) {
-                        // Wait for a set time to allow transmit task to
-                        // process message queue:
-                        sleep(0.35);
-
-                        // Send transfer frame to filter table task via message
-                        // queue:
-                        ret_val = rt_queue_write(&tx_tlm_pkt_msg_queue,\
-                            &tlm_pkt_xfr_frm_buf,TLM_PKT_XFR_FRM_SIZE,\
-                            Q_NORMAL); // Append message to queue
-                    } else {
-                        // Print:
-                        rt_printf("%d (RTRV_FILE_TASK) Error sending telemetry"
-                            " packet transfer frame\n",time(NULL));
-                        // NEED ERROR HANDLING
-                    }
-
-                    // Close file:
-                    fclose(src_dat_file_ptr);
-
-                    // Increment file count:
-                    file_cnt++;
-                }
-            }
-
-            // Check if any files were playedback:
+            // Check if data was played back:
             if (file_cnt > 0) {
-                // Print:
-                rt_printf("%d (RTRV_FILE_TASK) Magnetometer DAQ data playback"
-                    " complete\n",time(NULL));
+                // Increment counter:
+                ++cmd_exec_suc_cnt;
             } else {
-                // Print:
-                rt_printf("%d (RTRV_FILE_TASK) No magnetometer DAQ data"
-                    " recorded to playback\n",time(NULL));
+                // Increment counter:
+                ++cmd_exec_err_cnt;
             }
-
-            // Close file:
-            fclose(dir_ls_file_ptr);
-        } else if (cmd_arg == ARG_IMG) {
-            // Print:
-            rt_printf("%d (RTRV_FILE_TASK) Starting stored imaging data"
-                " playback\n",time(NULL));
-
-            // Set flag:
-            pbk_prog_flg = 1; // In progress
-
-            // Set execution status to successful:
-            cmd_exec_stat = -1;
-
-            // Reply to command executor task with command execution status:
-            ret_val = rt_task_reply(flw_id,&rply_mcb);
-
-            // Check for success:
-            if (ret_val == 0) {
-                // Print:
-                rt_printf("%d (RTRV_FILE_TASK) Reply message sent to command"
-                    " software task\n",time(NULL));
-            } else {
-                // Print:
-                rt_printf("%d (RTRV_FILE_TASK) Error sending reply message to"
-                    " execute command task\n",time(NULL));
-            }
-
-            // Open directory:
-            dir = opendir("../raw_record_tlm/img/");
-
-            // Loop to read directory listing file:
-            while ((ent = readdir(dir)) != NULL) {
-                // Only accept listing files (and not directories):
-                if(strstr(ent->d_name, "_dir.ls") != NULL) {
-                    // Create full file name:
-                    sprintf(file_name,"../raw_record_tlm/img/%s",ent->d_name);
-
-                    // Open directory listing file:
-                    dir_ls_file_ptr = fopen(file_name, "r");
-
-                    // Loop to read directory listing file:
-                    while (fgets(file_line,sizeof(file_line),\
-                        dir_ls_file_ptr)) {
-                        // Strip newline character:
-                        file_line[strcspn(file_line,"\n")] = 0;
-
-                        // Append directory to file name:
-                        sprintf(file_path,"../raw_record_tlm/img/%.*s/%s",14,\
-                            ent->d_name,file_line);
-
-                        // Open file to read
-                        src_dat_file_ptr = fopen(file_path,"rb");
-
-                        // Read file:
-                        ret_val = fread(&tlm_pkt_xfr_frm_buf,1,\
-                            TLM_PKT_XFR_FRM_SIZE,src_dat_file_ptr);
-
-                        // Send transfer frame to transmit telemetry packet
-                        // task via message queue:
-                        ret_val = rt_queue_write(&tx_tlm_pkt_msg_queue,\
-                            &tlm_pkt_xfr_frm_buf,TLM_PKT_XFR_FRM_SIZE,\
-                            Q_NORMAL); // Append message to queue
-
-                        // Check success:
-                        if ((ret_val > 0) || (ret_val == 0)) {
-                            // Print:
-                            rt_printf("%d (RTRV_FILE_TASK) Telemetry packet"
-                                " transfer frame sent to transmit telemetry"
-                                " packet task\n",time(NULL));
-                        } else if (ret_val == -ENOMEM) {
-                            // Wait for a set time to allow transmit task to
-                            // process message queue:
-                            sleep(0.35);
-
-                            // Send transfer frame to filter table task via
-                            // message queue:
-                            ret_val = rt_queue_write(&tx_tlm_pkt_msg_queue,\
-                                &tlm_pkt_xfr_frm_buf,TLM_PKT_XFR_FRM_SIZE,\
-                                Q_NORMAL); // Append message to queue
-                        } else {
-                            // Print:
-                            rt_printf("%d (RTRV_FILE_TASK) Error sending"
-                                " telemetry packet transfer frame\n",\
-                                time(NULL));
-                            // NEED ERROR HANDLING
-                        }
-                        // Close file:
-                        fclose(src_dat_file_ptr);
-
-                        // Increment file count:
-                        file_cnt++;
-                    }
-                    // Close listing file:
-                    fclose(dir_ls_file_ptr);
-                }
-            }
-
-            // Check if any files were playedback:
-            if (file_cnt > 0) {
-                // Print:
-                rt_printf("%d (RTRV_FILE_TASK) Image data playback"
-                    " complete\n",time(NULL));
-            } else {
-                // Print:
-                rt_printf("%d (RTRV_FILE_TASK) No image data"
-                    " recorded to playback\n",time(NULL));
-            }
-
-            // Close directory:
-            closedir(dir);
         } else {
           // Print:
             rt_printf("%d (RTRV_FILE_TASK) Command argument not recognized; "
-                " ignoring command transfer frame\n",time(NULL));
+                " ignoring command transfer frame\n",get_tm_sec());
 
-            // Set execution status to successful:
+            // Set execution status to not executed (counted by command
+            // executor task):
             cmd_exec_stat = 0;
 
             // Reply to command executor task with command execution status:
@@ -514,23 +235,14 @@ void rtrv_file(void* arg) {
             if (ret_val == 0) {
                 // Print:
                 rt_printf("%d (RTRV_FILE_TASK) Reply message sent to command"
-                    " software task\n",time(NULL));
+                    " software task\n",get_tm_sec());
             } else {
                 // Print:
                 rt_printf("%d (RTRV_FILE_TASK) Error sending reply message to"
-                    " execute command task\n",time(NULL));
+                    " execute command task\n",get_tm_sec());
             }
         }
 
-        // Check if data was played back:
-        if (file_cnt > 0) {
-            // Increment counter:
-            ++cmd_exec_suc_cnt;
-        } else {
-            // Increment counter:
-            ++cmd_exec_err_cnt;
-        }
-
         // Set flag:
         pbk_prog_flg = 0; // Idle
 
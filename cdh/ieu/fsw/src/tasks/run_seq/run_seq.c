@@ -0,0 +1,166 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Run Sequence
+//
+// Task responsible for executing stored command sequences (seq_tbl.h). The
+// task waits on its semaphore until the command software task starts a
+// sequence. Each step is then executed its relative delay after the previous
+// step: step times are accumulated from the start time, so execution time of
+// a step does not delay the steps after it. Each step is built into a
+// command transfer frame (execute now) and directed to its command
+// application task through the same dispatch as the command executor task
+// (send_cmd), and its execution status is counted.
+//
+// While waiting for a step, the task also waits on its semaphore, so a stop
+// request ends the sequence before its next step. Once the last step is
+// executed (or the sequence is stopped) the task is idle again and another
+// sequence can be started.
+//
+// -------------------------------------------------------------------------- /
+//
+// Dependencies:
+// - Xenomai 3 / Cobalt
+//
+// Input Arguments:
+// - N/A
+//
+// Output Arguments:
+// - N/A
+//
+// -------------------------------------------------------------------------- /
+//
+// agent
+// Project HEPCATS
+// Subsystem: C&DH
+// Created: October 17, 2026
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Standard libraries:
+#include <errno.h>   // Error number definitions
+#include <string.h>  // String function definitions
+#include <stdint.h>  // Standard integer types
+
+// Xenomai libraries:
+#include <alchemy/task.h>  // Task management service
+#include <alchemy/sem.h>   // Semaphore services
+#include <alchemy/timer.h> // Timer management services
+
+// Header files:
+#include <sems.h>       // Semaphore variable declarations
+#include <hk_tlm_var.h> // Housekeeping telemetry variable declarations
+#include <seq_tbl.h>    // Sequence table declarations
+#include <send_cmd.h>   // Send command declarations
+#include <tm_svc.h>     // Time service declarations
+
+// Macro definitions:
+#define CMD_XFR_FRM_SIZE 15 // Command transfer frame size in bytes
+
+// Semaphore definitions:
+RT_SEM run_seq_sem; // For cmd_sw and run_seq task synchronization
+                    // (sequence started or stop requested)
+
+// Wait until step time (returns -1 if stop requested)
+static int8_t wait_seq_step(uint64_t tm) {
+    // Definitions and initializations:
+    int ret_val; // Function return value
+
+    // Wait until step time; a token without stop request is stale (stop
+    // request of a previous sequence) and ignored:
+    do {
+        ret_val = rt_sem_p_until(&run_seq_sem,get_tm_tck(tm));
+        if (get_stp_seq()) {
+            return -1;
+        }
+    } while (ret_val == 0);
+
+    return 1;
+}
+
+void run_seq(void* arg) {
+    // Print:
+    rt_printf("%d (RUN_SEQ_TASK) Task started\n",get_tm_sec());
+
+    // Definitions and initializations:
+    int8_t   ret_val; // Function return value
+    uint8_t  id;      // Running sequence ID
+    uint16_t i;       // Step
+    uint64_t tm;      // Step time (ns since epoch)
+    uint32_t sec;     // Frame execution time (seconds)
+    uint16_t msec;    // Frame execution time (milliseconds)
+    uint8_t  atc_flg; // Frame ATC flag
+
+    const struct seq_tbl_seq* seq; // Running sequence
+
+    char cmd_xfr_frm_buf[CMD_XFR_FRM_SIZE]; // Buffer for command transfer
+                                            // frame
+
+    // Infinite loop to wait for a sequence to start and execute its steps:
+    while (1) {
+        // Wait for a sequence to start (or a stale stop request):
+        rt_sem_p(&run_seq_sem,TM_INFINITE);
+        id = __atomic_load_n(&seq_run_id,__ATOMIC_SEQ_CST);
+        if (id == SEQ_TBL_NONE) {
+            get_stp_seq();
+            continue;
+        }
+        seq = get_seq(id);
+
+        // Print:
+        rt_printf("%d (RUN_SEQ_TASK) Sequence %d started (%d steps)\n",\
+            get_tm_sec(),id,seq->nstep);
+
+        // Execute steps:
+        tm = get_tm_ns();
+        for (i = 0; i < seq->nstep; ++i) {
+            // Wait for step time:
+            tm += (uint64_t) seq->step[i].dly_ms*1000000;
+            if (wait_seq_step(tm) < 0) {
+                // Print:
+                rt_printf("%d (RUN_SEQ_TASK) Sequence %d stopped before step"
+                    " %d\n",get_tm_sec(),id,i);
+
+                break;
+            }
+
+            // Build command transfer frame (execute now):
+            atc_flg = 0;
+            sec = get_tm_sec();
+            msec = 0;
+            memcpy(cmd_xfr_frm_buf+0,&seq->step[i].apid,2);
+            memcpy(cmd_xfr_frm_buf+2,&seq->step[i].pkt_name,2);
+            memcpy(cmd_xfr_frm_buf+4,&atc_flg,1);
+            memcpy(cmd_xfr_frm_buf+5,&sec,4);
+            memcpy(cmd_xfr_frm_buf+9,&msec,2);
+            memcpy(cmd_xfr_frm_buf+11,&seq->step[i].arg,4);
+
+            // Send command to its command application task:
+            ret_val = send_cmd(cmd_xfr_frm_buf);
+
+            // Count step execution status (a step whose status is not
+            // known yet, e.g. playback started, counts as executed):
+            if (ret_val > 0) {
+                ++seq_suc_cnt;
+            } else {
+                ++seq_err_cnt;
+
+                // Print:
+                rt_printf("%d (RUN_SEQ_TASK) Sequence %d step %d (0x%X:0x%X)"
+                    " did not execute\n",get_tm_sec(),id,i,\
+                    seq->step[i].apid,seq->step[i].pkt_name);
+            }
+        }
+
+        // Print:
+        if (i == seq->nstep) {
+            rt_printf("%d (RUN_SEQ_TASK) Sequence %d complete\n",\
+                get_tm_sec(),id);
+        }
+
+        // Idle (another sequence can be started):
+        __atomic_store_n(&seq_run_id,SEQ_TBL_NONE,__ATOMIC_SEQ_CST);
+    }
+
+    // Will never reach this:
+    return;
+}
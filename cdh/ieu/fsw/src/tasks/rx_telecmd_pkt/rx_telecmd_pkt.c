@@ -7,6 +7,22 @@
 // packets. Once a packet is received, it is sent to the telecommand packet
 // processor task via message queue.
 //
+// Every telecommand packet is preceded by the CCSDS attached sync marker
+// (ccsds_asm.h), as on the downlink. Bytes from the port are collected in a
+// receive buffer that is searched for the marker. The primary header after
+// the marker must be a telecommand packet header of the fixed telecommand
+// length, and the packet must pass its packet error control (CRC) before it
+// is sent on. A marker that fails either check is a false lock: the search
+// resumes one byte past it. A byte dropped or inserted on the uplink
+// therefore costs at most the packet it hits; the receiver resynchronizes on
+// the marker of the next packet instead of misaligning every packet after
+// it. Since the length is fixed, a corrupted length field never makes the
+// receiver wait for bytes that are not part of the packet.
+//
+// Sync losses (bytes skipped or markers rejected while in sync),
+// resynchronizations (packets received after a sync loss), and CRC failures
+// are counted in housekeeping telemetry.
+//
 // -------------------------------------------------------------------------- /
 //
 // Dependencies:
@@ -32,6 +48,7 @@
 #include <stdlib.h>  // Standard library
 #include <unistd.h>  // UNIX standard function definitions
 #include <errno.h>   // Error number definitions
+#include <string.h>  // String function definitions
 #include <stdint.h>  // Standard integer types
 #include <time.h>    // Standard time types
 
@@ -45,10 +62,16 @@
 #include <msg_queues.h> // Message queue variable declarations
 #include <sems.h>       // Semaphore variable declarations
 #include <hk_tlm_var.h> // Housekeeping variable declarations
+#include <tm_svc.h>     // Time service declarations
+#include <ccsds_pkt.h>  // CCSDS packet codec
+#include <ccsds_crc.h>  // CCSDS packet error control (CRC)
+#include <ccsds_asm.h>  // CCSDS attached sync marker
 
 // Macro definitions:
 #define TELECMD_PKT_SIZE 20 // Telecommand packet size in bytes
 #define B2400       0000013 // Baud rate (as defined in terminos.h)
+#define RX_BUF_SIZE \
+    (4*(CCSDS_ASM_SIZE+TELECMD_PKT_SIZE)) // Receive buffer size in bytes
 
 // Message queue definitions:
 RT_QUEUE telecmd_pkt_msg_queue; // For telecommand packets
@@ -62,33 +85,93 @@ RT_SEM rx_telecmd_pkt_sem; // For rx_telecmd_pkt_task and proc_telecmd_pkt_task
 // Housekeeping telemetry variable definitions:
 uint8_t rx_telecmd_pkt_cnt = 0; // Received telecommand packet count
 
+// Receive buffer:
+static char   rx_buf[RX_BUF_SIZE];
+static size_t rx_len = 0; // Bytes in receive buffer
+
+// Read available bytes from port into receive buffer
+static void fill_rx_buf(int fd) {
+    // Definitions and initializations:
+    ssize_t ret_val; // Function return value
+
+    // Read from port:
+    ret_val = read(fd,rx_buf+rx_len,RX_BUF_SIZE-rx_len);
+
+    // Check success:
+    if (ret_val > 0) {
+        // Increment bytes in buffer:
+        rx_len += ret_val;
+    } else {
+        // Print:
+        rt_printf("%d (RX_TELECMD_PKT_TASK) Error reading uplink"
+            " serial port\n",get_tm_sec());
+        // NEED ERROR HANDLING
+    }
+
+    return;
+}
+
+// Drop bytes from front of receive buffer
+static void drop_rx_buf(size_t bytes) {
+    memmove(rx_buf,rx_buf+bytes,rx_len-bytes);
+    rx_len -= bytes;
+
+    return;
+}
+
+// Skip bytes from front of receive buffer (sync lost if in sync)
+static void skp_rx_buf(size_t bytes, uint8_t* sync_flg) {
+    drop_rx_buf(bytes);
+
+    // Count sync loss:
+    if (*sync_flg) {
+        *sync_flg = 0;
+        ++telecmd_sync_loss_cnt;
+    }
+
+    return;
+}
+
+// Check primary header is a telecommand packet header (fixed length)
+static uint8_t val_telecmd_pri_hdr(const char* buffer) {
+    // Definitions and initializations:
+    struct ccsds_pri_hdr pri_hdr; // Packet primary header
+
+    // Decode primary header:
+    dec_ccsds_pri_hdr(buffer,&pri_hdr);
+
+    return (pri_hdr.vrs == CCSDS_VRS) && \
+        (pri_hdr.typ == CCSDS_TYP_TELECMD) && (pri_hdr.sec_hdr_flg == 1) && \
+        (pri_hdr.pkt_len == CCSDS_PKT_LEN(CCSDS_APP_DAT_SIZE));
+}
+
 void rx_telecmd_pkt(void* arg) {
     // Print:
-    rt_printf("%d (RX_TELECMD_PKT_TASK) Task started\n",time(NULL));
+    rt_printf("%d (RX_TELECMD_PKT_TASK) Task started\n",get_tm_sec());
 
     // Task synchronize with proc_telecmd_pkt_task
     // (Wait for task to be ready to receive and process packets)
     rt_printf("%d (RX_TELECMD_PKT_TASK) Waiting for process telecommand"
-        " packet task to be ready\n",time(NULL));
+        " packet task to be ready\n",get_tm_sec());
     
     // Wait for signal:
     rt_sem_p(&rx_telecmd_pkt_sem,TM_INFINITE);
 
     // Print:
     rt_printf("%d (RX_TELECMD_PKT_TASK) Process telecommand packet task is" 
-        " ready; continuing\n",time(NULL));
+        " ready; continuing\n",get_tm_sec());
 
     // Definitions and initializations:
-    int8_t fd;      // File descriptor for port
-    int8_t ret_val; // Function return value
+    int8_t  fd;           // File descriptor for port
+    int8_t  ret_val;      // Function return value
+    size_t  off;          // Offset of marker in receive buffer
+    uint8_t sync_flg = 1; // In sync flag (packet follows previous packet
+                          // directly)
 
     char* port = "/dev/ttyUSB0"; // Uplink serial port
 
     char telecmd_pkt_buf[TELECMD_PKT_SIZE]; // Buffer for telecommand packet
 
-    uint8_t bytes_left = TELECMD_PKT_SIZE; // Bytes left to read from port
-    uint8_t bytes_read = 0;                // Bytes read from port
-
     // Open port:
     fd = open_port(port,B2400);
 
@@ -96,41 +179,74 @@ void rx_telecmd_pkt(void* arg) {
     if (fd > 0) {
         // Success:
         rt_printf("%d (RX_TELECMD_PKT_TASK) Uplink serial port opened and"
-            " configured\n",time(NULL));
+            " configured\n",get_tm_sec());
     } else {
         // Print:
         rt_printf("%d (RX_TELECMD_PKT_TASK) Error opening and configuring"
-            " uplink serial port\n",time(NULL));
+            " uplink serial port\n",get_tm_sec());
         // NEED ERROR HANDLING
     }
 
     // Print 
     rt_printf("%d (RX_TELECMD_PKT_TASK) Ready to receive telecommand packets"
-        " on uplink serial port\n",time(NULL));
+        " on uplink serial port\n",get_tm_sec());
 
     // Infinite loop to read uplink serial port for telecommand packets:
     while(1) {
-        // Loop to read full telecommand packet:
-        while (bytes_left > 0 ) {
-            // Read from port:
-            ret_val = read(fd,&telecmd_pkt_buf[bytes_read],bytes_left);
-
-            // Check to see if entire packet is received:
-            if (ret_val > 0) {
-                // Increment and decrement counters:
-                bytes_read += ret_val;
-                bytes_left -= ret_val;
-            } else {
-                // Print:
-                rt_printf("%d (RX_TELECMD_PKT_TASK) Error reading uplink"
-                    " serial port\n",time(NULL));
-                // NEED ERROR HANDLING
-            }
+        // Search for marker (keep a partial marker at end of buffer):
+        off = find_ccsds_asm(rx_buf,rx_len);
+        if (off == rx_len) {
+            off = (rx_len < CCSDS_ASM_SIZE) ? 0 : rx_len-(CCSDS_ASM_SIZE-1);
+        }
+        if (off > 0) {
+            skp_rx_buf(off,&sync_flg);
+        }
+
+        // Wait for marker and primary header:
+        if (rx_len < CCSDS_ASM_SIZE+CCSDS_PRI_HDR_SIZE) {
+            fill_rx_buf(fd);
+            continue;
+        }
+
+        // Check primary header (false lock if not a telecommand header):
+        if (!val_telecmd_pri_hdr(rx_buf+CCSDS_ASM_SIZE)) {
+            skp_rx_buf(1,&sync_flg);
+            continue;
+        }
+
+        // Wait for remainder of packet:
+        if (rx_len < CCSDS_ASM_SIZE+TELECMD_PKT_SIZE) {
+            fill_rx_buf(fd);
+            continue;
+        }
+
+        // Check packet error control (false lock or corrupted packet):
+        if (get_be16(rx_buf+CCSDS_ASM_SIZE+TELECMD_PKT_SIZE-\
+            CCSDS_ERR_CNT_SIZE) != calc_ccsds_crc(rx_buf+CCSDS_ASM_SIZE,\
+            TELECMD_PKT_SIZE-CCSDS_ERR_CNT_SIZE)) {
+            ++telecmd_crc_err_cnt;
+            skp_rx_buf(1,&sync_flg);
+            continue;
+        }
+
+        // Copy packet out of receive buffer:
+        memcpy(telecmd_pkt_buf,rx_buf+CCSDS_ASM_SIZE,TELECMD_PKT_SIZE);
+        drop_rx_buf(CCSDS_ASM_SIZE+TELECMD_PKT_SIZE);
+
+        // Count resynchronization:
+        if (!sync_flg) {
+            sync_flg = 1;
+            ++telecmd_resync_cnt;
+
+            // Print:
+            rt_printf("%d (RX_TELECMD_PKT_TASK) Uplink resynchronized (%u"
+                " sync losses, %u CRC failures)\n",get_tm_sec(),\
+                telecmd_sync_loss_cnt,telecmd_crc_err_cnt);
         }
 
         // Print:
         rt_printf("%d (RX_TELECMD_PKT_TASK) Telecommand packet received from"
-            " uplink serial port\n",time(NULL));
+            " uplink serial port\n",get_tm_sec());
 
         // Increment counter:
         rx_telecmd_pkt_cnt++;
@@ -144,17 +260,13 @@ void rx_telecmd_pkt(void* arg) {
         if (ret_val > 0) {
             // Print:
             rt_printf("%d (RX_TELECMD_PKT_TASK) Telecommand packet sent to"
-                    " processor task\n",time(NULL));
+                    " processor task\n",get_tm_sec());
         } else {
             // Print:
             rt_printf("%d (RX_TELECMD_PKT_TASK) Error sending telecommand"
-                " packet sent to processor task\n",time(NULL));
+                " packet sent to processor task\n",get_tm_sec());
             // NEED ERROR HANDLING
         }
-
-        // Reset counters:
-        bytes_left = TELECMD_PKT_SIZE; // Bytes left to read
-        bytes_read = 0;                // Bytes read
     }
 
     // This will never be reached:
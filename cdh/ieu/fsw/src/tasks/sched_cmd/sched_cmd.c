@@ -13,7 +13,18 @@
 //     - ATC flag
 //     - Arguments
 //
-// DESCRIBE ALGORITHM HERE
+// Frames with ATC flag 1 are added to the schedule and frames with ATC flag
+// 2 cancel scheduled commands (atc_sched.h); the reply tells command
+// executor task whether the schedule was changed. Between frames, the task
+// waits with an absolute timeout at the execution time of the next command
+// (millisecond precision). Every command due is then written to the command
+// transfer frame message queue with its ATC flag cleared, so command
+// executor task executes it now, and removed from the schedule. If the
+// queue is full, the command is kept and written again after
+// SCHED_CMD_RTRY_NS.
+//
+// The next execution time and the number of scheduled commands are
+// published in housekeeping telemetry after every change.
 //
 // -------------------------------------------------------------------------- /
 //
@@ -40,6 +51,7 @@
 #include <stdlib.h>  // Standard library
 #include <unistd.h>  // UNIX standard function definitions
 #include <errno.h>   // Error number definitions
+#include <string.h>  // String function definitions
 #include <stdint.h>  // Standard integer types
 #include <time.h>    // Standard time types
 
@@ -47,15 +59,23 @@
 #include <alchemy/task.h>  // Task management service
 #include <alchemy/timer.h> // Timer management services
 #include <alchemy/sem.h>   // Semaphore services
+#include <alchemy/queue.h> // Message queue services
 
 // Header files:
-#include <sems.h> // Semaphore variable declarations
+#include <msg_queues.h> // Message queue variable declarations
+#include <sems.h>       // Semaphore variable declarations
+#include <atc_sched.h>  // Absolutely timed command schedule declarations
+#include <hk_tlm_var.h> // Housekeeping telemetry variable declarations
+#include <tm_svc.h>     // Time service declarations
 
 // Macro definitions:
 #define CMD_XFR_FRM_SIZE 15 // Command transfer frame size in bytes
 #define RPLY_MSG_SIZE     1 // Command execution status reply message to
                             // command executor task size in bytes
 
+#define SCHED_CMD_RTRY_NS 10000000 // Wait before writing a command again
+                                   // (queue full) in ns (10 ms)
+
 // Semaphore definitions:
 RT_SEM cmd_sched_sem; // For exec_cmd and cmd_sched task
                       // synchronization
@@ -66,13 +86,23 @@ RT_TASK_MCB cmd_xfr_frm_sched_mcb; // For command transfer frame from command
 RT_TASK_MCB rply_sched_mcb;        // For command execution status reply message
                                    // to command executor task
 
+// Publish next execution time and scheduled commands
+static void set_sched_cmd_hk() {
+    next_atc_tm = get_atc_sched_tm()/1000000000ULL;
+    atc_cnt = get_atc_sched_cnt();
+
+    return;
+}
+
 void sched_cmd(void* arg) {
     // Print:
-    rt_printf("%d (SCHED_CMD_TASK) Task started\n",time(NULL));
+    rt_printf("%d (SCHED_CMD_TASK) Task started\n",get_tm_sec());
 
     // Declarations and initialization:
-    int8_t ret_val; // Function return value
-    int8_t flw_id;  // Flow identifier returned by rt_task_receive
+    int      ret_val; // Function return value
+    int      flw_id;  // Flow identifier returned by rt_task_receive_until
+    RTIME    wait_tm; // Wait for frames until (next execution time)
+    uint64_t tm;      // Next execution time (ns since epoch)
 
     uint8_t sched_stat; // Command schedule status (successfully added
                         // to schedule flag)
@@ -86,6 +116,8 @@ void sched_cmd(void* arg) {
 
     char cmd_xfr_frm_buf[CMD_XFR_FRM_SIZE]; // Buffer for command transfer
                                             // frame
+    char due_xfr_frm_buf[CMD_XFR_FRM_SIZE]; // Buffer for command transfer
+                                            // frame due
 
     cmd_xfr_frm_sched_mcb.data = cmd_xfr_frm_buf;  // Set message block buffer
     cmd_xfr_frm_sched_mcb.size = CMD_XFR_FRM_SIZE; // Set message block buffer
@@ -94,60 +126,109 @@ void sched_cmd(void* arg) {
     rply_sched_mcb.data = &sched_stat;
     rply_sched_mcb.size = RPLY_MSG_SIZE;
 
+    // Publish persisted schedule:
+    set_sched_cmd_hk();
+
     // Task synchronize with exec_cmd task
     // (tell task that it is now ready to receive frames)
     rt_printf("%d (SCHED_CMD_TASK) Ready to receive command transfer"
-        " frames\n",time(NULL));
+        " frames (%u commands scheduled)\n",get_tm_sec(),atc_cnt);
 
     // Signal task to continue executing:
     rt_sem_v(&cmd_sched_sem);
 
     // Infinite loop to receive a command transfer frame from command executor
-    // task via synchronous message passing.
+    // task via synchronous message passing until the next command is due,
+    // then send commands due to command executor task.
     while(1) {
         // Receive command transfer frames from command executor task via
-        // synchronous message:
-        flw_id = rt_task_receive(&cmd_xfr_frm_sched_mcb,\
-            TM_INFINITE); // Will wait infinite amount of time for message 
+        // synchronous message (waits until next execution time):
+        tm = get_atc_sched_tm();
+        wait_tm = (tm > 0) ? get_tm_tck(tm) : TM_INFINITE;
+        flw_id = rt_task_receive_until(&cmd_xfr_frm_sched_mcb,wait_tm);
 
         // Check success:
-        if (ret_val > 0) {
+        if (flw_id > 0) {
             // Print
             rt_printf("%d (SCHED_CMD_TASK) Received command transfer"
-                " frame\n",time(NULL));
-        } else {
+                " frame\n",get_tm_sec());
+
+            // Parse command transfer frame:
+            memcpy(&cmd_apid,cmd_xfr_frm_buf+0,2);
+            memcpy(&cmd_pkt_name,cmd_xfr_frm_buf+2,2);
+            memcpy(&cmd_atc_flg,cmd_xfr_frm_buf+4,1);
+            memcpy(&cmd_exec_time_sec,cmd_xfr_frm_buf+5,4);
+            memcpy(&cmd_exec_time_msec,cmd_xfr_frm_buf+9,2);
+            memcpy(&cmd_arg,cmd_xfr_frm_buf+11,4);
+
+            // Add command to schedule or cancel scheduled commands:
+            if (cmd_atc_flg == ATC_SCHED_FLG_ADD) {
+                ret_val = add_atc_sched(cmd_xfr_frm_buf);
+
+                // Print:
+                rt_printf("%d (SCHED_CMD_TASK) %s command 0x%X:0x%X for"
+                    " %u.%03u sec\n",get_tm_sec(),(ret_val > 0) ? \
+                    "Scheduled" : "Error scheduling (full or late)",\
+                    cmd_apid,cmd_pkt_name,cmd_exec_time_sec,\
+                    cmd_exec_time_msec);
+            } else if (cmd_atc_flg == ATC_SCHED_FLG_DEL) {
+                ret_val = del_atc_sched(cmd_xfr_frm_buf);
+
+                // Print:
+                rt_printf("%d (SCHED_CMD_TASK) %s command 0x%X:0x%X for"
+                    " %u.%03u sec\n",get_tm_sec(),(ret_val > 0) ? \
+                    "Cancelled" : "No scheduled",cmd_apid,cmd_pkt_name,\
+                    cmd_exec_time_sec,cmd_exec_time_msec);
+            } else {
+                ret_val = -1;
+            }
+            sched_stat = (ret_val > 0) ? 1 : 0;
+
+            // Reply to command executor task with command schedule status:
+            ret_val = rt_task_reply(flw_id,&rply_sched_mcb);
+
+            // Check for success:
+            if (ret_val != 0) {
+                // Print:
+                rt_printf("%d (SCHED_CMD_TASK) Error sending reply message"
+                    " to execute command task\n",get_tm_sec());
+            }
+        } else if (flw_id != -ETIMEDOUT) {
             // Print
             rt_printf("%d (SCHED_CMD_TASK) Error receiving command transfer"
-                " frame\n",time(NULL));
-            // NEED ERROR HANDLING
+                " frame; error %d\n",get_tm_sec(),flw_id);
         }
 
-        // Parse command transfer frame:
-        memcpy(&cmd_apid,cmd_xfr_frm_buf+0,2);
-        memcpy(&cmd_pkt_name,cmd_xfr_frm_buf+2,2);
-        memcpy(&cmd_atc_flg,cmd_xfr_frm_buf+4,1);
-        memcpy(&cmd_exec_time_sec,cmd_xfr_frm_buf+5,4);
-        memcpy(&cmd_exec_time_msec,cmd_xfr_frm_buf+9,2);
-        memcpy(&cmd_arg,cmd_xfr_frm_buf+11,4);
+        // Send commands due to command executor task (execute now):
+        while (((tm = get_atc_sched_tm()) > 0) && (tm <= get_tm_ns())) {
+            get_atc_sched(due_xfr_frm_buf);
+            due_xfr_frm_buf[4] = ATC_SCHED_FLG_NOW;
+            ret_val = rt_queue_write(&cmd_xfr_frm_msg_queue,\
+                &due_xfr_frm_buf,CMD_XFR_FRM_SIZE,Q_NORMAL);
 
-        sched_stat = 1;
+            // Check success (command kept and sent again if not):
+            if (ret_val < 0) {
+                // Print:
+                rt_printf("%d (SCHED_CMD_TASK) Error sending scheduled"
+                    " command to execute command task; error %d\n",\
+                    get_tm_sec(),ret_val);
 
+                rt_task_sleep(rt_timer_ns2ticks(SCHED_CMD_RTRY_NS));
 
-        // Reply to command executor task with command execution status:
-        ret_val = rt_task_reply(flw_id,&rply_sched_mcb);
+                break;
+            }
+            pop_atc_sched();
 
-        // Check for success:
-        if (ret_val == 0) {
             // Print:
-            rt_printf("%d (CMD_SW_TASK) Reply message sent to execute command"
-                " task\n",time(NULL));
-        } else {
-            // Print:
-            rt_printf("%d (CMD_SW_TASK) Error sending reply message to execute"
-                " command task\n",time(NULL));
+            rt_printf("%d (SCHED_CMD_TASK) Scheduled command sent to execute"
+                " command task (%llu ms late)\n",get_tm_sec(),\
+                (unsigned long long) ((get_tm_ns()-tm)/1000000));
         }
+
+        // Publish next execution time and scheduled commands:
+        set_sched_cmd_hk();
     }
 
     // Will never reach this:
     return;
-}
\ No newline at end of file
+}
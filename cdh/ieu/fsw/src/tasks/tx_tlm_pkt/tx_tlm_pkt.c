@@ -9,7 +9,21 @@
 //     - APID (origin)
 //     - Telemetry Packet
 //
-// The telemetry packet is removed from the transfer frame for downlinking.
+// The telemetry packet is written straight out of the transfer frame (frame
+// pool slot) for downlinking and the frame is then released back to the pool.
+//
+// Every telemetry packet is preceded on the line by the CCSDS attached sync
+// marker (ccsds_asm.h) so the ground receiver can find packet boundaries and
+// relock after lost bytes.
+//
+// Frames wait in a transmit ring until written. The downlink serial port is
+// non-blocking: the task polls it for room and writes every frame in the ring
+// with a single writev, so the serial driver buffer is refilled before it
+// runs dry and the line stays busy. A partial write leaves the remainder of
+// the frame at the head of the ring for the next writev. Frames are read
+// from the message queue while the port has no room. Achieved line
+// utilization (bytes written over line byte rate) is reported periodically,
+// also while the line is idle, and published in housekeeping telemetry.
 //
 // -------------------------------------------------------------------------- /
 //
@@ -17,7 +31,7 @@
 // - Xenomai 3 / Cobalt
 //
 // Input Arguments:
-// - N/A
+// - Downlink serial port device name (NULL: /dev/ttyUSB1)
 //
 // Output Arguments:
 // - N/A
@@ -39,24 +53,41 @@
 #include <string.h>  // String function definitions 
 #include <stdint.h>  // Standard integer types
 #include <time.h>    // Standard time types
+#include <fcntl.h>   // File control definitions
+#include <poll.h>    // Wait for file descriptor events
+#include <sys/uio.h> // Vector I/O (writev)
 
 // Xenomai libraries:
+#include <alchemy/task.h>  // Task management services
 #include <alchemy/queue.h> // Message queue services
 #include <alchemy/sem.h>   // Semaphore services
 #include <alchemy/timer.h> // Timer management services
 
 // Header files:
-#include <open_port.h>  // Open serial port function declaration
-#include <msg_queues.h> // Message queue variable declarations
-#include <sems.h>       // Semaphore variable declarations
+#include <open_port.h>    // Open serial port function declaration
+#include <msg_queues.h>   // Message queue variable declarations
+#include <sems.h>         // Semaphore variable declarations
+#include <tlm_frm_pool.h> // Telemetry frame pool declarations
+#include <flw_ctl.h>      // Flow control declarations
+#include <ccsds_pkt.h>    // CCSDS packet codec
+#include <ccsds_asm.h>    // CCSDS attached sync marker
+#include <hk_tlm_var.h>   // Housekeeping telemetry variable declarations
+#include <flt_tbl.h>      // Filter table (TO & DS) declarations
+#include <tm_svc.h>       // Time service declarations
 
 // Macro definitions:
-#define TLM_PKT_XFR_FRM_SIZE 1089 // Telemetry packet transfer frame size in bytes
-#define TLM_PKT_SIZE         1080 // Telemetry packet in bytes
 #define B1000000          0010010 // Baud rate (as defined in terminos.h)
+                                  // (downlink scheduler budget uses
+                                  // FLT_TBL_DL_BAUD in flt_tbl.h)
+#define TX_TLM_RING_NFRM     8    // Transmit ring size in frames (frames
+                                  // per writev)
+#define TX_TLM_POLL_TIMEOUT 10    // Serial port poll timeout in ms (longest
+                                  // wait before new frames are read)
+#define TX_TLM_UTIL_PRD     10    // Line utilization report period in
+                                  // seconds
 
 // Message queue definitions:
-RT_QUEUE tx_tlm_pkt_msg_queue;  // For telemetry packets
+RT_QUEUE tx_tlm_pkt_msg_queue;  // For telemetry frame handles
                                 // (flt_tbl_task/rtrv_file_task
                                 // --> tx_tlm_pkt_task)
 
@@ -64,23 +95,155 @@ RT_QUEUE tx_tlm_pkt_msg_queue;  // For telemetry packets
 RT_SEM tx_tlm_pkt_sem; // For tx_tlm_pkt_task, flt_tbl_task, and rtrv_file_task
                        // synchronization
 
+// Transmit ring structure:
+struct tx_tlm_ring {
+    tlm_frm_hdl_t hdl[TX_TLM_RING_NFRM];  // Frame handles
+    uint16_t      size[TX_TLM_RING_NFRM]; // Sizes on the line in bytes (sync
+                                          // marker and telemetry packet)
+    uint16_t      head;                   // Oldest frame
+    uint16_t      cnt;                    // Frames in ring
+    uint16_t      off;                    // Bytes of oldest frame written
+};
+
+// Transmit ring:
+static struct tx_tlm_ring tx_tlm_ring;
+
+// Read frame handles from message queue into transmit ring (waits at most
+// timeout for the first frame)
+static void fill_tx_tlm_ring(RTIME timeout) {
+    // Definitions and initializations:
+    int32_t  ret_val; // Function return value
+    uint16_t idx;     // Ring index
+
+    tlm_frm_hdl_t tlm_frm_hdl; // Telemetry frame handle (frame pool)
+
+    // Loop until ring is full or queue is empty:
+    while (tx_tlm_ring.cnt < TX_TLM_RING_NFRM) {
+        // Read frame handle from message queue:
+        ret_val = rt_queue_read(&tx_tlm_pkt_msg_queue,\
+            &tlm_frm_hdl,TLM_FRM_HDL_SIZE,timeout);
+
+        // Return credit of message read:
+        if (ret_val >= 0) {
+            rtn_flw_ctl(&flw_ctl_tbl[FLW_CTL_TX_TLM_PKT]);
+        }
+
+        // Check success:
+        if (ret_val != TLM_FRM_HDL_SIZE) {
+            // Error (not just an empty queue):
+            if ((ret_val != -EWOULDBLOCK) && (ret_val != -ETIMEDOUT)) {
+                // Print
+                rt_printf("%d (TX_TLM_PKT) Error receiving telemetry packet"
+                    " transfer frame\n",get_tm_sec());
+            }
+
+            return;
+        }
+
+        // Add frame to ring with its size on the line (attached sync marker
+        // and telemetry packet size from packet length field):
+        idx = (tx_tlm_ring.head+tx_tlm_ring.cnt) % TX_TLM_RING_NFRM;
+        tx_tlm_ring.hdl[idx] = tlm_frm_hdl;
+        tx_tlm_ring.size[idx] = CCSDS_ASM_SIZE+\
+            get_ccsds_pkt_size(get_tlm_frm_buf(tlm_frm_hdl)+9);
+        tx_tlm_ring.cnt++;
+
+        // Do not wait for further frames:
+        timeout = TM_NONBLOCK;
+    }
+
+    return;
+}
+
+// Write frames in transmit ring with one writev (returns bytes written, 0 if
+// the port has no room, or -1 on error); fully written frames are released
+static int32_t drain_tx_tlm_ring(int fd) {
+    // Definitions and initializations:
+    ssize_t  ret_val;  // Function return value
+    ssize_t  rem;      // Written bytes not yet consumed
+    uint16_t i;
+    uint16_t idx;      // Ring index
+    uint16_t nfrm;     // Frames in ring before write
+    uint16_t niov = 0; // I/O vectors to write
+    uint16_t off;      // Bytes of frame already written
+
+    struct iovec iov[2*TX_TLM_RING_NFRM]; // Markers and telemetry packets to
+                                          // write
+
+    // Point at unwritten bytes of attached sync markers and telemetry packets
+    // (packets straight from transfer frames):
+    for (i = 0; i < tx_tlm_ring.cnt; ++i) {
+        idx = (tx_tlm_ring.head+i) % TX_TLM_RING_NFRM;
+        off = (i == 0) ? tx_tlm_ring.off : 0;
+
+        if (off < CCSDS_ASM_SIZE) {
+            iov[niov].iov_base = (char*) ccsds_asm+off;
+            iov[niov++].iov_len = CCSDS_ASM_SIZE-off;
+            off = CCSDS_ASM_SIZE;
+        }
+        iov[niov].iov_base = get_tlm_frm_buf(tx_tlm_ring.hdl[idx])+9+\
+            off-CCSDS_ASM_SIZE;
+        iov[niov++].iov_len = tx_tlm_ring.size[idx]-off;
+    }
+
+    // Write markers and telemetry packets to downlink serial port:
+    ret_val = writev(fd,iov,niov);
+
+    // Check success:
+    if (ret_val < 0) {
+        return ((errno == EAGAIN) || (errno == EINTR)) ? 0 : -1;
+    }
+
+    // Consume written bytes (release fully written frames; keep offset into
+    // partially written frame):
+    rem = ret_val;
+    nfrm = tx_tlm_ring.cnt;
+    for (i = 0; (i < nfrm) && (rem >= tx_tlm_ring.size[tx_tlm_ring.head]-\
+        tx_tlm_ring.off); ++i) {
+        rem -= tx_tlm_ring.size[tx_tlm_ring.head]-tx_tlm_ring.off;
+
+        rls_tlm_frm(tx_tlm_ring.hdl[tx_tlm_ring.head]);
+        tx_tlm_ring.head = (tx_tlm_ring.head+1) % TX_TLM_RING_NFRM;
+        tx_tlm_ring.cnt--;
+        tx_tlm_ring.off = 0;
+    }
+    tx_tlm_ring.off += rem;
+
+    return ret_val;
+}
+
+// Release frames in transmit ring (downlink serial port failed)
+static void clr_tx_tlm_ring() {
+    // Release frames back to pool:
+    while (tx_tlm_ring.cnt > 0) {
+        rls_tlm_frm(tx_tlm_ring.hdl[tx_tlm_ring.head]);
+        tx_tlm_ring.head = (tx_tlm_ring.head+1) % TX_TLM_RING_NFRM;
+        tx_tlm_ring.cnt--;
+    }
+    tx_tlm_ring.off = 0;
+
+    return;
+}
+
 void tx_tlm_pkt(void* arg) {
     // Print:
-    rt_printf("%d (TX_TLM_PKT) Task started\n",time(NULL));
+    rt_printf("%d (TX_TLM_PKT) Task started\n",get_tm_sec());
 
     // Definitions and initializations:
     uint8_t i;
-    int16_t ret_val; // Function return value
+    int32_t ret_val; // Function return value
     int8_t  fd;      // File descriptor for port
 
-    char* port = "/dev/ttyUSB1"; // Downlink
+    char* port = (arg != NULL) ? (char*) arg : "/dev/ttyUSB1"; // Downlink
+
+    struct pollfd pfd; // Downlink serial port poll descriptor
+
+    uint64_t util_byte_cnt = 0; // Bytes written in utilization period
+    uint64_t util_pct;          // Utilization in percent
+    RTIME    util_tm_strt;      // Utilization period start time
+    RTIME    util_tm_dlt;       // Utilization period length (ns)
+    RTIME    util_tm_rem;       // Utilization period time left (ticks)
 
-    char tlm_pkt_buf[TLM_PKT_XFR_FRM_SIZE]; // Buffer for telemetry
-                                            // packet transfer frame
-                                            // buffer
-    char tlm_pkt_xfr_frm_buf[TLM_PKT_XFR_FRM_SIZE]; // Buffer for telemetry
-                                                    // packet transfer frame
-                                                    // buffer
     // Open port:
     fd = open_port(port,B1000000);
 
@@ -88,61 +251,118 @@ void tx_tlm_pkt(void* arg) {
     if (fd > 0) {
         // Success:
         rt_printf("%d (TX_TLM_PKT) Downlink serial port opened and"
-            " configured\n",time(NULL));
+            " configured\n",get_tm_sec());
     } else {
         // Print:
         rt_printf("%d (TX_TLM_PKT) Error opening and configuring downlink"
-            " serial port\n",time(NULL));
+            " serial port\n",get_tm_sec());
         // NEED ERROR HANDLING
     }
 
+    // Make port non-blocking (writes take what fits in the driver buffer):
+    ret_val = fcntl(fd,F_SETFL,fcntl(fd,F_GETFL) | O_NONBLOCK);
+
+    // Check for success:
+    if (ret_val < 0) {
+        // Print:
+        rt_printf("%d (TX_TLM_PKT) Error setting downlink serial port"
+            " non-blocking\n",get_tm_sec());
+    }
+
+    pfd.fd = fd;
+    pfd.events = POLLOUT;
+
     // Task synchronize with filter table and retrieve file task
     // (tell task that it is now ready to receive transfer frames)
     rt_printf("%d (TX_TLM_PKT) Ready to receive telemetry packet transfer"
-        " frames\n",time(NULL));
+        " frames\n",get_tm_sec());
     
     // Signal:
     for (i = 0; i < 2; ++i)
         rt_sem_v(&tx_tlm_pkt_sem);
 
+    // Start utilization period:
+    util_tm_strt = rt_timer_read();
+
     // Infinite loop to receive telemetry packet transfer frames via message
-    // queue and direct to either transmit telemetry packet task or create file
-    // task:
+    // queue into the transmit ring and write the ring to the downlink serial
+    // port whenever it has room:
     while (1) {
-        // Read transfer frame from message queue:
-        ret_val = rt_queue_read(&tx_tlm_pkt_msg_queue,\
-            &tlm_pkt_xfr_frm_buf,TLM_PKT_XFR_FRM_SIZE,TM_INFINITE);
-
-        // Check success:
-        if (ret_val == TLM_PKT_XFR_FRM_SIZE) {
-            // Print
-            rt_printf("%d (TX_TLM_PKT) Received telemetry packet transfer"
-                " frame\n",time(NULL));
-        // Error:
+        // Read frames into ring (wait for a frame only if ring is empty, and
+        // at most until the end of the utilization period, so utilization is
+        // also reported while the line is idle):
+        if (tx_tlm_ring.cnt == 0) {
+            util_tm_dlt = rt_timer_ticks2ns(rt_timer_read() - util_tm_strt);
+            util_tm_rem = 0;
+            if (util_tm_dlt < (RTIME) TX_TLM_UTIL_PRD*1000000000) {
+                util_tm_rem = rt_timer_ns2ticks((RTIME) TX_TLM_UTIL_PRD*\
+                    1000000000-util_tm_dlt);
+            }
+            fill_tx_tlm_ring((util_tm_rem > 0) ? util_tm_rem : TM_NONBLOCK);
         } else {
-            // Print
-            rt_printf("%d (TX_TLM_PKT) Error receiving telemetry packet"
-                " transfer frame\n",time(NULL));
-            // NEED ERROR HANDLING                                          
+            fill_tx_tlm_ring(TM_NONBLOCK);
         }
 
-        // Remove telemetry packet from transfer frame:
-        memcpy(&tlm_pkt_buf,tlm_pkt_xfr_frm_buf+9,TLM_PKT_SIZE);
+        // Wait for room in serial port (if there is anything to write):
+        if (tx_tlm_ring.cnt > 0) {
+            ret_val = poll(&pfd,1,TX_TLM_POLL_TIMEOUT);
 
-        // Write telemetry packet to downlink serial port:
-        ret_val = write(fd,&tlm_pkt_buf,TLM_PKT_SIZE);
+            // Check for port error:
+            if ((ret_val < 0) && (errno != EINTR)) {
+                // Print:
+                rt_printf("%d (TX_TLM_PKT) Error polling downlink serial"
+                    " port\n",get_tm_sec());
+            } else if ((ret_val > 0) && \
+                (pfd.revents & (POLLERR | POLLHUP | POLLNVAL))) {
+                // Print:
+                rt_printf("%d (TX_TLM_PKT) Downlink serial port error;"
+                    " %d telemetry packet(s) dropped\n",get_tm_sec(),\
+                    tx_tlm_ring.cnt);
 
-        // Check success:
-        if (ret_val == TLM_PKT_SIZE) {
-            // Print
-            rt_printf("%d (TX_TLM_PKT) Transmitted telemetry packet\n",\
-                time(NULL));
-        // Error:
-        } else {
-            // Print
-            rt_printf("%d (TX_TLM_PKT) Error transmitting telemetry packet\n",\
-                time(NULL));
-            // NEED ERROR HANDLING                                          
+                // Drop frames in ring and back off:
+                clr_tx_tlm_ring();
+                rt_task_sleep(TX_TLM_POLL_TIMEOUT*1000000);
+            } else if (ret_val > 0) {
+                // Write ring to downlink serial port:
+                ret_val = drain_tx_tlm_ring(fd);
+
+                // Check success:
+                if (ret_val > 0) {
+                    // Count bytes written:
+                    util_byte_cnt += ret_val;
+
+                    // Print
+                    rt_printf("%d (TX_TLM_PKT) Transmitted %d telemetry"
+                        " packet byte(s)\n",get_tm_sec(),ret_val);
+                // Error:
+                } else if (ret_val < 0) {
+                    // Print
+                    rt_printf("%d (TX_TLM_PKT) Error transmitting telemetry"
+                        " packet\n",get_tm_sec());
+                    // NEED ERROR HANDLING
+                }
+            }
+        }
+
+        // Report line utilization at end of period:
+        util_tm_dlt = rt_timer_ticks2ns(rt_timer_read() - util_tm_strt);
+        if (util_tm_dlt >= (RTIME) TX_TLM_UTIL_PRD*1000000000) {
+            // Utilization in percent of line byte rate (bytes written may
+            // still sit in the driver buffer, so cap at 100):
+            util_pct = util_byte_cnt*100*1000000000/\
+                ((uint64_t) FLT_TBL_DL_BYTE_RATE*util_tm_dlt);
+            dl_util_pct = (util_pct > 100) ? 100 : util_pct;
+
+            // Print:
+            rt_printf("%d (TX_TLM_PKT) Downlink line utilization %llu%% (%llu"
+                " bytes in %llu ms)\n",get_tm_sec(),\
+                (unsigned long long) util_pct,\
+                (unsigned long long) util_byte_cnt,\
+                (unsigned long long) util_tm_dlt/1000000);
+
+            // Start next period:
+            util_byte_cnt = 0;
+            util_tm_strt = rt_timer_read();
         }
     }
 }
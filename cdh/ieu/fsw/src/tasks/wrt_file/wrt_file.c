@@ -0,0 +1,117 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Write File
+//
+// Non-real-time task responsible for writing recorded telemetry packet
+// transfer frames to storage. Create file task copies frames into the record
+// telemetry ring (rec_tlm_ring.h) and wakes this task when the ring was
+// empty; this task appends every frame in the ring to the segments of their
+// classes in batches (rec_tlm.h) and frees them.
+//
+// The task runs in the Linux (secondary) domain, so waiting on storage only
+// delays this task and never a real-time task. Frames are written as large
+// vectored writes (io_uring with REC_TLM_URING, pwritev otherwise), so the
+// recording rate follows storage bandwidth rather than system calls per
+// frame. If no frame arrives within the sync period the pending batch is
+// synced anyway.
+//
+// -------------------------------------------------------------------------- /
+//
+// Dependencies:
+// - Xenomai 3 / Cobalt
+//
+// Input Arguments:
+// - N/A
+//
+// Output Arguments:
+// - N/A
+//
+// -------------------------------------------------------------------------- /
+//
+// agent
+// Project HEPCATS
+// Subsystem: C&DH
+// Created: October 17, 2026
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Standard libraries:
+#include <stdlib.h> // Standard library
+#include <errno.h>  // Error number definitions
+#include <stdint.h> // Standard integer types
+#include <time.h>   // Standard time types
+
+// Xenomai libraries:
+#include <alchemy/sem.h>   // Semaphore services
+#include <alchemy/timer.h> // Timer management services
+
+// Header files:
+#include <sems.h>         // Semaphore variable declarations
+#include <tlm_frm_pool.h> // Telemetry frame pool declarations
+#include <rec_tlm.h>      // Record telemetry declarations
+#include <rec_tlm_ring.h> // Record telemetry ring declarations
+#include <tm_svc.h>       // Time service declarations
+
+// Semaphore definitions:
+RT_SEM wrt_file_sem; // For crt_file_task and wrt_file_task synchronization
+                     // (frames in ring)
+
+void wrt_file(void* arg) {
+    // Print:
+    rt_printf("%d (WRT_FILE_TASK) Task started\n",get_tm_sec());
+
+    // Definitions and initialization:
+    int16_t     ret_val;     // Function return value
+    const char* frm;         // Frames to write (ring)
+    uint32_t    nfrm;        // Number of frames to write
+    uint32_t    wrt_cnt;     // Frames of batch recorded
+    uint32_t    rec_cnt = 0; // Frames recorded
+    uint32_t    err_cnt = 0; // Frames not recorded (error)
+
+    // Print:
+    rt_printf("%d (WRT_FILE_TASK) Ready to write recorded telemetry packet"
+        " transfer frames\n",get_tm_sec());
+
+    // Infinite loop to write frames in ring to segments of their class:
+    while (1) {
+        // Wait for frames (at most one sync period):
+        ret_val = rt_sem_p(&wrt_file_sem,REC_TLM_SYNC_PRD);
+
+        // Check success:
+        if ((ret_val != 0) && (ret_val != -ETIMEDOUT)) {
+            // Print:
+            rt_printf("%d (WRT_FILE_TASK) Error waiting for frames; error"
+                " %d\n",get_tm_sec(),ret_val);
+
+            continue;
+        }
+
+        // Write frames in ring (contiguous runs) until it is empty:
+        while ((nfrm = get_rec_tlm_ring(&frm)) > 0) {
+            wrt_cnt = app_rec_tlm(frm,nfrm);
+            rls_rec_tlm_ring(nfrm);
+
+            rec_cnt += wrt_cnt;
+            err_cnt += nfrm-wrt_cnt;
+
+            // Print:
+            if (wrt_cnt == nfrm) {
+                rt_printf("%d (WRT_FILE_TASK) %u telemetry packet transfer"
+                    " frames recorded (%u total)\n",get_tm_sec(),wrt_cnt,\
+                    rec_cnt);
+            } else {
+                rt_printf("%d (WRT_FILE_TASK) Error recording %u of %u"
+                    " telemetry packet transfer frames (%u errors)\n",\
+                    get_tm_sec(),nfrm-wrt_cnt,nfrm,err_cnt);
+            }
+        }
+
+        // No frame within sync period: sync pending batch:
+        if (ret_val == -ETIMEDOUT) {
+            sync_rec_tlm();
+        }
+    }
+
+    // Will never reach this
+    return;
+}
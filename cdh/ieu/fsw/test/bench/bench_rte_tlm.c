@@ -0,0 +1,194 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Route Telemetry Benchmark
+//
+// Measures throughput (frames/sec) of the filter table stage routing decision
+// for the flight filter tables (flt_tbl.h) in every filter table mode. The
+// former per-frame lookup (APID if/else chain plus range and frequency table
+// reads and counter updates) is compared against the compiled per-APID
+// routing descriptors (rte_tlm.h). Message queue writes and frame references
+// are not included.
+//
+// -------------------------------------------------------------------------- /
+//
+// Input Arguments:
+// - argv[1] (number of frames, optional, default 10000000)
+//
+// Output Arguments:
+// - N/A
+//
+// -------------------------------------------------------------------------- /
+//
+// agent
+// Project HEPCATS
+// Subsystem: C&DH
+// Created: October 17, 2026
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Standard libraries:
+#include <stdio.h>   // Standard input/output definitions
+#include <stdlib.h>  // Standard library
+#include <stdint.h>  // Standard integer types
+#include <string.h>  // String function definitions
+#include <time.h>    // Standard time function definitions
+
+// Header files:
+#include "ccsds_pkt.h" // CCSDS packet codec
+#include "flt_tbl.h"   // Filter table (TO & DS) declarations
+#include "rte_tlm.h"   // Route telemetry declarations
+
+// Macro definitions:
+#define NFRM_DFLT 10000000 // Default number of frames per benchmark
+#define NBUF            64 // Number of frame headers cycled through
+#define NMODE            5 // Number of filter table modes
+
+#define APID_SW  0x00 // Software origin
+#define APID_IMG 0x64 // Image origin
+#define APID_MDQ 0xC8 // Magnetometer DAQ origin
+
+// Transfer frame headers (APID in host order at offset 0):
+static char frm_buf[NBUF][9];
+
+// Filter table of each destination:
+static const uint16_t* flt_tbl_dst_tbl[FLT_TBL_NDST] = {
+    flt_tbl_to[0],flt_tbl_ds[0]
+};
+
+// Routing descriptors:
+static struct rte_tlm_dsc rte_tbl[RTE_TLM_NAPID];
+
+// Former per-frame routing state:
+static uint8_t flt_tbl_mode_prev = 255;
+static uint8_t flt_tbl_xfr_frm_cnt_to[FLT_TBL_ROW];
+static uint8_t flt_tbl_xfr_frm_cnt_ds[FLT_TBL_ROW];
+
+// Get monotonic time in seconds
+static double get_tm() {
+    // Definitions and initializations:
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC,&ts);
+
+    return ts.tv_sec + ts.tv_nsec/1e9;
+}
+
+// Print benchmark result
+static void print_res(const char* name, uint8_t mode, uint32_t nfrm,
+    double tm) {
+    printf("%-8s mode %d : %12.0f frames/sec (%6.2f ns/frame)\n",name,mode,\
+        nfrm/tm,tm*1e9/nfrm);
+}
+
+// Step one decimation counter the former way (returns 1 to send)
+static uint8_t step_cnt(uint8_t* cnt, uint8_t rng, uint8_t freq) {
+    if (freq == 0) {
+        return 0;
+    } else if (*cnt == freq) {
+        if (*cnt != rng) {
+            (*cnt)++;
+        }
+        return 1;
+    } else if (*cnt == rng) {
+        *cnt = freq;
+        return 0;
+    } else {
+        (*cnt)++;
+        return 0;
+    }
+}
+
+// Route transfer frame the former way (returns destination bitmask)
+static __attribute__((noinline)) uint8_t rte_tlm_frm_prev(char* frm,
+    uint8_t mode) {
+    // Definitions and initializations:
+    uint8_t  i;
+    uint8_t  row = 0;
+    uint16_t apid;
+
+    memcpy(&apid,frm,2);
+
+    // Determine filter table row depending of transfer frame APID:
+    if (apid == APID_SW) {
+        row = 0;
+    } else if (apid == APID_IMG) {
+        row = 1;
+    } else if (apid == APID_MDQ) {
+        row = 2;
+    }
+
+    // Reset transfer frame counts to frequency on mode change:
+    if (mode != flt_tbl_mode_prev) {
+        for (i = 0; i < FLT_TBL_ROW; ++i) {
+            flt_tbl_xfr_frm_cnt_to[i] = flt_tbl_to[i][mode*2+2];
+            flt_tbl_xfr_frm_cnt_ds[i] = flt_tbl_ds[i][mode*2+2];
+        }
+        flt_tbl_mode_prev = mode;
+    }
+
+    return (step_cnt(&flt_tbl_xfr_frm_cnt_to[row],flt_tbl_to[row][mode*2+1],\
+        flt_tbl_to[row][mode*2+2]) << FLT_TBL_DST_TO) | \
+        (step_cnt(&flt_tbl_xfr_frm_cnt_ds[row],flt_tbl_ds[row][mode*2+1],\
+        flt_tbl_ds[row][mode*2+2]) << FLT_TBL_DST_DS);
+}
+
+// Route transfer frame with compiled descriptors
+static __attribute__((noinline)) uint8_t rte_tlm_frm_cmpl(char* frm) {
+    // Definitions and initializations:
+    uint16_t apid;
+
+    memcpy(&apid,frm,2);
+
+    return rte_tlm_frm(rte_tbl,apid);
+}
+
+int main(int argc, char const *argv[]) {
+    // Definitions and initializations:
+    uint32_t nfrm = NFRM_DFLT; // Number of frames
+    uint32_t i;                // Counter
+    uint8_t  mode;             // Filter table mode
+    uint32_t chk_prev;         // Destination checksum (former routing)
+    uint32_t chk_cmpl;         // Destination checksum (compiled routing)
+    double   tm_strt;          // Start time
+
+    const uint16_t apid_tbl[3] = {APID_SW,APID_IMG,APID_MDQ};
+
+    // Get number of frames:
+    if (argc > 1) {
+        nfrm = strtoul(argv[1],NULL,0);
+    }
+
+    // Populate frame headers (mixed APIDs):
+    for (i = 0; i < NBUF; ++i) {
+        memcpy(frm_buf[i],&apid_tbl[i % 3],2);
+    }
+
+    // Loop over filter table modes:
+    for (mode = 0; mode < NMODE; ++mode) {
+        // Former routing:
+        chk_prev = 0;
+        tm_strt = get_tm();
+        for (i = 0; i < nfrm; ++i) {
+            chk_prev += rte_tlm_frm_prev(frm_buf[i % NBUF],mode);
+        }
+        print_res("Former",mode,nfrm,get_tm() - tm_strt);
+
+        // Compiled routing (compile time included):
+        chk_cmpl = 0;
+        tm_strt = get_tm();
+        cmpl_rte_tlm(rte_tbl,flt_tbl_dst_tbl,FLT_TBL_NDST,FLT_TBL_ROW,\
+            FLT_TBL_COL,mode,FLT_TBL_DFLT_MSK);
+        for (i = 0; i < nfrm; ++i) {
+            chk_cmpl += rte_tlm_frm_cmpl(frm_buf[i % NBUF]);
+        }
+        print_res("Compiled",mode,nfrm,get_tm() - tm_strt);
+
+        // Check both route the same frames:
+        if (chk_prev != chk_cmpl) {
+            printf("Mode %d destination checksum mismatch: %u != %u\n",mode,\
+                chk_prev,chk_cmpl);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,17 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Account Telemetry Sequence
+//
+// Account telemetry sequence function header file
+//
+// -------------------------------------------------------------------------- /
+//
+// agent
+// Project HEPCATS
+// Subsystem: C&DH
+// Created: October 17, 2026
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Function declaration:
+void acct_tlm_seq(uint16_t apid, uint16_t seq_cnt);
@@ -0,0 +1,17 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Macro filter table
+//
+// Macro filter table function header
+//
+// -------------------------------------------------------------------------- /
+//
+// agent
+// Project HEPCATS
+// Subsystem: C&DH
+// Created: October 17, 2026
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Function declaration:
+void macro_flt_tbl(char* cmd_str[]);
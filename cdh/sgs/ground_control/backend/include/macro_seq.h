@@ -0,0 +1,17 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Macro sequence
+//
+// Macro sequence function header
+//
+// -------------------------------------------------------------------------- /
+//
+// agent
+// Project HEPCATS
+// Subsystem: C&DH
+// Created: October 17, 2026
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Function declaration:
+void macro_seq(char* cmd_str[]);
@@ -14,5 +14,14 @@
 //
 ///////////////////////////////////////////////////////////////////////////////
 
-// Function declaration:
-char* read_port(int fd,char* buffer);
\ No newline at end of file
+// Receiver statistics structure:
+struct read_port_stat {
+    unsigned long pkt_cnt;        // Packets received
+    unsigned long relock_cnt;     // Packets received after a sync loss
+    unsigned long false_lock_cnt; // Markers rejected (header or CRC)
+    unsigned long skp_cnt;        // Bytes skipped while searching
+};
+
+// Function declarations:
+char* read_port(int fd,char* buffer);           // Read telemetry packet
+struct read_port_stat get_read_port_stat();     // Get receiver statistics
\ No newline at end of file
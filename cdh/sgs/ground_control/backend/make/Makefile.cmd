@@ -41,6 +41,7 @@ INCDIR    := $(ROOT)/../include
 BUILDDIR  := $(ROOT)/../obj/cmd
 TARGETDIR := $(ROOT)/../bin
 RESDIR    := $(ROOT)/../res
+PKTDIR    := $(ROOT)/../../../../ccsds_packet_definitions
 
 # Extensions:
 SRCEXT := c
@@ -52,8 +53,8 @@ CFLAGS   :=
 LDFLAGS  :=
 
 LIB     :=
-INC     := -I$(INCDIR) -I/usr/local/include
-INCDEP  := -I$(INCDIR)
+INC     := -I$(INCDIR) -I$(PKTDIR) -I/usr/local/include
+INCDEP  := -I$(INCDIR) -I$(PKTDIR)
 
 # Find source and object files:
 SOURCES := $(shell find $(SRCDIR) -type f -name *.$(SRCEXT))
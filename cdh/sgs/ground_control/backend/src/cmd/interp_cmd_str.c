@@ -170,6 +170,20 @@ struct telecmd_pkt_inputs interp_cmd_str(char* cmd_str_arr[]) {
     for (i = 0; i < 10; ++i) {
         // Check if command parameter flag is set:
         if (strcmp("with",cmd_str_arr[i]) == 0) {
+            // Check for raw hexadecimal argument (e.g. "with 0x00050001";
+            // for commands taking a value rather than a parameter):
+            if (strncmp("0x",cmd_str_arr[i+1],2) == 0) {
+                // Get Application Data from argument:
+                telecmd_pkt_inputs.pkt_app_dat_cmd_arg = \
+                    strtoul(cmd_str_arr[i+1],NULL,16);
+
+                // Print
+                printf(" %s %s",cmd_str_arr[i],cmd_str_arr[i+1]);
+
+                // Next flag:
+                continue;
+            }
+
             for (j = 0; j < 6; ++j) {
                 if (strcmp(prm_mnem[row][j],cmd_str_arr[i+1]) == 0) {
                     // Get Application Data for command parameter:
@@ -199,8 +213,10 @@ struct telecmd_pkt_inputs interp_cmd_str(char* cmd_str_arr[]) {
 
     // Check for command execution time:
     for (i = 0; i < 10; ++i) {
-        // Check if execution time flag is set:
-        if (strcmp("hold",cmd_str_arr[i]) == 0) {
+        // Check if execution time flag is set (hold: schedule command;
+        // cancel: cancel scheduled command):
+        if ((strcmp("hold",cmd_str_arr[i]) == 0) || \
+            (strcmp("cancel",cmd_str_arr[i]) == 0)) {
             // Set environment to UTC:
             // (required for mktime)
             setenv("TZ", "UTC", 1);
@@ -219,7 +235,9 @@ struct telecmd_pkt_inputs interp_cmd_str(char* cmd_str_arr[]) {
             telecmd_pkt_inputs.pkt_sec_hdr_t_void = 0xFF;
 
             // Set ATC flag:
-            telecmd_pkt_inputs.pkt_app_dat_atc_flg = 1; // True
+            telecmd_pkt_inputs.pkt_app_dat_atc_flg = \
+                (strcmp("hold",cmd_str_arr[i]) == 0) ? 1 : 2; // True or
+                                                              // cancel
 
             // Print
             printf(" %s %s",cmd_str_arr[i],\
@@ -30,7 +30,9 @@
 #include <unistd.h>  // UNIX standard function definitions
 
 // Header files:
-#include "macro_cmd.h" // Command macro function declaration
+#include "macro_cmd.h"     // Command macro function declaration
+#include "macro_flt_tbl.h" // Filter table macro function declaration
+#include "macro_seq.h"     // Sequence macro function declaration
 
 void main(int argc, char const *argv[]) {
     // Definitions and initializations:
@@ -52,6 +54,24 @@ void main(int argc, char const *argv[]) {
         return;
     } 
 
+    // Check to see if macro is "flttbl":
+    if (strcmp("flttbl",input_str_arr[0]) == 0){
+        // Start filter table upload macro function:
+        macro_flt_tbl(input_str_arr);
+
+        // Exit:
+        return;
+    }
+
+    // Check to see if macro is "seq":
+    if (strcmp("seq",input_str_arr[0]) == 0){
+        // Start sequence upload macro function:
+        macro_seq(input_str_arr);
+
+        // Exit:
+        return;
+    }
+
     // If you get here, the macro is not recognized:
     printf("(PROMPT_INTERP) <ERROR> \"%s\" macro not recognized\n",\
         input_str_arr[0]);
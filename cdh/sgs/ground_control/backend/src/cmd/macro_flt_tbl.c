@@ -0,0 +1,189 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Macro Filter Table
+//
+// Interpret prompt input that invokes the "flttbl" macro: upload a filter
+// table (TO & DS) definition file to the flight software. The file has one
+// row per line, TO rows first:
+//
+//     to,0x00,1,1,1,1,1,1,1,1,1,1
+//     ...
+//     ds,0x00,1,1,0,0,1,1,1,1,1,1
+//     ...
+//
+// Both tables must have the same APIDs in the same order. The macro sends
+// BGNFLTTBLLD (row size), one FLTTBLLD per word ((word index << 16) | word),
+// and ENDFLTTBLLD (CRC-16 of the row size and words, big-endian). Commands
+// are paced for the 2400 baud uplink. A word lost on the uplink makes the
+// flight software reject the upload; simply run the macro again.
+//
+// -------------------------------------------------------------------------- /
+//
+// Input Arguments:
+// - cmd_str (cmd_str[1]: filter table definition file)
+//
+// Output Arguments:
+// - N/A
+//
+// -------------------------------------------------------------------------- /
+//
+// agent
+// Project HEPCATS
+// Subsystem: C&DH
+// Created: October 17, 2026
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Standard libraries:
+#include <stdio.h>   // Standard input/output definitions
+#include <stdlib.h>  // Standard library
+#include <string.h>  // String function definitions
+#include <unistd.h>  // UNIX standard function definitions
+#include <stdint.h>  // Integer types
+
+// Header files:
+#include "ccsds_crc.h" // CCSDS packet error control (CRC)
+#include "macro_cmd.h" // Command macro function declaration
+
+// Macro definitions:
+#define FLT_TBL_ROW_MAX  8      // Maximum filter table row size (flight
+                                // software ld_flt_tbl.h)
+#define FLT_TBL_COL      11     // Filter table column size
+#define FLT_TBL_PKT_GAP  250000 // Time between commands in microseconds
+                                // (24 byte framed packet takes 100 ms at 2400
+                                // baud)
+
+// Send one filter table upload command with hexadecimal argument
+static void send_flt_tbl_cmd(char* cmd_mnem, uint32_t arg) {
+    // Definitions and initializations:
+    char arg_str[20]; // Argument string
+    char* cmd_str_arr[10] = \
+        {"cmd","hepcats",cmd_mnem,"with",arg_str," "," "," "," "," "};
+
+    // Send command:
+    sprintf(arg_str,"0x%08X",arg);
+    macro_cmd(cmd_str_arr);
+
+    // Wait for packet to clear the uplink:
+    usleep(FLT_TBL_PKT_GAP);
+
+    return;
+}
+
+void macro_flt_tbl(char* cmd_str_arr[]) {
+    // Definitions and initializations:
+    uint16_t to[FLT_TBL_ROW_MAX][FLT_TBL_COL]; // Telemetry output table
+    uint16_t ds[FLT_TBL_ROW_MAX][FLT_TBL_COL]; // Data storage table
+    uint16_t nrow_to = 0; // TO table row size
+    uint16_t nrow_ds = 0; // DS table row size
+    uint16_t nwrd;        // Words in upload
+    uint16_t* row;        // Row being read
+    uint16_t crc;         // CRC-16 of definition
+    size_t   n = 0;       // Bytes serialized
+
+    char buf[2+FLT_TBL_ROW_MAX*FLT_TBL_COL*4]; // Serialized definition
+    char line[200];                            // Line from file
+    char* token;                               // Field of line
+    int  col;                                  // Column
+
+    FILE* fd; // File descriptor
+
+    // Open filter table definition file:
+    fd = fopen(cmd_str_arr[1],"r");
+    if (fd == NULL) {
+        // Print error message:
+        printf("(MACRO_FLT_TBL) <ERROR> Unable to open \"%s\"\n",\
+            cmd_str_arr[1]);
+
+        return;
+    }
+
+    // Read file line by line:
+    while (fgets(line,sizeof(line),fd) != NULL) {
+        // Strip newline character:
+        line[strcspn(line,"\r\n")] = 0;
+
+        // Get table of row:
+        token = strtok(line,",");
+        if (token == NULL) {
+            continue;
+        } else if ((strcmp(token,"to") == 0) && (nrow_to < FLT_TBL_ROW_MAX)) {
+            row = to[nrow_to++];
+        } else if ((strcmp(token,"ds") == 0) && (nrow_ds < FLT_TBL_ROW_MAX)) {
+            row = ds[nrow_ds++];
+        } else {
+            // Print error message:
+            printf("(MACRO_FLT_TBL) <ERROR> Unexpected row \"%s\" (or more"
+                " than %d rows)\n",token,FLT_TBL_ROW_MAX);
+            fclose(fd);
+
+            return;
+        }
+
+        // Parse APID, ranges, and frequencies:
+        for (col = 0; col < FLT_TBL_COL; ++col) {
+            token = strtok(NULL,",");
+            if (token == NULL) {
+                // Print error message:
+                printf("(MACRO_FLT_TBL) <ERROR> Row has fewer than %d"
+                    " columns\n",FLT_TBL_COL);
+                fclose(fd);
+
+                return;
+            }
+            row[col] = strtoul(token,NULL,0);
+        }
+    }
+
+    // Close file:
+    fclose(fd);
+
+    // Check row sizes:
+    if ((nrow_to == 0) || (nrow_to != nrow_ds)) {
+        // Print error message:
+        printf("(MACRO_FLT_TBL) <ERROR> TO and DS tables need the same"
+            " number of rows (%d and %d)\n",nrow_to,nrow_ds);
+
+        return;
+    }
+
+    // Serialize definition and calculate CRC-16:
+    buf[n++] = nrow_to >> 8;
+    buf[n++] = nrow_to & 0xFF;
+    for (nwrd = 0; nwrd < nrow_to*FLT_TBL_COL; ++nwrd) {
+        buf[n++] = to[nwrd/FLT_TBL_COL][nwrd % FLT_TBL_COL] >> 8;
+        buf[n++] = to[nwrd/FLT_TBL_COL][nwrd % FLT_TBL_COL] & 0xFF;
+    }
+    for (nwrd = 0; nwrd < nrow_ds*FLT_TBL_COL; ++nwrd) {
+        buf[n++] = ds[nwrd/FLT_TBL_COL][nwrd % FLT_TBL_COL] >> 8;
+        buf[n++] = ds[nwrd/FLT_TBL_COL][nwrd % FLT_TBL_COL] & 0xFF;
+    }
+    crc = calc_ccsds_crc(buf,n);
+
+    // Print:
+    printf("(MACRO_FLT_TBL) Uploading %d row filter table (CRC 0x%04X)\n",\
+        nrow_to,crc);
+
+    // Begin upload:
+    send_flt_tbl_cmd("bgnflttblld",nrow_to);
+
+    // Send words (TO table, then DS table):
+    nwrd = nrow_to*FLT_TBL_COL;
+    for (col = 0; col < nwrd; ++col) {
+        send_flt_tbl_cmd("flttblld",((uint32_t) col << 16) | \
+            to[col/FLT_TBL_COL][col % FLT_TBL_COL]);
+    }
+    for (col = 0; col < nwrd; ++col) {
+        send_flt_tbl_cmd("flttblld",((uint32_t) (nwrd+col) << 16) | \
+            ds[col/FLT_TBL_COL][col % FLT_TBL_COL]);
+    }
+
+    // End upload:
+    send_flt_tbl_cmd("endflttblld",crc);
+
+    // Print:
+    printf("(MACRO_FLT_TBL) Filter table upload sent; check filter table CRC"
+        " 0x%04X in housekeeping telemetry\n",crc);
+
+    return;
+}
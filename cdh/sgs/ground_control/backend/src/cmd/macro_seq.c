@@ -0,0 +1,203 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Macro Sequence
+//
+// Interpret prompt input that invokes the "seq" macro: upload a stored
+// command sequence file to the flight software as sequence <id>. The file
+// has one step per line, each executed its delay after the previous step
+// (the first after the sequence is started):
+//
+//     apid,pkt_name,arg,delay_ms
+//     0x12C,0x00,0x00,0
+//     0xC8,0x00,0x00,2000
+//     ...
+//
+// The macro sends BGNSEQLD ((sequence ID << 16) | step count), one SEQLD
+// per word ((word index << 16) | word; APID, packet name, argument high and
+// low, delay high and low per step), and ENDSEQLD (CRC-16 of the sequence
+// ID, step count, and words, big-endian). Commands are paced for the 2400
+// baud uplink. A word lost on the uplink makes the flight software reject
+// the upload; simply run the macro again.
+//
+// The sequence is then run any number of times with one command:
+//
+//     cmd hepcats runseq with <id in hexadecimal>
+//
+// -------------------------------------------------------------------------- /
+//
+// Input Arguments:
+// - cmd_str (cmd_str[1]: sequence ID, cmd_str[2]: sequence file)
+//
+// Output Arguments:
+// - N/A
+//
+// -------------------------------------------------------------------------- /
+//
+// agent
+// Project HEPCATS
+// Subsystem: C&DH
+// Created: October 17, 2026
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Standard libraries:
+#include <stdio.h>   // Standard input/output definitions
+#include <stdlib.h>  // Standard library
+#include <string.h>  // String function definitions
+#include <unistd.h>  // UNIX standard function definitions
+#include <stdint.h>  // Integer types
+
+// Header files:
+#include "ccsds_crc.h" // CCSDS packet error control (CRC)
+#include "macro_cmd.h" // Command macro function declaration
+
+// Macro definitions:
+#define SEQ_NSEQ      16     // Sequences stored (flight software seq_tbl.h)
+#define SEQ_NSTEP     32     // Maximum steps per sequence (flight software
+                             // seq_tbl.h)
+#define SEQ_STEP_NWRD 6      // Upload words per step
+#define SEQ_PKT_GAP   250000 // Time between commands in microseconds
+                             // (24 byte framed packet takes 100 ms at 2400
+                             // baud)
+
+// Send one sequence upload command with hexadecimal argument
+static void send_seq_cmd(char* cmd_mnem, uint32_t arg) {
+    // Definitions and initializations:
+    char arg_str[20]; // Argument string
+    char* cmd_str_arr[10] = \
+        {"cmd","hepcats",cmd_mnem,"with",arg_str," "," "," "," "," "};
+
+    // Send command:
+    sprintf(arg_str,"0x%08X",arg);
+    macro_cmd(cmd_str_arr);
+
+    // Wait for packet to clear the uplink:
+    usleep(SEQ_PKT_GAP);
+
+    return;
+}
+
+void macro_seq(char* cmd_str_arr[]) {
+    // Definitions and initializations:
+    uint16_t wrd[SEQ_NSTEP*SEQ_STEP_NWRD]; // Words of upload
+    uint16_t nstep = 0; // Steps
+    uint16_t nwrd;      // Words in upload
+    uint16_t id;        // Sequence ID
+    uint16_t crc;       // CRC-16 of sequence
+    uint32_t val[4];    // APID, packet name, argument, and delay of step
+    size_t   n = 0;     // Bytes serialized
+    int      i;         // Counter
+
+    char buf[4+SEQ_NSTEP*SEQ_STEP_NWRD*2]; // Serialized sequence
+    char line[200];                        // Line from file
+    char* token;                           // Field of line
+    char* end;                             // End of number in field
+
+    FILE* fd; // File descriptor
+
+    // Check sequence ID:
+    id = strtoul(cmd_str_arr[1],&end,0);
+    if ((end == cmd_str_arr[1]) || (id >= SEQ_NSEQ)) {
+        // Print error message:
+        printf("(MACRO_SEQ) <ERROR> Sequence ID \"%s\" invalid (0 to %d)\n",\
+            cmd_str_arr[1],SEQ_NSEQ-1);
+
+        return;
+    }
+
+    // Open sequence file:
+    fd = fopen(cmd_str_arr[2],"r");
+    if (fd == NULL) {
+        // Print error message:
+        printf("(MACRO_SEQ) <ERROR> Unable to open \"%s\"\n",\
+            cmd_str_arr[2]);
+
+        return;
+    }
+
+    // Read file line by line:
+    while (fgets(line,sizeof(line),fd) != NULL) {
+        // Strip newline character and skip blank lines:
+        line[strcspn(line,"\r\n")] = 0;
+        token = strtok(line,",");
+        if (token == NULL) {
+            continue;
+        }
+
+        // Check step count:
+        if (nstep == SEQ_NSTEP) {
+            // Print error message:
+            printf("(MACRO_SEQ) <ERROR> More than %d steps\n",SEQ_NSTEP);
+            fclose(fd);
+
+            return;
+        }
+
+        // Parse APID, packet name, argument, and delay:
+        for (i = 0; i < 4; ++i) {
+            if (token == NULL) {
+                // Print error message:
+                printf("(MACRO_SEQ) <ERROR> Step %d has fewer than 4"
+                    " fields\n",nstep);
+                fclose(fd);
+
+                return;
+            }
+            val[i] = strtoul(token,NULL,0);
+            token = strtok(NULL,",");
+        }
+
+        // Store step words:
+        wrd[nstep*SEQ_STEP_NWRD+0] = val[0];
+        wrd[nstep*SEQ_STEP_NWRD+1] = val[1];
+        wrd[nstep*SEQ_STEP_NWRD+2] = val[2] >> 16;
+        wrd[nstep*SEQ_STEP_NWRD+3] = val[2] & 0xFFFF;
+        wrd[nstep*SEQ_STEP_NWRD+4] = val[3] >> 16;
+        wrd[nstep*SEQ_STEP_NWRD+5] = val[3] & 0xFFFF;
+        ++nstep;
+    }
+
+    // Close file:
+    fclose(fd);
+
+    // Check step count:
+    if (nstep == 0) {
+        // Print error message:
+        printf("(MACRO_SEQ) <ERROR> Sequence file has no steps\n");
+
+        return;
+    }
+
+    // Serialize sequence and calculate CRC-16:
+    nwrd = nstep*SEQ_STEP_NWRD;
+    buf[n++] = id >> 8;
+    buf[n++] = id & 0xFF;
+    buf[n++] = nstep >> 8;
+    buf[n++] = nstep & 0xFF;
+    for (i = 0; i < nwrd; ++i) {
+        buf[n++] = wrd[i] >> 8;
+        buf[n++] = wrd[i] & 0xFF;
+    }
+    crc = calc_ccsds_crc(buf,n);
+
+    // Print:
+    printf("(MACRO_SEQ) Uploading %d step sequence %d (CRC 0x%04X)\n",\
+        nstep,id,crc);
+
+    // Begin upload:
+    send_seq_cmd("bgnseqld",((uint32_t) id << 16) | nstep);
+
+    // Send words:
+    for (i = 0; i < nwrd; ++i) {
+        send_seq_cmd("seqld",((uint32_t) i << 16) | wrd[i]);
+    }
+
+    // End upload:
+    send_seq_cmd("endseqld",crc);
+
+    // Print:
+    printf("(MACRO_SEQ) Sequence upload sent; run it with \"cmd hepcats"
+        " runseq with 0x%X\"\n",id);
+
+    return;
+}
@@ -4,6 +4,11 @@
 //
 // Write telecommand packet to uplink serial port
 //
+// Every telecommand packet is preceded by the CCSDS attached sync marker
+// (ccsds_asm.h), as on the downlink, so the flight software receiver can
+// find packet boundaries and resynchronize after a byte is dropped or
+// inserted on the uplink. Marker and packet are written together.
+//
 // -------------------------------------------------------------------------- /
 //
 // Input Arguments:
@@ -27,15 +32,29 @@
 #include <stdio.h>   // Standard input/output definitions
 #include <stdlib.h>  // Standard library 
 #include <string.h>  // String function definitions 
+#include <unistd.h>  // UNIX standard function definitions
 #include <errno.h>   // Error number definitions 
 
+// Header files:
+#include "ccsds_asm.h" // CCSDS attached sync marker
+
+// Macro definitions:
+#define TELECMD_PKT_SIZE 20 // Telecommand packet size in bytes
+
 // Write buffer to port function
 void write_port(int fd, char* buffer) {
-    // Write buffer to port:
-    int bytes_sent = write(fd,buffer,20); // 17 byte telecommand packet
+    // Definitions and initializations:
+    char frm_buf[CCSDS_ASM_SIZE+TELECMD_PKT_SIZE]; // Marker and packet
+
+    // Prefix packet with attached sync marker:
+    memcpy(frm_buf,ccsds_asm,CCSDS_ASM_SIZE);
+    memcpy(frm_buf+CCSDS_ASM_SIZE,buffer,TELECMD_PKT_SIZE);
+
+    // Write marker and packet to port:
+    int bytes_sent = write(fd,frm_buf,sizeof(frm_buf));
 
-    // Check for success (20 bytes sent):
-    if (bytes_sent != 20) {
+    // Check for success (marker and 20 byte packet sent):
+    if (bytes_sent != sizeof(frm_buf)) {
         // Print error message:
         printf("(WRITE_BUFFER) <ERROR> Unable to write: %d, %d\n",\
             bytes_sent,errno);
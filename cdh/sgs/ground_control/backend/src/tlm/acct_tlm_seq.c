@@ -0,0 +1,127 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Account Telemetry Sequence
+//
+// Telemetry packet sequence count accounting
+//
+// Flight software gives each APID its own 14 bit sequence count that wraps
+// from 16383 to 0. Each received packet's sequence count is compared to the
+// last one received on the same APID (modulo 16384):
+//
+//     - Difference of 1: in sequence
+//     - Difference of 0: duplicate
+//     - Difference less than half the sequence range: gap (difference - 1
+//       packets lost)
+//     - Otherwise: out of order (late or played back packet); the last
+//       sequence count is not moved backwards
+//
+// Running statistics per APID (received, lost, duplicate, out of order, and
+// loss percentage) are printed whenever a gap or duplicate is found and
+// every TLM_SEQ_STATS_PRD packets.
+//
+// -------------------------------------------------------------------------- /
+//
+// Input Arguments:
+// - APID
+// - Sequence count
+//
+// Output Arguments:
+// - N/A
+//
+// -------------------------------------------------------------------------- /
+//
+// agent
+// Project HEPCATS
+// Subsystem: C&DH
+// Created: October 17, 2026
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Standard libraries:
+#include <stdio.h>   // Standard input/output definitions
+#include <stdint.h>  // Integer types
+
+// Header files:
+#include "ccsds_pkt.h"    // CCSDS packet codec
+#include "acct_tlm_seq.h" // Account telemetry sequence function declaration
+
+// Macro definitions:
+#define TLM_SEQ_MOD       (CCSDS_SEQ_MASK+1) // Sequence count modulus
+#define TLM_SEQ_STATS_PRD 100                // Statistics print period in
+                                             // packets (per APID)
+
+// Sequence statistics structure:
+struct tlm_seq_stats {
+    uint8_t  init;     // First packet received flag
+    uint16_t last;     // Last sequence count
+    uint32_t rx_cnt;   // Received packet count
+    uint32_t lost_cnt; // Lost packet count (gaps)
+    uint32_t dup_cnt;  // Duplicate packet count
+    uint32_t ooo_cnt;  // Out of order packet count
+};
+
+// Variable definitions:
+static struct tlm_seq_stats tlm_seq_stats_tbl[CCSDS_APID_MASK+1];
+
+// Print sequence statistics of APID
+static void prnt_tlm_seq_stats(uint16_t apid, struct tlm_seq_stats* stats) {
+    // Print:
+    printf("SEQ:0x%02X:%u,%u,%u,%u,%0.3f\n",apid,stats->rx_cnt,\
+        stats->lost_cnt,stats->dup_cnt,stats->ooo_cnt,\
+        100.0*stats->lost_cnt/(stats->rx_cnt+stats->lost_cnt));
+}
+
+void acct_tlm_seq(uint16_t apid, uint16_t seq_cnt) {
+    // Definitions and initializations:
+    struct tlm_seq_stats* stats = &tlm_seq_stats_tbl[apid & CCSDS_APID_MASK];
+
+    uint16_t seq_diff; // Sequence count difference (modulo 16384)
+
+    uint8_t prnt_flg = 0; // Print statistics flag
+
+    // Increment received packet count:
+    stats->rx_cnt++;
+
+    // Check for first packet of APID:
+    if (!stats->init) {
+        stats->init = 1;
+        stats->last = seq_cnt;
+
+        return;
+    }
+
+    // Get sequence count difference from last packet:
+    seq_diff = (seq_cnt - stats->last) & CCSDS_SEQ_MASK;
+
+    // Classify packet:
+    if (seq_diff == 1) {
+        // In sequence:
+        stats->last = seq_cnt;
+    } else if (seq_diff == 0) {
+        // Duplicate:
+        stats->dup_cnt++;
+
+        // Print:
+        printf("(ACCT_TLM_SEQ) <WARNING> APID 0x%02X duplicate sequence"
+            " count %u\n",apid,seq_cnt);
+        prnt_flg = 1;
+    } else if (seq_diff < TLM_SEQ_MOD/2) {
+        // Gap:
+        stats->lost_cnt += seq_diff-1;
+        stats->last = seq_cnt;
+
+        // Print:
+        printf("(ACCT_TLM_SEQ) <WARNING> APID 0x%02X sequence gap; %u"
+            " packet(s) lost before sequence count %u\n",apid,seq_diff-1,\
+            seq_cnt);
+        prnt_flg = 1;
+    } else {
+        // Out of order:
+        stats->ooo_cnt++;
+    }
+
+    // Print statistics after gap or duplicate and periodically:
+    if (prnt_flg || (stats->rx_cnt % TLM_SEQ_STATS_PRD == 0)) {
+        prnt_tlm_seq_stats(apid,stats);
+    }
+}
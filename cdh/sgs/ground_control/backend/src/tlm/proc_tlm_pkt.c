@@ -4,6 +4,12 @@
 //
 // Telemetry packet processor
 //
+// Housekeeping and magnetometer DAQ packets carry several samples packed
+// back to back, each behind an aggregated telemetry sub-header (see
+// agg_tlm_pkt.h). Each housekeeping record is printed on its own, and the
+// magnetometer DAQ scans in a packet are averaged and saved together.
+// Encoded magnetometer DAQ sub-samples are decoded first (mdq_cdc.h).
+//
 // -------------------------------------------------------------------------- /
 //
 // Input Arguments:
@@ -30,105 +36,225 @@
 #include <stdint.h>  // Integer types
 #include <time.h>    // Standard time
 
+// Header files:
+#include "ccsds_pkt.h"    // CCSDS packet codec
+#include "ccsds_crc.h"    // CCSDS packet error control (CRC)
+#include "agg_tlm_pkt.h"  // Aggregated telemetry packet sub-header
+#include "mdq_cdc.h"      // Magnetometer DAQ codec
+#include "acct_tlm_seq.h" // Account telemetry sequence function declaration
+
 // Macro definitions:
 #define APID_SW  0x00 // Software origin
 #define APID_IMG 0x64 // Image origin
 #define APID_MDQ 0xC8 // Magnetometer DAQ origin
 
-#define MDQ_BUF_SIZE 768 // Magnetometer DAQ read size in bytes
+#define HK_REC_SIZE  80 // Housekeeping record size in bytes
+#define MDQ_SCAN_SIZE 6 // Magnetometer DAQ scan size in bytes (channels 0, 1,
+                        // and 2)
+#define MDQ_RAW_MAX \
+    (CCSDS_TLM_DAT_MAX*20) // Magnetometer DAQ data per packet in bytes
+                           // (maximum; a 10 byte codec block decodes to
+                           // 192 bytes)
+
+// Housekeeping record processor function
+static void proc_hk_rec(char* hk_rec) {
+    // Declarations and initializations:
+    uint8_t  val_telecmd_pkt_cnt = 0;     // Valid telecommand packet counter
+    uint8_t  inv_telecmd_pkt_cnt = 0;     // Invalid telecommand packet counter
+    uint8_t  rx_telecmd_pkt_cnt = 0;      // Received telecommand packet count
+    uint8_t  val_cmd_cnt = 0;             // Valid command counter
+    uint8_t  inv_cmd_cnt = 0;             // Invalid command counter
+    uint8_t  cmd_exec_suc_cnt = 0;        // Commands executed successfully counter
+    uint8_t  cmd_exec_err_cnt = 0;        // Commands not executed (error) counter
+    uint16_t tlm_pkt_xfr_frm_seq_cnt = 0; // Packet sequence count
+    uint16_t acq_img_cnt = 0;             // Acquired images count
+    uint8_t  img_acq_prog_flag = 0;       // Image acquisition in progress flag
+    uint8_t  mdq_scan_state = 0;          // Magnetometer DAQ scanning state
+    uint8_t  ers_rly_swtch_state = 0;     // Electrical relay switch state
+    uint8_t  flt_tbl_mode = 0;            // Filter table mode
+    uint16_t img_accpt_cnt = 0;           // Accepted images (from IPS) count
+    uint16_t img_rej_cnt = 0;             // Rejected images (from IPS) count
+    time_t   next_img_acq_tm = 0;         // Next image acquisition time
+    time_t   next_atc_tm = 0;             // Next absolutely timed command time
+    uint8_t  pbk_prog_flg = 0;            // Playback progress (0: idle;
+                                          // 1-100: percent)
+    time_t   sys_tm = 0;                  // System time
+    uint8_t  ips_mdl_ld_state = 0;        // IPS model load state
+    uint16_t dl_dvrt_cnt[3] = {0};        // Frames diverted from downlink to
+                                          // recording (HK, MDQ, IMG class)
+    uint16_t queue_hwm[4] = {0};          // Message queue high-water marks
+                                          // (agg_tlm, flt_tbl, tx_tlm_pkt,
+                                          // crt_file)
+    uint16_t queue_drop_cnt[4] = {0};     // Message queue drop counters
+    uint16_t flt_tbl_def_crc = 0;         // Filter table definition CRC-16
+    uint8_t  dl_util_pct = 0;             // Downlink line utilization (%)
+    uint8_t  mdq_cdc_flg = 0;             // Magnetometer DAQ codec flag
+    uint16_t stor_free_mb = 0;            // Free recording storage (MB)
+    uint16_t stor_evct_cnt[3] = {0};      // Recorded segments evicted (HK,
+                                          // MDQ, IMG class)
+    uint16_t atc_cnt = 0;                 // Scheduled absolutely timed
+                                          // commands
+    uint8_t  seq_run_id = 0xFF;           // Running sequence ID (0xFF: idle)
+    uint16_t seq_suc_cnt = 0;             // Sequence steps executed
+                                          // successfully counter
+    uint16_t seq_err_cnt = 0;             // Sequence steps not executed
+                                          // (error) counter
+    uint16_t telecmd_sync_loss_cnt = 0;   // Uplink sync loss counter
+    uint16_t telecmd_resync_cnt = 0;      // Uplink resynchronization counter
+    uint16_t telecmd_crc_err_cnt = 0;     // Uplink packet CRC failure counter
+
+    char next_img_acq_tm_str[200]; // Next image acquisition time string
+    char next_atc_tm_str[200];     // Next absolutely timed command time string
+    char sys_tm_str[200];          // System time string
+    char pbk_prog_str[10];         // Playback progress string
+    char seq_run_id_str[10];       // Running sequence string
+
+    struct tm* tm;
+
+    // Parse data:
+    memcpy(&rx_telecmd_pkt_cnt,hk_rec+0,1);
+    memcpy(&val_telecmd_pkt_cnt,hk_rec+1,1);
+    memcpy(&inv_telecmd_pkt_cnt,hk_rec+2,1);
+    memcpy(&val_cmd_cnt,hk_rec+3,1);
+    memcpy(&inv_cmd_cnt,hk_rec+4,1);
+    memcpy(&cmd_exec_suc_cnt,hk_rec+5,1);
+    memcpy(&cmd_exec_err_cnt,hk_rec+6,1);
+    memcpy(&tlm_pkt_xfr_frm_seq_cnt,hk_rec+7,2);
+    memcpy(&acq_img_cnt,hk_rec+9,2);
+    memcpy(&img_acq_prog_flag,hk_rec+11,1);
+    memcpy(&ers_rly_swtch_state,hk_rec+12,1);
+    memcpy(&mdq_scan_state,hk_rec+13,1);
+    memcpy(&flt_tbl_mode,hk_rec+14,1);
+    memcpy(&img_accpt_cnt,hk_rec+15,2);
+    memcpy(&img_rej_cnt,hk_rec+17,2);
+    memcpy(&next_img_acq_tm,hk_rec+19,4);
+    memcpy(&next_atc_tm,hk_rec+23,4);
+    memcpy(&pbk_prog_flg,hk_rec+27,1);
+    memcpy(&sys_tm,hk_rec+28,4);
+    memcpy(&ips_mdl_ld_state,hk_rec+32,1);
+    memcpy(&dl_dvrt_cnt[0],hk_rec+33,2);
+    memcpy(&dl_dvrt_cnt[1],hk_rec+35,2);
+    memcpy(&dl_dvrt_cnt[2],hk_rec+37,2);
+    for (int i = 0; i < 4; ++i) {
+        memcpy(&queue_hwm[i],hk_rec+39+4*i,2);
+        memcpy(&queue_drop_cnt[i],hk_rec+41+4*i,2);
+    }
+    memcpy(&flt_tbl_def_crc,hk_rec+55,2);
+    memcpy(&dl_util_pct,hk_rec+57,1);
+    memcpy(&mdq_cdc_flg,hk_rec+58,1);
+    memcpy(&stor_free_mb,hk_rec+59,2);
+    memcpy(&stor_evct_cnt[0],hk_rec+61,2);
+    memcpy(&stor_evct_cnt[1],hk_rec+63,2);
+    memcpy(&stor_evct_cnt[2],hk_rec+65,2);
+    memcpy(&atc_cnt,hk_rec+67,2);
+    memcpy(&seq_run_id,hk_rec+69,1);
+    memcpy(&seq_suc_cnt,hk_rec+70,2);
+    memcpy(&seq_err_cnt,hk_rec+72,2);
+    memcpy(&telecmd_sync_loss_cnt,hk_rec+74,2);
+    memcpy(&telecmd_resync_cnt,hk_rec+76,2);
+    memcpy(&telecmd_crc_err_cnt,hk_rec+78,2);
+
+    // Convert Unix timestamps to "YYYY/DOY-HH:MM:SS"
+    tm = gmtime(&next_img_acq_tm);
+    strftime(next_img_acq_tm_str,sizeof(next_img_acq_tm_str),\
+        "%Y/%j-%H:%M:%S",tm);
+
+    tm = gmtime(&next_atc_tm);
+    strftime(next_atc_tm_str,sizeof(next_atc_tm_str),\
+        "%Y/%j-%H:%M:%S",tm);
+
+    tm = gmtime(&sys_tm);
+    strftime(sys_tm_str,sizeof(sys_tm_str),\
+        "%Y/%j-%H:%M:%S",tm);
+
+    // Format playback progress ("PBK <percent>%" or "IDLE"):
+    if (pbk_prog_flg) {
+        sprintf(pbk_prog_str,"PBK %u%%",pbk_prog_flg);
+    } else {
+        strcpy(pbk_prog_str,"IDLE");
+    }
+
+    // Format running sequence ("SEQ <ID>" or "IDLE"):
+    if (seq_run_id != 0xFF) {
+        sprintf(seq_run_id_str,"SEQ %u",seq_run_id);
+    } else {
+        strcpy(seq_run_id_str,"IDLE");
+    }
+
+    // Print:
+    printf("0x00:%u,%u,%u,%u,%u,%u,%u,%u,%u,%s,%s,%s,%s,%u,%u,%s,%s,%s,%s,%s,%u,%u,%u,"
+        "%u,%u,%u,%u,%u,%u,%u,%u,0x%04X,%u,%s,%u,%u,%u,%u,%u,%s,%u,%u,"
+        "%u,%u,%u\n",\
+        rx_telecmd_pkt_cnt,val_telecmd_pkt_cnt,inv_telecmd_pkt_cnt,\
+        val_cmd_cnt,inv_cmd_cnt,cmd_exec_suc_cnt,\
+        cmd_exec_err_cnt,tlm_pkt_xfr_frm_seq_cnt,acq_img_cnt,\
+        img_acq_prog_flag ? "IN PROGRESS" : "IDLE",\
+        ers_rly_swtch_state ? "ON" : "OFF",\
+        mdq_scan_state ? "SCANNING" : "IDLE",\
+        flt_tbl_mode == 0 ? "NORM" : flt_tbl_mode == 1 ? \
+        "RT" : flt_tbl_mode == 2 ? "PBK" : flt_tbl_mode == 3 ? "IMG" : "MAG",\
+        img_accpt_cnt,img_rej_cnt,next_img_acq_tm_str,next_atc_tm_str,\
+        pbk_prog_str,sys_tm_str,ips_mdl_ld_state == 0 ? \
+        "LOADING" : "READY",dl_dvrt_cnt[0],dl_dvrt_cnt[1],dl_dvrt_cnt[2],\
+        queue_hwm[0],queue_drop_cnt[0],queue_hwm[1],queue_drop_cnt[1],\
+        queue_hwm[2],queue_drop_cnt[2],queue_hwm[3],queue_drop_cnt[3],\
+        flt_tbl_def_crc,dl_util_pct,mdq_cdc_flg ? "CDC" : "RAW",\
+        stor_free_mb,stor_evct_cnt[0],stor_evct_cnt[1],stor_evct_cnt[2],\
+        atc_cnt,seq_run_id_str,seq_suc_cnt,seq_err_cnt,telecmd_sync_loss_cnt,\
+        telecmd_resync_cnt,telecmd_crc_err_cnt);
+}
 
 // Telemetry processor function
 void proc_tlm_pkt(char* buffer) {
     // Definitions:
-    int empty_ind = 0; // Index where user data begins to be empty
+    struct ccsds_pri_hdr pri_hdr; // Packet primary header
+    struct ccsds_sec_hdr sec_hdr; // Packet secondary header
 
-    uint16_t pkt_hdr_pkt_id;
-    uint16_t pkt_hdr_pkt_seq_cnt;
-    uint16_t pkt_hdr_pkt_len;
+    char     pkt_dat_fld_usr_data[CCSDS_TLM_DAT_MAX];
+    uint16_t pkt_usr_dat_size; // User data size in bytes
 
-    uint32_t pkt_dat_fld_sec_hdr_t_fld_sec;
-    uint16_t pkt_dat_fld_sec_hdr_t_fld_msec;
-    uint8_t  pkt_dat_fld_sec_hdr_p_fld;
-    char     pkt_dat_fld_usr_data[1064];
-    uint16_t pkt_dat_fld_pkt_err_cnt;
+    // Decode packet header with CCSDS packet codec:
+    dec_ccsds_pri_hdr(buffer,&pri_hdr);
+    dec_ccsds_sec_hdr(buffer,&sec_hdr);
 
-    // Save input buffer to seperate fields:
-    memcpy(&pkt_hdr_pkt_id,buffer,2);
-    memcpy(&pkt_hdr_pkt_seq_cnt,buffer+2,2);
-    memcpy(&pkt_hdr_pkt_len,buffer+4,2);
+    // Get user data size from packet length field:
+    pkt_usr_dat_size = get_ccsds_pkt_size(buffer)-CCSDS_HDR_SIZE-\
+        CCSDS_ERR_CNT_SIZE;
 
-    memcpy(&pkt_dat_fld_sec_hdr_t_fld_sec,buffer+6,4);
-    memcpy(&pkt_dat_fld_sec_hdr_t_fld_msec,buffer+10,2);
-    memcpy(&pkt_dat_fld_sec_hdr_p_fld,buffer+13,1);
-    memcpy(&pkt_dat_fld_usr_data,buffer+14,1064);
-    memcpy(&pkt_dat_fld_pkt_err_cnt,buffer+1078,2);
+    // Get packet error control (after user data):
+    uint16_t pkt_err_cnt = get_be16(buffer+CCSDS_HDR_SIZE+pkt_usr_dat_size);
 
-    // Packet Header Identification:
-    uint8_t pkt_id_vrs;
-    uint8_t pkt_id_typ;
-    uint8_t pkt_id_sec_hdr_flg;
-    uint16_t pkt_id_apid;
+    // Check packet error control against CRC of packet. If CRC does not
+    // match, drop packet before it is parsed or appended to any file:
+    if (pkt_err_cnt != calc_ccsds_crc(buffer,CCSDS_HDR_SIZE+\
+        pkt_usr_dat_size)) {
+        // Print:
+        printf("(PROC_TLM_PKT) <ERROR> Packet error control mismatch;"
+            " packet dropped\n");
 
-    // Packet I.D. Version:
-    pkt_id_vrs = pkt_hdr_pkt_id & 0x07; // Mask to keep bits 0-2
+        return;
+    }
 
-    // Packet I.D. Type:
-    pkt_id_typ = pkt_hdr_pkt_id & 0x08; // Mask to keep bit 3
-    pkt_id_typ = pkt_id_typ >> 3;       // Shift right by 3 bits
+    // Account packet sequence count (gaps and duplicates):
+    acct_tlm_seq(pri_hdr.apid,pri_hdr.seq_cnt);
 
-    // Packet I.D. Secondary Header Flag:
-    pkt_id_sec_hdr_flg = pkt_hdr_pkt_id & 0x10;   // Mask to keep bit 4
-    pkt_id_sec_hdr_flg = pkt_id_sec_hdr_flg >> 4; // Shift right by 4 bits
+    // Save user data:
+    memset(pkt_dat_fld_usr_data,0,CCSDS_TLM_DAT_MAX);
+    memcpy(pkt_dat_fld_usr_data,buffer+CCSDS_HDR_SIZE,pkt_usr_dat_size);
 
-    // Packet I.D. APID:
-    pkt_id_apid = pkt_hdr_pkt_id & 0xFFE0; // Mask to keep bits 5-15
-    pkt_id_apid = pkt_id_apid >> 5;        // Shift right by 5 bits
+    // Packet Header Identification:
+    uint16_t pkt_id_apid = pri_hdr.apid;
 
     // Packet Header Packet Sequence Control
-    uint8_t pkt_seq_cnt_grp_flg;
-    uint16_t pkt_seq_cnt_pkt_name;
-
-    // Packet Sequence Control Grouping Flag:
-    pkt_seq_cnt_grp_flg = pkt_hdr_pkt_seq_cnt & 0x3; // Mask to keep bits 0-1
-
-    // Packet Sequence Control Packet Name:
-    pkt_seq_cnt_pkt_name = pkt_hdr_pkt_seq_cnt \
-        & 0xFFFC; // Mask to keep bits 2-15
-    pkt_seq_cnt_pkt_name = pkt_hdr_pkt_seq_cnt >> 2; // Shift right by 2 bits
+    uint8_t  pkt_seq_cnt_grp_flg = pri_hdr.grp_flg;
+    uint16_t pkt_seq_cnt_pkt_name = pri_hdr.seq_cnt;
 
     // Packet Header Packet Length
-    uint16_t pkt_len = pkt_hdr_pkt_len;
-
-    // Packet Data Field Packet Secondary Header
-    uint32_t pkt_t_fld_sec;
-    uint16_t pkt_t_fld_msec;
-
-    uint8_t pkt_p_fld_ext;
-    uint8_t pkt_p_fld_id;
-    uint8_t pkt_p_fld_bas;
-    uint8_t pkt_p_fld_frc;
+    uint16_t pkt_len = pri_hdr.pkt_len;
 
     // Packet Data Field Packet Secondary Header T-Fields:
-    pkt_t_fld_sec = pkt_dat_fld_sec_hdr_t_fld_sec;
-    pkt_t_fld_msec = pkt_dat_fld_sec_hdr_t_fld_msec;
-
-    // Packet Secondary Header P-Field Extension:
-    pkt_p_fld_ext = pkt_dat_fld_sec_hdr_p_fld & 0x0; // Mask to keep bit 0
-
-    // Packet Secondary Header P-Field Identification:
-    pkt_p_fld_id = pkt_dat_fld_sec_hdr_p_fld & 0xE; // Mask to keep bits 1-3
-    pkt_p_fld_id = pkt_p_fld_id >> 1;               // Shift right by 1 bit
-
-    // Packet Secondary Header P-Field Variation:
-    pkt_p_fld_bas = pkt_dat_fld_sec_hdr_p_fld & 0x30; // Mask to keep bit 4-5
-    pkt_p_fld_bas = pkt_p_fld_bas >> 4;               // Shift right by 4 bits
-
-    // Packet Secondary Header P-Field Variation:
-    pkt_p_fld_frc = pkt_dat_fld_sec_hdr_p_fld & 0xC0; // Mask to keep bit 6-7
-    pkt_p_fld_frc = pkt_p_fld_frc >> 6;               // Shift right by 5 bits
-
-    // Packet Data Field Packet Error Control:
-    uint16_t pkt_err_cnt = pkt_dat_fld_pkt_err_cnt;
+    uint32_t pkt_t_fld_sec = sec_hdr.t_sec;
+    uint16_t pkt_t_fld_msec = ccsds_frc_to_msec(sec_hdr.t_frc);
 
     // Check the source data type:
     // (If housekeeping, parse and print to screen. If imaging, save to file.
@@ -136,84 +262,45 @@ void proc_tlm_pkt(char* buffer) {
     // save to file)
     if (pkt_id_apid == APID_SW) {
         // Declarations and initializations:
-        uint8_t  val_telecmd_pkt_cnt = 0;     // Valid telecommand packet counter
-        uint8_t  inv_telecmd_pkt_cnt = 0;     // Invalid telecommand packet counter
-        uint8_t  rx_telecmd_pkt_cnt = 0;      // Received telecommand packet count
-        uint8_t  val_cmd_cnt = 0;             // Valid command counter
-        uint8_t  inv_cmd_cnt = 0;             // Invalid command counter
-        uint8_t  cmd_exec_suc_cnt = 0;        // Commands executed successfully counter
-        uint8_t  cmd_exec_err_cnt = 0;        // Commands not executed (error) counter
-        uint16_t tlm_pkt_xfr_frm_seq_cnt = 0; // Packet sequence count
-        uint16_t acq_img_cnt = 0;             // Acquired images count
-        uint8_t  img_acq_prog_flag = 0;       // Image acquisition in progress flag
-        uint8_t  mdq_scan_state = 0;          // Magnetometer DAQ scanning state
-        uint8_t  ers_rly_swtch_state = 0;     // Electrical relay switch state
-        uint8_t  flt_tbl_mode = 0;            // Filter table mode
-        uint16_t img_accpt_cnt = 0;           // Accepted images (from IPS) count
-        uint16_t img_rej_cnt = 0;             // Rejected images (from IPS) count
-        time_t   next_img_acq_tm = 0;         // Next image acquisition time
-        time_t   next_atc_tm = 0;             // Next absolutely timed command time
-        uint8_t  pbk_prog_flg = 0;            // Playback in progress flag
-        time_t   sys_tm = 0;                  // System time
-        uint8_t  ips_mdl_ld_state = 0;        // IPS model load state
-
-        char next_img_acq_tm_str[200]; // Next image acquisition time string
-        char next_atc_tm_str[200];     // Next absolutely timed command time string
-        char sys_tm_str[200];          // System time string
-
-        struct tm* tm;
-
-        // Parse data:
-        memcpy(&rx_telecmd_pkt_cnt,pkt_dat_fld_usr_data+0,1);
-        memcpy(&val_telecmd_pkt_cnt,pkt_dat_fld_usr_data+1,1);
-        memcpy(&inv_telecmd_pkt_cnt,pkt_dat_fld_usr_data+2,1);
-        memcpy(&val_cmd_cnt,pkt_dat_fld_usr_data+3,1);
-        memcpy(&inv_cmd_cnt,pkt_dat_fld_usr_data+4,1);
-        memcpy(&cmd_exec_suc_cnt,pkt_dat_fld_usr_data+5,1);
-        memcpy(&cmd_exec_err_cnt,pkt_dat_fld_usr_data+6,1);
-        memcpy(&tlm_pkt_xfr_frm_seq_cnt,pkt_dat_fld_usr_data+7,2);
-        memcpy(&acq_img_cnt,pkt_dat_fld_usr_data+9,2);
-        memcpy(&img_acq_prog_flag,pkt_dat_fld_usr_data+11,1);
-        memcpy(&ers_rly_swtch_state,pkt_dat_fld_usr_data+12,1);
-        memcpy(&mdq_scan_state,pkt_dat_fld_usr_data+13,1);
-        memcpy(&flt_tbl_mode,pkt_dat_fld_usr_data+14,1);
-        memcpy(&img_accpt_cnt,pkt_dat_fld_usr_data+15,2);
-        memcpy(&img_rej_cnt,pkt_dat_fld_usr_data+17,2);
-        memcpy(&next_img_acq_tm,pkt_dat_fld_usr_data+19,4);
-        memcpy(&next_atc_tm,pkt_dat_fld_usr_data+23,4);
-        memcpy(&pbk_prog_flg,pkt_dat_fld_usr_data+27,1);
-        memcpy(&sys_tm,pkt_dat_fld_usr_data+28,4);
-        memcpy(&ips_mdl_ld_state,pkt_dat_fld_usr_data+32,1);
-
-        // Convert Unix timestamps to "YYYY/DOY-HH:MM:SS"
-        tm = gmtime(&next_img_acq_tm);
-        strftime(next_img_acq_tm_str,sizeof(next_img_acq_tm_str),\
-            "%Y/%j-%H:%M:%S",tm);
-
-        tm = gmtime(&next_atc_tm);
-        strftime(next_atc_tm_str,sizeof(next_atc_tm_str),\
-            "%Y/%j-%H:%M:%S",tm);
-
-        tm = gmtime(&sys_tm);
-        strftime(sys_tm_str,sizeof(sys_tm_str),\
-            "%Y/%j-%H:%M:%S",tm);
+        uint16_t ofst;      // Sub-sample offset in user data
+        uint16_t t_ofst;    // Sub-sample time offset in milliseconds
+        uint16_t smpl_size; // Sub-sample size in bytes
+        uint8_t  enc_flg;   // Sub-sample encoded flag
+
+        // Loop through sub-samples and print each housekeeping record:
+        for (ofst = 0; ofst+AGG_SUB_HDR_SIZE <= pkt_usr_dat_size; \
+            ofst += AGG_SUB_HDR_SIZE+smpl_size) {
+            // Decode sub-header:
+            dec_agg_sub_hdr(pkt_dat_fld_usr_data+ofst,&t_ofst,&smpl_size,\
+                &enc_flg);
+
+            // Check sub-sample fits in user data:
+            if (ofst+AGG_SUB_HDR_SIZE+smpl_size > pkt_usr_dat_size) {
+                // Print:
+                printf("(PROC_TLM_PKT) <ERROR> Housekeeping sub-sample"
+                    " overruns packet; remainder dropped\n");
+
+                break;
+            }
 
-        // Print:
-        printf("0x00:%u,%u,%u,%u,%u,%u,%u,%u,%u,%s,%s,%s,%s,%u,%u,%s,%s,%s,%s,%s\n",\
-            rx_telecmd_pkt_cnt,val_telecmd_pkt_cnt,inv_telecmd_pkt_cnt,\
-            val_cmd_cnt,inv_cmd_cnt,cmd_exec_suc_cnt,\
-            cmd_exec_err_cnt,tlm_pkt_xfr_frm_seq_cnt,acq_img_cnt,\
-            img_acq_prog_flag ? "IN PROGRESS" : "IDLE",\
-            ers_rly_swtch_state ? "ON" : "OFF",\
-            mdq_scan_state ? "SCANNING" : "IDLE",\
-            flt_tbl_mode == 0 ? "NORM" : flt_tbl_mode == 1 ? \
-            "RT" : flt_tbl_mode == 2 ? "PBK" : flt_tbl_mode == 3 ? "IMG" : "MAG",\
-            img_accpt_cnt,img_rej_cnt,next_img_acq_tm_str,next_atc_tm_str,\
-            pbk_prog_flg ? "PBK" : "IDLE",sys_tm_str,ips_mdl_ld_state == 0 ? \
-            "LOADING" : "READY");
+            // Loop through records in sub-sample:
+            for (int i = 0; i+HK_REC_SIZE <= smpl_size; i += HK_REC_SIZE) {
+                proc_hk_rec(pkt_dat_fld_usr_data+ofst+AGG_SUB_HDR_SIZE+i);
+            }
+        }
     } else if (pkt_id_apid == APID_MDQ) {
         // Declarations and initializations:
-        float mdq_conv_buf[MDQ_BUF_SIZE/2]; // Magnetometer DAQ converted data buffer
+        char  mdq_raw_buf[MDQ_RAW_MAX];    // Magnetometer DAQ raw data buffer
+        float mdq_conv_buf[MDQ_RAW_MAX/2]; // Magnetometer DAQ converted data buffer
+
+        uint16_t mdq_raw_size = 0; // Magnetometer DAQ raw data size in bytes
+        uint16_t mdq_nscan;        // Magnetometer DAQ scans in packet
+        int32_t  dec_size;         // Decoded sub-sample size in bytes
+
+        uint16_t ofst;      // Sub-sample offset in user data
+        uint16_t t_ofst;    // Sub-sample time offset in milliseconds
+        uint16_t smpl_size; // Sub-sample size in bytes
+        uint8_t  enc_flg;   // Sub-sample encoded flag
 
         float mdq_chnl0_sum = 0; // Channel 0 sum
         float mdq_chnl1_sum = 0; // Channel 1 sum
@@ -226,6 +313,60 @@ void proc_tlm_pkt(char* buffer) {
         char file_path[50];
         char file_name[100];
 
+        // Loop through sub-samples to gather scans into one contiguous
+        // buffer:
+        for (ofst = 0; ofst+AGG_SUB_HDR_SIZE <= pkt_usr_dat_size; \
+            ofst += AGG_SUB_HDR_SIZE+smpl_size) {
+            // Decode sub-header:
+            dec_agg_sub_hdr(pkt_dat_fld_usr_data+ofst,&t_ofst,&smpl_size,\
+                &enc_flg);
+
+            // Check sub-sample fits in user data:
+            if (ofst+AGG_SUB_HDR_SIZE+smpl_size > pkt_usr_dat_size) {
+                // Print:
+                printf("(PROC_TLM_PKT) <ERROR> Magnetometer DAQ sub-sample"
+                    " overruns packet; remainder dropped\n");
+
+                break;
+            }
+
+            // Check for encoded sub-sample:
+            if (enc_flg) {
+                // Decode sub-sample and append to raw data buffer:
+                dec_size = dec_mdq_cdc(pkt_dat_fld_usr_data+ofst+\
+                    AGG_SUB_HDR_SIZE,smpl_size,mdq_raw_buf+mdq_raw_size,\
+                    MDQ_RAW_MAX-mdq_raw_size);
+
+                // Check success:
+                if (dec_size < 0) {
+                    // Print:
+                    printf("(PROC_TLM_PKT) <ERROR> Magnetometer DAQ"
+                        " sub-sample cannot be decoded; remainder dropped\n");
+
+                    break;
+                }
+                mdq_raw_size += dec_size;
+            } else {
+                // Check sub-sample fits in raw data buffer:
+                if (mdq_raw_size+smpl_size > MDQ_RAW_MAX) {
+                    break;
+                }
+
+                // Append sub-sample to raw data buffer:
+                memcpy(mdq_raw_buf+mdq_raw_size,\
+                    pkt_dat_fld_usr_data+ofst+AGG_SUB_HDR_SIZE,smpl_size);
+                mdq_raw_size += smpl_size;
+            }
+        }
+
+        // Get number of whole scans:
+        mdq_nscan = mdq_raw_size/MDQ_SCAN_SIZE;
+
+        // Check for scans:
+        if (mdq_nscan == 0) {
+            return;
+        }
+
         // Loop through channels 0, 1, and 2 raw data buffers to convert from
         // char to signed 16 bit numbers. Each char is 8 bits, so the
         // measurement in each channel is composed of two chars: the one at 2n
@@ -233,10 +374,10 @@ void proc_tlm_pkt(char* buffer) {
         // combine with char at 2n. Once converted to 16 bit numbers, convert
         // from counts to nano Tesla. The conversion is:
         // [nT] = (10*(counts/32768))[V] * (10000[nT]/1[V])
-        for (int i = 0; i < MDQ_BUF_SIZE/2; ++i) {
+        for (int i = 0; i < 3*mdq_nscan; ++i) {
             // Convert two char to signed 16 bit number:
-            mdq_conv_buf[i] = (pkt_dat_fld_usr_data[2*i+1] << 8) | \
-                (pkt_dat_fld_usr_data[2*i] & 0xFF);
+            mdq_conv_buf[i] = (mdq_raw_buf[2*i+1] << 8) | \
+                (mdq_raw_buf[2*i] & 0xFF);
 
             // Convert from counts to nT:
             mdq_conv_buf[i] = \
@@ -244,16 +385,16 @@ void proc_tlm_pkt(char* buffer) {
         }
 
         // Loop to find sum of channel 0, 1, and 2:
-        for (int i = 0; i < (MDQ_BUF_SIZE/2-2); i+=3) {
+        for (int i = 0; i < 3*mdq_nscan; i+=3) {
             mdq_chnl0_sum = mdq_chnl0_sum + mdq_conv_buf[i];
             mdq_chnl1_sum = mdq_chnl1_sum + mdq_conv_buf[i+1];
             mdq_chnl2_sum = mdq_chnl2_sum + mdq_conv_buf[i+2];
         }
 
         // Find averages for channel 0, 1, and 2:
-        mdq_chnl0_avg = mdq_chnl0_sum/128;
-        mdq_chnl1_avg = mdq_chnl1_sum/128;
-        mdq_chnl2_avg = mdq_chnl2_sum/128;
+        mdq_chnl0_avg = mdq_chnl0_sum/mdq_nscan;
+        mdq_chnl1_avg = mdq_chnl1_sum/mdq_nscan;
+        mdq_chnl2_avg = mdq_chnl2_sum/mdq_nscan;
 
         // Print to screen:
         printf("0xC8:%0.3f,%0.3f,%0.3f\n",mdq_chnl0_avg,mdq_chnl1_avg,\
@@ -269,7 +410,7 @@ void proc_tlm_pkt(char* buffer) {
         FILE* file_ptr = fopen(file_name,"wb");
 
         // Print converted user data for channel 0, 1, and 2:
-        fwrite(&mdq_conv_buf,1,sizeof(mdq_conv_buf),file_ptr);
+        fwrite(&mdq_conv_buf,sizeof(float),3*mdq_nscan,file_ptr);
 
         // Close file:
         fclose(file_ptr);
@@ -278,10 +419,8 @@ void proc_tlm_pkt(char* buffer) {
         char file_path[50];
         char file_name[100];
 
-        char empty_char = "E";
-
-        // If first segment, create new file:
-        if (pkt_seq_cnt_grp_flg == 1) {
+        // If first segment (or unsegmented payload), create new file:
+        if ((pkt_seq_cnt_grp_flg == 1) || (pkt_seq_cnt_grp_flg == 3)) {
             // Set filepath:
             strcpy(file_path,"../../raw_record_files/img/"); // Relative to bin
 
@@ -293,7 +432,7 @@ void proc_tlm_pkt(char* buffer) {
             FILE* file_ptr = fopen(file_name,"wb");
 
             // Print user data to file:
-            fwrite(&pkt_dat_fld_usr_data,1,1064,file_ptr);
+            fwrite(&pkt_dat_fld_usr_data,1,pkt_usr_dat_size,file_ptr);
 
             // Close file:
             fclose(file_ptr);
@@ -308,21 +447,6 @@ void proc_tlm_pkt(char* buffer) {
             fclose(file_ptr);
         // Otherwise append to current file:
         } else {
-            // Check if last segment:
-            if (pkt_seq_cnt_grp_flg == 2) {
-                // Loop to determine byte position where "E" begins
-                // ("E" indicates that the character is empty)
-                for (int i = 0; i < 1064; ++i) {
-                    if (pkt_dat_fld_usr_data[i] == empty_char) {
-                        // Check if the next position is also "E". If yes, then
-                        // found the byte position:
-                        if (pkt_dat_fld_usr_data[i+1] == empty_char) {
-                            empty_ind = i;
-                        }
-                    }
-                }
-            }
-
             // Open file to get current file name:
             FILE* file_ptr = \
                 fopen("../../raw_record_files/img/current_file.txt","r");
@@ -337,7 +461,7 @@ void proc_tlm_pkt(char* buffer) {
             file_ptr = fopen(file_name,"ab");
 
              // Print user data to file:
-            fwrite(&pkt_dat_fld_usr_data,1,1064-empty_ind,file_ptr);
+            fwrite(&pkt_dat_fld_usr_data,1,pkt_usr_dat_size,file_ptr);
 
             // Close file:
             fclose(file_ptr);
@@ -352,9 +476,9 @@ void proc_tlm_pkt(char* buffer) {
 // Print results:
 printf("Packet Header\n");
 printf("  Packet I.D.\n");
-printf("      Version               : %u\n",pkt_id_vrs);
-printf("      Type                  : %u\n",pkt_id_typ);
-printf("      Secondary Header Flag : %u\n",pkt_id_sec_hdr_flg);
+printf("      Version               : %u\n",pri_hdr.vrs);
+printf("      Type                  : %u\n",pri_hdr.typ);
+printf("      Secondary Header Flag : %u\n",pri_hdr.sec_hdr_flg);
 printf("      APID                  : %u\n",pkt_id_apid);
 printf("  Packet Sequence Control\n");
 printf("      Grouping Flags        : %u\n",pkt_seq_cnt_grp_flg);
@@ -365,10 +489,10 @@ printf("Packet Data Field\n");
 printf("  Packet Secondary Header\n");
 printf("      T-Field Sec             : %u\n",pkt_t_fld_sec);
 printf("      T-Field mSec            : %u\n",pkt_t_fld_msec);
-printf("      P-Field Ext             : %u\n",pkt_p_fld_ext);
-printf("      P-Field I.D.            : %u\n",pkt_p_fld_id);
-printf("      P-Field Basic Octets    : %u\n",pkt_p_fld_bas);
-printf("      P-Field Fraction Octets : %u\n",pkt_p_fld_frc);
+printf("      P-Field Ext             : %u\n",sec_hdr.p_ext);
+printf("      P-Field I.D.            : %u\n",sec_hdr.p_id);
+printf("      P-Field Basic Octets    : %u\n",sec_hdr.p_bas);
+printf("      P-Field Fraction Octets : %u\n",sec_hdr.p_frc);
 printf("  Packet Error Control\n");
 printf("      Packet Error Control  : %u\n",pkt_err_cnt);
 printf("\n");
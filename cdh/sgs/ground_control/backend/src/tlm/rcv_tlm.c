@@ -11,7 +11,8 @@
 // -------------------------------------------------------------------------- /
 //
 // Input Arguments:
-// - N/A
+// - argv[1] (downlink serial port, optional, default /dev/ttyUSB1; e.g. the
+//   pty of the link simulator)
 //
 // Output Arguments:
 // - N/A
@@ -39,7 +40,7 @@
 
 void main(int argc, char const *argv[]) {
     // Open port:
-    int fd = open_port("/dev/ttyUSB1");
+    int fd = open_port((argc > 1) ? (char*) argv[1] : "/dev/ttyUSB1");
 
     // Allocate buffer for telemetry packet:
     char* buf = malloc(1080*sizeof(char));
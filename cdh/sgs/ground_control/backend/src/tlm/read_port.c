@@ -1,18 +1,32 @@
 ///////////////////////////////////////////////////////////////////////////////
 //
 // Read (Serial) Port
-// 
+//
 // Read downlink serial port for telemetry packet
 //
+// Every telemetry packet is preceded by the CCSDS attached sync marker
+// (ccsds_asm.h). Bytes from the port are collected in a receive buffer that
+// is searched for the marker (SIMD). The primary header after the marker must
+// be a plausible telemetry packet header (version, type, secondary header
+// flag, and length in range) and the packet must pass its packet error
+// control (CRC) before it is returned. A marker that fails either check is a
+// false lock: the search resumes one byte past it. Bytes lost or corrupted on
+// the link therefore cost at most the packet they hit; the receiver relocks
+// on the marker of the next packet.
+//
+// Receiver statistics (packets received, false locks, bytes skipped while
+// searching) are printed whenever the receiver relocks and can be read with
+// get_read_port_stat().
+//
 // -------------------------------------------------------------------------- /
 //
 // Input Arguments:
 // - fd
-// - buffer
+// - buffer (at least CCSDS_TLM_PKT_MAX bytes)
 //
 // Output Arguments:
 // - buffer
-// 
+//
 // -------------------------------------------------------------------------- /
 //
 // Benjamin Spencer
@@ -20,7 +34,7 @@
 // Project HEPCATS
 // Subsystem: C&DH
 // Created: February 12, 2018
-// 
+//
 ///////////////////////////////////////////////////////////////////////////////
 
 // Standard libraries:
@@ -30,33 +44,138 @@
 #include <string.h>  // String function definitions
 #include <unistd.h>  // UNIX standard function definitions
 
-char* read_port(int fd,char* buffer) {
-	// Definitions and initializations: 
+// Header files:
+#include "ccsds_pkt.h" // CCSDS packet codec
+#include "ccsds_crc.h" // CCSDS packet error control (CRC)
+#include "ccsds_asm.h" // CCSDS attached sync marker
+#include "read_port.h" // Read port function declaration
+
+// Macro definitions:
+#define RX_BUF_SIZE (4*(CCSDS_ASM_SIZE+CCSDS_TLM_PKT_MAX)) // Receive buffer
+                                                          // size in bytes
+
+// Receive buffer:
+static char   rx_buf[RX_BUF_SIZE];
+static size_t rx_len = 0; // Bytes in receive buffer
+
+// Receiver statistics:
+static struct read_port_stat rx_stat;
+
+// Read available bytes from port into receive buffer (waits for at least one)
+static void fill_rx_buf(int fd) {
+	// Definitions and initializations:
 	int bytes_received;
-	int bytes_read = 0;
-	int bytes_to_read = 1080; // 20 bytes telecommand packet
 
-	// Temporary buffer:
-	char temp_buffer[1080];
+	// Loop until bytes are received:
+	do {
+		bytes_received = read(fd,rx_buf+rx_len,RX_BUF_SIZE-rx_len);
+	} while (bytes_received <= 0);
+
+	// Increment bytes in buffer:
+	rx_len += bytes_received;
+}
+
+// Drop bytes from front of receive buffer
+static void drop_rx_buf(size_t bytes) {
+	memmove(rx_buf,rx_buf+bytes,rx_len-bytes);
+	rx_len -= bytes;
+}
+
+static int val_pri_hdr(char* buffer) {
+	// Definitions and initializations:
+	struct ccsds_pri_hdr pri_hdr; // Packet primary header
+
+	// Decode primary header:
+	dec_ccsds_pri_hdr(buffer,&pri_hdr);
+
+	return pri_hdr.vrs == CCSDS_VRS && pri_hdr.typ == CCSDS_TYP_TLM && \
+		pri_hdr.sec_hdr_flg == 1 && \
+		pri_hdr.pkt_len >= CCSDS_PKT_LEN(0) && \
+		pri_hdr.pkt_len <= CCSDS_PKT_LEN(CCSDS_TLM_DAT_MAX);
+}
+
+static int val_pkt_crc(char* buffer, uint16_t pkt_size) {
+	// Compare packet error control (last two bytes) with CRC of packet:
+	return get_be16(buffer+pkt_size-CCSDS_ERR_CNT_SIZE) == \
+		calc_ccsds_crc(buffer,pkt_size-CCSDS_ERR_CNT_SIZE);
+}
+
+char* read_port(int fd,char* buffer) {
+	// Definitions and initializations:
+	size_t   off;          // Offset of marker in receive buffer
+	uint16_t pkt_size;     // Telemetry packet size in bytes
+	uint32_t skp_cnt = 0;  // Bytes skipped for this packet
+	uint8_t  lock_flg = 1; // Packet follows previous packet directly
+
+	// Loop until a packet is received:
+	while (1) {
+		// Search for marker (keep a partial marker at end of buffer):
+		off = find_ccsds_asm(rx_buf,rx_len);
+		if (off == rx_len) {
+			off = (rx_len < CCSDS_ASM_SIZE) ? 0 : \
+				rx_len-(CCSDS_ASM_SIZE-1);
+		}
+		if (off > 0) {
+			skp_cnt += off;
+			lock_flg = 0;
+			drop_rx_buf(off);
+		}
+
+		// Wait for marker and primary header:
+		if (rx_len < CCSDS_ASM_SIZE+CCSDS_PRI_HDR_SIZE) {
+			fill_rx_buf(fd);
+			continue;
+		}
+
+		// Check primary header (false lock if implausible):
+		if (!val_pri_hdr(rx_buf+CCSDS_ASM_SIZE)) {
+			rx_stat.false_lock_cnt++;
+			skp_cnt++;
+			lock_flg = 0;
+			drop_rx_buf(1);
+			continue;
+		}
+
+		// Wait for remainder of packet:
+		pkt_size = get_ccsds_pkt_size(rx_buf+CCSDS_ASM_SIZE);
+		if (rx_len < CCSDS_ASM_SIZE+pkt_size) {
+			fill_rx_buf(fd);
+			continue;
+		}
+
+		// Check packet error control (false lock or corrupted packet):
+		if (!val_pkt_crc(rx_buf+CCSDS_ASM_SIZE,pkt_size)) {
+			rx_stat.false_lock_cnt++;
+			skp_cnt++;
+			lock_flg = 0;
+			drop_rx_buf(1);
+			continue;
+		}
 
-	// Loop to get full telecommand packet:
-	while (bytes_to_read > 0 ) {
-		// Read from port:
-		bytes_received = read(fd,&temp_buffer[bytes_read],bytes_to_read);
+		// Copy packet out of receive buffer:
+		memcpy(buffer,rx_buf+CCSDS_ASM_SIZE,pkt_size);
+		drop_rx_buf(CCSDS_ASM_SIZE+pkt_size);
 
-		// Check to see if entire packet is received:
-		if ( bytes_received > 0 ) {
-			// Increment bytes read:
-			bytes_read += bytes_received;
+		// Update statistics:
+		rx_stat.pkt_cnt++;
+		rx_stat.skp_cnt += skp_cnt;
+		if (!lock_flg) {
+			rx_stat.relock_cnt++;
 
-			// Increment bytes to read:
-			bytes_to_read -= bytes_received;
-		} 
-	}	
+			// Print:
+			printf("(READ_PORT) Relocked after %u byte(s) skipped (%lu"
+				" packets, %lu relocks, %lu false locks, %lu bytes"
+				" skipped)\n",skp_cnt,rx_stat.pkt_cnt,\
+				rx_stat.relock_cnt,rx_stat.false_lock_cnt,\
+				rx_stat.skp_cnt);
+		}
 
-	// Copy temporary buffer to return buffer:
-	memcpy(buffer,&temp_buffer,1080);
+		// Return:
+		return buffer;
+	}
+}
 
-	// Return:
-  	return buffer;
-}
\ No newline at end of file
+// Get receiver statistics
+struct read_port_stat get_read_port_stat() {
+	return rx_stat;
+}
@@ -29,6 +29,10 @@
 #include <unistd.h>  // UNIX standard function definitions
 #include <stdint.h>  // Integer types
 
+// Header files:
+#include "ccsds_pkt.h" // CCSDS packet codec
+#include "ccsds_crc.h" // CCSDS packet error control (CRC)
+
 // Macro definitions:
 #define APID_SW 0x00  // Software origin
 #define APID_IMG 0x64 // Image origin
@@ -37,16 +41,6 @@
 // Telemetry processor function
 void gc_proc_tlm_pkt(char* buffer) {   
     // Definitions:
-    uint16_t pkt_hdr_pkt_id;
-    uint16_t pkt_hdr_pkt_seq_cnt;
-    uint16_t pkt_hdr_pkt_len;
-
-    uint32_t pkt_dat_fld_sec_hdr_t_fld_sec;
-    uint16_t pkt_dat_fld_sec_hdr_t_fld_msec;
-    uint8_t pkt_dat_fld_sec_hdr_p_fld;
-    uint32_t pkt_dat_fld_usr_data;
-    uint16_t pkt_dat_fld_pkt_err_cnt;
-
     uint8_t val_telecmd_pkt_cnt; // Valid telecommand packet counter
     uint8_t inv_telecmd_pkt_cnt; // Invalid telecommand packet counter
     uint8_t rx_telecmd_pkt_cnt;  // Received telecommand packet count
@@ -58,87 +52,50 @@ void gc_proc_tlm_pkt(char* buffer) {
     char file_path[50];
     char file_name[100];
 
-    // Save input buffer to seperate fields:
-    memcpy(&pkt_hdr_pkt_id,buffer,2);
-    memcpy(&pkt_hdr_pkt_seq_cnt,buffer+2,2);
-    memcpy(&pkt_hdr_pkt_len,buffer+4,2);
+    // Decode packet header with CCSDS packet codec:
+    struct ccsds_pri_hdr pri_hdr; // Packet primary header
+    struct ccsds_sec_hdr sec_hdr; // Packet secondary header
 
-    memcpy(&pkt_dat_fld_sec_hdr_t_fld_sec,buffer+6,4);
-    memcpy(&pkt_dat_fld_sec_hdr_t_fld_msec,buffer+10,2);
-    memcpy(&pkt_dat_fld_sec_hdr_p_fld,buffer+13,1);
-    memcpy(&pkt_dat_fld_usr_data,buffer+14,1064);
-    memcpy(&pkt_dat_fld_pkt_err_cnt,buffer+1078,2);
+    dec_ccsds_pri_hdr(buffer,&pri_hdr);
+    dec_ccsds_sec_hdr(buffer,&sec_hdr);
 
     // Packet Header Identification:
-    uint8_t pkt_id_vrs;
-    uint8_t pkt_id_typ;
-    uint8_t pkt_id_sec_hdr_flg;
-    uint16_t pkt_id_apid;
-
-    // Packet I.D. Version:
-    pkt_id_vrs = pkt_hdr_pkt_id & 0x07; // Mask to keep bits 0-2
-
-    // Packet I.D. Type:
-    pkt_id_typ = pkt_hdr_pkt_id & 0x08; // Mask to keep bit 3 
-    pkt_id_typ = pkt_id_typ >> 3;       // Shift right by 3 bits
-
-    // Packet I.D. Secondary Header Flag:
-    pkt_id_sec_hdr_flg = pkt_hdr_pkt_id & 0x10;   // Mask to keep bit 4
-    pkt_id_sec_hdr_flg = pkt_id_sec_hdr_flg >> 4; // Shift right by 4 bits
-
-    // Packet I.D. APID:
-    pkt_id_apid = pkt_hdr_pkt_id & 0xFFE0; // Mask to keep bits 5-15
-    pkt_id_apid = pkt_id_apid >> 5;        // Shift right by 5 bits
+    uint8_t  pkt_id_vrs = pri_hdr.vrs;
+    uint8_t  pkt_id_typ = pri_hdr.typ;
+    uint8_t  pkt_id_sec_hdr_flg = pri_hdr.sec_hdr_flg;
+    uint16_t pkt_id_apid = pri_hdr.apid;
 
     // Packet Header Packet Sequence Control
-    uint8_t pkt_seq_cnt_grp_flg;
-    uint16_t pkt_seq_cnt_pkt_name;
-
-    // Packet Sequence Control Grouping Flag:
-    pkt_seq_cnt_grp_flg = pkt_hdr_pkt_seq_cnt & 0x3; // Mask to keep bits 0-1
-
-    // Packet Sequence Control Packet Name:
-    pkt_seq_cnt_pkt_name = pkt_hdr_pkt_seq_cnt \
-        & 0xFFFC; // Mask to keep bits 2-15 
-    pkt_seq_cnt_pkt_name = pkt_hdr_pkt_seq_cnt >> 2; // Shift right by 2 bits
+    uint8_t  pkt_seq_cnt_grp_flg = pri_hdr.grp_flg;
+    uint16_t pkt_seq_cnt_pkt_name = pri_hdr.seq_cnt;
 
     // Packet Header Packet Length
-    uint16_t pkt_len = pkt_hdr_pkt_len;
-
-    // Packet Data Field Packet Secondary Header
-    uint32_t pkt_t_fld_sec;
-    uint16_t pkt_t_fld_msec;
-
-    uint8_t pkt_p_fld_ext;
-    uint8_t pkt_p_fld_id;
-    uint8_t pkt_p_fld_bas;
-    uint8_t pkt_p_fld_frc;
+    uint16_t pkt_len = pri_hdr.pkt_len;
 
     // Packet Data Field Packet Secondary Header T-Fields:
-    pkt_t_fld_sec = pkt_dat_fld_sec_hdr_t_fld_sec;
-    pkt_t_fld_msec = pkt_dat_fld_sec_hdr_t_fld_msec;
-
-    // Packet Secondary Header P-Field Extension:
-    pkt_p_fld_ext = pkt_dat_fld_sec_hdr_p_fld & 0x0; // Mask to keep bit 0
+    uint32_t pkt_t_fld_sec = sec_hdr.t_sec;
+    uint16_t pkt_t_fld_msec = ccsds_frc_to_msec(sec_hdr.t_frc);
 
-    // Packet Secondary Header P-Field Identification:
-    pkt_p_fld_id = pkt_dat_fld_sec_hdr_p_fld & 0xE; // Mask to keep bits 1-3
-    pkt_p_fld_id = pkt_p_fld_id >> 1;               // Shift right by 1 bit
+    // Packet Data Field Packet Secondary Header P-Field:
+    uint8_t pkt_p_fld_ext = sec_hdr.p_ext;
+    uint8_t pkt_p_fld_id = sec_hdr.p_id;
+    uint8_t pkt_p_fld_bas = sec_hdr.p_bas;
+    uint8_t pkt_p_fld_frc = sec_hdr.p_frc;
 
-    // Packet Secondary Header P-Field Variation:
-    pkt_p_fld_bas = pkt_dat_fld_sec_hdr_p_fld & 0x30; // Mask to keep bit 4-5
-    pkt_p_fld_bas = pkt_p_fld_bas >> 4;               // Shift right by 4 bits
+    // Packet Data Field User Data
+    char pkt_usr_data[1064];
+    memcpy(pkt_usr_data,buffer+CCSDS_HDR_SIZE,1064);
 
-    // Packet Secondary Header P-Field Variation:
-    pkt_p_fld_frc = pkt_dat_fld_sec_hdr_p_fld & 0xC0; // Mask to keep bit 6-7
-    pkt_p_fld_frc = pkt_p_fld_frc >> 6;               // Shift right by 5 bits
+    // Packet Data Field Packet Error Control:
+    uint16_t pkt_err_cnt = get_be16(buffer+1078);
 
-    // Packet Data Field Application Data
-    int pkt_usr_data[1064]; 
-    memcpy(pkt_usr_data,&pkt_dat_fld_usr_data,1064);
+    // Check packet error control against CRC of packet (drop if corrupted):
+    if (pkt_err_cnt != calc_ccsds_crc(buffer,1078)) {
+        // Print:
+        printf("<ERROR> Packet error control mismatch; packet dropped\n");
 
-    // Packet Data Field Packet Error Control:
-    uint16_t pkt_err_cnt = pkt_dat_fld_pkt_err_cnt;
+        return;
+    }
 
     // If housekeeping telemetry, parse data and print. If image or
     // magnetometer data, save file:
@@ -172,8 +129,8 @@ void gc_proc_tlm_pkt(char* buffer) {
         // Close file:
         fclose(file_ptr);
     } else if (pkt_id_apid == APID_IMG) {
-        // If first segment, create new file:
-        if (pkt_seq_cnt_grp_flg == 1) {
+        // If first segment (or unsegmented payload), create new file:
+        if ((pkt_seq_cnt_grp_flg == 1) || (pkt_seq_cnt_grp_flg == 3)) {
             // Set filepath:
             strcpy(file_path,"/tmp/img/");
 
@@ -15,4 +15,4 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 // Function declaration:
-char* sim_ieu_crt_tlm_pkt(char* buffer);
\ No newline at end of file
+char* sim_ieu_crt_tlm_pkt(char* buffer, uint16_t seq_cnt);
\ No newline at end of file
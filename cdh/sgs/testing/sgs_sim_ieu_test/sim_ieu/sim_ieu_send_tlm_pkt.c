@@ -2,12 +2,22 @@
 //
 // SGS and Simulated IEU Communication Test
 // 
-// Simulated IEU Receive Ground TeleCommand
+// Simulated IEU Send Telemetry Packets
+//
+// Sends idle telemetry packets, each preceded by the CCSDS attached sync
+// marker (ccsds_asm.h), with consecutive packet sequence counts. Bytes can be
+// dropped at random on the way out to exercise the ground receiver: the
+// ground reports packets received, relocks, and sequence count gaps, so the
+// recovered packet rate is packets received over packets sent. Ideally only
+// the packets hit by a lost byte are lost.
 //
 // -------------------------------------------------------------------------- /
 //
 // Input Arguments:
-// - N/A
+// - argv[1] (port, optional, default /dev/pts/2)
+// - argv[2] (number of packets, optional, default 1)
+// - argv[3] (byte loss probability, optional, default 0)
+// - argv[4] (time between packets in ms, optional, default 0)
 //
 // Output Arguments:
 // - N/A
@@ -33,23 +43,73 @@
 #include <termios.h> // POSIX terminal control definitions
 
 // Header files:
+#include "ccsds_pkt.h"            // CCSDS packet codec
+#include "ccsds_asm.h"            // CCSDS attached sync marker
 #include "sim_ieu_open_port.h"    // Open port function declaration
 #include "sim_ieu_crt_tlm_pkt.h"  // Create packet function declaraton
-#include "sim_ieu_write_port.h" // Write buffer function declaration
+#include "sim_ieu_write_port.h"   // Write buffer function declaration
 
 void main(int argc, char const *argv[]) {
-    // Create telemetry packet:
-    char* buffer = malloc(1080*sizeof(char));
-    buffer = sim_ieu_crt_tlm_pkt(buffer);
+    // Definitions and initializations:
+    char*    port = "/dev/pts/2"; // Port
+    uint32_t npkt = 1;            // Number of packets
+    double   loss_prob = 0;       // Byte loss probability
+    uint32_t prd = 0;             // Time between packets in ms
+
+    uint32_t i;
+    uint32_t j;
+    int      size;               // Bytes on the line for packet
+    uint32_t drop_cnt = 0;       // Bytes dropped
+    uint32_t hit_cnt = 0;        // Packets with a dropped byte
+    uint8_t  hit_flg;            // Packet has a dropped byte
+
+    char pkt_buf[CCSDS_TLM_PKT_MAX];                // Telemetry packet
+    char line_buf[CCSDS_ASM_SIZE+CCSDS_TLM_PKT_MAX]; // Marker and packet
+
+    // Get arguments:
+    if (argc > 1) port = (char*) argv[1];
+    if (argc > 2) npkt = strtoul(argv[2],NULL,0);
+    if (argc > 3) loss_prob = atof(argv[3]);
+    if (argc > 4) prd = strtoul(argv[4],NULL,0);
 
     // Open port:
-    int fd = sim_ieu_open_port("/dev/pts/2");
+    int fd = sim_ieu_open_port(port);
+
+    // Loop over packets:
+    for (i = 0; i < npkt; ++i) {
+        // Create telemetry packet:
+        sim_ieu_crt_tlm_pkt(pkt_buf,i & CCSDS_SEQ_MASK);
+
+        // Copy marker and packet to line, dropping bytes at random:
+        size = 0;
+        hit_flg = 0;
+        for (j = 0; j < CCSDS_ASM_SIZE+CCSDS_TLM_PKT_MAX; ++j) {
+            if (rand() < loss_prob*((double) RAND_MAX+1)) {
+                drop_cnt++;
+                hit_flg = 1;
+                continue;
+            }
+            line_buf[size++] = (j < CCSDS_ASM_SIZE) ? ccsds_asm[j] : \
+                pkt_buf[j-CCSDS_ASM_SIZE];
+        }
+        hit_cnt += hit_flg;
+
+        // Write buffer to port:
+        sim_ieu_write_port(fd,line_buf,size);
+
+        // Wait:
+        if (prd > 0) {
+            usleep(prd*1000);
+        }
+    }
 
-    // Write buffer to port:
-    sim_ieu_write_port(fd,buffer);
+    // Print:
+    printf("SIM IEU: %u packets sent, %u bytes dropped, %u packets hit"
+        " (at most %u should be received)\n",npkt,drop_cnt,hit_cnt,\
+        npkt-hit_cnt);
 
     // Close port:
     close(fd);
 
     return;
-}
\ No newline at end of file
+}
@@ -32,10 +32,10 @@
 #include <errno.h>   // Error number definitions 
 #include <termios.h> // POSIX terminal control definitions 
 
-void sim_ieu_write_port(int fd, char* buffer)
+void sim_ieu_write_port(int fd, char* buffer, int size)
 {
 	// Write buffer to port:
-	int bytes_sent = write(fd,buffer,1080); // 1080 byte telemetry packet
+	int bytes_sent = write(fd,buffer,size);
 
 	return;
 }
\ No newline at end of file
@@ -15,4 +15,4 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 // Function declaration:
-void sim_ieu_write_port(int fd, char* buffer);
\ No newline at end of file
+void sim_ieu_write_port(int fd, char* buffer, int size);
\ No newline at end of file
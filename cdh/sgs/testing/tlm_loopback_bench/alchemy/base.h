@@ -0,0 +1,36 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Alchemy Base Services (POSIX Shim)
+//
+// Time types and timeouts of the Xenomai 3 Alchemy API for building flight
+// software tasks on plain Linux (see xeno_shim.c). Only what the telemetry
+// path uses is provided. Ticks are nanoseconds.
+//
+// -------------------------------------------------------------------------- /
+//
+// agent
+// Project HEPCATS
+// Subsystem: C&DH
+// Created: October 17, 2026
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef ALCHEMY_BASE_H
+#define ALCHEMY_BASE_H
+
+// Standard libraries:
+#include <stddef.h>    // Standard definitions (size_t)
+#include <sys/types.h> // System types (ssize_t)
+
+// Time types:
+typedef unsigned long long RTIME;  // Time in ticks (ns)
+typedef long long          SRTIME; // Signed time in ticks (ns)
+
+// Macro definitions:
+#define TM_INFINITE 0             // Wait forever
+#define TM_NONBLOCK ((RTIME) -1)  // Do not wait
+
+// Function declarations:
+int rt_printf(const char* fmt, ...); // Print (silent unless verbose)
+
+#endif
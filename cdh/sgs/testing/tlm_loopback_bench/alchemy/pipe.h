@@ -0,0 +1,30 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Alchemy Message Pipe Services (POSIX Shim)
+//
+// Pipes are only created (not used) on the telemetry path.
+//
+// -------------------------------------------------------------------------- /
+//
+// agent
+// Project HEPCATS
+// Subsystem: C&DH
+// Created: October 17, 2026
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef ALCHEMY_PIPE_H
+#define ALCHEMY_PIPE_H
+
+#include <alchemy/base.h>
+
+// Message pipe structure:
+typedef struct {
+    int minor; // Pipe minor number
+} RT_PIPE;
+
+// Function declarations:
+int rt_pipe_create(RT_PIPE* pipe, const char* name, int minor,
+    size_t poolsize); // Create message pipe
+
+#endif
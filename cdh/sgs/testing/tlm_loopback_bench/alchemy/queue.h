@@ -0,0 +1,44 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Alchemy Message Queue Services (POSIX Shim)
+//
+// Every message is stamped when it is written so the time it waits in the
+// queue can be measured (xeno_shim.h).
+//
+// -------------------------------------------------------------------------- /
+//
+// agent
+// Project HEPCATS
+// Subsystem: C&DH
+// Created: October 17, 2026
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef ALCHEMY_QUEUE_H
+#define ALCHEMY_QUEUE_H
+
+#include <alchemy/base.h>
+
+// Macro definitions:
+#define Q_FIFO      0 // Waiters in FIFO order
+#define Q_PRIO      1 // Waiters in priority order
+#define Q_NORMAL    0 // Append message
+#define Q_URGENT    1 // Prepend message
+#define Q_UNLIMITED 0 // No message limit
+
+// Message queue structure:
+typedef struct {
+    struct xeno_shim_queue* queue; // Shim queue (NULL until created)
+} RT_QUEUE;
+
+// Function declarations:
+int rt_queue_create(RT_QUEUE* q, const char* name, size_t poolsize,
+    size_t qlimit, int mode);                  // Create message queue
+int rt_queue_write(RT_QUEUE* q, const void* buf, size_t size,
+    int mode);                                 // Copy message into queue
+ssize_t rt_queue_read(RT_QUEUE* q, void* buf, size_t size,
+    RTIME timeout);                            // Read (relative timeout)
+ssize_t rt_queue_read_until(RT_QUEUE* q, void* buf, size_t size,
+    RTIME abs_tm);                             // Read (absolute timeout)
+
+#endif
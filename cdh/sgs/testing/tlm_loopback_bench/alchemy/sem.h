@@ -0,0 +1,35 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Alchemy Semaphore Services (POSIX Shim)
+//
+// -------------------------------------------------------------------------- /
+//
+// agent
+// Project HEPCATS
+// Subsystem: C&DH
+// Created: October 17, 2026
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef ALCHEMY_SEM_H
+#define ALCHEMY_SEM_H
+
+#include <alchemy/base.h>
+
+// Macro definitions:
+#define S_FIFO 0 // Waiters in FIFO order
+#define S_PRIO 1 // Waiters in priority order
+
+// Semaphore structure:
+typedef struct {
+    struct xeno_shim_sem* sem; // Shim semaphore (NULL until created)
+} RT_SEM;
+
+// Function declarations:
+int rt_sem_create(RT_SEM* sem, const char* name, unsigned long icount,
+    int mode);                                 // Create semaphore
+int rt_sem_p(RT_SEM* sem, RTIME timeout);      // Wait (relative timeout)
+int rt_sem_p_until(RT_SEM* sem, RTIME abs_tm); // Wait (absolute timeout)
+int rt_sem_v(RT_SEM* sem);                     // Signal
+
+#endif
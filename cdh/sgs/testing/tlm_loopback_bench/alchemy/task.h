@@ -0,0 +1,30 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Alchemy Task Services (POSIX Shim)
+//
+// Tasks are started as POSIX threads by the loopback benchmark; only task
+// sleep is provided.
+//
+// -------------------------------------------------------------------------- /
+//
+// agent
+// Project HEPCATS
+// Subsystem: C&DH
+// Created: October 17, 2026
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef ALCHEMY_TASK_H
+#define ALCHEMY_TASK_H
+
+#include <alchemy/base.h>
+
+// Task structure (declared by tasks.h; not used):
+typedef struct {
+    int id; // Task I.D.
+} RT_TASK;
+
+// Function declarations:
+int rt_task_sleep(RTIME dly); // Sleep for dly ticks
+
+#endif
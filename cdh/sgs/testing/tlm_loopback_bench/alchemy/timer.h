@@ -0,0 +1,24 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Alchemy Timer Services (POSIX Shim)
+//
+// -------------------------------------------------------------------------- /
+//
+// agent
+// Project HEPCATS
+// Subsystem: C&DH
+// Created: October 17, 2026
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef ALCHEMY_TIMER_H
+#define ALCHEMY_TIMER_H
+
+#include <alchemy/base.h>
+
+// Function declarations:
+RTIME  rt_timer_read(void);           // Get monotonic time
+SRTIME rt_timer_ns2ticks(SRTIME ns);  // Convert ns to ticks
+SRTIME rt_timer_ticks2ns(SRTIME tck); // Convert ticks to ns
+
+#endif
@@ -0,0 +1,673 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Telemetry Loopback Benchmark
+//
+// Downlink throughput and latency benchmark over a pseudo-terminal loopback.
+// The flight software telemetry tasks (agg_tlm, flt_tbl, tx_tlm_pkt) run
+// unmodified as POSIX threads on the Alchemy POSIX shim (xeno_shim.c) and
+// transmit to the slave side of an openpty() pair; the ground receiver
+// (read_port) reads the master side and decodes every telemetry packet the
+// way proc_tlm_pkt does (sub-headers, magnetometer DAQ codec) without
+// writing telemetry files. Recorded frames (create file queue) are counted
+// and released by a stand-in for crt_file.
+//
+// Synthetic telemetry is injected at configurable rates:
+//     - HK:  housekeeping records (send_agg_tlm, APID 0x00)
+//     - MDQ: magnetometer DAQ reads of 128 scans (send_agg_tlm, APID 0xC8;
+//            encoded with the codec if enabled)
+//     - IMG: images (seg_tlm_pkt_xfr_frm, APID 0x64)
+//
+// Reported after the run (and a drain period for frames in flight):
+//     - Frames/sec and bytes/sec received by the ground
+//     - Per-stage latency: time waited in the aggregate telemetry, filter
+//       table, and transmit queues, transmit dequeue to ground decode, and
+//       end to end (creation time to ground decode)
+//     - Loss: frames dequeued for transmit but never decoded, sequence count
+//       gaps, samples dropped by flow control, and frames diverted to
+//       recording by the downlink scheduler
+//
+// A pseudo-terminal has no line rate, so downlink throughput is bounded by
+// the downlink scheduler budget (FLT_TBL_DL_BAUD in flt_tbl.h), not by the
+// port.
+//
+// -------------------------------------------------------------------------- /
+//
+// Input Arguments:
+// - argv[1] (run time in seconds, optional, default 10)
+// - argv[2] (housekeeping records per second, optional, default 1)
+// - argv[3] (magnetometer DAQ reads per second, optional, default 2)
+// - argv[4] (images per second, optional, default 0.2)
+// - argv[5] (image size in bytes, optional, default 102400)
+// - argv[6] (magnetometer DAQ codec flag, optional, default 0)
+// - argv[7] (print flight software output flag, optional, default 0)
+//
+// Output Arguments:
+// - N/A
+//
+// -------------------------------------------------------------------------- /
+//
+// agent
+// Project HEPCATS
+// Subsystem: C&DH
+// Created: October 17, 2026
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Standard libraries:
+#include <stdio.h>   // Standard input/output definitions
+#include <stdlib.h>  // Standard library
+#include <string.h>  // String function definitions
+#include <stdint.h>  // Standard integer types
+#include <unistd.h>  // UNIX standard function definitions
+#include <errno.h>   // Error number definitions
+#include <math.h>    // Math function definitions
+#include <time.h>    // Standard time types
+#include <pthread.h> // POSIX threads
+#include <pty.h>     // Pseudo-terminals (openpty)
+
+// Xenomai libraries (POSIX shim):
+#include <alchemy/task.h>  // Task management services
+#include <alchemy/queue.h> // Message queue services
+#include <alchemy/sem.h>   // Semaphore services
+#include <alchemy/timer.h> // Timer management services
+#include <alchemy/pipe.h>  // Message pipe services
+
+// Flight software header files:
+#include <ccsds_pkt.h>           // CCSDS packet codec
+#include <ccsds_asm.h>           // CCSDS attached sync marker
+#include <agg_tlm_pkt.h>         // Aggregated telemetry packet sub-header
+#include <mdq_cdc.h>             // Magnetometer DAQ codec
+#include <msg_queues.h>          // Message queue variable declarations
+#include <sems.h>                // Semaphore variable declarations
+#include <tasks.h>               // Task function declarations
+#include <dat_struct_startup.h>  // Data structures startup declarations
+#include <tlm_frm_pool.h>        // Telemetry frame pool declarations
+#include <flw_ctl.h>             // Flow control declarations
+#include <agg_tlm.h>             // Aggregate telemetry declarations
+#include <seg_tlm_pkt_xfr_frm.h> // Segment telemetry packet transfer frames
+#include <flt_tbl.h>             // Filter table (TO & DS) declarations
+#include <ld_flt_tbl.h>          // Load filter table declarations
+#include <hk_tlm_var.h>          // Housekeeping telemetry variables
+#include <tm_svc.h>              // Time service declarations
+#include <pbk_rec_tlm.h>         // Play back recorded telemetry declarations
+
+// Ground header files:
+#include <read_port.h> // Read port function declaration
+
+// Shim header files:
+#include "xeno_shim.h" // POSIX shim hooks
+
+// Macro definitions:
+#define BENCH_APID_HK  0x00 // Housekeeping APID
+#define BENCH_APID_IMG 0x64 // Image APID
+#define BENCH_APID_MDQ 0xC8 // Magnetometer DAQ APID
+#define BENCH_NAPID       3 // Number of APIDs
+
+#define BENCH_STG_AGG     0 // Aggregate telemetry queue
+#define BENCH_STG_FLT     1 // Filter table queue
+#define BENCH_STG_TX      2 // Transmit telemetry packet queue
+#define BENCH_STG_DL      3 // Transmit dequeue to ground decode
+#define BENCH_STG_E2E     4 // Creation time to ground decode
+#define BENCH_NSTG        5 // Number of latency stages
+
+#define BENCH_LAT_MAX (1 << 20) // Latency samples kept per stage
+#define BENCH_DRAIN_TM        3 // Drain period in seconds
+#define BENCH_SEQ_NCNT \
+    (CCSDS_SEQ_MASK+1)          // Sequence counts per APID
+
+#define MDQ_READ_NSCAN 128 // Scans per magnetometer DAQ read
+#define MDQ_READ_SIZE  \
+    (MDQ_READ_NSCAN*AGG_TLM_MDQ_REC_SIZE) // Read size in bytes
+
+// Housekeeping variable definitions (defined by get_hk_tlm, which is not
+// part of the benchmark):
+uint16_t tlm_pkt_xfr_frm_seq_cnt; // Packet sequence count
+uint16_t dl_dvrt_cnt[3];          // Frames diverted from downlink
+uint16_t flt_tbl_def_crc;         // Filter table definition CRC-16
+uint8_t  dl_util_pct;             // Downlink line utilization (%)
+
+// Playback stand-in (recorded telemetry is not played back during the
+// benchmark, so realtime telemetry gets the whole link):
+uint8_t get_pbk_rec_tlm_act_pct() {
+    return 0;
+}
+
+// Flight software task structure (thread argument):
+struct bench_task {
+    void (*fn)(void*); // Task function
+    void* arg;         // Task argument
+};
+
+// Latency statistics structure:
+struct bench_lat {
+    const char* name; // Stage name
+    uint64_t*   smpl; // Samples in ns
+    size_t      n;    // Samples recorded
+};
+
+// Benchmark configuration:
+static double   bench_dur = 10;         // Run time in seconds
+static double   bench_hk_rate = 1;      // Housekeeping records per second
+static double   bench_mdq_rate = 2;     // Magnetometer DAQ reads per second
+static double   bench_img_rate = 0.2;   // Images per second
+static uint32_t bench_img_size = 102400; // Image size in bytes
+static uint8_t  bench_cdc_flg = 0;      // Magnetometer DAQ codec flag
+
+// Benchmark state (under bench_mtx):
+static pthread_mutex_t bench_mtx = PTHREAD_MUTEX_INITIALIZER;
+static volatile int    bench_run = 1; // Producers running
+
+static struct bench_lat bench_lat[BENCH_NSTG] = {
+    {"agg_tlm queue"},{"flt_tbl queue"},{"tx_tlm_pkt queue"},
+    {"tx -> ground decode"},{"end to end"}
+};
+
+static pthread_t bench_tx_thrd; // Transmit telemetry packet task thread
+
+static uint64_t (*bench_tx_tm)[BENCH_SEQ_NCNT]; // Transmit dequeue time of
+                                                // every sequence count
+static uint64_t bench_tx_cnt[BENCH_NAPID];      // Frames dequeued for
+                                                // transmit
+
+static uint64_t bench_smpl_cnt[BENCH_NAPID];     // Samples sent
+static uint64_t bench_smpl_drop_cnt[BENCH_NAPID]; // Samples dropped (flow
+                                                  // control)
+static uint64_t bench_rx_cnt[BENCH_NAPID];       // Frames decoded
+static uint64_t bench_rx_gap_cnt[BENCH_NAPID];   // Sequence counts skipped
+static uint64_t bench_rx_smpl_cnt[BENCH_NAPID];  // Records, scans, or bytes
+                                                 // decoded
+static uint64_t bench_rx_byte_cnt;   // Bytes received (marker and packet)
+static uint64_t bench_rx_cdc_err_cnt; // Codec decode errors
+static uint64_t bench_rec_cnt;       // Frames recorded
+static RTIME    bench_rx_tm_last;    // Time of last frame decoded
+
+// Get APID index (-1 if not a benchmark APID)
+static int get_bench_apid_idx(uint16_t apid) {
+    switch (apid) {
+        case BENCH_APID_HK:  return 0;
+        case BENCH_APID_MDQ: return 1;
+        case BENCH_APID_IMG: return 2;
+        default:             return -1;
+    }
+}
+
+// Add latency sample (caller holds bench_mtx)
+static void add_bench_lat(uint8_t stg, uint64_t lat) {
+    if (bench_lat[stg].n < BENCH_LAT_MAX) {
+        bench_lat[stg].smpl[bench_lat[stg].n++] = lat;
+    }
+}
+
+// Compare latency samples (qsort)
+static int cmp_bench_lat(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*) a;
+    uint64_t y = *(const uint64_t*) b;
+
+    return (x > y) - (x < y);
+}
+
+// Message queue read hook: queue latency and transmit dequeue time
+static void hook_bench_read(RT_QUEUE* q, const void* msg, size_t msg_size,
+    RTIME dwell) {
+    // Definitions and initializations:
+    struct ccsds_pri_hdr pri_hdr; // Packet primary header
+
+    tlm_frm_hdl_t tlm_frm_hdl; // Telemetry frame handle
+    int idx;                   // APID index
+
+    pthread_mutex_lock(&bench_mtx);
+
+    // Record queue latency:
+    if (q == &agg_tlm_msg_queue) {
+        add_bench_lat(BENCH_STG_AGG,dwell);
+    } else if (q == &flt_tbl_msg_queue) {
+        add_bench_lat(BENCH_STG_FLT,dwell);
+    } else if ((q == &tx_tlm_pkt_msg_queue) && \
+        pthread_equal(pthread_self(),bench_tx_thrd) && \
+        (msg_size == TLM_FRM_HDL_SIZE)) {
+        add_bench_lat(BENCH_STG_TX,dwell);
+
+        // Record transmit dequeue time by APID and sequence count (frames
+        // evicted by flow control are read by other threads and not
+        // counted):
+        memcpy(&tlm_frm_hdl,msg,TLM_FRM_HDL_SIZE);
+        dec_ccsds_pri_hdr(get_tlm_frm_buf(tlm_frm_hdl)+9,&pri_hdr);
+        idx = get_bench_apid_idx(pri_hdr.apid);
+        if (idx >= 0) {
+            bench_tx_tm[idx][pri_hdr.seq_cnt] = rt_timer_read();
+            bench_tx_cnt[idx]++;
+        }
+    }
+
+    pthread_mutex_unlock(&bench_mtx);
+}
+
+// Sleep until absolute monotonic time in ns
+static void sleep_bench_until(uint64_t tm) {
+    // Definitions and initializations:
+    struct timespec ts; // Wake-up time
+
+    ts.tv_sec  = tm/1000000000;
+    ts.tv_nsec = tm%1000000000;
+    while (clock_nanosleep(CLOCK_MONOTONIC,TIMER_ABSTIME,&ts,NULL) == EINTR);
+}
+
+// Count sample sent or dropped
+static void cnt_bench_smpl(int idx, int32_t ret_val) {
+    pthread_mutex_lock(&bench_mtx);
+    bench_smpl_cnt[idx]++;
+    if (ret_val < 0) {
+        bench_smpl_drop_cnt[idx]++;
+    }
+    pthread_mutex_unlock(&bench_mtx);
+}
+
+// Housekeeping producer
+static void* prod_bench_hk(void* arg) {
+    // Definitions and initializations:
+    uint64_t tm = rt_timer_read(); // Next record time
+    uint32_t i = 0;                // Record counter
+
+    char rec[AGG_TLM_HK_REC_SIZE]; // Housekeeping record
+
+    // Loop until run time is over:
+    while (bench_run) {
+        // Build and send record (counter in first bytes):
+        memset(rec,0,sizeof(rec));
+        memcpy(rec,&i,sizeof(i));
+        cnt_bench_smpl(0,send_agg_tlm(rec,sizeof(rec),BENCH_APID_HK,0));
+        ++i;
+
+        // Wait for next record:
+        tm += 1e9/bench_hk_rate;
+        sleep_bench_until(tm);
+    }
+
+    return NULL;
+}
+
+// Magnetometer DAQ producer
+static void* prod_bench_mdq(void* arg) {
+    // Definitions and initializations:
+    uint64_t tm = rt_timer_read(); // Next read time
+    uint32_t i = 0;                // Read counter
+    uint32_t j;                    // Count counter
+    int16_t  cnt;                  // Count
+    size_t   enc_size = 0;         // Encoded read size in bytes
+
+    char raw[MDQ_READ_SIZE]; // Raw read
+    char enc[MDQ_READ_SIZE]; // Encoded read
+
+    // Loop until run time is over:
+    while (bench_run) {
+        // Build read (slowly turning field plus noise, as bench_mdq_cdc):
+        for (j = 0; j < MDQ_READ_NSCAN*MDQ_CDC_NCHNL; ++j) {
+            cnt = (int16_t) (6554*sin(0.001*(i*MDQ_READ_NSCAN+j/3)+j%3) + \
+                4*(2.0*rand()/RAND_MAX-1));
+            raw[2*j]   = (char) cnt;
+            raw[2*j+1] = (char) ((uint16_t) cnt >> 8);
+        }
+
+        // Encode (raw if codec disabled or not smaller) and send read:
+        if (bench_cdc_flg) {
+            enc_size = enc_mdq_cdc(raw,MDQ_READ_NSCAN,enc,sizeof(enc));
+        }
+        if (enc_size > 0) {
+            cnt_bench_smpl(1,send_agg_tlm(enc,enc_size,BENCH_APID_MDQ,1));
+        } else {
+            cnt_bench_smpl(1,send_agg_tlm(raw,sizeof(raw),BENCH_APID_MDQ,0));
+        }
+        ++i;
+
+        // Wait for next read:
+        tm += 1e9/bench_mdq_rate;
+        sleep_bench_until(tm);
+    }
+
+    return NULL;
+}
+
+// Image producer
+static void* prod_bench_img(void* arg) {
+    // Definitions and initializations:
+    uint64_t tm = rt_timer_read(); // Next image time
+    uint32_t j;                    // Byte counter
+
+    char* img = malloc(bench_img_size); // Image
+
+    // Fill image:
+    for (j = 0; j < bench_img_size; ++j) {
+        img[j] = (char) rand();
+    }
+
+    // Loop until run time is over:
+    while (bench_run) {
+        // Segment image into frames and publish to filter table task:
+        cnt_bench_smpl(2,seg_tlm_pkt_xfr_frm(img,bench_img_size,\
+            BENCH_APID_IMG,&flw_ctl_tbl[FLW_CTL_FLT_TBL]));
+
+        // Wait for next image:
+        tm += 1e9/bench_img_rate;
+        sleep_bench_until(tm);
+    }
+
+    free(img);
+
+    return NULL;
+}
+
+// Create file task stand-in: count and release recorded frames
+static void* rec_bench(void* arg) {
+    // Definitions and initializations:
+    int32_t ret_val; // Function return value
+
+    tlm_frm_hdl_t tlm_frm_hdl; // Telemetry frame handle
+
+    // Task synchronize with filter table task:
+    rt_sem_v(&crt_file_sem);
+
+    // Loop over recorded frames:
+    while (1) {
+        ret_val = rt_queue_read(&crt_file_msg_queue,&tlm_frm_hdl,\
+            TLM_FRM_HDL_SIZE,TM_INFINITE);
+        if (ret_val >= 0) {
+            rtn_flw_ctl(&flw_ctl_tbl[FLW_CTL_CRT_FILE]);
+        }
+        if (ret_val == TLM_FRM_HDL_SIZE) {
+            rls_tlm_frm(tlm_frm_hdl);
+
+            pthread_mutex_lock(&bench_mtx);
+            bench_rec_cnt++;
+            pthread_mutex_unlock(&bench_mtx);
+        }
+    }
+
+    return NULL;
+}
+
+// Decode telemetry packet like proc_tlm_pkt (sub-headers and codec) and
+// record latencies (caller holds bench_mtx)
+static void dec_bench_pkt(char* pkt, uint16_t pkt_size, uint64_t tm_ns,
+    RTIME tm_rt) {
+    // Definitions and initializations:
+    struct ccsds_pri_hdr pri_hdr; // Packet primary header
+    struct ccsds_sec_hdr sec_hdr; // Packet secondary header
+
+    int      idx;       // APID index
+    uint16_t exp_seq;   // Expected sequence count
+    uint16_t off;       // Offset of sub-header in packet
+    uint16_t end;       // End of user data in packet
+    uint16_t t_ofst;    // Sub-sample time offset in ms
+    uint16_t smpl_size; // Sub-sample size in bytes
+    uint8_t  enc_flg;   // Sub-sample encoded flag
+    int32_t  dec_size;  // Decoded sub-sample size in bytes
+    uint64_t tm_crt;    // Packet creation time in ns since epoch
+
+    static int32_t  prev_seq[BENCH_NAPID] = {-1,-1,-1}; // Last sequence count
+    static char     mdq_buf[CCSDS_TLM_DAT_MAX*20];       // Decoded sub-sample
+
+    // Decode headers:
+    dec_ccsds_pri_hdr(pkt,&pri_hdr);
+    dec_ccsds_sec_hdr(pkt,&sec_hdr);
+    idx = get_bench_apid_idx(pri_hdr.apid);
+    if (idx < 0) {
+        return;
+    }
+
+    // Count frame and sequence count gaps:
+    bench_rx_cnt[idx]++;
+    if (prev_seq[idx] >= 0) {
+        exp_seq = (prev_seq[idx]+1) & CCSDS_SEQ_MASK;
+        bench_rx_gap_cnt[idx] += (pri_hdr.seq_cnt-exp_seq) & CCSDS_SEQ_MASK;
+    }
+    prev_seq[idx] = pri_hdr.seq_cnt;
+
+    // Transmit dequeue to ground decode latency:
+    if (bench_tx_tm[idx][pri_hdr.seq_cnt] != 0) {
+        add_bench_lat(BENCH_STG_DL,tm_rt-bench_tx_tm[idx][pri_hdr.seq_cnt]);
+        bench_tx_tm[idx][pri_hdr.seq_cnt] = 0;
+    }
+
+    // Get creation time (T-field):
+    tm_crt = (uint64_t) sec_hdr.t_sec*1000000000+\
+        (((uint64_t) sec_hdr.t_frc*1000000000) >> CCSDS_CUC_FRC_SHFT);
+    end = pkt_size-CCSDS_ERR_CNT_SIZE;
+
+    // Image packets (one image segment each):
+    if (pri_hdr.apid == BENCH_APID_IMG) {
+        bench_rx_smpl_cnt[idx] += end-CCSDS_HDR_SIZE;
+        add_bench_lat(BENCH_STG_E2E,tm_ns-tm_crt);
+
+        return;
+    }
+
+    // Aggregated packets (loop over sub-samples):
+    for (off = CCSDS_HDR_SIZE; off+AGG_SUB_HDR_SIZE <= end; \
+        off += AGG_SUB_HDR_SIZE+smpl_size) {
+        // Decode sub-header:
+        dec_agg_sub_hdr(pkt+off,&t_ofst,&smpl_size,&enc_flg);
+        if (off+AGG_SUB_HDR_SIZE+smpl_size > end) {
+            break;
+        }
+
+        // Count records (decode encoded magnetometer DAQ scans):
+        if (enc_flg) {
+            dec_size = dec_mdq_cdc(pkt+off+AGG_SUB_HDR_SIZE,smpl_size,\
+                mdq_buf,sizeof(mdq_buf));
+            if (dec_size < 0) {
+                bench_rx_cdc_err_cnt++;
+                continue;
+            }
+            bench_rx_smpl_cnt[idx] += dec_size/AGG_TLM_MDQ_REC_SIZE;
+        } else if (pri_hdr.apid == BENCH_APID_MDQ) {
+            bench_rx_smpl_cnt[idx] += smpl_size/AGG_TLM_MDQ_REC_SIZE;
+        } else {
+            bench_rx_smpl_cnt[idx] += smpl_size/AGG_TLM_HK_REC_SIZE;
+        }
+
+        // Creation time to ground decode latency of sub-sample:
+        add_bench_lat(BENCH_STG_E2E,tm_ns-tm_crt-(uint64_t) t_ofst*1000000);
+    }
+}
+
+// Ground receiver: read and decode telemetry packets from master side
+static void* rcv_bench(void* arg) {
+    // Definitions and initializations:
+    int fd = *(int*) arg; // Master file descriptor
+
+    char pkt[CCSDS_TLM_PKT_MAX]; // Telemetry packet
+
+    // Loop over telemetry packets:
+    while (1) {
+        read_port(fd,pkt);
+
+        pthread_mutex_lock(&bench_mtx);
+        bench_rx_byte_cnt += CCSDS_ASM_SIZE+get_ccsds_pkt_size(pkt);
+        bench_rx_tm_last = rt_timer_read();
+        dec_bench_pkt(pkt,get_ccsds_pkt_size(pkt),get_tm_ns(),\
+            bench_rx_tm_last);
+        pthread_mutex_unlock(&bench_mtx);
+    }
+
+    return NULL;
+}
+
+// Flight software task thread entry
+static void* run_bench_task(void* arg) {
+    ((struct bench_task*) arg)->fn(((struct bench_task*) arg)->arg);
+
+    return NULL;
+}
+
+// Start thread
+static pthread_t strt_bench_thrd(void* (*fn)(void*), void* arg) {
+    // Definitions and initializations:
+    pthread_t thrd; // Thread
+
+    if (pthread_create(&thrd,NULL,fn,arg) != 0) {
+        printf("(TLM_LOOPBACK_BENCH) <ERROR> Unable to start thread\n");
+        exit(1);
+    }
+    pthread_detach(thrd);
+
+    return thrd;
+}
+
+// Print latency statistics of stage
+static void print_bench_lat(struct bench_lat* lat) {
+    // Definitions and initializations:
+    uint64_t sum = 0; // Sum of samples in ns
+    size_t   i;
+
+    // Check samples:
+    if (lat->n == 0) {
+        printf("  %-20s %8s\n",lat->name,"-");
+        return;
+    }
+
+    // Sort and print (microseconds):
+    for (i = 0; i < lat->n; ++i) {
+        sum += lat->smpl[i];
+    }
+    qsort(lat->smpl,lat->n,sizeof(uint64_t),cmp_bench_lat);
+    printf("  %-20s %8zu %10.1f %10.1f %10.1f %10.1f\n",lat->name,lat->n,\
+        (double) sum/lat->n/1e3,lat->smpl[lat->n/2]/1e3,\
+        lat->smpl[lat->n*99/100]/1e3,lat->smpl[lat->n-1]/1e3);
+}
+
+int main(int argc, char const *argv[]) {
+    // Definitions and initializations:
+    int      mfd;         // Master file descriptor
+    int      sfd;         // Slave file descriptor
+    uint8_t  i;           // Counter
+    RTIME    tm_strt;     // Start time
+    double   tm_dlt;      // Run time to last frame in seconds
+    uint64_t rx_tot = 0;  // Frames decoded
+    uint64_t tx_tot = 0;  // Frames dequeued for transmit
+    uint64_t gap_tot = 0; // Sequence counts skipped
+
+    char port[64]; // Slave device name
+
+    struct bench_task agg_tlm_task    = {agg_tlm,NULL};    // Tasks (transmit
+    struct bench_task flt_tbl_task    = {flt_tbl,NULL};    // task gets the
+    struct bench_task tx_tlm_pkt_task = {tx_tlm_pkt,port}; // slave name)
+
+    static const char* apid_name[BENCH_NAPID] = {"HK","MDQ","IMG"};
+    static const char* smpl_unit[BENCH_NAPID] = {"records","scans","bytes"};
+
+    // Get configuration:
+    if (argc > 1) bench_dur = strtod(argv[1],NULL);
+    if (argc > 2) bench_hk_rate = strtod(argv[2],NULL);
+    if (argc > 3) bench_mdq_rate = strtod(argv[3],NULL);
+    if (argc > 4) bench_img_rate = strtod(argv[4],NULL);
+    if (argc > 5) bench_img_size = strtoul(argv[5],NULL,0);
+    if (argc > 6) bench_cdc_flg = strtoul(argv[6],NULL,0) != 0;
+    if (argc > 7) xeno_shim_verbose = strtoul(argv[7],NULL,0) != 0;
+
+    // Allocate latency samples and transmit dequeue times:
+    for (i = 0; i < BENCH_NSTG; ++i) {
+        bench_lat[i].smpl = malloc(BENCH_LAT_MAX*sizeof(uint64_t));
+    }
+    bench_tx_tm = calloc(BENCH_NAPID,sizeof(*bench_tx_tm));
+
+    // Open pseudo-terminal pair (tx_tlm_pkt opens the slave by name):
+    if (openpty(&mfd,&sfd,port,NULL,NULL) < 0) {
+        printf("(TLM_LOOPBACK_BENCH) <ERROR> Unable to open pseudo-terminal"
+            "\n");
+        return 1;
+    }
+
+    // Print:
+    printf("(TLM_LOOPBACK_BENCH) %s: %.0f s, HK %.2f/s, MDQ %.2f reads/s"
+        " (codec %s), IMG %.2f/s of %u bytes\n",port,bench_dur,\
+        bench_hk_rate,bench_mdq_rate,bench_cdc_flg ? "on" : "off",\
+        bench_img_rate,bench_img_size);
+
+    // Start flight software data structures and services:
+    init_tm_svc();
+    crt_msg_queues_pipes();
+    crt_sems();
+    init_flt_tbl_def();
+    xeno_shim_read_hook = hook_bench_read;
+
+    // Start ground receiver and telemetry tasks:
+    strt_bench_thrd(rcv_bench,&mfd);
+    strt_bench_thrd(rec_bench,NULL);
+    bench_tx_thrd = strt_bench_thrd(run_bench_task,&tx_tlm_pkt_task);
+    strt_bench_thrd(run_bench_task,&flt_tbl_task);
+    strt_bench_thrd(run_bench_task,&agg_tlm_task);
+
+    // Wait for filter table task to be ready (it signals flt_tbl_sem once
+    // for every producer):
+    rt_sem_p(&flt_tbl_sem,TM_INFINITE);
+
+    // Start producers:
+    tm_strt = rt_timer_read();
+    if (bench_hk_rate > 0) strt_bench_thrd(prod_bench_hk,NULL);
+    if (bench_mdq_rate > 0) strt_bench_thrd(prod_bench_mdq,NULL);
+    if (bench_img_rate > 0) strt_bench_thrd(prod_bench_img,NULL);
+
+    // Run, stop producers, and drain frames in flight:
+    sleep_bench_until(tm_strt+bench_dur*1e9);
+    bench_run = 0;
+    sleep_bench_until(tm_strt+(bench_dur+BENCH_DRAIN_TM)*1e9);
+
+    pthread_mutex_lock(&bench_mtx);
+
+    // Print throughput:
+    for (i = 0; i < BENCH_NAPID; ++i) {
+        rx_tot += bench_rx_cnt[i];
+        tx_tot += bench_tx_cnt[i];
+        gap_tot += bench_rx_gap_cnt[i];
+    }
+    tm_dlt = (bench_rx_tm_last > tm_strt) ? \
+        (bench_rx_tm_last-tm_strt)/1e9 : bench_dur;
+    printf("\nThroughput (%.2f s to last frame):\n",tm_dlt);
+    printf("  %.1f frames/s, %.1f bytes/s (%.1f%% of %d bytes/s downlink"
+        " budget)\n",rx_tot/tm_dlt,bench_rx_byte_cnt/tm_dlt,\
+        100*bench_rx_byte_cnt/tm_dlt/FLT_TBL_DL_BYTE_RATE,\
+        FLT_TBL_DL_BYTE_RATE);
+
+    // Print per-APID counts:
+    printf("\n  %-4s %8s %8s %8s %8s %8s %12s\n","APID","sent","dropped",\
+        "tx","rx","seq gap","decoded");
+    for (i = 0; i < BENCH_NAPID; ++i) {
+        printf("  %-4s %8llu %8llu %8llu %8llu %8llu %12llu %s\n",\
+            apid_name[i],(unsigned long long) bench_smpl_cnt[i],\
+            (unsigned long long) bench_smpl_drop_cnt[i],\
+            (unsigned long long) bench_tx_cnt[i],\
+            (unsigned long long) bench_rx_cnt[i],\
+            (unsigned long long) bench_rx_gap_cnt[i],\
+            (unsigned long long) bench_rx_smpl_cnt[i],smpl_unit[i]);
+    }
+
+    // Print loss:
+    printf("\nLoss:\n");
+    printf("  %llu frame(s) dequeued for transmit but not decoded\n",\
+        (unsigned long long) (tx_tot-rx_tot));
+    printf("  %llu sequence count(s) skipped (dropped, diverted, or lost)\n",\
+        (unsigned long long) gap_tot);
+    printf("  %llu frame(s) recorded (diverted %u HK, %u MDQ, %u IMG)\n",\
+        (unsigned long long) bench_rec_cnt,dl_dvrt_cnt[0],dl_dvrt_cnt[1],\
+        dl_dvrt_cnt[2]);
+    printf("  flow control drops: agg_tlm %u, flt_tbl %u, tx_tlm_pkt %u,"
+        " crt_file %u\n",flw_ctl_tbl[FLW_CTL_AGG_TLM].drop_cnt,\
+        flw_ctl_tbl[FLW_CTL_FLT_TBL].drop_cnt,\
+        flw_ctl_tbl[FLW_CTL_TX_TLM_PKT].drop_cnt,\
+        flw_ctl_tbl[FLW_CTL_CRT_FILE].drop_cnt);
+    printf("  %lu false lock(s), %lu byte(s) skipped, %llu codec error(s)\n",\
+        get_read_port_stat().false_lock_cnt,get_read_port_stat().skp_cnt,\
+        (unsigned long long) bench_rx_cdc_err_cnt);
+
+    // Print latency:
+    printf("\nLatency (us):\n");
+    printf("  %-20s %8s %10s %10s %10s %10s\n","stage","count","mean",\
+        "p50","p99","max");
+    for (i = 0; i < BENCH_NSTG; ++i) {
+        print_bench_lat(&bench_lat[i]);
+    }
+
+    pthread_mutex_unlock(&bench_mtx);
+
+    return 0;
+}
@@ -0,0 +1,341 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Xenomai Alchemy POSIX Shim
+//
+// POSIX implementation of the Alchemy services used on the flight software
+// telemetry path (message queues, semaphores, timer, task sleep, rt_printf)
+// so the telemetry tasks can run as POSIX threads on plain Linux for the
+// loopback benchmark. Semantics follow Xenomai 3 where the tasks depend on
+// them:
+//     - Timeouts are relative ticks (TM_INFINITE waits forever, TM_NONBLOCK
+//       never waits); read_until takes an absolute time
+//     - Empty queues and unavailable semaphores return -EWOULDBLOCK (no
+//       wait) or -ETIMEDOUT (timeout); full queues return -ENOMEM
+//     - Reads return the message size (messages larger than the buffer are
+//       truncated)
+//     - Ticks are nanoseconds of CLOCK_MONOTONIC
+//
+// Message queues stamp every message when written; the read hook gets the
+// time the message waited (see xeno_shim.h).
+//
+// -------------------------------------------------------------------------- /
+//
+// agent
+// Project HEPCATS
+// Subsystem: C&DH
+// Created: October 17, 2026
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Standard libraries:
+#include <stdio.h>   // Standard input/output definitions
+#include <stdlib.h>  // Standard library
+#include <string.h>  // String function definitions
+#include <stdarg.h>  // Variable arguments
+#include <errno.h>   // Error number definitions
+#include <time.h>    // Standard time types
+#include <pthread.h> // POSIX threads
+
+// Header files:
+#include <alchemy/task.h>  // Task management services
+#include <alchemy/queue.h> // Message queue services
+#include <alchemy/sem.h>   // Semaphore services
+#include <alchemy/timer.h> // Timer management services
+#include <alchemy/pipe.h>  // Message pipe services
+#include "xeno_shim.h"     // POSIX shim hooks
+
+// Message structure:
+struct xeno_shim_msg {
+    struct xeno_shim_msg* next; // Next message in queue
+    size_t size;                // Message size in bytes
+    RTIME  tm;                  // Time written
+    char   buf[];               // Message
+};
+
+// Message queue structure:
+struct xeno_shim_queue {
+    pthread_mutex_t mtx;          // Queue lock
+    pthread_cond_t  cnd;          // Message written
+    struct xeno_shim_msg* head;   // Oldest message
+    struct xeno_shim_msg* tail;   // Newest message
+    size_t nmsg;                  // Messages in queue
+    size_t qlimit;                // Message limit (0: unlimited)
+};
+
+// Semaphore structure:
+struct xeno_shim_sem {
+    pthread_mutex_t mtx; // Semaphore lock
+    pthread_cond_t  cnd; // Semaphore signaled
+    unsigned long   cnt; // Semaphore count
+};
+
+// Variable definitions:
+int xeno_shim_verbose = 0;                        // Print rt_printf output
+xeno_shim_read_hook_t xeno_shim_read_hook = NULL; // Read hook (NULL: none)
+
+// Initialize condition variable on monotonic clock
+static void init_xeno_shim_cnd(pthread_cond_t* cnd) {
+    // Definitions and initializations:
+    pthread_condattr_t attr; // Condition variable attributes
+
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr,CLOCK_MONOTONIC);
+    pthread_cond_init(cnd,&attr);
+    pthread_condattr_destroy(&attr);
+}
+
+// Wait on condition variable until absolute time (TM_INFINITE: forever;
+// returns 0 or ETIMEDOUT)
+static int wait_xeno_shim_cnd(pthread_cond_t* cnd, pthread_mutex_t* mtx,
+    RTIME abs_tm) {
+    // Definitions and initializations:
+    struct timespec ts; // Absolute time
+
+    // Wait forever:
+    if (abs_tm == TM_INFINITE) {
+        return pthread_cond_wait(cnd,mtx);
+    }
+
+    // Wait until absolute time:
+    ts.tv_sec  = abs_tm/1000000000;
+    ts.tv_nsec = abs_tm%1000000000;
+
+    return pthread_cond_timedwait(cnd,mtx,&ts);
+}
+
+// Convert relative timeout to absolute time (TM_INFINITE and TM_NONBLOCK
+// are kept)
+static RTIME get_xeno_shim_abs_tm(RTIME timeout) {
+    if ((timeout == TM_INFINITE) || (timeout == TM_NONBLOCK)) {
+        return timeout;
+    }
+
+    return rt_timer_read()+timeout;
+}
+
+int rt_printf(const char* fmt, ...) {
+    // Definitions and initializations:
+    va_list args;    // Arguments
+    int     ret_val; // Function return value
+
+    // Print only in verbose mode:
+    if (!xeno_shim_verbose) {
+        return 0;
+    }
+
+    va_start(args,fmt);
+    ret_val = vprintf(fmt,args);
+    va_end(args);
+
+    return ret_val;
+}
+
+RTIME rt_timer_read(void) {
+    // Definitions and initializations:
+    struct timespec ts; // Monotonic clock
+
+    clock_gettime(CLOCK_MONOTONIC,&ts);
+
+    return (RTIME) ts.tv_sec*1000000000+ts.tv_nsec;
+}
+
+SRTIME rt_timer_ns2ticks(SRTIME ns) {
+    return ns;
+}
+
+SRTIME rt_timer_ticks2ns(SRTIME tck) {
+    return tck;
+}
+
+int rt_task_sleep(RTIME dly) {
+    // Definitions and initializations:
+    struct timespec ts; // Sleep time
+
+    ts.tv_sec  = dly/1000000000;
+    ts.tv_nsec = dly%1000000000;
+
+    return nanosleep(&ts,NULL) == 0 ? 0 : -EINTR;
+}
+
+int rt_sem_create(RT_SEM* sem, const char* name, unsigned long icount,
+    int mode) {
+    // Allocate semaphore:
+    sem->sem = calloc(1,sizeof(struct xeno_shim_sem));
+    if (sem->sem == NULL) {
+        return -ENOMEM;
+    }
+
+    // Initialize:
+    pthread_mutex_init(&sem->sem->mtx,NULL);
+    init_xeno_shim_cnd(&sem->sem->cnd);
+    sem->sem->cnt = icount;
+
+    return 0;
+}
+
+int rt_sem_p_until(RT_SEM* sem, RTIME abs_tm) {
+    // Definitions and initializations:
+    struct xeno_shim_sem* s = sem->sem;
+
+    int ret_val = 0; // Function return value
+
+    pthread_mutex_lock(&s->mtx);
+
+    // Wait for count (unless not waiting):
+    while ((s->cnt == 0) && (abs_tm != TM_NONBLOCK) && (ret_val == 0)) {
+        ret_val = wait_xeno_shim_cnd(&s->cnd,&s->mtx,abs_tm);
+    }
+
+    // Take count:
+    if (s->cnt > 0) {
+        s->cnt--;
+        ret_val = 0;
+    } else {
+        ret_val = (abs_tm == TM_NONBLOCK) ? -EWOULDBLOCK : -ETIMEDOUT;
+    }
+
+    pthread_mutex_unlock(&s->mtx);
+
+    return ret_val;
+}
+
+int rt_sem_p(RT_SEM* sem, RTIME timeout) {
+    return rt_sem_p_until(sem,get_xeno_shim_abs_tm(timeout));
+}
+
+int rt_sem_v(RT_SEM* sem) {
+    // Definitions and initializations:
+    struct xeno_shim_sem* s = sem->sem;
+
+    pthread_mutex_lock(&s->mtx);
+    s->cnt++;
+    pthread_cond_signal(&s->cnd);
+    pthread_mutex_unlock(&s->mtx);
+
+    return 0;
+}
+
+int rt_queue_create(RT_QUEUE* q, const char* name, size_t poolsize,
+    size_t qlimit, int mode) {
+    // Allocate message queue:
+    q->queue = calloc(1,sizeof(struct xeno_shim_queue));
+    if (q->queue == NULL) {
+        return -ENOMEM;
+    }
+
+    // Initialize:
+    pthread_mutex_init(&q->queue->mtx,NULL);
+    init_xeno_shim_cnd(&q->queue->cnd);
+    q->queue->qlimit = qlimit;
+
+    return 0;
+}
+
+int rt_queue_write(RT_QUEUE* q, const void* buf, size_t size, int mode) {
+    // Definitions and initializations:
+    struct xeno_shim_queue* qu = q->queue;
+    struct xeno_shim_msg*   msg;
+
+    // Copy and stamp message:
+    msg = malloc(sizeof(struct xeno_shim_msg)+size);
+    if (msg == NULL) {
+        return -ENOMEM;
+    }
+    memcpy(msg->buf,buf,size);
+    msg->size = size;
+    msg->tm = rt_timer_read();
+
+    pthread_mutex_lock(&qu->mtx);
+
+    // Check limit:
+    if ((qu->qlimit != Q_UNLIMITED) && (qu->nmsg >= qu->qlimit)) {
+        pthread_mutex_unlock(&qu->mtx);
+        free(msg);
+
+        return -ENOMEM;
+    }
+
+    // Prepend (urgent) or append message:
+    if (mode & Q_URGENT) {
+        msg->next = qu->head;
+        qu->head = msg;
+        if (qu->tail == NULL) {
+            qu->tail = msg;
+        }
+    } else {
+        msg->next = NULL;
+        if (qu->tail != NULL) {
+            qu->tail->next = msg;
+        } else {
+            qu->head = msg;
+        }
+        qu->tail = msg;
+    }
+    qu->nmsg++;
+
+    // Wake a reader:
+    pthread_cond_signal(&qu->cnd);
+    pthread_mutex_unlock(&qu->mtx);
+
+    return 0;
+}
+
+ssize_t rt_queue_read_until(RT_QUEUE* q, void* buf, size_t size,
+    RTIME abs_tm) {
+    // Definitions and initializations:
+    struct xeno_shim_queue* qu = q->queue;
+    struct xeno_shim_msg*   msg;
+
+    int     ret_val = 0; // Function return value
+    ssize_t msg_size;    // Message size in bytes
+    RTIME   dwell;       // Time message waited in queue
+
+    pthread_mutex_lock(&qu->mtx);
+
+    // Wait for message (unless not waiting):
+    while ((qu->head == NULL) && (abs_tm != TM_NONBLOCK) && (ret_val == 0)) {
+        ret_val = wait_xeno_shim_cnd(&qu->cnd,&qu->mtx,abs_tm);
+    }
+
+    // Check for message:
+    msg = qu->head;
+    if (msg == NULL) {
+        pthread_mutex_unlock(&qu->mtx);
+
+        return (abs_tm == TM_NONBLOCK) ? -EWOULDBLOCK : -ETIMEDOUT;
+    }
+
+    // Dequeue:
+    qu->head = msg->next;
+    if (qu->head == NULL) {
+        qu->tail = NULL;
+    }
+    qu->nmsg--;
+
+    pthread_mutex_unlock(&qu->mtx);
+
+    // Copy message out:
+    msg_size = msg->size;
+    memcpy(buf,msg->buf,(msg->size < size) ? msg->size : size);
+    dwell = rt_timer_read()-msg->tm;
+
+    // Call read hook:
+    if (xeno_shim_read_hook != NULL) {
+        xeno_shim_read_hook(q,msg->buf,msg->size,dwell);
+    }
+    free(msg);
+
+    return msg_size;
+}
+
+ssize_t rt_queue_read(RT_QUEUE* q, void* buf, size_t size, RTIME timeout) {
+    return rt_queue_read_until(q,buf,size,get_xeno_shim_abs_tm(timeout));
+}
+
+int rt_pipe_create(RT_PIPE* pipe, const char* name, int minor,
+    size_t poolsize) {
+    // Pipes are not used on the telemetry path:
+    pipe->minor = minor;
+
+    return minor;
+}
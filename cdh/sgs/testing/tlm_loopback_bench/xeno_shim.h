@@ -0,0 +1,28 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Xenomai Alchemy POSIX Shim Header
+//
+// Hooks of the POSIX shim of the Alchemy services (alchemy/*.h) used to run
+// the flight software telemetry tasks as POSIX threads on plain Linux. The
+// read hook is called after every message queue read with the message and
+// the time it waited in the queue.
+//
+// -------------------------------------------------------------------------- /
+//
+// agent
+// Project HEPCATS
+// Subsystem: C&DH
+// Created: October 17, 2026
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Header files:
+#include <alchemy/queue.h> // Message queue services
+
+// Type definitions:
+typedef void (*xeno_shim_read_hook_t)(RT_QUEUE* q, const void* msg,
+    size_t msg_size, RTIME dwell); // Message queue read hook
+
+// Variable declarations:
+extern int xeno_shim_verbose;                       // Print rt_printf output
+extern xeno_shim_read_hook_t xeno_shim_read_hook; // Read hook (NULL: none)